@@ -1,5 +1,11 @@
 #include "OpenSimCreator/Screens/MainUIScreen.hpp"
+#include "OpenSimCreator/BasicModelStatePair.hpp"
+#include "OpenSimCreator/BatchSimulator.hpp"
+#include "OpenSimCreator/ForwardDynamicSimulatorParams.hpp"
 #include "OpenSimCreator/OpenSimApp.hpp"
+#include "OpenSimCreator/OpenSimHelpers.hpp"
+#include "OpenSimCreator/SimulationClock.hpp"
+#include "OpenSimCreator/SimulationStatus.hpp"
 
 #include "oscar/Platform/Config.hpp"
 #include "oscar/Platform/Log.hpp"
@@ -7,20 +13,57 @@
 #include "oscar/Tabs/TabHost.hpp"
 #include "oscar/Tabs/TabRegistry.hpp"
 #include "oscar/Utils/CStringView.hpp"
+#include "oscar/Utils/WorkStealingThreadPool.hpp"
 
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdlib>
+#include <exception>
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
-static osc::CStringView constexpr c_Usage = R"(usage: osc [--help] [fd] MODEL.osim
+static osc::CStringView constexpr c_Usage = R"(usage: osc [--help] [MODEL.osim...]
+       osc batch [--help] [BATCH_OPTIONS] MODEL.osim
 )";
 
 static osc::CStringView constexpr c_Help = R"(OPTIONS
     --help
         Show this help
+
+BATCH_OPTIONS
+    Runs a batch of forward-dynamic simulations of MODEL.osim without opening
+    a window (e.g. on build machines) and writes the results to disk
+
+    --sweep=integrators|accuracy|perturbed
+        What to vary between simulations (default: integrators)
+    --final-time=SECONDS
+        Final time of each simulation (default: 10)
+    --threads=N
+        Number of worker threads, from 1 to 1024 (default: number of hardware threads)
+    --output=DIR
+        Directory to write a CSV per simulation, plus a summary.csv, into (default: osc_batch)
+    --num-perturbations=N
+        --sweep=perturbed: number of simulations (default: 10)
+    --perturbation-stddev=X
+        --sweep=perturbed: standard deviation of the noise added to each coordinate (default: 0.01)
 )";
 
 namespace
 {
+    // upper limits on `osc batch` counts, so that typos can't (e.g.) spawn millions of threads
+    constexpr long long c_MaxNumThreads = 1024;
+    constexpr long long c_MaxNumPerturbations = 1000000;
+
     bool SkipPrefix(char const* prefix, char const* s, char const** out)
     {
         do
@@ -35,6 +78,189 @@ namespace
 
         return false;
     }
+
+    // returns the value part of a `--flag=value` argument, or `std::nullopt` if the
+    // argument isn't that flag or it has no value
+    std::optional<std::string> TryGetFlagValue(char const* flag, char const* arg)
+    {
+        char const* rest = nullptr;
+        if (!SkipPrefix(flag, arg, &rest) || *rest != '=')
+        {
+            return std::nullopt;
+        }
+        return std::string{rest + 1};
+    }
+
+    // returns the integer value of a `--flag=value` argument's value
+    //
+    // throws if the value isn't an integer in the range [1, max], rather than letting
+    // (e.g.) a negative value wrap around to a huge unsigned one
+    size_t ParseCount(std::string const& value, char const* flag, long long max)
+    {
+        size_t numParsed = 0;
+        long long rv = 0;
+        try
+        {
+            rv = std::stoll(value, &numParsed);
+        }
+        catch (std::exception const&)
+        {
+            numParsed = 0;
+        }
+        if (numParsed == 0 || numParsed != value.size())
+        {
+            throw std::invalid_argument{std::string{flag} + ": '" + value + "' is not an integer (or is too large)"};
+        }
+        if (rv < 1 || rv > max)
+        {
+            throw std::out_of_range{std::string{flag} + " must be between 1 and " + std::to_string(max)};
+        }
+        return static_cast<size_t>(rv);
+    }
+
+    // entrypoint for `osc batch`: headless batch simulation
+    int RunBatchSimulations(int argc, char** argv)
+    {
+        std::string sweep = "integrators";
+        std::filesystem::path outputDir = "osc_batch";
+        osc::BatchSimulatorParams batchParams;
+        osc::ForwardDynamicSimulatorParams simParams;
+        size_t numPerturbations = 10;
+        double perturbationStddev = 0.01;
+
+        try
+        {
+            for (; argc && **argv == '-'; --argc, ++argv)
+            {
+                char const* arg = *argv;
+                if (std::string_view{arg} == "--help" || std::string_view{arg} == "-h")
+                {
+                    std::cout << c_Usage << '\n' << c_Help << '\n';
+                    return EXIT_SUCCESS;
+                }
+                else if (auto sweepArg = TryGetFlagValue("--sweep", arg))
+                {
+                    sweep = *sweepArg;
+                }
+                else if (auto finalTimeArg = TryGetFlagValue("--final-time", arg))
+                {
+                    simParams.finalTime = osc::SimulationClock::start() + osc::SimulationClock::duration{std::stod(*finalTimeArg)};
+                }
+                else if (auto threadsArg = TryGetFlagValue("--threads", arg))
+                {
+                    batchParams.numThreads = ParseCount(*threadsArg, "--threads", c_MaxNumThreads);
+                }
+                else if (auto outputArg = TryGetFlagValue("--output", arg))
+                {
+                    outputDir = *outputArg;
+                }
+                else if (auto numPerturbationsArg = TryGetFlagValue("--num-perturbations", arg))
+                {
+                    numPerturbations = ParseCount(*numPerturbationsArg, "--num-perturbations", c_MaxNumPerturbations);
+                }
+                else if (auto stddevArg = TryGetFlagValue("--perturbation-stddev", arg))
+                {
+                    perturbationStddev = std::stod(*stddevArg);
+                }
+                else
+                {
+                    std::cerr << "osc batch: unknown option: " << arg << '\n' << c_Usage;
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+        catch (std::exception const& ex)
+        {
+            std::cerr << "osc batch: invalid option value: " << ex.what() << '\n';
+            return EXIT_FAILURE;
+        }
+
+        if (argc != 1)
+        {
+            std::cerr << "osc batch: exactly one model file must be provided\n" << c_Usage;
+            return EXIT_FAILURE;
+        }
+        batchParams.outputDirectory = outputDir;
+
+        // init OpenSim (without initializing the UI)
+        std::unique_ptr<osc::Config> config = osc::Config::load();
+        osc::GlobalInitOpenSim(*config);
+
+        // load the model
+        std::optional<osc::BasicModelStatePair> maybeModelState;
+        try
+        {
+            OpenSim::Model model{std::string{*argv}};
+            osc::InitializeModel(model);
+            osc::InitializeState(model);
+            maybeModelState.emplace(model, model.getWorkingState());
+        }
+        catch (std::exception const& ex)
+        {
+            std::cerr << "osc batch: " << *argv << ": error loading model: " << ex.what() << '\n';
+            return EXIT_FAILURE;
+        }
+        osc::BasicModelStatePair const& modelState = *maybeModelState;
+
+        std::vector<osc::BatchSimulationJob> jobs;
+        if (sweep == "integrators")
+        {
+            jobs = osc::GenerateIntegratorSweepJobs(modelState, simParams);
+        }
+        else if (sweep == "accuracy")
+        {
+            std::array<double, 5> constexpr c_Accuracies = {1.0e-2, 1.0e-3, 1.0e-4, 1.0e-5, 1.0e-6};
+            jobs = osc::GenerateAccuracySweepJobs(modelState, simParams, c_Accuracies);
+        }
+        else if (sweep == "perturbed")
+        {
+            try
+            {
+                jobs = osc::GeneratePerturbedInitialStateJobs(modelState, simParams, numPerturbations, perturbationStddev, 0u);
+            }
+            catch (std::exception const& ex)
+            {
+                std::cerr << "osc batch: error perturbing the model's initial state (is --perturbation-stddev too large?): " << ex.what() << '\n';
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            std::cerr << "osc batch: unknown sweep type: " << sweep << '\n';
+            return EXIT_FAILURE;
+        }
+
+        // run the batch, printing progress until it finishes
+        osc::BatchSimulator batch{std::move(jobs), batchParams};
+        std::cout << "running " << batch.getNumJobs() << " simulations on " << batchParams.numThreads << " threads\n";
+        while (!batch.isFinished())
+        {
+            std::this_thread::sleep_for(std::chrono::seconds{1});
+
+            float totalProgress = 0.0f;
+            for (size_t i = 0; i < batch.getNumJobs(); ++i)
+            {
+                totalProgress += batch.getJobProgress(i).progress;
+            }
+            std::cout << '[' << batch.getNumFinishedJobs() << '/' << batch.getNumJobs() << " finished] "
+                      << static_cast<int>(100.0f * totalProgress / static_cast<float>(batch.getNumJobs())) << "%\n";
+        }
+        batch.wait();
+
+        int rv = EXIT_SUCCESS;
+        for (size_t i = 0; i < batch.getNumJobs(); ++i)
+        {
+            osc::SimulationStatus const status = batch.getJobProgress(i).status;
+            std::cout << batch.getJobName(i) << ": " << osc::GetAllSimulationStatusStrings()[static_cast<size_t>(status)] << '\n';
+            if (status != osc::SimulationStatus::Completed)
+            {
+                rv = EXIT_FAILURE;
+            }
+        }
+        std::cout << "results written to " << outputDir.string() << '\n';
+
+        return rv;
+    }
 }
 
 int main(int argc, char** argv)
@@ -43,6 +269,12 @@ int main(int argc, char** argv)
     --argc;
     ++argv;
 
+    // handle subcommands
+    if (argc && std::string_view{*argv} == "batch")
+    {
+        return RunBatchSimulations(argc - 1, argv + 1);
+    }
+
     // handle named flag args (e.g. --help)
     while (argc)
     {
@@ -0,0 +1,181 @@
+#include "OpenSimCreator/Graphics/SimTKMeshLoader.hpp"
+
+#include "oscar/Graphics/Mesh.hpp"
+#include "oscar/Graphics/MeshIndicesView.hpp"
+#include "oscar/Maths/AABB.hpp"
+#include "oscar/Maths/BVH.hpp"
+#include "oscar/Maths/Line.hpp"
+#include "oscar/Maths/MathHelpers.hpp"
+#include "oscar/Maths/Triangle.hpp"
+#include "oscar/Platform/Config.hpp"
+
+#include <benchmark/benchmark.h>
+#include <glm/vec3.hpp>
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace
+{
+    // a selection of the (larger) bone meshes that the Rajagopal model uses
+    std::vector<osc::Mesh> LoadRajagopalBoneMeshes()
+    {
+        auto config = osc::Config::load();
+        std::filesystem::path const geometryDir = config->getResourceDir() / "geometry";
+
+        std::vector<osc::Mesh> rv;
+        for (char const* filename : {"r_femur.vtp", "r_tibia.vtp", "r_pelvis.vtp", "sacrum.vtp", "hat_spine.vtp", "hat_skull.vtp", "hat_ribs_scap.vtp"})
+        {
+            rv.push_back(osc::LoadMeshViaSimTK(geometryDir / filename));
+        }
+        return rv;
+    }
+
+    osc::BVHBuildOptions GetBuildOptions(benchmark::State const& state)
+    {
+        osc::BVHBuildOptions rv;
+        rv.strategy = static_cast<osc::BVHBuildStrategy>(state.range(0));
+        return rv;
+    }
+
+    void BuildBVH(osc::BVH& bvh, osc::Mesh const& mesh, osc::BVHBuildOptions const& opts)
+    {
+        osc::MeshIndicesView const indices = mesh.getIndices();
+        if (indices.isU16())
+        {
+            bvh.buildFromIndexedTriangles(mesh.getVerts(), indices.toU16Span(), opts);
+        }
+        else
+        {
+            bvh.buildFromIndexedTriangles(mesh.getVerts(), indices.toU32Span(), opts);
+        }
+    }
+
+    // returns a grid of (slightly tilted) "hover" rays that are fired into the front of the given
+    // bounds, similar to what hit-testing does when a user moves the mouse over a mesh
+    std::vector<osc::Line> GenerateHoverRays(osc::AABB const& bounds, size_t numRaysPerAxis)
+    {
+        glm::vec3 const dims = bounds.max - bounds.min;
+
+        std::vector<osc::Line> rv;
+        rv.reserve(numRaysPerAxis * numRaysPerAxis);
+        for (size_t i = 0; i < numRaysPerAxis; ++i)
+        {
+            for (size_t j = 0; j < numRaysPerAxis; ++j)
+            {
+                float const fx = (static_cast<float>(i) + 0.5f) / static_cast<float>(numRaysPerAxis);
+                float const fy = (static_cast<float>(j) + 0.5f) / static_cast<float>(numRaysPerAxis);
+
+                glm::vec3 const origin
+                {
+                    bounds.min.x + fx*dims.x,
+                    bounds.min.y + fy*dims.y,
+                    bounds.max.z + dims.z,
+                };
+                glm::vec3 const dir{0.1f*(fx - 0.5f), 0.1f*(fy - 0.5f), -1.0f};
+                rv.push_back(osc::Line{origin, dir});
+            }
+        }
+        return rv;
+    }
+}
+
+static void BM_BVHBuildRajagopalBoneMeshes(benchmark::State& state)
+{
+    std::vector<osc::Mesh> const meshes = LoadRajagopalBoneMeshes();
+    osc::BVHBuildOptions const opts = GetBuildOptions(state);
+
+    osc::BVH bvh;
+    for (auto _ : state)
+    {
+        for (osc::Mesh const& mesh : meshes)
+        {
+            BuildBVH(bvh, mesh, opts);
+            benchmark::DoNotOptimize(bvh.nodes.data());
+        }
+    }
+}
+BENCHMARK(BM_BVHBuildRajagopalBoneMeshes)
+    ->Arg(static_cast<int>(osc::BVHBuildStrategy::Midpoint))
+    ->Arg(static_cast<int>(osc::BVHBuildStrategy::BinnedSAH));
+
+static void BM_BVHClosestRayTriangleCollisionRajagopalBoneMeshes(benchmark::State& state)
+{
+    std::vector<osc::Mesh> const meshes = LoadRajagopalBoneMeshes();
+    osc::BVHBuildOptions const opts = GetBuildOptions(state);
+
+    std::vector<osc::BVH> bvhs(meshes.size());
+    std::vector<std::vector<osc::Line>> rays;
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        BuildBVH(bvhs[i], meshes[i], opts);
+        rays.push_back(GenerateHoverRays(meshes[i].getBounds(), 32));
+    }
+
+    size_t numRays = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            osc::MeshIndicesView const indices = meshes[i].getIndices();
+            for (osc::Line const& ray : rays[i])
+            {
+                std::optional<osc::BVHCollision> const hit = indices.isU16() ?
+                    bvhs[i].getClosestRayIndexedTriangleCollision(meshes[i].getVerts(), indices.toU16Span(), ray) :
+                    bvhs[i].getClosestRayIndexedTriangleCollision(meshes[i].getVerts(), indices.toU32Span(), ray);
+                benchmark::DoNotOptimize(hit);
+            }
+            numRays += rays[i].size();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(numRays));
+}
+BENCHMARK(BM_BVHClosestRayTriangleCollisionRajagopalBoneMeshes)
+    ->Arg(static_cast<int>(osc::BVHBuildStrategy::Midpoint))
+    ->Arg(static_cast<int>(osc::BVHBuildStrategy::BinnedSAH));
+
+static void BM_BVHForEachRayAABBCollisionRajagopalBoneMeshTriangles(benchmark::State& state)
+{
+    // use each triangle's AABB as a "scene element", so that the scene BVH is
+    // much larger (and denser) than a typical model's decoration list
+    std::vector<osc::Mesh> const meshes = LoadRajagopalBoneMeshes();
+    osc::Mesh const& mesh = meshes.back();
+
+    std::vector<osc::AABB> aabbs;
+    {
+        nonstd::span<glm::vec3 const> const verts = mesh.getVerts();
+        osc::MeshIndicesView const indices = mesh.getIndices();
+        for (ptrdiff_t i = 0; static_cast<size_t>(i+2) < indices.size(); i += 3)
+        {
+            osc::Triangle const triangle
+            {
+                verts[indices[i]],
+                verts[indices[i+1]],
+                verts[indices[i+2]],
+            };
+            aabbs.push_back(osc::AABBFromTriangle(triangle));
+        }
+    }
+
+    osc::BVH bvh;
+    bvh.buildFromAABBs(aabbs, GetBuildOptions(state));
+    std::vector<osc::Line> const rays = GenerateHoverRays(mesh.getBounds(), 32);
+
+    for (auto _ : state)
+    {
+        size_t numCollisions = 0;
+        for (osc::Line const& ray : rays)
+        {
+            bvh.forEachRayAABBCollision(ray, [&numCollisions](osc::BVHCollision const&) { ++numCollisions; });
+        }
+        benchmark::DoNotOptimize(numCollisions);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rays.size()));
+}
+BENCHMARK(BM_BVHForEachRayAABBCollisionRajagopalBoneMeshTriangles)
+    ->Arg(static_cast<int>(osc::BVHBuildStrategy::Midpoint))
+    ->Arg(static_cast<int>(osc::BVHBuildStrategy::BinnedSAH));
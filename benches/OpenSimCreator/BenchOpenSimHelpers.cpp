@@ -1,10 +1,20 @@
 #include "OpenSimCreator/OpenSimHelpers.hpp"
 
+#include "OpenSimCreator/ComponentPathIndex.hpp"
+#include "oscar/Platform/Config.hpp"
+#include "oscar/Utils/UID.hpp"
+
 #include <benchmark/benchmark.h>
 #include <OpenSim/Common/Component.h>
+#include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
+#include <OpenSim/Actuators/RegisterTypes_osimActuators.h>
 
+#include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <vector>
 
 struct NestedComponentChain {
     std::unique_ptr<OpenSim::Component> root;
@@ -83,4 +93,94 @@ static void BM_OscGetAbsolutePath(benchmark::State& state)
         benchmark::DoNotOptimize(osc::GetAbsolutePath(*c.deepestChild));
     }
 }
-BENCHMARK(BM_OscGetAbsolutePath);
\ No newline at end of file
+BENCHMARK(BM_OscGetAbsolutePath);
+
+static std::unique_ptr<OpenSim::Model> LoadRajagopalModel()
+{
+    RegisterTypes_osimActuators();
+    auto config = osc::Config::load();
+    std::filesystem::path modelPath = config->getResourceDir() / "models" / "RajagopalModel" / "Rajagopal2015.osim";
+    auto model = std::make_unique<OpenSim::Model>(modelPath.string());
+    osc::InitializeModel(*model);
+    return model;
+}
+
+static std::vector<OpenSim::ComponentPath> GetAllAbsolutePaths(OpenSim::Model const& model)
+{
+    std::vector<OpenSim::ComponentPath> rv;
+    for (OpenSim::Component const& c : model.getComponentList())
+    {
+        rv.push_back(c.getAbsolutePath());
+    }
+    return rv;
+}
+
+static void BM_OscFindComponentRajagopal(benchmark::State& state)
+{
+    std::unique_ptr<OpenSim::Model> model = LoadRajagopalModel();
+    std::vector<OpenSim::ComponentPath> const paths = GetAllAbsolutePaths(*model);
+    for (auto _ : state)
+    {
+        for (OpenSim::ComponentPath const& p : paths)
+        {
+            benchmark::DoNotOptimize(osc::FindComponent(*model, p));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * paths.size()));
+}
+BENCHMARK(BM_OscFindComponentRajagopal);
+
+static void BM_OscFindComponentWithIndexRajagopal(benchmark::State& state)
+{
+    std::unique_ptr<OpenSim::Model> model = LoadRajagopalModel();
+    std::vector<OpenSim::ComponentPath> const paths = GetAllAbsolutePaths(*model);
+    osc::ComponentPathIndex index;
+    osc::UID const version;
+    for (auto _ : state)
+    {
+        for (OpenSim::ComponentPath const& p : paths)
+        {
+            benchmark::DoNotOptimize(osc::FindComponent(index, *model, version, p));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * paths.size()));
+}
+BENCHMARK(BM_OscFindComponentWithIndexRajagopal);
+
+// e.g. a selection that was deleted from the model: the lookup fails on each frame
+static void BM_OscFindMissingComponentRajagopal(benchmark::State& state)
+{
+    std::unique_ptr<OpenSim::Model> model = LoadRajagopalModel();
+    OpenSim::ComponentPath const path{"/bodyset/deleted_body"};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FindComponent(*model, path));
+    }
+}
+BENCHMARK(BM_OscFindMissingComponentRajagopal);
+
+static void BM_OscFindMissingComponentWithIndexRajagopal(benchmark::State& state)
+{
+    std::unique_ptr<OpenSim::Model> model = LoadRajagopalModel();
+    OpenSim::ComponentPath const path{"/bodyset/deleted_body"};
+    osc::ComponentPathIndex index;
+    osc::UID const version;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FindComponent(index, *model, version, path));
+    }
+}
+BENCHMARK(BM_OscFindMissingComponentWithIndexRajagopal);
+
+// worst case: the model is edited (i.e. the index is rebuilt) before each lookup
+static void BM_OscRebuildComponentPathIndexRajagopal(benchmark::State& state)
+{
+    std::unique_ptr<OpenSim::Model> model = LoadRajagopalModel();
+    OpenSim::ComponentPath const path = model->getComponentList().begin()->getAbsolutePath();
+    osc::ComponentPathIndex index;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FindComponent(index, *model, osc::UID{}, path));
+    }
+}
+BENCHMARK(BM_OscRebuildComponentPathIndexRajagopal);
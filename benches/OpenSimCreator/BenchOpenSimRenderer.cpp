@@ -10,8 +10,11 @@
 #include <OpenSim/Actuators/RegisterTypes_osimActuators.h>
 #include <simbody.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <optional>
 
 static void BM_OpenSimRenderRajagopalDecorations(benchmark::State& state)
 {
@@ -22,18 +25,26 @@ static void BM_OpenSimRenderRajagopalDecorations(benchmark::State& state)
     osc::InitializeModel(model);
     SimTK::State const& modelState = osc::InitializeState(model);
 
-    osc::MeshCache meshCache;
-    osc::CustomDecorationOptions decorationOptions;
-    std::function<void(OpenSim::Component const&, osc::SceneDecoration&&)> outputFunc = [](OpenSim::Component const&, osc::SceneDecoration&&) {};
+    auto const strategy = static_cast<osc::DecorationGenerationStrategy>(state.range(0));
+    state.SetLabel(strategy == osc::DecorationGenerationStrategy::Parallel ? "parallel" : "serial");
 
+    osc::MeshCache meshCache{std::nullopt};
+    osc::CustomDecorationOptions decorationOptions;
+    size_t numDecorations = 0;
+    std::function<void(OpenSim::Component const&, osc::SceneDecoration&&)> outputFunc = [&numDecorations](OpenSim::Component const&, osc::SceneDecoration&&) { ++numDecorations; };
 
     // warmup
-    osc::GenerateModelDecorations(meshCache, model, modelState, decorationOptions, 1.0, outputFunc);
+    osc::GenerateModelDecorations(meshCache, model, modelState, decorationOptions, 1.0, outputFunc, strategy);
+    numDecorations = 0;
 
     for (auto _ : state)
     {
-        osc::GenerateModelDecorations(meshCache, model, modelState, decorationOptions, 1.0, outputFunc);
+        osc::GenerateModelDecorations(meshCache, model, modelState, decorationOptions, 1.0, outputFunc, strategy);
     }
+    state.SetItemsProcessed(static_cast<int64_t>(numDecorations));
 }
 
-BENCHMARK(BM_OpenSimRenderRajagopalDecorations)->Iterations(100000);
+BENCHMARK(BM_OpenSimRenderRajagopalDecorations)
+    ->Arg(static_cast<int>(osc::DecorationGenerationStrategy::Serial))
+    ->Arg(static_cast<int>(osc::DecorationGenerationStrategy::Parallel))
+    ->Iterations(100000);
@@ -0,0 +1,129 @@
+#include <oscar/Graphics/Camera.hpp>
+#include <oscar/Graphics/Color.hpp>
+#include <oscar/Graphics/Graphics.hpp>
+#include <oscar/Graphics/Material.hpp>
+#include <oscar/Graphics/MaterialPropertyBlock.hpp>
+#include <oscar/Graphics/Mesh.hpp>
+#include <oscar/Graphics/MeshGen.hpp>
+#include <oscar/Graphics/RenderTexture.hpp>
+#include <oscar/Graphics/Shader.hpp>
+#include <oscar/Maths/Transform.hpp>
+#include <oscar/Platform/App.hpp>
+
+#include <benchmark/benchmark.h>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr char const c_VertexShader[] =
+    R"(
+        #version 330 core
+
+        uniform mat4 uViewProjMat;
+
+        layout (location = 0) in vec3 aPos;
+        layout (location = 6) in mat4 aModelMat;
+
+        void main()
+        {
+            gl_Position = uViewProjMat * aModelMat * vec4(aPos, 1.0);
+        }
+    )";
+
+    constexpr char const c_FragmentShader[] =
+    R"(
+        #version 330 core
+
+        uniform vec4 uColor;
+
+        out vec4 FragColor;
+
+        void main()
+        {
+            FragColor = uColor;
+        }
+    )";
+
+    // a draw call, similar to what a `SceneDecoration` is converted into
+    struct RenderQueueBenchDrawCall final {
+        size_t meshIndex;
+        size_t materialIndex;
+        osc::Color color;
+        osc::Transform transform;
+    };
+
+    // returns draw calls that roughly resemble a full-body model with markers and contact
+    // geometry (i.e. many small decorations that share a few meshes, materials, and colors)
+    std::vector<RenderQueueBenchDrawCall> GenerateDrawCalls(size_t n, size_t numMeshes, size_t numMaterials)
+    {
+        std::array<osc::Color, 6> const colors =
+        {
+            osc::Color::red(),
+            osc::Color::green(),
+            osc::Color::blue(),
+            osc::Color::white(),
+            osc::Color::yellow(),
+            osc::Color::black(),
+        };
+
+        std::mt19937 rng{1234};
+        std::uniform_real_distribution<float> positionDist{-5.0f, 5.0f};
+
+        std::vector<RenderQueueBenchDrawCall> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            osc::Transform t;
+            t.position = {positionDist(rng), positionDist(rng), positionDist(rng)};
+            t.scale = glm::vec3{0.05f};
+            rv.push_back(RenderQueueBenchDrawCall{rng() % numMeshes, rng() % numMaterials, colors[rng() % colors.size()], t});
+        }
+        return rv;
+    }
+}
+
+static void BM_RenderQueueFlush(benchmark::State& state)
+{
+    static std::unique_ptr<osc::App> const s_App = std::make_unique<osc::App>();
+
+    std::vector<osc::Mesh> const meshes = {osc::GenCube(), osc::GenUntexturedUVSphere(12, 12), osc::GenCube()};
+
+    osc::Shader const shader{c_VertexShader, c_FragmentShader};
+    std::vector<osc::Material> materials;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        materials.emplace_back(shader);
+    }
+    materials.back().setTransparent(true);  // some decorations are transparent (e.g. selected ones)
+
+    std::vector<RenderQueueBenchDrawCall> const drawCalls =
+        GenerateDrawCalls(static_cast<size_t>(state.range(0)), meshes.size(), materials.size());
+
+    osc::Camera camera;
+    camera.setPosition({0.0f, 0.0f, 10.0f});
+    camera.setDirection({0.0f, 0.0f, -1.0f});
+    osc::RenderTexture renderTexture{glm::ivec2{64, 64}};
+
+    for (auto _ : state)
+    {
+        for (RenderQueueBenchDrawCall const& dc : drawCalls)
+        {
+            // like the scene renderer, create a new property block per draw call
+            osc::MaterialPropertyBlock props;
+            props.setColor("uColor", dc.color);
+            osc::Graphics::DrawMesh(meshes[dc.meshIndex], dc.transform, materials[dc.materialIndex], camera, std::move(props));
+        }
+        camera.renderTo(renderTexture);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * drawCalls.size()));
+}
+BENCHMARK(BM_RenderQueueFlush)->Arg(1000)->Arg(10000)->Arg(50000);
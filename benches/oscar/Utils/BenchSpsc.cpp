@@ -0,0 +1,129 @@
+#include <oscar/Utils/Spsc.hpp>
+#include <oscar/Utils/SpscRingBuffer.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    // the number of messages that are sent from the producer to the consumer per iteration
+    constexpr int64_t c_NumMessages = 1 << 16;
+
+    // a baseline: mutex + condition variable + `std::list` queue, which is how
+    // `osc::spsc::channel` was implemented before it was lock-free
+    template<typename T>
+    class MutexQueue final {
+    public:
+        void send(T v)
+        {
+            {
+                std::lock_guard lock{m_Mutex};
+                m_Queue.push_back(std::move(v));
+            }
+            m_CondVar.notify_one();
+        }
+
+        T recv()
+        {
+            std::unique_lock lock{m_Mutex};
+            m_CondVar.wait(lock, [this]() { return !m_Queue.empty(); });
+            T rv = std::move(m_Queue.front());
+            m_Queue.pop_front();
+            return rv;
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::condition_variable m_CondVar;
+        std::list<T> m_Queue;
+    };
+}
+
+static void BM_MutexQueueTransfer(benchmark::State& state)
+{
+    for ([[maybe_unused]] auto _ : state)
+    {
+        MutexQueue<int64_t> q;
+        std::thread producer{[&q]()
+        {
+            for (int64_t i = 0; i < c_NumMessages; ++i)
+            {
+                q.send(i);
+            }
+        }};
+
+        int64_t sum = 0;
+        for (int64_t i = 0; i < c_NumMessages; ++i)
+        {
+            sum += q.recv();
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * c_NumMessages);
+}
+BENCHMARK(BM_MutexQueueTransfer);
+
+static void BM_SpscRingBufferTransfer(benchmark::State& state)
+{
+    for ([[maybe_unused]] auto _ : state)
+    {
+        osc::SpscRingBuffer<int64_t> buf{static_cast<size_t>(state.range(0))};
+        std::thread producer{[&buf]()
+        {
+            for (int64_t i = 0; i < c_NumMessages; ++i)
+            {
+                while (!buf.tryPush(int64_t{i}))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }};
+
+        int64_t sum = 0;
+        for (int64_t numReceived = 0; numReceived < c_NumMessages;)
+        {
+            if (std::optional<int64_t> v = buf.tryPop())
+            {
+                sum += *v;
+                ++numReceived;
+            }
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * c_NumMessages);
+}
+BENCHMARK(BM_SpscRingBufferTransfer)->Arg(64)->Arg(1024);
+
+static void BM_SpscChannelTransfer(benchmark::State& state)
+{
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto [tx, rx] = osc::spsc::channel<int64_t>(static_cast<size_t>(state.range(0)));
+        std::thread producer{[tx = std::move(tx)]() mutable
+        {
+            for (int64_t i = 0; i < c_NumMessages; ++i)
+            {
+                tx.send(i);
+            }
+        }};
+
+        int64_t sum = 0;
+        while (std::optional<int64_t> v = rx.recv())
+        {
+            sum += *v;
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * c_NumMessages);
+}
+BENCHMARK(BM_SpscChannelTransfer)->Arg(64)->Arg(1024);
@@ -12,11 +12,13 @@ layout (location = 0) in vec3 aPos;
 layout (location = 2) in vec3 aNormal;
 layout (location = 6) in mat4 aModelMat;
 layout (location = 10) in mat3 aNormalMat;
+layout (location = 13) in vec4 aDiffuseColor;  // per-instance, so that differently-colored instances can be batched
 
 out vec3 FragWorldPos;
 out vec4 FragLightSpacePos;
 out vec3 NormalWorldDir;
 out float NonAmbientBrightness;
+out vec4 DiffuseColor;
 
 void main()
 {
@@ -38,6 +40,7 @@ void main()
     FragLightSpacePos = uLightSpaceMat * worldPos;
     NormalWorldDir = normalDir;
     NonAmbientBrightness = diffuseAmt + specularAmt;
+    DiffuseColor = aDiffuseColor;
 
     gl_Position = uViewProjMat * worldPos;
 }
\ No newline at end of file
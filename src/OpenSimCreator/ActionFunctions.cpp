@@ -12,6 +12,7 @@
 #include "OpenSimCreator/ForwardDynamicSimulation.hpp"
 #include "OpenSimCreator/ForwardDynamicSimulatorParams.hpp"
 #include "OpenSimCreator/OpenSimHelpers.hpp"
+#include "OpenSimCreator/OutputExtractor.hpp"
 #include "OpenSimCreator/Simulation.hpp"
 #include "OpenSimCreator/SimTKHelpers.hpp"
 #include "OpenSimCreator/StoFileSimulation.hpp"
@@ -366,6 +367,17 @@ bool osc::ActionStartSimulatingModel(std::weak_ptr<MainUIStateAPI> parent, Undoa
     BasicModelStatePair modelState{uim};
     ForwardDynamicSimulatorParams params = osc::FromParamBlock(parent.lock()->getSimulationParams());
 
+    // evaluate the user's watched outputs on the simulator thread, so that the UI can
+    // plot/export them without re-extracting them from each report
+    for (int i = 0, len = parent.lock()->getNumUserOutputExtractors(); i < len; ++i)
+    {
+        OutputExtractor const& output = parent.lock()->getUserOutputExtractor(i);
+        if (output.getOutputType() == OutputType::Float)
+        {
+            params.simulatorThreadOutputs.push_back(SimulatorThreadOutput{output, UID{}});
+        }
+    }
+
     auto simulation = std::make_shared<Simulation>(ForwardDynamicSimulation{std::move(modelState), std::move(params)});
     auto simulationTab = std::make_unique<SimulatorTab>(parent, std::move(simulation));
 
@@ -1287,24 +1299,21 @@ bool osc::ActionSetCoordinateSpeed(UndoableModelStatePair& model, OpenSim::Coord
 {
     OpenSim::ComponentPath const coordPath = osc::GetAbsolutePath(coord);
 
-    UID const oldVersion = model.getModelVersion();
     try
     {
-        OpenSim::Model& mutModel = model.updModel();
+        OpenSim::Model& mutModel = model.updModelForPreview();
 
         OpenSim::Coordinate* const mutCoord = osc::FindComponentMut<OpenSim::Coordinate>(mutModel, coordPath);
         if (!mutCoord)
         {
-            model.setModelVersion(oldVersion);  // can't find the coordinate within the provided model
-            return false;
+            return false;  // can't find the coordinate within the provided model
         }
 
-        // PERF HACK: don't do a full model+state re-realization here: only do it
-        //            when the caller wants to save the coordinate change
+        // PERF HACK: only preview the edit here: the full model+state re-realization is
+        //            done when the caller wants to save the coordinate change
         mutCoord->setDefaultSpeedValue(v);
         mutCoord->setSpeedValue(mutModel.updWorkingState(), v);
-        mutModel.equilibrateMuscles(mutModel.updWorkingState());
-        mutModel.realizeDynamics(mutModel.updWorkingState());
+        model.realizePreview();
 
         return true;
     }
@@ -1377,33 +1386,30 @@ bool osc::ActionSetCoordinateValue(UndoableModelStatePair& model, OpenSim::Coord
 {
     OpenSim::ComponentPath const coordPath = osc::GetAbsolutePath(coord);
 
-    UID const oldVersion = model.getModelVersion();
     try
     {
-        OpenSim::Model& mutModel = model.updModel();
-
-        OpenSim::Coordinate* const mutCoord = osc::FindComponentMut<OpenSim::Coordinate>(mutModel, coordPath);
-        if (!mutCoord)
+        OpenSim::Coordinate const* const coordInModel = osc::FindComponent<OpenSim::Coordinate>(model.getModel(), coordPath);
+        if (!coordInModel)
         {
-            model.setModelVersion(oldVersion);  // can't find the coordinate within the provided model
-            return false;
+            return false;  // can't find the coordinate within the provided model
         }
 
-        double const rangeMin = std::min(mutCoord->getRangeMin(), mutCoord->getRangeMax());
-        double const rangeMax = std::max(mutCoord->getRangeMin(), mutCoord->getRangeMax());
+        double const rangeMin = std::min(coordInModel->getRangeMin(), coordInModel->getRangeMax());
+        double const rangeMax = std::max(coordInModel->getRangeMin(), coordInModel->getRangeMax());
 
         if (!(rangeMin <= v && v <= rangeMax))
         {
-            model.setModelVersion(oldVersion);  // the requested edit is outside the coordinate's allowed range
-            return false;
+            return false;  // the requested edit is outside the coordinate's allowed range
         }
 
-        // PERF HACK: don't do a full model+state re-realization here: only do it
-        //            when the caller wants to save the coordinate change
+        OpenSim::Model& mutModel = model.updModelForPreview();
+        OpenSim::Coordinate* const mutCoord = osc::FindComponentMut<OpenSim::Coordinate>(mutModel, coordPath);
+
+        // PERF HACK: only preview the edit here: the full model+state re-realization is
+        //            done when the caller wants to save the coordinate change
         mutCoord->setDefaultValue(v);
         mutCoord->setValue(mutModel.updWorkingState(), v);
-        mutModel.equilibrateMuscles(mutModel.updWorkingState());
-        mutModel.realizeDynamics(mutModel.updWorkingState());
+        model.realizePreview();
 
         return true;
     }
@@ -1602,29 +1608,26 @@ bool osc::ActionTranslateStation(
     glm::vec3 const& deltaPosition)
 {
     OpenSim::ComponentPath const stationPath = osc::GetAbsolutePath(station);
-    UID const oldVersion = model.getModelVersion();
     try
     {
-        OpenSim::Model& mutModel = model.updModel();
-
-        OpenSim::Station* const mutStation = FindComponentMut<OpenSim::Station>(mutModel, stationPath);
-        if (!mutStation)
+        if (!FindComponent<OpenSim::Station>(model.getModel(), stationPath))
         {
-            model.setModelVersion(oldVersion);  // the provided path isn't a station
-            return false;
+            return false;  // the provided path isn't a station
         }
 
+        OpenSim::Model& mutModel = model.updModelForPreview();
+        OpenSim::Station* const mutStation = FindComponentMut<OpenSim::Station>(mutModel, stationPath);
+
         SimTK::Vec3 const originalPos = mutStation->get_location();
         SimTK::Vec3 const newPos = originalPos + ToSimTKVec3(deltaPosition);
 
         // perform mutation
         mutStation->set_location(newPos);
 
-        // HACK: don't perform a full reinitialization because that would be very expensive
-        // and likely isn't necessary for a station
-        //
-        // osc::InitializeModel(mutModel);
-        osc::InitializeState(mutModel);
+        // HACK: only preview the edit, because a full reinitialization would be very expensive
+        // and isn't necessary for a station (its location is only used from the position stage
+        // onwards): the caller reinitializes the model when it saves the edit
+        model.realizePreview();
 
         return true;
     }
@@ -1665,24 +1668,22 @@ bool osc::ActionTranslatePathPoint(
     glm::vec3 const& deltaPosition)
 {
     OpenSim::ComponentPath const ppPath = osc::GetAbsolutePath(pathPoint);
-    UID const oldVersion = model.getModelVersion();
     try
     {
-        OpenSim::Model& mutModel = model.updModel();
-
-        OpenSim::PathPoint* const mutPathPoint = FindComponentMut<OpenSim::PathPoint>(mutModel, ppPath);
-        if (!mutPathPoint)
+        if (!FindComponent<OpenSim::PathPoint>(model.getModel(), ppPath))
         {
-            model.setModelVersion(oldVersion);  // the provided path isn't a station
-            return false;
+            return false;  // the provided path isn't a path point
         }
 
+        OpenSim::Model& mutModel = model.updModelForPreview();
+        OpenSim::PathPoint* const mutPathPoint = FindComponentMut<OpenSim::PathPoint>(mutModel, ppPath);
+
         SimTK::Vec3 const originalPos = mutPathPoint->get_location();
         SimTK::Vec3 const newPos = originalPos + ToSimTKVec3(deltaPosition);
 
-        // perform mutation
+        // perform mutation (the caller reinitializes the model when it saves the edit)
         mutPathPoint->setLocation(newPos);
-        osc::InitializeState(mutModel);
+        model.realizePreview();
 
         return true;
     }
@@ -1742,8 +1743,12 @@ bool osc::ActionTransformPof(
         // perform mutation
         mutPof->set_translation(newPos);
         mutPof->set_orientation(ToSimTKVec3(newPofEulers));
+
+        // the transform is baked into the system, so the model has to be reinitialized, but
+        // only the preview has to be realized until the edit is committed
         osc::InitializeModel(mutModel);
-        osc::InitializeState(mutModel);
+        mutModel.initializeState();
+        model.realizePreview();
 
         return true;
     }
@@ -1781,8 +1786,12 @@ bool osc::ActionTransformWrapObject(
         // perform mutation
         mutPof->set_translation(newPos);
         mutPof->set_xyz_body_rotation(ToSimTKVec3(newEulers));
+
+        // the transform is baked into the system, so the model has to be reinitialized, but
+        // only the preview has to be realized until the edit is committed
         osc::InitializeModel(mutModel);
-        osc::InitializeState(mutModel);
+        mutModel.initializeState();
+        model.realizePreview();
 
         return true;
     }
@@ -1820,8 +1829,12 @@ bool osc::ActionTransformContactGeometry(
         // perform mutation
         mutGeom->set_location(newPos);
         mutGeom->set_orientation(ToSimTKVec3(newEulers));
+
+        // the transform is baked into the system, so the model has to be reinitialized, but
+        // only the preview has to be realized until the edit is committed
         osc::InitializeModel(mutModel);
-        osc::InitializeState(mutModel);
+        mutModel.initializeState();
+        model.realizePreview();
 
         return true;
     }
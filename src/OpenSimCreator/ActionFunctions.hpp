@@ -97,7 +97,8 @@ namespace osc
     // force a reload of the model, and its associated assets, from its backing file
     bool ActionReloadOsimFromDisk(UndoableModelStatePair&, MeshCache&);
 
-    // start performing a series of simulations against the model by opening a tab that tries all possible integrators
+    // start performing a series of simulations against the model by opening a tab that runs a batch (see
+    // `BatchSimulator`) that tries all possible integrators
     bool ActionSimulateAgainstAllIntegrators(std::weak_ptr<osc::MainUIStateAPI>, UndoableModelStatePair const&);
 
     // add an offset frame to the current selection (if applicable)
@@ -162,6 +163,8 @@ namespace osc
     bool ActionAddComponentToModel(UndoableModelStatePair&, std::unique_ptr<OpenSim::Component>, std::string& errorOut);
 
     // set the speed of a coordinate
+    //
+    // (only previews the change: see `UndoableModelStatePair::updModelForPreview`)
     bool ActionSetCoordinateSpeed(UndoableModelStatePair&, OpenSim::Coordinate const&, double);
 
     // set the speed of a coordinate and ensure it is saved
@@ -171,6 +174,8 @@ namespace osc
     bool ActionSetCoordinateLockedAndSave(UndoableModelStatePair&, OpenSim::Coordinate const&, bool);
 
     // set the value of a coordinate
+    //
+    // (only previews the change: see `UndoableModelStatePair::updModelForPreview`)
     bool ActionSetCoordinateValue(UndoableModelStatePair&, OpenSim::Coordinate const&, double);
 
     // set the value of a coordinate and ensure it is saved
@@ -194,7 +199,7 @@ namespace osc
 
     // sets the location of the given station in its parent frame to its old location plus the provided delta
     //
-    // (does not save the change to undo/redo storage)
+    // (only previews the change, and does not save it to undo/redo storage)
     bool ActionTranslateStation(
         UndoableModelStatePair&,
         OpenSim::Station const&,
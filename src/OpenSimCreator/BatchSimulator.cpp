@@ -0,0 +1,474 @@
+#include "BatchSimulator.hpp"
+
+#include "OpenSimCreator/BasicModelStatePair.hpp"
+#include "OpenSimCreator/ForwardDynamicSimulator.hpp"
+#include "OpenSimCreator/ForwardDynamicSimulatorParams.hpp"
+#include "OpenSimCreator/IntegratorMethod.hpp"
+#include "OpenSimCreator/OutputExtractor.hpp"
+#include "OpenSimCreator/SimulationClock.hpp"
+#include "OpenSimCreator/SimulationReport.hpp"
+#include "OpenSimCreator/SimulationStatus.hpp"
+
+#include <oscar/Platform/Log.hpp>
+#include <oscar/Utils/Assertions.hpp>
+#include <oscar/Utils/Cpp20Shims.hpp>
+#include <oscar/Utils/SynchronizedValue.hpp>
+#include <oscar/Utils/WorkStealingThreadPool.hpp>
+
+#include <nonstd/span.hpp>
+#include <OpenSim/Common/Array.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <simbody/internal/MobilizedBody.h>
+#include <simbody/internal/SimbodyMatterSubsystem.h>
+#include <SimTKcommon.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // returns a version of the name that's safe to use in a filename
+    std::string ToSafeFilenameComponent(std::string const& name)
+    {
+        std::string rv = name;
+        std::replace_if(rv.begin(), rv.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)); }, '_');
+        return rv;
+    }
+
+    // streams simulation reports into a CSV file as they're emitted by a simulation
+    class CSVReportWriter final {
+    public:
+        CSVReportWriter(std::filesystem::path const& path, OpenSim::Model const& model) :
+            m_Model{&model},
+            m_Output{path}
+        {
+            m_Output.precision(std::numeric_limits<double>::digits10);
+
+            // header line
+            m_Output << "time";
+            for (int i = 0, len = osc::GetNumFdSimulatorOutputExtractors(); i < len; ++i)
+            {
+                m_Output << ',' << osc::GetFdSimulatorOutputExtractor(i).getName();
+            }
+            OpenSim::Array<std::string> const stateVarNames = model.getStateVariableNames();
+            for (int i = 0; i < stateVarNames.size(); ++i)
+            {
+                m_Output << ',' << stateVarNames[i];
+            }
+            m_Output << '\n';
+        }
+
+        bool good() const
+        {
+            return static_cast<bool>(m_Output);
+        }
+
+        void write(osc::SimulationReport const& report)
+        {
+            SimTK::State const& st = report.getState();
+
+            m_Output << st.getTime();
+            for (int i = 0, len = osc::GetNumFdSimulatorOutputExtractors(); i < len; ++i)
+            {
+                m_Output << ',' << osc::GetFdSimulatorOutputExtractor(i).getValueFloat(*m_Model, report);
+            }
+            SimTK::Vector const stateVarValues = m_Model->getStateVariableValues(st);
+            for (int i = 0; i < stateVarValues.size(); ++i)
+            {
+                m_Output << ',' << stateVarValues[i];
+            }
+            m_Output << '\n';
+        }
+
+    private:
+        OpenSim::Model const* m_Model;
+        std::ofstream m_Output;
+    };
+
+    // exclusively owned by the batch, but concurrently read by its worker threads
+    class JobState final {
+    public:
+        JobState(osc::BatchSimulationJob job, std::optional<std::filesystem::path> outputFile) :
+            m_Job{std::move(job)},
+            m_OutputFile{std::move(outputFile)}
+        {
+        }
+
+        osc::BatchSimulationJob const& getJob() const { return m_Job; }
+        std::optional<std::filesystem::path> const& getOutputFile() const { return m_OutputFile; }
+        osc::BatchSimulationJobProgress getProgress() const { return *m_Progress.lock(); }
+        osc::SynchronizedValueGuard<osc::BatchSimulationJobProgress> updProgress() { return m_Progress.lock(); }
+
+    private:
+        osc::BatchSimulationJob m_Job;
+        std::optional<std::filesystem::path> m_OutputFile;
+        osc::SynchronizedValue<osc::BatchSimulationJobProgress> m_Progress;
+    };
+
+    float CalcProgress(osc::BatchSimulationJob const& job, osc::SimulationReport const& report)
+    {
+        osc::SimulationClock::time_point const tStart = osc::SimulationClock::start() + osc::SimulationClock::duration{job.modelState.getState().getTime()};
+        osc::SimulationClock::duration const total = job.params.finalTime - tStart;
+        if (total <= osc::SimulationClock::duration{0.0})
+        {
+            return 1.0f;
+        }
+        return std::clamp(static_cast<float>((report.getTime() - tStart) / total), 0.0f, 1.0f);
+    }
+}
+
+class osc::BatchSimulator::Impl final {
+public:
+    Impl(std::vector<BatchSimulationJob> jobs, BatchSimulatorParams const& params) :
+        m_OutputDirectory{params.outputDirectory},
+        m_Pool{params.numThreads}
+    {
+        if (m_OutputDirectory)
+        {
+            std::filesystem::create_directories(*m_OutputDirectory);
+        }
+
+        m_Jobs.reserve(jobs.size());
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            std::optional<std::filesystem::path> outputFile;
+            if (m_OutputDirectory)
+            {
+                outputFile = *m_OutputDirectory / (std::to_string(i) + '_' + ToSafeFilenameComponent(jobs[i].name) + ".csv");
+            }
+            m_Jobs.push_back(std::make_unique<JobState>(std::move(jobs[i]), std::move(outputFile)));
+        }
+
+        // start the jobs once all of them are initialized, because the last job to
+        // finish reads all of them (summary)
+        for (size_t i = 0; i < m_Jobs.size(); ++i)
+        {
+            m_Pool.submit([this, i]() { runJob(*m_Jobs[i]); });
+        }
+    }
+    Impl(Impl const&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(Impl const&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept
+    {
+        // cancel any running/queued jobs, the pool then waits for them to exit
+        requestStop();
+    }
+
+    size_t getNumJobs() const
+    {
+        return m_Jobs.size();
+    }
+
+    std::string const& getJobName(size_t i) const
+    {
+        return m_Jobs.at(i)->getJob().name;
+    }
+
+    ForwardDynamicSimulatorParams const& getJobParams(size_t i) const
+    {
+        return m_Jobs.at(i)->getJob().params;
+    }
+
+    BatchSimulationJobProgress getJobProgress(size_t i) const
+    {
+        return m_Jobs.at(i)->getProgress();
+    }
+
+    size_t getNumFinishedJobs() const
+    {
+        return m_NumFinishedJobs.load();
+    }
+
+    bool isFinished() const
+    {
+        return getNumFinishedJobs() == getNumJobs();
+    }
+
+    void requestStop()
+    {
+        m_StopSource.request_stop();
+    }
+
+    void wait()
+    {
+        m_Pool.waitUntilIdle();
+    }
+
+private:
+    // MAIN function for a worker that's running a job (exceptions are handled by
+    // the simulator)
+    void runJob(JobState& state)
+    {
+        BatchSimulationJob const& job = state.getJob();
+        stop_token stopToken = m_StopSource.get_token();
+
+        if (stopToken.stop_requested())
+        {
+            state.updProgress()->status = SimulationStatus::Cancelled;
+            onJobFinished();
+            return;  // cancelled while queued
+        }
+        state.updProgress()->status = SimulationStatus::Running;
+
+        // the simulator runs against its own copy of the model, so the job's copy can be
+        // used to write outputs on this thread
+        std::optional<CSVReportWriter> writer;
+        if (state.getOutputFile())
+        {
+            writer.emplace(*state.getOutputFile(), job.modelState.getModel());
+            if (!writer->good())
+            {
+                log::error("%s: error opening file for writing: simulation outputs for this job will not be written", state.getOutputFile()->string().c_str());
+                writer.reset();
+            }
+        }
+
+        auto const onReport = [&state, &job, &writer](SimulationReport report)
+        {
+            if (writer)
+            {
+                writer->write(report);
+            }
+
+            auto progress = state.updProgress();
+            progress->progress = CalcProgress(job, report);
+            progress->numReports++;
+            progress->latestReport = std::move(report);
+        };
+
+        SimulationStatus const status = RunForwardDynamicSimulation(
+            job.modelState,
+            job.params,
+            onReport,
+            std::move(stopToken)
+        );
+
+        if (writer && !writer->good())
+        {
+            log::error("%s: error encountered while writing simulation outputs", state.getOutputFile()->string().c_str());
+        }
+        writer.reset();  // flush + close before the job is marked as finished
+
+        {
+            auto progress = state.updProgress();
+            progress->status = status;
+            if (status == SimulationStatus::Completed)
+            {
+                progress->progress = 1.0f;
+            }
+        }
+        onJobFinished();
+    }
+
+    void onJobFinished()
+    {
+        if (++m_NumFinishedJobs == m_Jobs.size() && m_OutputDirectory)
+        {
+            writeSummary();
+        }
+    }
+
+    // writes one row per job, which contains the job's status and the final value of
+    // each simulator output (e.g. wall time, number of steps taken)
+    void writeSummary() const
+    {
+        std::filesystem::path const summaryPath = *m_OutputDirectory / "summary.csv";
+        std::ofstream fout{summaryPath};
+        if (!fout)
+        {
+            log::error("%s: error opening file for writing", summaryPath.string().c_str());
+            return;
+        }
+
+        fout << "name,integrator,accuracy,status,num reports,output file";
+        for (int i = 0, len = GetNumFdSimulatorOutputExtractors(); i < len; ++i)
+        {
+            fout << ',' << GetFdSimulatorOutputExtractor(i).getName();
+        }
+        fout << '\n';
+
+        for (std::unique_ptr<JobState> const& state : m_Jobs)
+        {
+            BatchSimulationJob const& job = state->getJob();
+            BatchSimulationJobProgress const progress = state->getProgress();
+
+            fout << job.name << ','
+                 << GetIntegratorMethodString(job.params.integratorMethodUsed) << ','
+                 << job.params.integratorAccuracy << ','
+                 << GetAllSimulationStatusStrings()[static_cast<size_t>(progress.status)] << ','
+                 << progress.numReports << ','
+                 << (state->getOutputFile() ? state->getOutputFile()->filename().string() : std::string{});
+            for (int i = 0, len = GetNumFdSimulatorOutputExtractors(); i < len; ++i)
+            {
+                fout << ',';
+                if (progress.latestReport)
+                {
+                    fout << GetFdSimulatorOutputExtractor(i).getValueFloat(job.modelState.getModel(), *progress.latestReport);
+                }
+            }
+            fout << '\n';
+        }
+
+        if (!fout)
+        {
+            log::error("%s: error encountered while writing batch summary", summaryPath.string().c_str());
+            return;
+        }
+        log::info("%s: wrote batch simulation summary", summaryPath.string().c_str());
+    }
+
+    std::optional<std::filesystem::path> m_OutputDirectory;
+    std::vector<std::unique_ptr<JobState>> m_Jobs;
+    std::atomic<size_t> m_NumFinishedJobs = 0;
+    stop_source m_StopSource;
+
+    // last, so that it's destroyed (i.e. waits for the workers to finish) first
+    WorkStealingThreadPool m_Pool;
+};
+
+
+// public API (PIMPL)
+
+std::vector<osc::BatchSimulationJob> osc::GenerateIntegratorSweepJobs(
+    BasicModelStatePair const& modelState,
+    ForwardDynamicSimulatorParams const& params)
+{
+    std::vector<BatchSimulationJob> rv;
+    for (IntegratorMethod m : GetAllIntegratorMethods())
+    {
+        ForwardDynamicSimulatorParams p = params;
+        p.integratorMethodUsed = m;
+        rv.push_back(BatchSimulationJob{std::string{GetIntegratorMethodString(m)}, modelState, p});
+    }
+    return rv;
+}
+
+std::vector<osc::BatchSimulationJob> osc::GenerateAccuracySweepJobs(
+    BasicModelStatePair const& modelState,
+    ForwardDynamicSimulatorParams const& params,
+    nonstd::span<double const> accuracies)
+{
+    std::vector<BatchSimulationJob> rv;
+    rv.reserve(accuracies.size());
+    for (double accuracy : accuracies)
+    {
+        ForwardDynamicSimulatorParams p = params;
+        p.integratorAccuracy = accuracy;
+
+        std::stringstream name;
+        name << "accuracy " << accuracy;
+        rv.push_back(BatchSimulationJob{std::move(name).str(), modelState, p});
+    }
+    return rv;
+}
+
+std::vector<osc::BatchSimulationJob> osc::GeneratePerturbedInitialStateJobs(
+    BasicModelStatePair const& modelState,
+    ForwardDynamicSimulatorParams const& params,
+    size_t numJobs,
+    double standardDeviation,
+    unsigned int seed)
+{
+    std::mt19937 rng{seed};
+    std::normal_distribution<double> noise{0.0, standardDeviation};
+
+    OpenSim::Model const& model = modelState.getModel();
+    SimTK::SimbodyMatterSubsystem const& matter = model.getMatterSubsystem();
+
+    std::vector<BatchSimulationJob> rv;
+    rv.reserve(numJobs);
+    for (size_t i = 0; i < numJobs; ++i)
+    {
+        SimTK::State st = modelState.getState();
+        for (OpenSim::Coordinate const& c : model.getComponentList<OpenSim::Coordinate>())
+        {
+            // locked coordinates must keep their value, and coordinates of quaternion-based
+            // mobilizers (e.g. ball joints) don't map onto a single Q that noise can be added to
+            if (c.getLocked(st))
+            {
+                continue;
+            }
+            SimTK::MobilizedBody const& mobod = matter.getMobilizedBody(c.getBodyIndex());
+            if (mobod.getNumQ(st) != mobod.getNumU(st))
+            {
+                continue;
+            }
+
+            c.setValue(st, c.getValue(st) + noise(rng), false);
+        }
+
+        // project the perturbed coordinates back onto the model's constraints (e.g. coupled
+        // coordinates, closed loops), so that the simulation doesn't start from a violated state
+        model.getSystem().realize(st, SimTK::Stage::Time);
+        model.getSystem().projectQ(st, params.integratorAccuracy);
+
+        rv.push_back(BatchSimulationJob{"perturbation " + std::to_string(i), BasicModelStatePair{modelState.getModel(), st}, params});
+    }
+    return rv;
+}
+
+osc::BatchSimulator::BatchSimulator(
+    std::vector<BatchSimulationJob> jobs,
+    BatchSimulatorParams const& params) :
+
+    m_Impl{std::make_unique<Impl>(std::move(jobs), params)}
+{
+}
+osc::BatchSimulator::BatchSimulator(BatchSimulator&&) noexcept = default;
+osc::BatchSimulator& osc::BatchSimulator::operator=(BatchSimulator&&) noexcept = default;
+osc::BatchSimulator::~BatchSimulator() noexcept = default;
+
+size_t osc::BatchSimulator::getNumJobs() const
+{
+    return m_Impl->getNumJobs();
+}
+
+std::string const& osc::BatchSimulator::getJobName(size_t i) const
+{
+    return m_Impl->getJobName(i);
+}
+
+osc::ForwardDynamicSimulatorParams const& osc::BatchSimulator::getJobParams(size_t i) const
+{
+    return m_Impl->getJobParams(i);
+}
+
+osc::BatchSimulationJobProgress osc::BatchSimulator::getJobProgress(size_t i) const
+{
+    return m_Impl->getJobProgress(i);
+}
+
+size_t osc::BatchSimulator::getNumFinishedJobs() const
+{
+    return m_Impl->getNumFinishedJobs();
+}
+
+bool osc::BatchSimulator::isFinished() const
+{
+    return m_Impl->isFinished();
+}
+
+void osc::BatchSimulator::requestStop()
+{
+    m_Impl->requestStop();
+}
+
+void osc::BatchSimulator::wait()
+{
+    m_Impl->wait();
+}
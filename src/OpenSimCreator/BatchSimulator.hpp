@@ -0,0 +1,104 @@
+#pragma once
+
+#include "OpenSimCreator/BasicModelStatePair.hpp"
+#include "OpenSimCreator/ForwardDynamicSimulatorParams.hpp"
+#include "OpenSimCreator/SimulationReport.hpp"
+#include "OpenSimCreator/SimulationStatus.hpp"
+
+#include <oscar/Utils/WorkStealingThreadPool.hpp>
+
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace osc
+{
+    // one simulation in a batch
+    struct BatchSimulationJob final {
+        std::string name;  // human-readable, also used to name the job's output file
+        BasicModelStatePair modelState;
+        ForwardDynamicSimulatorParams params;
+    };
+
+    // returns one job per available integrator method, all other params are as-provided
+    std::vector<BatchSimulationJob> GenerateIntegratorSweepJobs(
+        BasicModelStatePair const&,
+        ForwardDynamicSimulatorParams const&
+    );
+
+    // returns one job per provided integrator accuracy, all other params are as-provided
+    std::vector<BatchSimulationJob> GenerateAccuracySweepJobs(
+        BasicModelStatePair const&,
+        ForwardDynamicSimulatorParams const&,
+        nonstd::span<double const> accuracies
+    );
+
+    // returns `numJobs` jobs that start from the provided state, but with each unlocked coordinate
+    // perturbed by normally-distributed noise with the given standard deviation and then projected
+    // back onto the model's constraints
+    //
+    // coordinates of quaternion-based mobilizers (e.g. ball/free joint rotations) aren't perturbed
+    //
+    // the noise is generated from `seed`, so the same arguments produce the same jobs
+    std::vector<BatchSimulationJob> GeneratePerturbedInitialStateJobs(
+        BasicModelStatePair const&,
+        ForwardDynamicSimulatorParams const&,
+        size_t numJobs,
+        double standardDeviation,
+        unsigned int seed
+    );
+
+    struct BatchSimulatorParams final {
+
+        // number of worker threads that run the simulations
+        size_t numThreads = GetDefaultNumWorkerThreads();
+
+        // if provided, each job streams its reports to a CSV file in this directory and
+        // a `summary.csv` is written once all jobs have finished
+        std::optional<std::filesystem::path> outputDirectory;
+    };
+
+    // a snapshot of the progress of one job in a batch
+    struct BatchSimulationJobProgress final {
+        SimulationStatus status = SimulationStatus::Initializing;  // `Initializing` also means "queued"
+        float progress = 0.0f;  // [0.0, 1.0]
+        size_t numReports = 0;
+        std::optional<SimulationReport> latestReport;
+    };
+
+    // runs a batch of forward-dynamic simulations on a fixed-size work-stealing thread pool
+    //
+    // the simulations immediately start running upon construction. Progress can be polled
+    // from any thread, and destroying the batch cancels any unfinished simulations
+    class BatchSimulator final {
+    public:
+        explicit BatchSimulator(
+            std::vector<BatchSimulationJob>,
+            BatchSimulatorParams const& = {}
+        );
+        BatchSimulator(BatchSimulator const&) = delete;
+        BatchSimulator(BatchSimulator&&) noexcept;
+        BatchSimulator& operator=(BatchSimulator const&) = delete;
+        BatchSimulator& operator=(BatchSimulator&&) noexcept;
+        ~BatchSimulator() noexcept;
+
+        size_t getNumJobs() const;
+        std::string const& getJobName(size_t) const;
+        ForwardDynamicSimulatorParams const& getJobParams(size_t) const;
+        BatchSimulationJobProgress getJobProgress(size_t) const;
+        size_t getNumFinishedJobs() const;
+        bool isFinished() const;
+
+        void requestStop();  // asynchronous
+        void wait();  // synchronous (blocks until all jobs have finished)
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
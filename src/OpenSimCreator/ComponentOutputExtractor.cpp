@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <memory>
 #include <typeinfo>
 #include <sstream>
@@ -68,17 +69,20 @@ namespace output_magic
     }
 
     // type-erased version of one of the above
+    //
+    // care: callers must have already checked that `o` is an `OutputType` (e.g. via
+    // `typeid`), so that this doesn't need to `dynamic_cast` on each call
     template<typename OutputType>
     double extractTypeErased(OpenSim::AbstractOutput const& o, SimTK::State const& s)
     {
-        return extract<>(dynamic_cast<OutputType const&>(o), s);
+        return extract<>(static_cast<OutputType const&>(o), s);
     }
 
     // type-erase a concrete *subfield* extractor function
     template<osc::OutputSubfield sf, typename OutputType>
     double extractTypeErased(OpenSim::AbstractOutput const& o, SimTK::State const& s)
     {
-        return extract<sf>(dynamic_cast<OutputType const&>(o), s);
+        return extract<sf>(static_cast<OutputType const&>(o), s);
     }
 }
 
@@ -231,7 +235,7 @@ public:
         OpenSim::AbstractOutput const* const ao = FindOutput(c, m_ComponentAbsPath, m_OutputName);
         if (ao)
         {
-            if (m_ExtractorFunc)
+            if (m_ExtractorFunc && typeid(*ao) == *m_OutputType)
             {
                 return std::to_string(m_ExtractorFunc(*ao, r.getState()));
             }
@@ -246,6 +250,25 @@ public:
         }
     }
 
+    std::function<float(SimulationReport const&)> bindValueFloat(OpenSim::Component const& c) const
+    {
+        // resolve the output once, rather than once per call
+        OpenSim::AbstractOutput const* const ao = FindOutput(c, m_ComponentAbsPath, m_OutputName);
+
+        if (!ao || typeid(*ao) != *m_OutputType || !m_ExtractorFunc)
+        {
+            // cannot find output
+            // or the type of the output changed
+            // or don't know how to extract a value from the output
+            return [](SimulationReport const&) { return static_cast<float>(NAN); };
+        }
+
+        return [ao, f = m_ExtractorFunc](SimulationReport const& r)
+        {
+            return static_cast<float>(f(*ao, r.getState()));
+        };
+    }
+
     std::size_t getHash() const
     {
         return osc::HashOf(m_ComponentAbsPath.toString(), m_OutputName, m_Label, m_OutputType, m_ExtractorFunc);
@@ -374,6 +397,11 @@ std::string osc::ComponentOutputExtractor::getValueString(OpenSim::Component con
     return m_Impl->getValueString(c, r);
 }
 
+std::function<float(osc::SimulationReport const&)> osc::ComponentOutputExtractor::bindValueFloat(OpenSim::Component const& c) const
+{
+    return m_Impl->bindValueFloat(c);
+}
+
 std::size_t osc::ComponentOutputExtractor::getHash() const
 {
     return m_Impl->getHash();
@@ -8,6 +8,7 @@
 #include <nonstd/span.hpp>
 
 #include <cstddef>
+#include <functional>
 #include <string>
 
 namespace OpenSim { class AbstractOutput; }
@@ -69,6 +70,10 @@ namespace osc
             SimulationReport const&
         ) const final;
 
+        std::function<float(SimulationReport const&)> bindValueFloat(
+            OpenSim::Component const&
+        ) const final;
+
         std::size_t getHash() const final;
         bool equals(VirtualOutputExtractor const&) const final;
 
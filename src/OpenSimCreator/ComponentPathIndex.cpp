@@ -0,0 +1,51 @@
+#include "ComponentPathIndex.hpp"
+
+#include "OpenSimCreator/OpenSimHelpers.hpp"
+
+#include <oscar/Utils/Assertions.hpp>
+#include <oscar/Utils/Perf.hpp>
+#include <oscar/Utils/UID.hpp>
+
+#include <OpenSim/Common/Component.h>
+
+#include <string>
+
+OpenSim::Component const* osc::ComponentPathIndex::find(
+    OpenSim::Component const& root,
+    UID rootVersion,
+    std::string const& absPath)
+{
+    if (&root != m_Root || rootVersion != m_RootVersion)
+    {
+        rebuild(root, rootVersion);
+    }
+
+    auto const it = m_Lookup.find(absPath);
+    return it != m_Lookup.end() ? it->second : nullptr;
+}
+
+void osc::ComponentPathIndex::clear()
+{
+    m_Root = nullptr;
+    m_RootVersion = UID::empty();
+    m_Lookup.clear();
+}
+
+void osc::ComponentPathIndex::rebuild(OpenSim::Component const& root, UID rootVersion)
+{
+    OSC_PERF("ComponentPathIndex/rebuild");
+    OSC_ASSERT(!root.hasOwner() && "the index only contains absolute paths, so it must index a root component");
+
+    m_Lookup.clear();
+    m_Lookup.emplace(GetAbsolutePathString(root), &root);
+
+    std::string path;
+    for (OpenSim::Component const& c : root.getComponentList())
+    {
+        GetAbsolutePathString(c, path);
+        m_Lookup.emplace(path, &c);
+    }
+
+    m_Root = &root;
+    m_RootVersion = rootVersion;
+}
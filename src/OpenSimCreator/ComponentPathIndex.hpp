@@ -0,0 +1,41 @@
+#pragma once
+
+#include <oscar/Utils/UID.hpp>
+
+#include <string>
+#include <unordered_map>
+
+namespace OpenSim { class Component; }
+
+namespace osc
+{
+    // a lazily-built lookup from absolute path strings (e.g. "/bodyset/pelvis") to the components
+    // in a root component (e.g. a model)
+    //
+    // the lookup is (re)built by the first `find` call after the root, or the root's version, has
+    // changed. It's up to the caller to provide a version that changes whenever the root's components
+    // are (or may be) added, removed, renamed, or reallocated, and to not call `find` while the root
+    // is being edited
+    class ComponentPathIndex final {
+    public:
+        // returns the component in `root` that has the given absolute path, or nullptr if `root` contains
+        // no such component
+        //
+        // `root` must be a root component (i.e. it has no owner)
+        OpenSim::Component const* find(
+            OpenSim::Component const& root,
+            UID rootVersion,
+            std::string const& absPath
+        );
+
+        // drops the lookup, so that the next `find` call rebuilds it
+        void clear();
+
+    private:
+        void rebuild(OpenSim::Component const& root, UID rootVersion);
+
+        OpenSim::Component const* m_Root = nullptr;
+        UID m_RootVersion = UID::empty();
+        std::unordered_map<std::string, OpenSim::Component const*> m_Lookup;
+    };
+}
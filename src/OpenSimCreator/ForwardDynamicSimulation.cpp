@@ -7,41 +7,91 @@
 #include "OpenSimCreator/ParamBlock.hpp"
 #include "OpenSimCreator/SimulationClock.hpp"
 #include "OpenSimCreator/SimulationReport.hpp"
+#include "OpenSimCreator/SimulationReportStore.hpp"
 #include "OpenSimCreator/SimulationStatus.hpp"
 
+#include <oscar/Utils/Spsc.hpp>
 #include <oscar/Utils/SynchronizedValue.hpp>
+#include <oscar/Utils/UID.hpp>
 
 #include <nonstd/span.hpp>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <SimTKcommon.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 // helpers
 namespace
 {
-    // creates a simulator that's hooked up to the reports vector
+    // maximum number of reports that can be in-flight between the simulator thread and
+    // the UI thread before the simulator thread is blocked (backpressure)
+    constexpr size_t c_ReportChannelCapacity = 1024;
+
+    // creates a simulator that's hooked up to the sending end of a report channel
+    //
+    // if the channel is full, the simulator thread waits for the UI thread to pop some
+    // reports, unless a stop was requested (in which case the report is dropped)
     osc::ForwardDynamicSimulator MakeSimulation(
         osc::BasicModelStatePair p,
         osc::ForwardDynamicSimulatorParams const& params,
-        osc::SynchronizedValue<std::vector<osc::SimulationReport>>& reportQueue)
+        osc::spsc::Sender<osc::SimulationReport> reportSender,
+        std::shared_ptr<std::atomic<bool>> stopRequested)
     {
-        auto callback = [&](osc::SimulationReport r)
+        auto sender = std::make_shared<osc::spsc::Sender<osc::SimulationReport>>(std::move(reportSender));
+        auto callback = [sender, stopRequested](osc::SimulationReport r)
         {
-            auto reportsGuard = reportQueue.lock();
-            reportsGuard->push_back(std::move(r));
+            sender->send(std::move(r), [&stopRequested]() { return stopRequested->load(); });
         };
         return osc::ForwardDynamicSimulator{std::move(p), params, std::move(callback)};
     }
 
+    // upper limit on how many reports are preallocated in the report store up-front (the
+    // store can still grow beyond this: it just has to reallocate)
+    constexpr size_t c_MaxPreallocatedReports = 1<<16;
+
+    // returns the number of reports the simulation is expected to emit, so that the report
+    // store can be preallocated
+    size_t EstimateNumReports(
+        osc::BasicModelStatePair const& p,
+        osc::ForwardDynamicSimulatorParams const& params)
+    {
+        osc::SimulationClock::time_point const startTime = osc::SimulationClock::start() + osc::SimulationClock::duration{p.getState().getTime()};
+        double const numIntervals = (params.finalTime - startTime) / params.reportingInterval;
+        if (!(numIntervals > 0.0))
+        {
+            return 1;
+        }
+        double const numReports = std::ceil(numIntervals / std::max(params.reportingStride, 1)) + 2.0;  // +start, +end
+        return static_cast<size_t>(std::min(numReports, static_cast<double>(c_MaxPreallocatedReports)));
+    }
+
+    // returns a lookup for finding which auxiliary value a user output was written to
+    std::unordered_map<osc::OutputExtractor, osc::UID> CreateSimulatorThreadOutputLookup(
+        osc::ForwardDynamicSimulatorParams const& params)
+    {
+        std::unordered_map<osc::OutputExtractor, osc::UID> rv;
+        for (osc::SimulatorThreadOutput const& o : params.simulatorThreadOutputs)
+        {
+            if (o.output.getOutputType() == osc::OutputType::Float)
+            {
+                rv.try_emplace(o.output, o.auxiliaryValueID);
+            }
+        }
+        return rv;
+    }
+
     std::vector<osc::OutputExtractor> GetFdSimulatorOutputExtractorsAsVector()
     {
         std::vector<osc::OutputExtractor> rv;
@@ -53,17 +103,44 @@ namespace
         }
         return rv;
     }
+
+    // creates an (empty) report store that realizes any states it restores against
+    // its own copy of the model
+    //
+    // (a separate copy is used because restoration can happen while a caller is
+    //  holding the simulation's model lock, e.g. while extracting outputs)
+    std::shared_ptr<osc::SimulationReportStore> MakeReportStore(osc::BasicModelStatePair const& p)
+    {
+        auto realizerModel = std::make_shared<osc::BasicModelStatePair>(p);
+        return std::make_shared<osc::SimulationReportStore>([realizerModel](SimTK::State& st)
+        {
+            realizerModel->getModel().realizeReport(st);
+        });
+    }
 }
 
 class osc::ForwardDynamicSimulation::Impl final {
 public:
 
     Impl(BasicModelStatePair p, ForwardDynamicSimulatorParams const& params) :
+        Impl{std::move(p), params, spsc::channel<SimulationReport>(c_ReportChannelCapacity, spsc::OverflowPolicy::Block)}
+    {
+    }
+
+    Impl(
+        BasicModelStatePair p,
+        ForwardDynamicSimulatorParams const& params,
+        std::pair<spsc::Sender<SimulationReport>, spsc::Receiver<SimulationReport>> reportChannel) :
+
         m_ModelState{std::move(p)},
-        m_Simulation{MakeSimulation(*m_ModelState.lock(), params, m_ReportQueue)},
+        m_ReportStore{MakeReportStore(*m_ModelState.lock())},
+        m_Simulation{MakeSimulation(*m_ModelState.lock(), params, std::move(reportChannel.first), m_StopRequested)},
         m_ParamsAsParamBlock{ToParamBlock(params)},
-        m_SimulatorOutputExtractors(GetFdSimulatorOutputExtractorsAsVector())
+        m_SimulatorOutputExtractors(GetFdSimulatorOutputExtractorsAsVector()),
+        m_SimulatorThreadOutputLookup{CreateSimulatorThreadOutputLookup(params)},
+        m_ReportReceiver{std::move(reportChannel.second)}
     {
+        m_ReportStore->reserve(EstimateNumReports(*m_ModelState.lock(), params));
     }
 
     SynchronizedValueGuard<OpenSim::Model const> getModel() const
@@ -83,12 +160,18 @@ public:
         return m_Reports.at(reportIndex);
     }
 
-    std::vector<SimulationReport> getAllSimulationReports() const
+    nonstd::span<SimulationReport const> getAllSimulationReports() const
     {
         popReportsHACK();
         return m_Reports;
     }
 
+    nonstd::span<double const> getReportTimes() const
+    {
+        popReportsHACK();
+        return m_ReportStore->getTimes();
+    }
+
     SimulationStatus getStatus() const
     {
         return m_Simulation.getStatus();
@@ -98,9 +181,9 @@ public:
     {
         popReportsHACK();
 
-        if (!m_Reports.empty())
+        if (!m_ReportStore->empty())
         {
-            return SimulationClock::start() + SimulationClock::duration{m_Reports.back().getState().getTime()};
+            return SimulationClock::start() + SimulationClock::duration{m_ReportStore->getTimes().back()};
         }
         else
         {
@@ -136,13 +219,33 @@ public:
         return m_SimulatorOutputExtractors;
     }
 
+    std::optional<nonstd::span<float const>> getPrecomputedOutputValues(OutputExtractor const& output) const
+    {
+        auto const it = m_SimulatorThreadOutputLookup.find(output);
+        if (it == m_SimulatorThreadOutputLookup.end())
+        {
+            return std::nullopt;  // the output wasn't computed on the simulator thread
+        }
+
+        popReportsHACK();
+
+        nonstd::span<float const> const values = m_ReportStore->getAuxiliaryValues(it->second);
+        if (values.size() != m_ReportStore->size())
+        {
+            return std::nullopt;  // no report has emitted it yet
+        }
+        return values;
+    }
+
     void requestStop()
     {
+        *m_StopRequested = true;
         m_Simulation.requestStop();
     }
 
     void stop()
     {
+        *m_StopRequested = true;
         m_Simulation.stop();
     }
 
@@ -159,48 +262,42 @@ public:
 private:
     // MUST be done from the UI thread
     //
-    // the reason this insane hack is necessary is because the background thread
-    // requires access to the UI thread's copy of the model in order to perform
-    // the realization step
+    // moves any reports emitted by the background thread into the (columnar) report
+    // store, which drops their `SimTK::State`s. The UI-facing reports are store-backed,
+    // so a full state is only rebuilt (+ realized) if something actually requests it
     void popReportsHACK() const
     {
-        auto& reports = const_cast<std::vector<SimulationReport>&>(m_Reports);
-
-        std::size_t nReportsBefore = reports.size();
+        // pop everything that's currently in the (lock-free) channel in one go, so
+        // that the background thread sees all of the freed-up space at once
+        std::vector<SimulationReport> incoming;
+        const_cast<spsc::Receiver<SimulationReport>&>(m_ReportReceiver).tryReceiveAll(std::back_inserter(incoming));
 
-        // pop them onto the local reports queue
-        {
-            auto guard = const_cast<SynchronizedValue<std::vector<SimulationReport>>&>(m_ReportQueue).lock();
-
-            reports.reserve(reports.size() + guard->size());
-            std::copy(std::make_move_iterator(guard->begin()),
-                      std::make_move_iterator(guard->end()),
-                      std::back_inserter(reports));
-            guard->clear();
-        }
-
-        std::size_t nReportsAfter = reports.size();
-        std::size_t nAdded = nReportsAfter-nReportsBefore;
-
-        if (nAdded <= 0)
+        if (incoming.empty())
         {
             return;
         }
 
-        // ensure all reports are realized on the UI model
-        auto modelLock = m_ModelState.lock();
-        for (auto it = reports.begin() + nReportsBefore; it != reports.end(); ++it)
+        auto& reports = const_cast<std::vector<SimulationReport>&>(m_Reports);
+        reports.reserve(reports.size() + incoming.size());
+        for (SimulationReport const& report : incoming)
         {
-            modelLock->getModel().realizeReport(it->updStateHACK());
+            m_ReportStore->append(report);
+            reports.emplace_back(m_ReportStore, m_ReportStore->size() - 1);
         }
     }
 
     SynchronizedValue<BasicModelStatePair> m_ModelState;
-    SynchronizedValue<std::vector<SimulationReport>> m_ReportQueue;
-    std::vector<SimulationReport> m_Reports;
+    std::shared_ptr<SimulationReportStore> m_ReportStore;
+    std::vector<SimulationReport> m_Reports;  // store-backed
+    std::shared_ptr<std::atomic<bool>> m_StopRequested = std::make_shared<std::atomic<bool>>(false);
     ForwardDynamicSimulator m_Simulation;
     ParamBlock m_ParamsAsParamBlock;
     std::vector<OutputExtractor> m_SimulatorOutputExtractors;
+    std::unordered_map<OutputExtractor, UID> m_SimulatorThreadOutputLookup;
+
+    // care: this must be destroyed *before* `m_Simulation`, so that the simulator thread
+    // sees the hangup (and stops waiting on a full channel) before it is joined
+    spsc::Receiver<SimulationReport> m_ReportReceiver;
 };
 
 
@@ -230,11 +327,16 @@ osc::SimulationReport osc::ForwardDynamicSimulation::implGetSimulationReport(int
     return m_Impl->getSimulationReport(std::move(reportIndex));
 }
 
-std::vector<osc::SimulationReport> osc::ForwardDynamicSimulation::implGetAllSimulationReports() const
+nonstd::span<osc::SimulationReport const> osc::ForwardDynamicSimulation::implGetAllSimulationReports() const
 {
     return m_Impl->getAllSimulationReports();
 }
 
+nonstd::span<double const> osc::ForwardDynamicSimulation::implGetReportTimes() const
+{
+    return m_Impl->getReportTimes();
+}
+
 osc::SimulationStatus osc::ForwardDynamicSimulation::implGetStatus() const
 {
     return m_Impl->getStatus();
@@ -270,6 +372,11 @@ nonstd::span<osc::OutputExtractor const> osc::ForwardDynamicSimulation::implGetO
     return m_Impl->getOutputExtractors();
 }
 
+std::optional<nonstd::span<float const>> osc::ForwardDynamicSimulation::implGetPrecomputedOutputValues(OutputExtractor const& output) const
+{
+    return m_Impl->getPrecomputedOutputValues(output);
+}
+
 void osc::ForwardDynamicSimulation::implRequestStop()
 {
     return m_Impl->requestStop();
@@ -11,6 +11,7 @@
 #include <nonstd/span.hpp>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace OpenSim { class Model; }
@@ -36,7 +37,8 @@ namespace osc
 
         int implGetNumReports() const final;
         SimulationReport implGetSimulationReport(int reportIndex) const final;
-        std::vector<SimulationReport> implGetAllSimulationReports() const final;
+        nonstd::span<SimulationReport const> implGetAllSimulationReports() const final;
+        nonstd::span<double const> implGetReportTimes() const final;
 
         SimulationStatus implGetStatus() const final;
         SimulationClock::time_point implGetCurTime() const final;
@@ -45,6 +47,7 @@ namespace osc
         float implGetProgress() const final;
         ParamBlock const& implGetParams() const final;
         nonstd::span<OutputExtractor const> implGetOutputExtractors() const final;
+        std::optional<nonstd::span<float const>> implGetPrecomputedOutputValues(OutputExtractor const&) const final;
 
         void implRequestStop() final;
         void implStop() final;
@@ -13,6 +13,7 @@
 #include <oscar/Platform/Log.hpp>
 #include <oscar/Utils/Algorithms.hpp>
 #include <oscar/Utils/Cpp20Shims.hpp>
+#include <oscar/Utils/CStringView.hpp>
 #include <oscar/Utils/UID.hpp>
 
 #include <nonstd/span.hpp>
@@ -23,9 +24,11 @@
 #include <simmath/Integrator.h>
 #include <simmath/TimeStepper.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <exception>
 #include <functional>
@@ -33,6 +36,7 @@
 #include <optional>
 #include <ratio>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -41,6 +45,8 @@ namespace OpenSim { class Component; }
 
 static osc::UID const c_WalltimeUID;
 static osc::UID const c_StepDurationUID;
+static osc::CStringView constexpr c_WalltimeName = "Wall time";
+static osc::CStringView constexpr c_StepDurationName = "Step Wall Time";
 
 namespace
 {
@@ -56,6 +62,7 @@ namespace
         {
         }
 
+        OpenSim::Model const& getModel() const { return m_ModelState.getModel(); }
         SimTK::MultibodySystem const& getMultiBodySystem() const { return m_ModelState.getModel().getMultibodySystem(); }
         SimTK::State const& getState() const { return m_ModelState.getState(); }
         osc::ForwardDynamicSimulatorParams const& getParams() const { return m_Params; }
@@ -168,14 +175,14 @@ namespace
 
         {
             osc::OutputExtractor out{AuxiliaryVariableOutputExtractor{
-                "Wall time",
+                std::string{c_WalltimeName},
                 "Total cumulative time spent computing the simulation",
                 c_WalltimeUID
             }};
             rv.push_back(out);
 
             osc::OutputExtractor out2{AuxiliaryVariableOutputExtractor{
-                "Step Wall Time",
+                std::string{c_StepDurationName},
                 "How long it took, in wall time, to compute the last integration step",
                 c_StepDurationUID
             }};
@@ -222,48 +229,173 @@ namespace
         return osc::SimulationClock::time_point(osc::SimulationClock::duration(integ.getTime()));
     }
 
-    osc::SimulationReport CreateSimulationReport(
-        std::chrono::duration<float> wallTime,
-        std::chrono::duration<float> stepDuration,
-        SimTK::MultibodySystem const& sys,
-        SimTK::Integrator const& integrator)
-    {
-        SimTK::State st = integrator.getState();
-        std::unordered_map<osc::UID, float> auxValues;
+    // a precomputed (per-simulation) plan for what's captured in each report
+    //
+    // the plan is computed once, so that creating each report only evaluates what the
+    // caller actually asked for
+    class ReportCapturePlan final {
+    public:
+        ReportCapturePlan(
+            osc::ForwardDynamicSimulatorParams const& params,
+            OpenSim::Model const& model) :
+
+            m_SimulatorThreadOutputs{params.simulatorThreadOutputs}
+        {
+            auto const isWhitelisted = [&whitelist = params.auxiliaryOutputWhitelist](std::string_view name)
+            {
+                return !whitelist || osc::ContainsIf(*whitelist, [name](std::string const& el) { return el == name; });
+            };
+
+            m_CaptureWallTime = isWhitelisted(c_WalltimeName);
+            m_CaptureStepDuration = isWhitelisted(c_StepDurationName);
+            for (int i = 0, len = osc::GetNumIntegratorOutputExtractors(); i < len; ++i)
+            {
+                if (isWhitelisted(osc::GetIntegratorOutputExtractor(i).getName()))
+                {
+                    m_IntegratorOutputs.push_back(&osc::GetIntegratorOutputExtractor(i));
+                }
+            }
+            for (int i = 0, len = osc::GetNumMultiBodySystemOutputExtractors(); i < len; ++i)
+            {
+                if (isWhitelisted(osc::GetMultiBodySystemOutputExtractor(i).getName()))
+                {
+                    m_MultiBodySystemOutputs.push_back(&osc::GetMultiBodySystemOutputExtractor(i));
+                }
+            }
+
+            // remove user outputs that can't be stored as an auxiliary (float) value
+            osc::RemoveErase(m_SimulatorThreadOutputs, [](osc::SimulatorThreadOutput const& o)
+            {
+                return o.output.getOutputType() != osc::OutputType::Float;
+            });
+
+            // resolve the user outputs against the model once, rather than once per report
+            m_BoundSimulatorThreadOutputs.reserve(m_SimulatorThreadOutputs.size());
+            for (osc::SimulatorThreadOutput const& o : m_SimulatorThreadOutputs)
+            {
+                m_BoundSimulatorThreadOutputs.push_back(o.output.bindValueFloat(model));
+            }
+
+            m_NumAuxiliaryValues =
+                static_cast<size_t>(m_CaptureWallTime) +
+                static_cast<size_t>(m_CaptureStepDuration) +
+                m_IntegratorOutputs.size() +
+                m_MultiBodySystemOutputs.size() +
+                m_SimulatorThreadOutputs.size();
+        }
+
+        osc::SimulationReport createReport(
+            std::chrono::duration<float> wallTime,
+            std::chrono::duration<float> stepDuration,
+            SimulatorThreadInput const& input,
+            SimTK::Integrator const& integrator) const
+        {
+            SimTK::State st = integrator.getState();
+            std::unordered_map<osc::UID, float> auxValues;
+            auxValues.reserve(m_NumAuxiliaryValues);
+
+            // care: state needs to be realized on the simulator thread
+            st.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+
+            // populate forward dynamic simulator outputs
+            if (m_CaptureWallTime)
+            {
+                auxValues.emplace(c_WalltimeUID, wallTime.count());
+            }
+            if (m_CaptureStepDuration)
+            {
+                auxValues.emplace(c_StepDurationUID, stepDuration.count());
+            }
+
+            // populate integrator outputs
+            for (osc::IntegratorOutputExtractor const* o : m_IntegratorOutputs)
+            {
+                auxValues.emplace(o->getAuxiliaryDataID(), o->getExtractorFunction()(integrator));
+            }
+
+            // populate mbs outputs
+            for (osc::MultiBodySystemOutputExtractor const* o : m_MultiBodySystemOutputs)
+            {
+                auxValues.emplace(o->getAuxiliaryDataID(), o->getExtractorFunction()(input.getMultiBodySystem()));
+            }
+
+            if (m_SimulatorThreadOutputs.empty())
+            {
+                return osc::SimulationReport{std::move(st), std::move(auxValues)};
+            }
 
-        // care: state needs to be realized on the simulator thread
-        st.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+            // populate user outputs
+            //
+            // these are evaluated against a fully-realized state, so that they behave
+            // identically to evaluating them (later) from the report's state
+            input.getModel().realizeReport(st);
+            osc::SimulationReport withoutUserOutputs{std::move(st)};
+            for (size_t i = 0; i < m_SimulatorThreadOutputs.size(); ++i)
+            {
+                auxValues.emplace(m_SimulatorThreadOutputs[i].auxiliaryValueID, m_BoundSimulatorThreadOutputs[i](withoutUserOutputs));
+            }
+            return osc::SimulationReport{std::move(withoutUserOutputs.updStateHACK()), std::move(auxValues)};
+        }
+
+    private:
+        bool m_CaptureWallTime = true;
+        bool m_CaptureStepDuration = true;
+        std::vector<osc::IntegratorOutputExtractor const*> m_IntegratorOutputs;
+        std::vector<osc::MultiBodySystemOutputExtractor const*> m_MultiBodySystemOutputs;
+        std::vector<osc::SimulatorThreadOutput> m_SimulatorThreadOutputs;
+        std::vector<std::function<float(osc::SimulationReport const&)>> m_BoundSimulatorThreadOutputs;
+        size_t m_NumAuxiliaryValues = 0;
+    };
 
-        // populate forward dynamic simulator outputs
+    // decides which reporting intervals actually emit a report
+    class ReportDecimator final {
+    public:
+        explicit ReportDecimator(osc::ForwardDynamicSimulatorParams const& params) :
+            m_Stride{std::max(params.reportingStride, 1)},
+            m_Threshold{params.adaptiveDecimationThreshold}
         {
-            auxValues.emplace(c_WalltimeUID, wallTime.count());
-            auxValues.emplace(c_StepDurationUID, stepDuration.count());
         }
 
-        // populate integrator outputs
+        // returns `true` if the `step`th reporting interval should emit a report
+        //
+        // called before the report is created, so that skipped intervals don't pay for
+        // copying the state, computing outputs, etc.
+        bool shouldEmit(int step, SimTK::State const& st) const
         {
-            int numOutputs = osc::GetNumIntegratorOutputExtractors();
-            auxValues.reserve(auxValues.size() + numOutputs);
-            for (int i = 0; i < numOutputs; ++i)
+            if (step % m_Stride != 0)
+            {
+                return false;
+            }
+
+            if (m_Threshold > 0.0 && m_LastEmittedY.size() == st.getNY())
             {
-                osc::IntegratorOutputExtractor const& o = osc::GetIntegratorOutputExtractor(i);
-                auxValues.emplace(o.getAuxiliaryDataID(), o.getExtractorFunction()(integrator));
+                SimTK::Vector const& y = st.getY();
+                for (int i = 0; i < y.size(); ++i)
+                {
+                    if (std::abs(y[i] - m_LastEmittedY[i]) > m_Threshold)
+                    {
+                        return true;
+                    }
+                }
+                return false;  // nothing has changed enough
             }
+
+            return true;
         }
 
-        // populate mbs outputs
+        void onEmitted(SimTK::State const& st)
         {
-            int numOutputs = osc::GetNumMultiBodySystemOutputExtractors();
-            auxValues.reserve(auxValues.size() + numOutputs);
-            for (int i = 0; i < numOutputs; ++i)
+            if (m_Threshold > 0.0)
             {
-                osc::MultiBodySystemOutputExtractor const& o = osc::GetMultiBodySystemOutputExtractor(i);
-                auxValues.emplace(o.getAuxiliaryDataID(), o.getExtractorFunction()(sys));
+                m_LastEmittedY = st.getY();
             }
         }
 
-        return osc::SimulationReport{std::move(st), std::move(auxValues)};
-    }
+    private:
+        int m_Stride;
+        double m_Threshold;
+        SimTK::Vector m_LastEmittedY;
+    };
 
     // this is the main function that the simulator thread works through (unguarded against exceptions)
     osc::SimulationStatus FdSimulationMainUnguarded(
@@ -286,10 +418,15 @@ namespace
         // inform observers that everything has been initialized and the sim is now running
         shared.setStatus(osc::SimulationStatus::Running);
 
+        // figure out what's captured in each report, and which reports are emitted
+        ReportCapturePlan const capturePlan{params, input.getModel()};
+        ReportDecimator decimator{params};
+
         // immediately report t = start
         {
             std::chrono::duration<float> wallDur = std::chrono::high_resolution_clock::now() - tSimStart;
-            input.emitReport(CreateSimulationReport(wallDur, {}, input.getMultiBodySystem(), *integ));
+            input.emitReport(capturePlan.createReport(wallDur, {}, input, *integ));
+            decimator.onEmitted(integ->getState());
         }
 
         // integrate (t0..tfinal]
@@ -322,11 +459,18 @@ namespace
             }
             else if (timestepRv == SimTK::Integrator::ReachedReportTime)
             {
-                // report the step and continue
-                std::chrono::duration<float> wallDur = tStepEnd - tSimStart;
-                std::chrono::duration<float> stepDur = tStepEnd - tStepStart;
-                input.emitReport(CreateSimulationReport(wallDur, stepDur, input.getMultiBodySystem(), *integ));
-                tLastReport = GetSimulationTime(*integ);
+                // report the step (unless it's decimated) and continue
+                //
+                // the last step of the simulation is never decimated, so that the final
+                // state is always reported
+                if (integ->isSimulationOver() || decimator.shouldEmit(step, integ->getState()))
+                {
+                    std::chrono::duration<float> wallDur = tStepEnd - tSimStart;
+                    std::chrono::duration<float> stepDur = tStepEnd - tStepStart;
+                    input.emitReport(capturePlan.createReport(wallDur, stepDur, input, *integ));
+                    decimator.onEmitted(integ->getState());
+                    tLastReport = GetSimulationTime(*integ);
+                }
                 ++step;
                 continue;
             }
@@ -340,7 +484,7 @@ namespace
                 {
                     std::chrono::duration<float> wallDur = tStepEnd - tSimStart;
                     std::chrono::duration<float> stepDur = tStepEnd - tStepStart;
-                    input.emitReport(CreateSimulationReport(wallDur, stepDur, input.getMultiBodySystem(), *integ));
+                    input.emitReport(capturePlan.createReport(wallDur, stepDur, input, *integ));
                     tLastReport = t;
                 }
                 break;
@@ -354,19 +498,19 @@ namespace
         return osc::SimulationStatus::Completed;
     }
 
-    // MAIN function for the simulator thread
+    // runs a simulation to completion on the calling thread
     //
     // guarded against exceptions (which are handled as simulation failures)
-    int FdSimulationMain(
+    osc::SimulationStatus FdSimulationMainGuarded(
         osc::stop_token stopToken,
-        std::unique_ptr<SimulatorThreadInput> input,
-        std::shared_ptr<SharedState> shared)
+        SimulatorThreadInput& input,
+        SharedState& shared)
     {
         osc::SimulationStatus status = osc::SimulationStatus::Error;
 
         try
         {
-            status = FdSimulationMainUnguarded(std::move(stopToken), *input, *shared);
+            status = FdSimulationMainUnguarded(std::move(stopToken), input, shared);
         }
         catch (OpenSim::Exception const& ex)
         {
@@ -381,8 +525,18 @@ namespace
             osc::log::error("an exception with unknown type occurred when running a simulation (no error message available)");
         }
 
-        shared->setStatus(status);
+        shared.setStatus(status);
+
+        return status;
+    }
 
+    // MAIN function for the simulator thread
+    int FdSimulationMain(
+        osc::stop_token stopToken,
+        std::unique_ptr<SimulatorThreadInput> input,
+        std::shared_ptr<SharedState> shared)
+    {
+        FdSimulationMainGuarded(std::move(stopToken), *input, *shared);
         return 0;
     }
 }
@@ -446,6 +600,17 @@ osc::OutputExtractor osc::GetFdSimulatorOutputExtractor(int idx)
     return GetSimulatorOutputExtractors().at(static_cast<size_t>(idx));
 }
 
+osc::SimulationStatus osc::RunForwardDynamicSimulation(
+    BasicModelStatePair modelState,
+    ForwardDynamicSimulatorParams const& params,
+    std::function<void(SimulationReport)> onReport,
+    stop_token stopToken)
+{
+    SimulatorThreadInput input{std::move(modelState), params, std::move(onReport)};
+    SharedState shared;
+    return FdSimulationMainGuarded(std::move(stopToken), input, shared);
+}
+
 osc::ForwardDynamicSimulator::ForwardDynamicSimulator(BasicModelStatePair msp,
                                 ForwardDynamicSimulatorParams const& params,
                                 std::function<void(SimulationReport)> reportCallback) :
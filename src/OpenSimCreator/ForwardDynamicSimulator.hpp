@@ -4,6 +4,8 @@
 #include "OpenSimCreator/OutputExtractor.hpp"
 #include "OpenSimCreator/SimulationStatus.hpp"
 
+#include <oscar/Utils/Cpp20Shims.hpp>
+
 #include <functional>
 #include <memory>
 
@@ -17,6 +19,18 @@ namespace osc
     int GetNumFdSimulatorOutputExtractors();
     OutputExtractor GetFdSimulatorOutputExtractor(int);
 
+    // runs a forward-dynamic simulation synchronously on the calling thread
+    //
+    // returns the final status of the simulation (exceptions are handled as errors). The
+    // callback is called on the calling thread and the simulation stops early (with a
+    // `Cancelled` status) once `stopToken` is requested
+    SimulationStatus RunForwardDynamicSimulation(
+        BasicModelStatePair,
+        ForwardDynamicSimulatorParams const&,
+        std::function<void(SimulationReport)> onReport,
+        stop_token
+    );
+
     // a forward-dynamic simulation that immediately starts running on a background thread
     class ForwardDynamicSimulator final {
     public:
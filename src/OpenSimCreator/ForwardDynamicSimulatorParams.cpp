@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <variant>
+#include <vector>
 
 static osc::CStringView constexpr c_FinalTimeTitle = "Final Time (sec)";
 static osc::CStringView constexpr c_FinalTimeDesc = "The final time, in seconds, that the forward dynamic simulation should integrate up to";
@@ -23,6 +24,10 @@ static osc::CStringView constexpr c_IntegratorMaximumStepSizeTitle = "Maximum st
 static osc::CStringView constexpr c_IntegratorMaximumStepSizeDesc = "The maximum step size, in seconds, that the integrator must take during the simulation. Note: this is mostly only relevant for error-correct integrators that change their step size dynamically as the simulation runs";
 static osc::CStringView constexpr c_IntegratorAccuracyTitle = "Accuracy";
 static osc::CStringView constexpr c_IntegratorAccuracyDesc = "Target accuracy for the integrator. Mostly only relevant for error-controlled integrators that change their step size by comparing this accuracy value to measured integration error";
+static osc::CStringView constexpr c_ReportingStrideTitle = "Reporting Stride";
+static osc::CStringView constexpr c_ReportingStrideDesc = "Only emit a simulation report every Nth reporting interval. Higher values reduce the overhead of collecting reports in long simulations that have a small reporting interval, at the cost of having fewer datapoints.";
+static osc::CStringView constexpr c_AdaptiveDecimationThresholdTitle = "Adaptive Decimation Threshold";
+static osc::CStringView constexpr c_AdaptiveDecimationThresholdDesc = "If greater than zero, a simulation report is skipped if no state variable has changed by more than this amount since the last emitted report. This reduces the number of reports emitted while the model is (nearly) static.";
 
 
 // public API
@@ -34,10 +39,17 @@ osc::ForwardDynamicSimulatorParams::ForwardDynamicSimulatorParams() :
     integratorStepLimit{20000},
     integratorMinimumStepSize{1.0e-8},
     integratorMaximumStepSize{1.0},
-    integratorAccuracy{1.0e-5}
+    integratorAccuracy{1.0e-5},
+    reportingStride{1},
+    adaptiveDecimationThreshold{0.0}
 {
 }
 
+bool osc::operator==(SimulatorThreadOutput const& a, SimulatorThreadOutput const& b)
+{
+    return a.output == b.output && a.auxiliaryValueID == b.auxiliaryValueID;
+}
+
 bool osc::operator==(ForwardDynamicSimulatorParams const& a, ForwardDynamicSimulatorParams const& b)
 {
     return
@@ -47,7 +59,11 @@ bool osc::operator==(ForwardDynamicSimulatorParams const& a, ForwardDynamicSimul
         a.integratorStepLimit == b.integratorStepLimit &&
         a.integratorMinimumStepSize == b.integratorMinimumStepSize &&
         a.integratorMaximumStepSize == b.integratorMaximumStepSize &&
-        a.integratorAccuracy == b.integratorAccuracy;
+        a.integratorAccuracy == b.integratorAccuracy &&
+        a.reportingStride == b.reportingStride &&
+        a.adaptiveDecimationThreshold == b.adaptiveDecimationThreshold &&
+        a.auxiliaryOutputWhitelist == b.auxiliaryOutputWhitelist &&
+        a.simulatorThreadOutputs == b.simulatorThreadOutputs;
 }
 
 osc::ParamBlock osc::ToParamBlock(ForwardDynamicSimulatorParams const& p)
@@ -60,6 +76,8 @@ osc::ParamBlock osc::ToParamBlock(ForwardDynamicSimulatorParams const& p)
     rv.pushParam(c_IntegratorMinimumStepSizeTitle, c_IntegratorMinimumStepSizeDesc, p.integratorMinimumStepSize.count());
     rv.pushParam(c_IntegratorMaximumStepSizeTitle, c_IntegratorMaximumStepSizeDesc, p.integratorMaximumStepSize.count());
     rv.pushParam(c_IntegratorAccuracyTitle, c_IntegratorAccuracyDesc, p.integratorAccuracy);
+    rv.pushParam(c_ReportingStrideTitle, c_ReportingStrideDesc, p.reportingStride);
+    rv.pushParam(c_AdaptiveDecimationThresholdTitle, c_AdaptiveDecimationThresholdDesc, p.adaptiveDecimationThreshold);
     return rv;
 }
 
@@ -94,5 +112,13 @@ osc::ForwardDynamicSimulatorParams osc::FromParamBlock(ParamBlock const& b)
     {
         rv.integratorAccuracy = std::get<double>(*acc);
     }
+    if (auto stride = b.findValue(c_ReportingStrideTitle); stride && std::holds_alternative<int>(*stride))
+    {
+        rv.reportingStride = std::get<int>(*stride);
+    }
+    if (auto threshold = b.findValue(c_AdaptiveDecimationThresholdTitle); threshold && std::holds_alternative<double>(*threshold))
+    {
+        rv.adaptiveDecimationThreshold = std::get<double>(*threshold);
+    }
     return rv;
 }
@@ -1,11 +1,30 @@
 #pragma once
 
 #include "OpenSimCreator/IntegratorMethod.hpp"
+#include "OpenSimCreator/OutputExtractor.hpp"
 #include "OpenSimCreator/ParamBlock.hpp"
 #include "OpenSimCreator/SimulationClock.hpp"
 
+#include <oscar/Utils/UID.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
 namespace osc
 {
+    // a user output that the simulator evaluates on its own thread as it creates each
+    // report, rather than it being (lazily) evaluated later from the report's state
+    struct SimulatorThreadOutput final {
+
+        OutputExtractor output;
+
+        // the ID of the auxiliary value that the output's value is written to in each report
+        UID auxiliaryValueID;
+    };
+
+    bool operator==(SimulatorThreadOutput const&, SimulatorThreadOutput const&);
+
     // simulation parameters
     struct ForwardDynamicSimulatorParams final {
 
@@ -45,11 +64,33 @@ namespace osc
         // this only does something if the integrator is error-controlled and able
         // to improve accuracy (e.g. by taking many more steps)
         double integratorAccuracy;
+
+        // only emit a report every Nth reporting interval
+        //
+        // the simulation still integrates to each reporting interval (so the integrator
+        // behaves identically), but skipped intervals don't pay the cost of copying the
+        // state or computing outputs
+        int reportingStride;
+
+        // if greater than zero, don't emit a report if no state variable (Q, U, or Z) has
+        // changed by more than this amount since the last emitted report
+        //
+        // the first and last reports of a simulation are always emitted
+        double adaptiveDecimationThreshold;
+
+        // if provided, only the simulator's auxiliary outputs (see `GetFdSimulatorOutputExtractor`)
+        // with these names are computed for each report (by default, all of them are)
+        std::optional<std::vector<std::string>> auxiliaryOutputWhitelist;
+
+        // user outputs that should be evaluated on the simulator thread for each report
+        std::vector<SimulatorThreadOutput> simulatorThreadOutputs;
     };
 
     bool operator==(ForwardDynamicSimulatorParams const& a, ForwardDynamicSimulatorParams const& b);
 
     // convert to a generic parameter block (for UI binding)
+    //
+    // care: only the scalar parameters are represented in the parameter block
     ParamBlock ToParamBlock(ForwardDynamicSimulatorParams const&);
     ForwardDynamicSimulatorParams FromParamBlock(ParamBlock const&);
 }
\ No newline at end of file
@@ -5,12 +5,14 @@
 #include "OpenSimCreator/Graphics/ModelRendererParams.hpp"
 #include "OpenSimCreator/Graphics/ModelSceneDecorations.hpp"
 #include "OpenSimCreator/Graphics/ModelSceneDecorationsParams.hpp"
+#include "OpenSimCreator/Graphics/MuscleColoringStyle.hpp"
 #include "OpenSimCreator/Graphics/OpenSimDecorationGenerator.hpp"
 #include "OpenSimCreator/Graphics/OverlayDecorationGenerator.hpp"
 #include "OpenSimCreator/OpenSimHelpers.hpp"
 #include "OpenSimCreator/VirtualConstModelStatePair.hpp"
 
 #include <oscar/Graphics/GraphicsHelpers.hpp>
+#include <oscar/Graphics/Mesh.hpp>
 #include <oscar/Graphics/MeshCache.hpp>
 #include <oscar/Graphics/SceneDecoration.hpp>
 #include <oscar/Graphics/SceneDecorationFlags.hpp>
@@ -19,15 +21,30 @@
 #include <oscar/Maths/MathHelpers.hpp>
 #include <oscar/Maths/PolarPerspectiveCamera.hpp>
 #include <oscar/Maths/Rect.hpp>
+#include <oscar/Platform/App.hpp>
+#include <oscar/Utils/InternedString.hpp>
 #include <oscar/Utils/Perf.hpp>
 #include <oscar/Utils/UID.hpp>
 
 #include <nonstd/span.hpp>
 #include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/AbstractPathPoint.h>
+#include <OpenSim/Simulation/Model/Frame.h>
+#include <OpenSim/Simulation/Model/Geometry.h>
+#include <OpenSim/Simulation/Model/GeometryPath.h>
 #include <OpenSim/Simulation/Model/Model.h>
-
+#include <OpenSim/Simulation/Model/PathPoint.h>
+#include <OpenSim/Simulation/Model/PathPointSet.h>
+#include <OpenSim/Simulation/Model/PhysicalFrame.h>
+#include <OpenSim/Simulation/Model/Station.h>
+#include <Simbody.h>
+
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <typeinfo>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -35,6 +52,22 @@ namespace OpenSim { class Component; }
 
 namespace
 {
+    // returns the stage that a state must be realized to in order to generate decorations with
+    // the given options
+    //
+    // (states are usually fully realized, but preview edits only realize the position stage)
+    SimTK::Stage GetRequiredStage(osc::CustomDecorationOptions const& opts)
+    {
+        switch (opts.getMuscleColoringStyle())
+        {
+        case osc::MuscleColoringStyle::Excitation:
+        case osc::MuscleColoringStyle::Force:
+            return SimTK::Stage::Dynamics;  // computed from the model's controls/forces
+        default:
+            return SimTK::Stage::Position;
+        }
+    }
+
     // helper: compute the decoration flags for a given component
     osc::SceneDecorationFlags ComputeSceneDecorationFlags(
         OpenSim::Component const& component,
@@ -82,57 +115,182 @@ namespace
         }
     }
 
-    // generate model decorations via the SimTK/OpenSim backend
-    void GenerateModelDecorations(
-        osc::VirtualConstModelStatePair const& model,
-        osc::ModelSceneDecorationsParams const& params,
-        osc::MeshCache& meshCache,
-        osc::ModelSceneDecorations& out)
+    // interned decoration IDs (absolute component paths), cached per component, so that
+    // regenerating decorations for the same model doesn't recompute them
+    class ComponentIDCache final {
+    public:
+        osc::InternedString const& get(OpenSim::Component const& c, osc::UID modelVersion)
+        {
+            if (modelVersion != m_ModelVersion)
+            {
+                m_IDs.clear();  // the model changed, so components may have been renamed/moved/deleted
+                m_ModelVersion = modelVersion;
+            }
+
+            auto [it, inserted] = m_IDs.try_emplace(&c);
+            if (inserted)
+            {
+                osc::GetAbsolutePathString(c, m_PathBuffer);
+                it->second = osc::InternedString{m_PathBuffer};
+            }
+            return it->second;
+        }
+
+    private:
+        osc::UID m_ModelVersion = osc::UID::empty();
+        std::unordered_map<OpenSim::Component const*, osc::InternedString> m_IDs;
+        std::string m_PathBuffer;
+    };
+
+    // assigns IDs and flags to generated decorations
+    //
+    // the generator typically emits many decorations for the same component in a row, so
+    // this caches the previous component's ID and flags
+    class DecorationIDAndFlagsAssigner final {
+    public:
+        DecorationIDAndFlagsAssigner(
+            ComponentIDCache& idCache,
+            osc::UID modelVersion,
+            OpenSim::Component const* selected,
+            OpenSim::Component const* hovered) :
+
+            m_IDCache{idCache},
+            m_ModelVersion{modelVersion},
+            m_Selected{selected},
+            m_Hovered{hovered}
+        {
+        }
+
+        void operator()(OpenSim::Component const& c, osc::SceneDecoration& dec)
+        {
+            if (&c != m_LastComponent)
+            {
+                m_LastID = m_IDCache.get(c, m_ModelVersion);
+                m_LastFlags = ComputeSceneDecorationFlags(c, m_Selected, m_Hovered);
+                m_LastComponent = &c;
+            }
+            dec.id = m_LastID;
+            dec.flags = m_LastFlags;
+        }
+
+    private:
+        ComponentIDCache& m_IDCache;
+        osc::UID m_ModelVersion;
+        OpenSim::Component const* m_Selected;
+        OpenSim::Component const* m_Hovered;
+        OpenSim::Component const* m_LastComponent = nullptr;
+        osc::SceneDecorationFlags m_LastFlags = osc::SceneDecorationFlags_None;
+        osc::InternedString m_LastID;
+    };
+
+    // tries to append the indices of the mobilized bodies that the given component's
+    // decorations depend on to `out` (i.e. its decorations can only change if one of
+    // those bodies moves)
+    //
+    // returns `false` if the dependencies can't be (cheaply) determined, in which case the
+    // component's decorations should be assumed to depend on anything in the state
+    bool TryAppendDependentMobilizedBodies(
+        OpenSim::Component const& c,
+        std::vector<SimTK::MobilizedBodyIndex>& out)
     {
-        OpenSim::Component const* selected = model.getSelected();
-        OpenSim::Component const* hovered = model.getHovered();
-        OpenSim::Component const* lastComponent = nullptr;
-        osc::SceneDecorationFlags lastFlags = osc::SceneDecorationFlags_None;
-        std::string lastID;
+        auto const appendFrame = [&out](OpenSim::Frame const& frame)
+        {
+            if (auto const* physicalFrame = dynamic_cast<OpenSim::PhysicalFrame const*>(&frame.findBaseFrame()))
+            {
+                out.push_back(physicalFrame->getMobilizedBodyIndex());
+                return true;
+            }
+            return false;
+        };
 
-        osc::GenerateModelDecorations(
-            meshCache,
-            model.getModel(),
-            model.getState(),
-            params.decorationOptions,
-            params.fixupScaleFactor,
-            [&out, selected, hovered, lastComponent, lastID, lastFlags](OpenSim::Component const& c, osc::SceneDecoration&& dec) mutable
+        if (auto const* geom = dynamic_cast<OpenSim::Geometry const*>(&c))
+        {
+            return appendFrame(geom->getFrame());
+        }
+        else if (auto const* frame = dynamic_cast<OpenSim::PhysicalFrame const*>(&c))
+        {
+            out.push_back(frame->getMobilizedBodyIndex());
+            return true;
+        }
+        else if (auto const* station = dynamic_cast<OpenSim::Station const*>(&c))
+        {
+            return appendFrame(station->getParentFrame());
+        }
+        else if (auto const* gp = dynamic_cast<OpenSim::GeometryPath const*>(&c))
+        {
+            // only handle simple paths: wrapping and moving/conditional path points can
+            // depend on more than the frames that the path points are attached to
+            if (gp->getWrapSet().getSize() > 0)
+            {
+                return false;
+            }
+
+            OpenSim::PathPointSet const& pps = gp->getPathPointSet();
+            for (int i = 0; i < pps.getSize(); ++i)
             {
-                if (&c == lastComponent)
+                OpenSim::AbstractPathPoint const& pp = pps[i];
+                if (typeid(pp) != typeid(OpenSim::PathPoint) || !appendFrame(pp.getParentFrame()))
                 {
-                    dec.id = lastID;
-                    dec.flags = lastFlags;
+                    return false;
                 }
-                else
+            }
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // returns a mask that is `true` for each mobilized body that may have moved between
+    // `prevQ` and the given state (i.e. one of its, or its ancestors', coordinates changed)
+    std::vector<bool> ComputeMovedMobilizedBodies(
+        SimTK::SimbodyMatterSubsystem const& matter,
+        SimTK::State const& state,
+        SimTK::Vector const& prevQ)
+    {
+        SimTK::Vector const& q = state.getQ();
+
+        // mobilized bodies are always ordered parent-first, so a single forward pass
+        // can propagate movement to descendants
+        std::vector<bool> rv(static_cast<size_t>(matter.getNumBodies()), false);
+        for (SimTK::MobilizedBodyIndex i{1}; i < matter.getNumBodies(); ++i)
+        {
+            SimTK::MobilizedBody const& mobod = matter.getMobilizedBody(i);
+            if (rv[static_cast<size_t>(mobod.getParentMobilizedBody().getMobilizedBodyIndex())])
+            {
+                rv[static_cast<size_t>(i)] = true;
+                continue;
+            }
+
+            int const firstQ = mobod.getFirstQIndex(state);
+            for (int j = firstQ; j < firstQ + mobod.getNumQ(state); ++j)
+            {
+                if (q[j] != prevQ[j])
                 {
-                    osc::GetAbsolutePathString(c, lastID);
-                    dec.id = lastID;
-                    dec.flags = ComputeSceneDecorationFlags(c, selected, hovered);
-                    lastFlags = dec.flags;
-                    lastComponent = &c;
+                    rv[static_cast<size_t>(i)] = true;
+                    break;
                 }
-                out.push_back(std::move(dec));
             }
-        );
+        }
+        return rv;
     }
 
-    // generate all model scene decorations for the given model+state pair and parameters
-    void GenerateModelSceneDecorations(
-        osc::VirtualConstModelStatePair const& model,
-        osc::ModelSceneDecorationsParams const& params,
-        osc::MeshCache& meshCache,
-        osc::ModelSceneDecorations& out)
+    // returns `true` if both vectors contain exactly the same values
+    bool IsEqual(SimTK::Vector const& a, SimTK::Vector const& b)
     {
-        out.clear();
-        GenerateModelDecorations(model, params, meshCache, out);
-        out.computeBVH();  // only hittest model decorations
-        auto onAppend = [&out](osc::SceneDecoration&& dec) { out.push_back(std::move(dec)); };
-        osc::GenerateOverlayDecorations(meshCache, params.renderingOptions, out.getBVH(), onAppend);
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (int i = 0; i < a.size(); ++i)
+        {
+            if (a[i] != b[i])
+            {
+                return false;
+            }
+        }
+        return true;
     }
 
     // create low-level scene renderer parameters from the given high-level model
@@ -160,6 +318,7 @@ namespace
         params.drawRims = renderParams.renderingOptions.getDrawSelectionRims();
         params.drawMeshNormals = renderParams.renderingOptions.getDrawMeshNormals();
         params.drawShadows = renderParams.renderingOptions.getDrawShadows();
+        params.minDecorationDiameterInPixels = renderParams.renderingOptions.getCullSmallDecorations() ? 2.0f : 0.0f;
         params.lightColor = renderParams.lightColor;
         params.backgroundColor = renderParams.backgroundColor;
         params.floorLocation = renderParams.floorLocation;
@@ -213,6 +372,12 @@ public:
             m_PrevRendererParams = rendererParameters;
         }
 
+        // keep redrawing until this renderer's placeholder meshes have loaded, so that they're swapped in
+        if (!m_PendingPlaceholders.empty())
+        {
+            App::upd().requestRedraw();
+        }
+
         return m_Renderer.updRenderTexture();
     }
 
@@ -244,6 +409,17 @@ public:
     }
 
 private:
+    // decoration bookkeeping for one component that the decoration generator visited,
+    // so that decorations can be regenerated per-component
+    struct ComponentDecorations final {
+        OpenSim::Component const* component = nullptr;
+        size_t firstDecoration = 0;
+        size_t numDecorations = 0;
+        size_t firstDependency = 0;
+        size_t numDependencies = 0;
+        bool dependsOnWholeState = false;
+    };
+
     bool generateDecorationsCached(
         VirtualConstModelStatePair const& modelState,
         ModelRendererParams const& renderParams)
@@ -257,21 +433,307 @@ private:
             renderParams.renderingOptions
         };
 
+        SimTK::Stage const requiredStage = GetRequiredStage(renderParams.decorationOptions);
+        if (modelState.getStateForRendering().getSystemStage() < requiredStage)
+        {
+            modelState.getModel().getSystem().realize(modelState.getStateForRendering(), requiredStage);
+        }
+
         if (decorationParams == m_PrevSceneParams)
         {
-            return false;  // no decoration generation necessary
+            if (!anyPendingPlaceholderHasLoaded())
+            {
+                return false;  // no decoration generation necessary
+            }
+
+            // meshes that were generated as placeholders may have finished loading: swap them in
+            regenerateAllDecorations(modelState, decorationParams);
+            return true;
         }
-        else
+
+        if (!HasSameModelAndOptions(decorationParams, m_PrevSceneParams))
         {
-            GenerateModelSceneDecorations(modelState, decorationParams, *m_MeshCache, m_Scene);
-            m_PrevSceneParams = std::move(decorationParams);
-            return true;  // new decorations were generated
+            regenerateAllDecorations(modelState, decorationParams);
         }
+        else if (HasSameState(decorationParams, m_PrevSceneParams))
+        {
+            // only the selection/hover changed: patch the existing decorations' flags
+            updateSelectionAndHoverFlags(modelState);
+        }
+        else if (!tryRegenerateMovedDecorations(modelState, decorationParams))
+        {
+            regenerateAllDecorations(modelState, decorationParams);
+        }
+
+        m_PrevSceneParams = std::move(decorationParams);
+        return true;  // new decorations were generated
+    }
+
+    // regenerates all decorations (+BVH, overlays) from scratch
+    void regenerateAllDecorations(
+        VirtualConstModelStatePair const& modelState,
+        ModelSceneDecorationsParams const& params)
+    {
+        OSC_PERF("CachedModelRenderer/regenerateAllDecorations");
+
+        m_Scene.clear();
+        m_Components.clear();
+        m_Dependencies.clear();
+        m_DecorationOwners.clear();
+        m_PendingPlaceholders.clear();
+
+        DecorationIDAndFlagsAssigner assignIDAndFlags{m_IDCache, modelState.getModelVersion(), modelState.getSelected(), modelState.getHovered()};
+        osc::GenerateModelDecorations(
+            *m_MeshCache,
+            modelState.getModel(),
+            modelState.getStateForRendering(),
+            params.decorationOptions,
+            params.fixupScaleFactor,
+            [this, &assignIDAndFlags](OpenSim::Component const& c, SceneDecoration&& dec)
+            {
+                assignIDAndFlags(c, dec);
+                trackIfPlaceholder(dec.mesh);
+                m_Scene.push_back(std::move(dec));
+                m_DecorationOwners.push_back(&c);
+                ++m_Components.back().numDecorations;
+            },
+            [this](OpenSim::Component const& c)
+            {
+                ComponentDecorations& entry = m_Components.emplace_back();
+                entry.component = &c;
+                entry.firstDecoration = m_Scene.size();
+                entry.firstDependency = m_Dependencies.size();
+                if (!TryAppendDependentMobilizedBodies(c, m_Dependencies))
+                {
+                    m_Dependencies.resize(entry.firstDependency);
+                    entry.dependsOnWholeState = true;
+                }
+                entry.numDependencies = m_Dependencies.size() - entry.firstDependency;
+                return true;
+            },
+            DecorationGenerationStrategy::Parallel,
+            MeshLoadingPolicy::PlaceholderWhileLoading
+        );
+        m_NumModelDecorations = m_Scene.size();
+
+        m_Scene.computeBVH();  // only hittest model decorations
+        appendOverlayDecorations(params);
+        storeStateSnapshot(modelState.getStateForRendering());
+    }
+
+    // remembers `mesh` if it's a placeholder for a still-loading mesh, so that the decorations
+    // can be regenerated once it has loaded
+    void trackIfPlaceholder(Mesh const& mesh)
+    {
+        if (mesh.getVerts().empty() &&
+            m_MeshCache->isLoading(mesh) &&
+            std::find(m_PendingPlaceholders.begin(), m_PendingPlaceholders.end(), mesh) == m_PendingPlaceholders.end())
+        {
+            m_PendingPlaceholders.push_back(mesh);
+        }
+    }
+
+    bool anyPendingPlaceholderHasLoaded() const
+    {
+        return std::any_of(m_PendingPlaceholders.begin(), m_PendingPlaceholders.end(), [this](Mesh const& placeholder)
+        {
+            return !m_MeshCache->isLoading(placeholder);
+        });
+    }
+
+    // tries to only regenerate the decorations of components that (may) have moved since
+    // the last generation
+    //
+    // returns `false` if that isn't possible (e.g. because more than the state's coordinates
+    // changed), in which case the caller should regenerate everything
+    bool tryRegenerateMovedDecorations(
+        VirtualConstModelStatePair const& modelState,
+        ModelSceneDecorationsParams const& params)
+    {
+        OSC_PERF("CachedModelRenderer/tryRegenerateMovedDecorations");
+
+        SimTK::State const& state = modelState.getStateForRendering();
+
+        // muscle coloring etc. can depend on speeds, auxiliary states, and time, so only
+        // handle the common case of (e.g.) a coordinate being edited
+        if (state.getTime() != m_PrevTime ||
+            state.getQ().size() != m_PrevQ.size() ||
+            !IsEqual(state.getU(), m_PrevU) ||
+            !IsEqual(state.getZ(), m_PrevZ))
+        {
+            return false;
+        }
+
+        std::vector<bool> const moved = ComputeMovedMobilizedBodies(
+            modelState.getModel().getMatterSubsystem(),
+            state,
+            m_PrevQ
+        );
+        if (std::none_of(moved.begin(), moved.end(), [](bool v) { return v; }))
+        {
+            return false;  // something other than the coordinates changed
+        }
+
+        auto const isDirty = [this, &moved](ComponentDecorations const& entry)
+        {
+            if (entry.dependsOnWholeState)
+            {
+                return true;
+            }
+            for (size_t i = entry.firstDependency; i < entry.firstDependency + entry.numDependencies; ++i)
+            {
+                auto const mobod = static_cast<size_t>(m_Dependencies[i]);
+                if (mobod >= moved.size() || moved[mobod])
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        // generate the dirty components' decorations into scratch space, so that they can
+        // be checked against the existing decorations before being spliced in
+        m_ScratchDecorations.clear();
+        m_ScratchOwners.clear();
+        m_ScratchComponents.clear();
+        size_t nextComponent = 0;
+        bool mismatched = false;
+
+        DecorationIDAndFlagsAssigner assignIDAndFlags{m_IDCache, modelState.getModelVersion(), modelState.getSelected(), modelState.getHovered()};
+        osc::GenerateModelDecorations(
+            *m_MeshCache,
+            modelState.getModel(),
+            state,
+            params.decorationOptions,
+            params.fixupScaleFactor,
+            [this, &assignIDAndFlags](OpenSim::Component const& c, SceneDecoration&& dec)
+            {
+                assignIDAndFlags(c, dec);
+                m_ScratchDecorations.push_back(std::move(dec));
+                m_ScratchOwners.push_back(&c);
+            },
+            [this, &isDirty, &nextComponent, &mismatched](OpenSim::Component const& c)
+            {
+                if (mismatched || nextComponent >= m_Components.size() || m_Components[nextComponent].component != &c)
+                {
+                    mismatched = true;
+                    return false;
+                }
+
+                ComponentDecorations const& entry = m_Components[nextComponent];
+                if (!isDirty(entry))
+                {
+                    ++nextComponent;
+                    return false;
+                }
+
+                m_ScratchComponents.emplace_back(nextComponent, m_ScratchDecorations.size());
+                ++nextComponent;
+                return true;
+            },
+            DecorationGenerationStrategy::Serial,
+            MeshLoadingPolicy::PlaceholderWhileLoading
+        );
+
+        if (mismatched || nextComponent != m_Components.size())
+        {
+            return false;  // the generator visited different components
+        }
+
+        // each regenerated component must emit the same number of decorations, so that they
+        // can be patched in-place (e.g. a path's number of points can change)
+        for (size_t i = 0; i < m_ScratchComponents.size(); ++i)
+        {
+            size_t const begin = m_ScratchComponents[i].second;
+            size_t const end = i+1 < m_ScratchComponents.size() ? m_ScratchComponents[i+1].second : m_ScratchDecorations.size();
+            if (end - begin != m_Components[m_ScratchComponents[i].first].numDecorations)
+            {
+                return false;
+            }
+        }
+
+        // patch the regenerated decorations into the scene
+        nonstd::span<SceneDecoration> const decorations = m_Scene.updDrawlist();
+        for (auto const& [componentIndex, scratchBegin] : m_ScratchComponents)
+        {
+            ComponentDecorations const& entry = m_Components[componentIndex];
+            for (size_t i = 0; i < entry.numDecorations; ++i)
+            {
+                trackIfPlaceholder(m_ScratchDecorations[scratchBegin + i].mesh);
+                decorations[entry.firstDecoration + i] = std::move(m_ScratchDecorations[scratchBegin + i]);
+                m_DecorationOwners[entry.firstDecoration + i] = m_ScratchOwners[scratchBegin + i];
+            }
+        }
+
+        if (params.selection != m_PrevSceneParams.selection || params.hover != m_PrevSceneParams.hover)
+        {
+            updateSelectionAndHoverFlags(modelState);
+        }
+
+        m_Scene.truncate(m_NumModelDecorations);  // overlays may depend on the BVH
+        m_Scene.refitBVH(m_NumModelDecorations);
+        appendOverlayDecorations(params);
+        storeStateSnapshot(state);
+
+        return true;
+    }
+
+    // recomputes the selection/hover flags of the existing model decorations
+    void updateSelectionAndHoverFlags(VirtualConstModelStatePair const& modelState)
+    {
+        OSC_PERF("CachedModelRenderer/updateSelectionAndHoverFlags");
+
+        OpenSim::Component const* selected = modelState.getSelected();
+        OpenSim::Component const* hovered = modelState.getHovered();
+        OpenSim::Component const* lastOwner = nullptr;
+        SceneDecorationFlags lastFlags = SceneDecorationFlags_None;
+
+        nonstd::span<SceneDecoration> const decorations = m_Scene.updDrawlist();
+        for (size_t i = 0; i < m_DecorationOwners.size(); ++i)
+        {
+            if (m_DecorationOwners[i] != lastOwner)
+            {
+                lastOwner = m_DecorationOwners[i];
+                lastFlags = ComputeSceneDecorationFlags(*lastOwner, selected, hovered);
+            }
+            decorations[i].flags = lastFlags;
+        }
+    }
+
+    void appendOverlayDecorations(ModelSceneDecorationsParams const& params)
+    {
+        auto onAppend = [this](SceneDecoration&& dec) { m_Scene.push_back(std::move(dec)); };
+        osc::GenerateOverlayDecorations(*m_MeshCache, params.renderingOptions, m_Scene.getBVH(), onAppend);
+    }
+
+    void storeStateSnapshot(SimTK::State const& state)
+    {
+        m_PrevTime = state.getTime();
+        m_PrevQ = state.getQ();
+        m_PrevU = state.getU();
+        m_PrevZ = state.getZ();
     }
 
     std::shared_ptr<MeshCache> m_MeshCache;
     ModelSceneDecorationsParams m_PrevSceneParams;
     ModelSceneDecorations m_Scene;
+
+    ComponentIDCache m_IDCache;
+
+    // bookkeeping for incrementally regenerating `m_Scene`
+    size_t m_NumModelDecorations = 0;  // overlays come after the model decorations
+    std::vector<Mesh> m_PendingPlaceholders;  // placeholders (for still-loading meshes) in the decorations
+    std::vector<ComponentDecorations> m_Components;
+    std::vector<SimTK::MobilizedBodyIndex> m_Dependencies;
+    std::vector<OpenSim::Component const*> m_DecorationOwners;
+    double m_PrevTime = 0.0;
+    SimTK::Vector m_PrevQ;
+    SimTK::Vector m_PrevU;
+    SimTK::Vector m_PrevZ;
+    std::vector<SceneDecoration> m_ScratchDecorations;
+    std::vector<OpenSim::Component const*> m_ScratchOwners;
+    std::vector<std::pair<size_t, size_t>> m_ScratchComponents;  // (component index, first scratch decoration)
+
     SceneRendererParams m_PrevRendererParams;
     SceneRenderer m_Renderer;
 };
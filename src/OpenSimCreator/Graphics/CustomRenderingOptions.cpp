@@ -17,17 +17,18 @@ namespace
         CustomRenderingOptionFlags_DrawFloor = 1 << 0,
         CustomRenderingOptionFlags_MeshNormals = 1 << 1,
         CustomRenderingOptionFlags_Shadows = 1 << 2,
+        CustomRenderingOptionFlags_CullSmallDecorations = 1 << 3,
 
-        CustomRenderingOptionFlags_DrawXZGrid = 1 << 3,
-        CustomRenderingOptionFlags_DrawXYGrid = 1 << 4,
-        CustomRenderingOptionFlags_DrawYZGrid = 1 << 5,
-        CustomRenderingOptionFlags_DrawAxisLines = 1 << 6,
+        CustomRenderingOptionFlags_DrawXZGrid = 1 << 4,
+        CustomRenderingOptionFlags_DrawXYGrid = 1 << 5,
+        CustomRenderingOptionFlags_DrawYZGrid = 1 << 6,
+        CustomRenderingOptionFlags_DrawAxisLines = 1 << 7,
 
-        CustomRenderingOptionFlags_DrawAABBs = 1 << 7,
-        CustomRenderingOptionFlags_DrawBVH = 1 << 8,
-        CustomRenderingOptionFlags_DrawSelectionRims = 1 << 9,
+        CustomRenderingOptionFlags_DrawAABBs = 1 << 8,
+        CustomRenderingOptionFlags_DrawBVH = 1 << 9,
+        CustomRenderingOptionFlags_DrawSelectionRims = 1 << 10,
 
-        CustomRenderingOptionFlags_COUNT = 10,
+        CustomRenderingOptionFlags_COUNT = 11,
         CustomRenderingOptionFlags_Default =
             CustomRenderingOptionFlags_DrawFloor |
             CustomRenderingOptionFlags_Shadows |
@@ -39,6 +40,7 @@ namespace
         "Floor",
         "Mesh Normals",
         "Shadows",
+        "Cull Small Decorations",
 
         "XZ Grid",
         "XY Grid",
@@ -70,6 +72,7 @@ namespace
         CustomRenderingOptionGroup::Rendering,
         CustomRenderingOptionGroup::Rendering,
         CustomRenderingOptionGroup::Rendering,
+        CustomRenderingOptionGroup::Rendering,
 
         CustomRenderingOptionGroup::Alignment,
         CustomRenderingOptionGroup::Alignment,
@@ -160,6 +163,16 @@ void osc::CustomRenderingOptions::setDrawShadows(bool v)
     SetFlag(m_Flags, CustomRenderingOptionFlags_Shadows, v);
 }
 
+bool osc::CustomRenderingOptions::getCullSmallDecorations() const
+{
+    return m_Flags & CustomRenderingOptionFlags_CullSmallDecorations;
+}
+
+void osc::CustomRenderingOptions::setCullSmallDecorations(bool v)
+{
+    SetFlag(m_Flags, CustomRenderingOptionFlags_CullSmallDecorations, v);
+}
+
 bool osc::CustomRenderingOptions::getDrawXZGrid() const
 {
     return m_Flags & CustomRenderingOptionFlags_DrawXZGrid;
@@ -28,6 +28,10 @@ namespace osc
         bool getDrawShadows() const;
         void setDrawShadows(bool);
 
+        // if enabled, decorations that would appear tiny on-screen aren't drawn
+        bool getCullSmallDecorations() const;
+        void setCullSmallDecorations(bool);
+
         bool getDrawXZGrid() const;
         void setDrawXZGrid(bool);
 
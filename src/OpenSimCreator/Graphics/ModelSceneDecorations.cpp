@@ -5,6 +5,42 @@
 #include <oscar/Maths/PolarPerspectiveCamera.hpp>
 #include <oscar/Utils/Perf.hpp>
 
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+    // returns true if refitting `bvh` with `aabbs` would yield the same prims as rebuilding it
+    //
+    // the BVH skips point-like AABBs when it's built, so its prims must refer to exactly the
+    // non-point AABBs (e.g. a decoration that collapsed to a point, while another one expanded
+    // from a point, keeps the prim count the same but requires a rebuild)
+    bool IsRefittableWith(osc::BVH const& bvh, nonstd::span<osc::AABB const> aabbs)
+    {
+        std::vector<bool> isUsedByAPrim(aabbs.size(), false);
+        for (osc::BVHPrim const& prim : bvh.prims)
+        {
+            auto const id = static_cast<size_t>(prim.getID());
+            if (id >= aabbs.size() || isUsedByAPrim[id] || osc::IsAPoint(aabbs[id]))
+            {
+                return false;
+            }
+            isUsedByAPrim[id] = true;
+        }
+
+        for (size_t i = 0; i < aabbs.size(); ++i)
+        {
+            if (!isUsedByAPrim[i] && !osc::IsAPoint(aabbs[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
 osc::ModelSceneDecorations::ModelSceneDecorations() = default;
 
 void osc::ModelSceneDecorations::clear()
@@ -23,6 +59,35 @@ void osc::ModelSceneDecorations::computeBVH()
     UpdateSceneBVH(m_Drawlist, m_BVH);
 }
 
+void osc::ModelSceneDecorations::refitBVH(size_t n)
+{
+    OSC_PERF("ModelSceneDecorations/refitBVH");
+
+    std::vector<AABB> aabbs;
+    aabbs.reserve(n);
+    for (size_t i = 0; i < n && i < m_Drawlist.size(); ++i)
+    {
+        aabbs.push_back(GetWorldspaceAABB(m_Drawlist[i]));
+    }
+
+    if (IsRefittableWith(m_BVH, aabbs))
+    {
+        m_BVH.refitFromAABBs(aabbs);
+    }
+    else
+    {
+        m_BVH.buildFromAABBs(aabbs);
+    }
+}
+
+void osc::ModelSceneDecorations::truncate(size_t n)
+{
+    if (n < m_Drawlist.size())
+    {
+        m_Drawlist.erase(m_Drawlist.begin() + static_cast<ptrdiff_t>(n), m_Drawlist.end());
+    }
+}
+
 std::optional<osc::AABB> osc::ModelSceneDecorations::getRootAABB() const
 {
     return m_BVH.getRootAABB();
@@ -11,6 +11,7 @@
 
 #include <cstddef>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace osc { struct PolarPerspectiveCamera; }
@@ -24,14 +25,28 @@ namespace osc
         void reserve(size_t);
         void computeBVH();
 
+        // updates the BVH's bounds from the (first `n`) decorations without rebuilding it
+        //
+        // falls back to rebuilding the BVH if the decorations don't match the ones it was
+        // built from
+        void refitBVH(size_t n);
+
+        // erases all decorations after the first `n`
+        void truncate(size_t n);
+
         nonstd::span<SceneDecoration const> getDrawlist() const
         {
             return m_Drawlist;
         }
 
+        nonstd::span<SceneDecoration> updDrawlist()
+        {
+            return m_Drawlist;
+        }
+
         void push_back(SceneDecoration&& decoration)
         {
-            m_Drawlist.push_back(decoration);
+            m_Drawlist.push_back(std::move(decoration));
         }
 
         size_t size() const
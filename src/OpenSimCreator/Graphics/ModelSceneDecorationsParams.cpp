@@ -33,4 +33,18 @@ bool osc::operator==(ModelSceneDecorationsParams const& a, ModelSceneDecorations
 bool osc::operator!=(ModelSceneDecorationsParams const& a, ModelSceneDecorationsParams const& b) noexcept
 {
     return !(a == b);
-}
\ No newline at end of file
+}
+
+bool osc::HasSameModelAndOptions(ModelSceneDecorationsParams const& a, ModelSceneDecorationsParams const& b) noexcept
+{
+    return
+        a.modelVersion == b.modelVersion &&
+        a.fixupScaleFactor == b.fixupScaleFactor &&
+        a.decorationOptions == b.decorationOptions &&
+        a.renderingOptions == b.renderingOptions;
+}
+
+bool osc::HasSameState(ModelSceneDecorationsParams const& a, ModelSceneDecorationsParams const& b) noexcept
+{
+    return a.stateVersion == b.stateVersion;
+}
@@ -27,6 +27,8 @@ namespace osc
 
     private:
         friend bool operator==(ModelSceneDecorationsParams const&, ModelSceneDecorationsParams const&) noexcept;
+        friend bool HasSameModelAndOptions(ModelSceneDecorationsParams const&, ModelSceneDecorationsParams const&) noexcept;
+        friend bool HasSameState(ModelSceneDecorationsParams const&, ModelSceneDecorationsParams const&) noexcept;
         UID modelVersion;
         UID stateVersion;
     public:
@@ -39,4 +41,11 @@ namespace osc
 
     bool operator==(ModelSceneDecorationsParams const&, ModelSceneDecorationsParams const&) noexcept;
     bool operator!=(ModelSceneDecorationsParams const&, ModelSceneDecorationsParams const&) noexcept;
+
+    // returns `true` if both parameters refer to the same model version with the same options (i.e.
+    // they may only differ in their state, selection, or hover)
+    bool HasSameModelAndOptions(ModelSceneDecorationsParams const&, ModelSceneDecorationsParams const&) noexcept;
+
+    // returns `true` if both parameters refer to the same state version
+    bool HasSameState(ModelSceneDecorationsParams const&, ModelSceneDecorationsParams const&) noexcept;
 }
\ No newline at end of file
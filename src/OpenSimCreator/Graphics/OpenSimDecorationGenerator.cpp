@@ -19,6 +19,7 @@
 #include <oscar/Utils/Assertions.hpp>
 #include <oscar/Utils/Cpp20Shims.hpp>
 #include <oscar/Utils/Perf.hpp>
+#include <oscar/Utils/WorkStealingThreadPool.hpp>
 
 #include <glm/vec3.hpp>
 #include <OpenSim/Common/Component.h>
@@ -34,11 +35,14 @@
 #include <OpenSim/Simulation/Model/Station.h>
 #include <OpenSim/Simulation/SimbodyEngine/Body.h>
 #include <OpenSim/Simulation/SimbodyEngine/ScapulothoracicJoint.h>
+#include <nonstd/span.hpp>
 #include <SimTKcommon.h>
 
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <exception>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <optional>
@@ -169,14 +173,16 @@ namespace
             SimTK::State const& state,
             osc::CustomDecorationOptions const& opts,
             float fixupScaleFactor,
-            std::function<void(OpenSim::Component const&, osc::SceneDecoration&&)> const& out) :
+            std::function<void(OpenSim::Component const&, osc::SceneDecoration&&)> const& out,
+            osc::MeshLoadingPolicy meshLoadingPolicy) :
 
             m_MeshCache{meshCache},
             m_Model{model},
             m_State{state},
             m_Opts{opts},
             m_FixupScaleFactor{fixupScaleFactor},
-            m_Out{out}
+            m_Out{out},
+            m_MeshLoadingPolicy{meshLoadingPolicy}
         {
         }
 
@@ -260,7 +266,8 @@ namespace
                     getState(),
                     geom,
                     getFixupScaleFactor(),
-                    callback
+                    callback,
+                    m_MeshLoadingPolicy
                 );
             }
 
@@ -279,7 +286,8 @@ namespace
                     getState(),
                     geom,
                     getFixupScaleFactor(),
-                    callback
+                    callback,
+                    m_MeshLoadingPolicy
                 );
             }
         }
@@ -296,6 +304,7 @@ namespace
         osc::CustomDecorationOptions const& m_Opts;
         float m_FixupScaleFactor;
         std::function<void(OpenSim::Component const&, osc::SceneDecoration&&)> const& m_Out;
+        osc::MeshLoadingPolicy m_MeshLoadingPolicy;
         SimTK::Array_<SimTK::DecorativeGeometry> m_GeomList;
     };
 
@@ -909,16 +918,250 @@ namespace
     }
 }
 
+// top-level generation
+namespace
+{
+    // emits the decorations of one component via the OSC-specific decoration specializations,
+    // or falls back to generic component decoration handling
+    void HandleComponent(
+        RendererState& rs,
+        OpenSim::Component const& c)
+    {
+        osc::CustomDecorationOptions const& opts = rs.getOptions();
+
+        if (typeid(c) == typeid(OpenSim::GeometryPath))
+        {
+            HandleGeometryPath(rs, static_cast<OpenSim::GeometryPath const&>(c));
+        }
+        else if (typeid(c) == typeid(OpenSim::Body))
+        {
+            HandleBody(rs, static_cast<OpenSim::Body const&>(c));
+        }
+        else if (typeid(c) == typeid(OpenSim::FrameGeometry))
+        {
+            HandleFrameGeometry(rs, static_cast<OpenSim::FrameGeometry const&>(c));
+        }
+        else if (opts.getShouldShowPointToPointSprings() && typeid(c) == typeid(OpenSim::PointToPointSpring))
+        {
+            HandlePointToPointSpring(rs, static_cast<OpenSim::PointToPointSpring const&>(c));
+        }
+        else if (typeid(c) == typeid(OpenSim::Station))
+        {
+            // CARE: it's a typeid comparison because OpenSim::Marker inherits from OpenSim::Station
+            HandleStation(rs, static_cast<OpenSim::Station const&>(c));
+        }
+        else if (opts.getShouldShowScapulo() && typeid(c) == typeid(OpenSim::ScapulothoracicJoint))
+        {
+            HandleScapulothoracicJoint(rs, static_cast<OpenSim::ScapulothoracicJoint const&>(c));
+        }
+        else if (typeid(c) == typeid(OpenSim::HuntCrossleyForce))
+        {
+            HandleHuntCrossleyForce(rs, static_cast<OpenSim::HuntCrossleyForce const&>(c));
+        }
+        else
+        {
+            rs.emitGenericDecorations(c, c);
+        }
+    }
+
+    // the minimum number of components that one parallel task generates decorations for
+    //
+    // most components (coordinates, joints, etc.) are very cheap, so smaller tasks
+    // mostly measure scheduling overhead
+    constexpr size_t c_MinComponentsPerParallelTask = 32;
+
+    // the pool that parallel decoration generation runs on
+    osc::WorkStealingThreadPool& GetDecorationGenerationThreadPool()
+    {
+        static osc::WorkStealingThreadPool s_Pool;
+        return s_Pool;
+    }
+
+    // decorations that were generated for a contiguous range of components by one task
+    struct DecorationArena final {
+        nonstd::span<OpenSim::Component const* const> components;
+        std::vector<std::pair<OpenSim::Component const*, osc::SceneDecoration>> decorations;
+        std::vector<size_t> offsets;  // `offsets[i]` is the first decoration of `components[i]`
+    };
+
+    void GenerateIntoArena(
+        osc::MeshCache& meshCache,
+        OpenSim::Model const& model,
+        SimTK::State const& state,
+        osc::CustomDecorationOptions const& opts,
+        float fixupScaleFactor,
+        osc::MeshLoadingPolicy meshLoadingPolicy,
+        DecorationArena& arena)
+    {
+        std::function<void(OpenSim::Component const&, osc::SceneDecoration&&)> const out =
+            [&arena](OpenSim::Component const& c, osc::SceneDecoration&& dec)
+        {
+            arena.decorations.emplace_back(&c, std::move(dec));
+        };
+        RendererState rendererState{meshCache, model, state, opts, fixupScaleFactor, out, meshLoadingPolicy};
+
+        arena.offsets.reserve(arena.components.size() + 1);
+        for (OpenSim::Component const* c : arena.components)
+        {
+            arena.offsets.push_back(arena.decorations.size());
+            HandleComponent(rendererState, *c);
+        }
+        arena.offsets.push_back(arena.decorations.size());
+    }
+
+    // generates decorations for the given components in parallel and emits them, in the
+    // same order that a serial generator would, on the calling thread
+    void GenerateModelDecorationsInParallel(
+        osc::MeshCache& meshCache,
+        OpenSim::Model const& model,
+        SimTK::State const& state,
+        osc::CustomDecorationOptions const& opts,
+        float fixupScaleFactor,
+        osc::MeshLoadingPolicy meshLoadingPolicy,
+        nonstd::span<OpenSim::Component const* const> components,
+        std::function<void(OpenSim::Component const&, osc::SceneDecoration&&)> const& out,
+        std::function<bool(OpenSim::Component const&)> const& shouldGenerate)
+    {
+        osc::WorkStealingThreadPool& pool = GetDecorationGenerationThreadPool();
+
+        // oversubscribe the pool, so that tasks that happen to contain many (expensive)
+        // muscles can be balanced by work-stealing
+        size_t const numTasks = std::clamp<size_t>(
+            components.size() / c_MinComponentsPerParallelTask,
+            1,
+            4 * (pool.getNumThreads() + 1)
+        );
+        size_t const componentsPerTask = (components.size() + numTasks - 1) / numTasks;
+
+        std::vector<DecorationArena> arenas(numTasks);
+        for (size_t i = 0; i < numTasks; ++i)
+        {
+            size_t const begin = std::min(i * componentsPerTask, components.size());
+            size_t const end = std::min(begin + componentsPerTask, components.size());
+            arenas[i].components = components.subspan(begin, end - begin);
+        }
+
+        // run the first task on the calling thread, rather than leaving it idle
+        std::vector<std::future<void>> futures;
+        futures.reserve(numTasks);
+        for (size_t i = 1; i < numTasks; ++i)
+        {
+            auto task = std::make_shared<std::packaged_task<void()>>([&, i]()
+            {
+                GenerateIntoArena(meshCache, model, state, opts, fixupScaleFactor, meshLoadingPolicy, arenas[i]);
+            });
+            futures.push_back(task->get_future());
+            pool.submit([task]() { (*task)(); });
+        }
+        std::exception_ptr callingThreadException;
+        try
+        {
+            GenerateIntoArena(meshCache, model, state, opts, fixupScaleFactor, meshLoadingPolicy, arenas.front());
+        }
+        catch (...)
+        {
+            callingThreadException = std::current_exception();
+        }
+
+        // wait for every task before (potentially) rethrowing, because they reference the arenas
+        for (std::future<void> const& f : futures)
+        {
+            f.wait();
+        }
+        if (callingThreadException)
+        {
+            std::rethrow_exception(callingThreadException);
+        }
+        for (std::future<void>& f : futures)
+        {
+            f.get();
+        }
+
+        // merge: emit the decorations in component order, so that the output is deterministic
+        for (DecorationArena& arena : arenas)
+        {
+            for (size_t i = 0; i < arena.components.size(); ++i)
+            {
+                if (!shouldGenerate(*arena.components[i]))
+                {
+                    continue;
+                }
+                for (size_t j = arena.offsets[i]; j < arena.offsets[i+1]; ++j)
+                {
+                    out(*arena.decorations[j].first, std::move(arena.decorations[j].second));
+                }
+            }
+        }
+    }
+}
+
+void osc::GenerateModelDecorations(
+    MeshCache& meshCache,
+    OpenSim::Model const& model,
+    SimTK::State const& state,
+    CustomDecorationOptions const& opts,
+    float fixupScaleFactor,
+    std::function<void(OpenSim::Component const&, SceneDecoration&&)> const& out,
+    DecorationGenerationStrategy strategy,
+    MeshLoadingPolicy meshLoadingPolicy)
+{
+    GenerateModelDecorations(
+        meshCache,
+        model,
+        state,
+        opts,
+        fixupScaleFactor,
+        out,
+        [](OpenSim::Component const&) { return true; },
+        strategy,
+        meshLoadingPolicy
+    );
+}
+
 void osc::GenerateModelDecorations(
     MeshCache& meshCache,
     OpenSim::Model const& model,
     SimTK::State const& state,
     CustomDecorationOptions const& opts,
     float fixupScaleFactor,
-    std::function<void(OpenSim::Component const&, SceneDecoration&&)> const& out)
+    std::function<void(OpenSim::Component const&, SceneDecoration&&)> const& out,
+    std::function<bool(OpenSim::Component const&)> const& shouldGenerate,
+    DecorationGenerationStrategy strategy,
+    MeshLoadingPolicy meshLoadingPolicy)
 {
     OSC_PERF("OpenSimRenderer/GenerateModelDecorations");
 
+    // parallel generation concurrently reads from the state, which is only safe if
+    // nothing in it is lazily computed during generation (e.g. muscle lengths)
+    if (strategy == DecorationGenerationStrategy::Parallel &&
+        state.getSystemStage() >= SimTK::Stage::Dynamics)
+    {
+        std::vector<OpenSim::Component const*> components;
+        for (OpenSim::Component const& c : model.getComponentList())
+        {
+            if (osc::ShouldShowInUI(c))
+            {
+                components.push_back(&c);
+            }
+        }
+
+        if (components.size() >= 2*c_MinComponentsPerParallelTask)
+        {
+            GenerateModelDecorationsInParallel(
+                meshCache,
+                model,
+                state,
+                opts,
+                fixupScaleFactor,
+                meshLoadingPolicy,
+                components,
+                out,
+                shouldGenerate
+            );
+            return;
+        }
+    }
+
     RendererState rendererState
     {
         meshCache,
@@ -927,48 +1170,22 @@ void osc::GenerateModelDecorations(
         opts,
         fixupScaleFactor,
         out,
+        meshLoadingPolicy,
     };
 
     for (OpenSim::Component const& c : model.getComponentList())
     {
-        // handle OSC-specific decoration specializations, or fallback to generic
-        // component decoration handling
         if (!osc::ShouldShowInUI(c))
         {
             continue;
         }
-        else if (typeid(c) == typeid(OpenSim::GeometryPath))
-        {
-            HandleGeometryPath(rendererState, static_cast<OpenSim::GeometryPath const&>(c));
-        }
-        else if (typeid(c) == typeid(OpenSim::Body))
-        {
-            HandleBody(rendererState, static_cast<OpenSim::Body const&>(c));
-        }
-        else if (typeid(c) == typeid(OpenSim::FrameGeometry))
-        {
-            HandleFrameGeometry(rendererState, static_cast<OpenSim::FrameGeometry const&>(c));
-        }
-        else if (opts.getShouldShowPointToPointSprings() && typeid(c) == typeid(OpenSim::PointToPointSpring))
-        {
-            HandlePointToPointSpring(rendererState, static_cast<OpenSim::PointToPointSpring const&>(c));
-        }
-        else if (typeid(c) == typeid(OpenSim::Station))
-        {
-            // CARE: it's a typeid comparison because OpenSim::Marker inherits from OpenSim::Station
-            HandleStation(rendererState, static_cast<OpenSim::Station const&>(c));
-        }
-        else if (opts.getShouldShowScapulo() && typeid(c) == typeid(OpenSim::ScapulothoracicJoint))
-        {
-            HandleScapulothoracicJoint(rendererState, static_cast<OpenSim::ScapulothoracicJoint const&>(c));
-        }
-        else if (typeid(c) == typeid(OpenSim::HuntCrossleyForce))
+        else if (!shouldGenerate(c))
         {
-            HandleHuntCrossleyForce(rendererState, static_cast<OpenSim::HuntCrossleyForce const&>(c));
+            continue;
         }
         else
         {
-            rendererState.emitGenericDecorations(c, c);
+            HandleComponent(rendererState, c);
         }
     }
 }
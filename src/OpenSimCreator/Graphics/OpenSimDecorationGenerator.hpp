@@ -1,25 +1,65 @@
 #pragma once
 
+#include <oscar/Graphics/MeshCache.hpp>
+
 #include <functional>
 
 namespace OpenSim { class Component; }
 namespace OpenSim { class Model; }
 namespace osc { class CustomDecorationOptions; }
-namespace osc { class MeshCache; }
 namespace osc { struct SceneDecoration; }
 namespace SimTK { class State; }
 
 namespace osc
 {
+    enum class DecorationGenerationStrategy {
+
+        // generate each component's decorations, one after another, on the calling thread
+        Serial = 0,
+
+        // generate components' decorations in parallel on a thread pool
+        //
+        // the output consumer is still only called on the calling thread, with the same
+        // decorations in the same order as `Serial`. Falls back to `Serial` for small models,
+        // or if the state isn't realized to at least `SimTK::Stage::Dynamics`
+        Parallel,
+
+        NUM_OPTIONS,
+    };
+
     // generates 3D decorations for the given model (+other data) and passes
     // them to the output consumer
+    //
+    // the `MeshLoadingPolicy` is used when loading mesh files (e.g. for `OpenSim::Mesh`es)
+    void GenerateModelDecorations(
+        MeshCache&,
+        OpenSim::Model const&,
+        SimTK::State const&,
+        CustomDecorationOptions const&,
+        float fixupScaleFactor,
+        std::function<void(OpenSim::Component const&, SceneDecoration&&)> const& out,
+        DecorationGenerationStrategy = DecorationGenerationStrategy::Serial,
+        MeshLoadingPolicy = MeshLoadingPolicy::Blocking
+    );
+
+    // as above, but only passes decorations for components for which `shouldGenerate`
+    // returns `true` to the output consumer
+    //
+    // `shouldGenerate` is called on the calling thread, in generation order, with each component
+    // that the generator visits, right before that component's decorations are passed to the
+    // output consumer. This enables callers to (e.g.) only regenerate decorations for components
+    // that have changed. `Parallel` generation generates decorations for every component up-front,
+    // so it's only worth using when most components are going to be generated
     void GenerateModelDecorations(
         MeshCache&,
         OpenSim::Model const&,
         SimTK::State const&,
         CustomDecorationOptions const&,
         float fixupScaleFactor,
-        std::function<void(OpenSim::Component const&, SceneDecoration&&)> const& out
+        std::function<void(OpenSim::Component const&, SceneDecoration&&)> const& out,
+        std::function<bool(OpenSim::Component const&)> const& shouldGenerate,
+        DecorationGenerationStrategy = DecorationGenerationStrategy::Serial,
+        MeshLoadingPolicy = MeshLoadingPolicy::Blocking
     );
 
     // returns the recommended scale factor for the given {model, state} pair
@@ -82,13 +82,15 @@ namespace
             SimTK::SimbodyMatterSubsystem const& matter,
             SimTK::State const& st,
             float fixupScaleFactor,
-            std::function<void(osc::SimpleSceneDecoration&&)> const& out) :
+            std::function<void(osc::SimpleSceneDecoration&&)> const& out,
+            osc::MeshLoadingPolicy meshLoadingPolicy) :
 
             m_MeshCache{meshCache},
             m_Matter{matter},
             m_St{st},
             m_FixupScaleFactor{fixupScaleFactor},
-            m_Consumer{out}
+            m_Consumer{out},
+            m_MeshLoadingPolicy{meshLoadingPolicy}
         {
         }
 
@@ -275,12 +277,11 @@ namespace
 
         void implementMeshFileGeometry(SimTK::DecorativeMeshFile const& d) final
         {
-            std::string const& path = d.getMeshFile();
-            auto meshLoader = [&path](){ return osc::LoadMeshViaSimTK(path); };
+            std::filesystem::path const path{d.getMeshFile()};
 
             m_Consumer(osc::SimpleSceneDecoration
             {
-                m_MeshCache.get(path, meshLoader),
+                m_MeshCache.getFromFile(path, osc::LoadMeshViaSimTK, m_MeshLoadingPolicy),
                 ToOscTransform(d),
                 GetColor(d)
             });
@@ -369,6 +370,7 @@ namespace
         SimTK::State const& m_St;
         float m_FixupScaleFactor;
         std::function<void(osc::SimpleSceneDecoration&&)> const& m_Consumer;
+        osc::MeshLoadingPolicy m_MeshLoadingPolicy;
     };
 }
 
@@ -378,8 +380,9 @@ void osc::GenerateDecorations(
     SimTK::State const& state,
     SimTK::DecorativeGeometry const& geom,
     float fixupScaleFactor,
-    std::function<void(SimpleSceneDecoration&&)> const& out)
+    std::function<void(SimpleSceneDecoration&&)> const& out,
+    MeshLoadingPolicy meshLoadingPolicy)
 {
-    GeometryImpl impl{meshCache, matter, state, fixupScaleFactor, out};
+    GeometryImpl impl{meshCache, matter, state, fixupScaleFactor, out, meshLoadingPolicy};
     geom.implementGeometry(impl);
 }
\ No newline at end of file
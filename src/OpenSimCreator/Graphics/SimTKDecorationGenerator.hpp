@@ -1,8 +1,9 @@
 #pragma once
 
+#include <oscar/Graphics/MeshCache.hpp>
+
 #include <functional>
 
-namespace osc { class MeshCache; }
 namespace osc { struct SimpleSceneDecoration; }
 namespace SimTK { class DecorativeGeometry; }
 namespace SimTK { class SimbodyMatterSubsystem; }
@@ -12,12 +13,15 @@ namespace osc
 {
     // generates `osc::SimpleSceneDecoration`s for the given `SimTK::DecorativeGeometry`
     // and passes them to the output consumer
+    //
+    // `meshLoadingPolicy` is used when loading mesh files (e.g. `SimTK::DecorativeMeshFile`s)
     void GenerateDecorations(
         MeshCache&,
         SimTK::SimbodyMatterSubsystem const&,
         SimTK::State const&,
         SimTK::DecorativeGeometry const&,
         float fixupScaleFactor,
-        std::function<void(SimpleSceneDecoration&&)> const& out
+        std::function<void(SimpleSceneDecoration&&)> const& out,
+        MeshLoadingPolicy meshLoadingPolicy = MeshLoadingPolicy::Blocking
     );
 }
\ No newline at end of file
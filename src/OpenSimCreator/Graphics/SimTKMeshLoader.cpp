@@ -2,9 +2,8 @@
 
 #include "OpenSimCreator/SimTKHelpers.hpp"
 
+#include <oscar/Graphics/GraphicsHelpers.hpp>
 #include <oscar/Graphics/Mesh.hpp>
-#include <oscar/Graphics/MeshTopology.hpp>
-#include <oscar/Maths/MathHelpers.hpp>
 #include <oscar/Maths/Triangle.hpp>
 
 #include <glm/vec3.hpp>
@@ -12,7 +11,6 @@
 #include <SimTKcommon/internal/PolygonalMesh.h>
 
 #include <cstddef>
-#include <cstdint>
 #include <vector>
 
 // helper functions
@@ -26,6 +24,17 @@ namespace
 
         return osc::ToVec3(pos);
     }
+
+    // returns the parameters that are used to weld the triangles of a loaded mesh
+    //
+    // (meshes are smooth-shaded, except across sharp edges, because most meshes that
+    //  are loaded this way are (e.g.) bones that approximate a smooth surface)
+    osc::MeshWeldingParams GetMeshWeldingParams()
+    {
+        osc::MeshWeldingParams rv;
+        rv.maybeSmoothingAngleDegrees = 30.0f;
+        return rv;
+    }
 }
 
 osc::Mesh osc::ToOscMesh(SimTK::PolygonalMesh const& mesh)
@@ -33,25 +42,12 @@ osc::Mesh osc::ToOscMesh(SimTK::PolygonalMesh const& mesh)
     // see: simbody VisualizerProtocol.cpp:drawPolygonalMesh(...) for what this is
     // roughly based on
 
-    std::vector<glm::vec3> verts;
-    std::vector<glm::vec3> normals;
-    std::vector<uint32_t> indices;
-
-    verts.reserve(static_cast<size_t>(mesh.getNumVertices()));
-    normals.reserve(static_cast<size_t>(mesh.getNumVertices()));
-    indices.reserve(static_cast<size_t>(mesh.getNumVertices()));
+    std::vector<osc::Triangle> triangles;
+    triangles.reserve(static_cast<size_t>(mesh.getNumFaces()));
 
-    uint32_t index = 0;
-    auto const pushTriangle = [&verts, &normals, &indices, &index](osc::Triangle const& tri)
+    auto const pushTriangle = [&triangles](osc::Triangle const& tri)
     {
-        glm::vec3 const normal = osc::TriangleNormal(tri);
-
-        for (size_t i = 0; i < 3; ++i)
-        {
-            verts.push_back(tri[i]);
-            normals.push_back(normal);
-            indices.push_back(index++);
-        }
+        triangles.push_back(tri);
     };
 
     for (int face = 0, nfaces = mesh.getNumFaces(); face < nfaces; ++face)
@@ -125,12 +121,9 @@ osc::Mesh osc::ToOscMesh(SimTK::PolygonalMesh const& mesh)
         }
     }
 
-    osc::Mesh rv;
-    rv.setTopology(osc::MeshTopology::Triangles);
-    rv.setVerts(verts);
-    rv.setNormals(normals);
-    rv.setIndices(indices);
-    return rv;
+    // the triangles are welded, so that vertices are shared between triangles, rather than
+    // emitting three unique vertices per triangle
+    return osc::CreateWeldedTriangleMesh(triangles, GetMeshWeldingParams());
 }
 
 std::string osc::GetCommaDelimitedListOfSupportedSimTKMeshFormats()
@@ -49,6 +49,18 @@ namespace osc
             implSetSimulationPlaybackSpeed(v);
         }
 
+        // if true, the shown state is linearly interpolated between the reports either side
+        // of the scrub time, rather than being the first report at (or after) the scrub time
+        bool getSimulationStateInterpolation()
+        {
+            return implGetSimulationStateInterpolation();
+        }
+
+        void setSimulationStateInterpolation(bool v)
+        {
+            implSetSimulationStateInterpolation(v);
+        }
+
         SimulationClock::time_point getSimulationScrubTime()
         {
             return implGetSimulationScrubTime();
@@ -116,6 +128,8 @@ namespace osc
         virtual void implSetSimulationPlaybackState(bool) = 0;
         virtual float implGetSimulationPlaybackSpeed() = 0;
         virtual void implSetSimulationPlaybackSpeed(float) = 0;
+        virtual bool implGetSimulationStateInterpolation() = 0;
+        virtual void implSetSimulationStateInterpolation(bool) = 0;
         virtual SimulationClock::time_point implGetSimulationScrubTime() = 0;
         virtual void implSetSimulationScrubTime(SimulationClock::time_point) = 0;
         virtual void implStepBack() = 0;
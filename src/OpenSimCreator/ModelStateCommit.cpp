@@ -3,19 +3,119 @@
 #include "OpenSimCreator/VirtualConstModelStatePair.hpp"
 #include "OpenSimCreator/OpenSimHelpers.hpp"
 
+#include <oscar/Platform/Log.hpp>
 #include <oscar/Utils/CStringView.hpp>
+#include <oscar/Utils/Perf.hpp>
 #include <oscar/Utils/SynchronizedValue.hpp>
+#include <oscar/Utils/TextDelta.hpp>
 #include <oscar/Utils/UID.hpp>
+#include <oscar/Utils/WorkStealingThreadPool.hpp>
 
+#include <OpenSim/Common/ModelDisplayHints.h>
+#include <OpenSim/Common/XMLDocument.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <SimTKcommon/internal/Xml.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <exception>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
 
+namespace
+{
+    // the pool that asynchronous commits initialize their models on
+    osc::WorkStealingThreadPool& GetCommitInitializationThreadPool()
+    {
+        static osc::WorkStealingThreadPool s_Pool;
+        return s_Pool;
+    }
+
+    // returns a future that holds the given model once it has been initialized
+    //
+    // if an asynchronous initialization fails, `failed` is set before the future is fulfilled
+    // with the (uninitialized) model
+    std::shared_future<std::unique_ptr<OpenSim::Model>> Initialize(
+        std::unique_ptr<OpenSim::Model> model,
+        osc::ModelStateCommitStrategy strategy,
+        std::shared_ptr<std::atomic<bool>> const& failed)
+    {
+        if (strategy == osc::ModelStateCommitStrategy::Synchronous)
+        {
+            // initialize on the calling thread, so that errors propagate to the caller (e.g.
+            // so that it can rollback)
+            osc::InitializeModel(*model);
+            osc::InitializeState(*model);
+
+            std::promise<std::unique_ptr<OpenSim::Model>> promise;
+            promise.set_value(std::move(model));
+            return promise.get_future().share();
+        }
+
+        auto task = std::make_shared<std::packaged_task<std::unique_ptr<OpenSim::Model>()>>([m = std::move(model), failed]() mutable
+        {
+            OSC_PERF("ModelStateCommit/asynchronous initialization");
+            try
+            {
+                osc::InitializeModel(*m);
+                osc::InitializeState(*m);
+            }
+            catch (std::exception const& ex)
+            {
+                // there's nothing to rollback to at this point: the caller has already moved on, so
+                // flag the commit, so that its owner can drop it (see `failedToInitialize`)
+                osc::log::error("exception occurred while initializing a commit's model in the background: %s", ex.what());
+                *failed = true;
+            }
+            return std::move(m);
+        });
+        std::shared_future<std::unique_ptr<OpenSim::Model>> rv = task->get_future().share();
+        GetCommitInitializationThreadPool().submit([task]() { (*task)(); });
+        return rv;
+    }
+
+    // serializes the model's properties as an XML document
+    std::string SerializeModel(OpenSim::Model const& model)
+    {
+        OSC_PERF("ModelStateCommit/SerializeModel");
+
+        SimTK::Xml::Document doc;
+        SimTK::Xml::Element root = doc.getRootElement();
+        model.updateXMLNode(root);
+
+        SimTK::String rv;
+        doc.writeToString(rv, false);  // not compact: `TextDelta` is line-based, so each element should be on its own line
+        return std::move(rv);
+    }
+
+    // returns a new (not initialized) model from an XML document that was written by `SerializeModel`
+    std::unique_ptr<OpenSim::Model> DeserializeModel(std::string const& document)
+    {
+        OSC_PERF("ModelStateCommit/DeserializeModel");
+
+        SimTK::Xml::Document doc;
+        doc.readFromString(document);
+
+        SimTK::Xml::Element root = doc.getRootElement();
+        auto const it = root.element_begin("Model");
+        if (it == root.element_end())
+        {
+            throw std::runtime_error{"cannot reconstruct a commit's model: its document does not contain a model"};
+        }
+
+        auto rv = std::make_unique<OpenSim::Model>();
+        static_cast<OpenSim::Object&>(*rv).updateFromXMLNode(*it, OpenSim::XMLDocument::getLatestVersion());  // (called via `Object`, because `Model`'s override isn't public)
+        return rv;
+    }
+}
+
 class osc::ModelStateCommit::Impl final {
 public:
     Impl(VirtualConstModelStatePair const& msp, std::string_view message) :
@@ -24,17 +124,23 @@ public:
     }
 
     Impl(VirtualConstModelStatePair const& msp, std::string_view message, UID parent) :
+        Impl{msp, message, parent, ModelStateCommitStrategy::Synchronous}
+    {
+    }
+
+    Impl(VirtualConstModelStatePair const& msp, std::string_view message, UID parent, ModelStateCommitStrategy strategy) :
         m_AccessMutex{},
         m_ID{},
         m_MaybeParentID{std::move(parent)},
         m_CommitTime{std::chrono::system_clock::now()},
-        m_Model{std::make_unique<OpenSim::Model>(msp.getModel())},
         m_ModelVersion{msp.getModelVersion()},
         m_FixupScaleFactor{msp.getFixupScaleFactor()},
-        m_CommitMessage{std::move(message)}
+        m_CommitMessage{std::move(message)},
+        m_InitializationFailed{std::make_shared<std::atomic<bool>>(false)},
+        m_MaybeModel{Initialize(std::make_unique<OpenSim::Model>(msp.getModel()), strategy, m_InitializationFailed)},
+        m_InputFileName{msp.getModel().getInputFileName()},
+        m_DisplayHints{msp.getModel().getDisplayHints()}
     {
-        osc::InitializeModel(*m_Model);
-        osc::InitializeState(*m_Model);
     }
 
     UID getID() const
@@ -62,9 +168,40 @@ public:
         return m_CommitMessage;
     }
 
+    bool isReady() const
+    {
+        std::lock_guard lock{m_AccessMutex};
+
+        // compacted commits are always ready, because they can only be compacted once initialized
+        return !m_MaybeModel.valid() || m_MaybeModel.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+    }
+
+    bool failedToInitialize() const
+    {
+        std::lock_guard lock{m_AccessMutex};
+
+        if (m_MaybeModel.valid())
+        {
+            m_MaybeModel.wait();
+        }
+        return *m_InitializationFailed;
+    }
+
     SynchronizedValueGuard<OpenSim::Model const> getModel() const
     {
-        return {m_AccessMutex, *m_Model};
+        std::unique_lock lock{m_AccessMutex};
+
+        if (!m_MaybeModel.valid())
+        {
+            // the model was compacted: reconstruct it from its document
+            std::promise<std::unique_ptr<OpenSim::Model>> promise;
+            promise.set_value(reconstructModel(getDocumentLocked()));
+            m_MaybeModel = promise.get_future().share();
+        }
+        OpenSim::Model const& model = *m_MaybeModel.get();
+
+        lock.release();  // the guard takes ownership
+        return {m_AccessMutex, std::adopt_lock, model};
     }
 
     UID getModelVersion() const
@@ -77,15 +214,135 @@ public:
         return m_FixupScaleFactor;
     }
 
+    void compact(std::shared_ptr<Impl const> const& maybeDeltaBase, bool keepModel) const
+    {
+        OSC_PERF("ModelStateCommit/compact");
+
+        // get the base's document before locking this commit, so that at most one commit is
+        // locked at a time (other than when following a chain of deltas, which always goes
+        // from older commits to newer ones)
+        std::optional<std::string> maybeBaseDocument;
+        if (maybeDeltaBase && !wasCompactedAgainst(maybeDeltaBase))
+        {
+            maybeBaseDocument = maybeDeltaBase->getDocument();
+        }
+
+        std::lock_guard lock{m_AccessMutex};
+
+        if (maybeBaseDocument)
+        {
+            std::string document = getDocumentLocked();
+            TextDelta delta{*maybeBaseDocument, document};
+            if (delta.getNumBytesUsed() < document.size())
+            {
+                m_MaybeDelta = std::move(delta);
+                m_MaybeDeltaBase = maybeDeltaBase;
+                m_MaybeDocument.reset();
+            }
+            else
+            {
+                // e.g. the whole model was replaced
+                m_MaybeDocument = std::move(document);
+                m_MaybeDelta.reset();
+                m_MaybeDeltaBase.reset();
+            }
+            m_LastCompactionBase = maybeDeltaBase;
+        }
+        else if (!maybeDeltaBase && !m_MaybeDocument)
+        {
+            m_MaybeDocument = getDocumentLocked();
+            m_MaybeDelta.reset();
+            m_MaybeDeltaBase.reset();
+            m_LastCompactionBase.reset();
+        }
+
+        if (!keepModel)
+        {
+            m_MaybeModel = {};
+        }
+    }
+
+    size_t getNumSerializedBytes() const
+    {
+        std::lock_guard lock{m_AccessMutex};
+
+        size_t rv = 0;
+        if (m_MaybeDocument)
+        {
+            rv += m_MaybeDocument->capacity();
+        }
+        if (m_MaybeDelta)
+        {
+            rv += m_MaybeDelta->getNumBytesUsed();
+        }
+        return rv;
+    }
+
 private:
+    std::string getDocument() const
+    {
+        std::lock_guard lock{m_AccessMutex};
+        return getDocumentLocked();
+    }
+
+    // returns the commit's serialized model (`m_AccessMutex` must be locked by the caller)
+    std::string getDocumentLocked() const
+    {
+        if (m_MaybeDocument)
+        {
+            return *m_MaybeDocument;
+        }
+        else if (m_MaybeDelta)
+        {
+            return m_MaybeDelta->apply(m_MaybeDeltaBase->getDocument());
+        }
+        else
+        {
+            // the commit hasn't been compacted yet, so serialize (and cache) its model
+            m_MaybeDocument = SerializeModel(*m_MaybeModel.get());
+            return *m_MaybeDocument;
+        }
+    }
+
+    bool wasCompactedAgainst(std::shared_ptr<Impl const> const& base) const
+    {
+        std::lock_guard lock{m_AccessMutex};
+        return !m_LastCompactionBase.owner_before(base) && !base.owner_before(m_LastCompactionBase);
+    }
+
+    std::unique_ptr<OpenSim::Model> reconstructModel(std::string const& document) const
+    {
+        OSC_PERF("ModelStateCommit/reconstructModel");
+
+        std::unique_ptr<OpenSim::Model> rv = DeserializeModel(document);
+        rv->setInputFileName(m_InputFileName);  // so that (e.g.) relative mesh paths still work
+        rv->updDisplayHints() = m_DisplayHints;
+        osc::InitializeModel(*rv);
+        osc::InitializeState(*rv);
+        return rv;
+    }
+
     mutable std::mutex m_AccessMutex;
     UID m_ID;
     UID m_MaybeParentID;
     std::chrono::system_clock::time_point m_CommitTime;
-    std::unique_ptr<OpenSim::Model> m_Model;
     UID m_ModelVersion;
     float m_FixupScaleFactor;
     std::string m_CommitMessage;
+    std::shared_ptr<std::atomic<bool>> m_InitializationFailed;  // shared with the (background) initialization
+
+    // the commit's model is stored as an (initialized) model and/or a serialized document. The
+    // document may be stored as a delta against another (newer) commit's document. Compacting
+    // the commit drops the model, which is then reconstructed from the document on-demand
+    mutable std::shared_future<std::unique_ptr<OpenSim::Model>> m_MaybeModel;
+    mutable std::optional<std::string> m_MaybeDocument;
+    mutable std::optional<TextDelta> m_MaybeDelta;
+    mutable std::shared_ptr<Impl const> m_MaybeDeltaBase;
+    mutable std::weak_ptr<Impl const> m_LastCompactionBase;
+
+    // (not part of the model's properties, so not in its document)
+    std::string m_InputFileName;
+    OpenSim::ModelDisplayHints m_DisplayHints;
 };
 
 
@@ -101,6 +358,11 @@ osc::ModelStateCommit::ModelStateCommit(VirtualConstModelStatePair const& p, std
 {
 }
 
+osc::ModelStateCommit::ModelStateCommit(VirtualConstModelStatePair const& p, std::string_view message, UID parent, ModelStateCommitStrategy strategy) :
+    m_Impl{std::make_shared<Impl>(p, std::move(message), std::move(parent), strategy)}
+{
+}
+
 osc::ModelStateCommit::ModelStateCommit(ModelStateCommit const&) = default;
 osc::ModelStateCommit::ModelStateCommit(ModelStateCommit&&) noexcept = default;
 osc::ModelStateCommit& osc::ModelStateCommit::operator=(ModelStateCommit const&) = default;
@@ -132,6 +394,16 @@ osc::CStringView osc::ModelStateCommit::getCommitMessage() const
     return m_Impl->getCommitMessage();
 }
 
+bool osc::ModelStateCommit::isReady() const
+{
+    return m_Impl->isReady();
+}
+
+bool osc::ModelStateCommit::failedToInitialize() const
+{
+    return m_Impl->failedToInitialize();
+}
+
 osc::SynchronizedValueGuard<OpenSim::Model const> osc::ModelStateCommit::getModel() const
 {
     return m_Impl->getModel();
@@ -146,3 +418,13 @@ float osc::ModelStateCommit::getFixupScaleFactor() const
 {
     return m_Impl->getFixupScaleFactor();
 }
+
+void osc::ModelStateCommit::compact(ModelStateCommit const* maybeDeltaBase, bool keepModel) const
+{
+    m_Impl->compact(maybeDeltaBase ? maybeDeltaBase->m_Impl : nullptr, keepModel);
+}
+
+size_t osc::ModelStateCommit::getNumSerializedBytes() const
+{
+    return m_Impl->getNumSerializedBytes();
+}
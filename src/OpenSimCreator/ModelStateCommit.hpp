@@ -5,6 +5,7 @@
 #include <oscar/Utils/UID.hpp>
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string_view>
 
@@ -14,12 +15,30 @@ namespace osc { class VirtualConstModelStatePair; }
 
 namespace osc
 {
+    // how a commit initializes (i.e. builds the system and state of) its copy of the model
+    enum class ModelStateCommitStrategy {
+
+        // initialize the copy on the calling thread, in the commit's constructor
+        Synchronous = 0,
+
+        // initialize the copy on a background thread, so that the commit's constructor only
+        // has to copy the model
+        //
+        // `getModel` waits for the initialization to finish. If the initialization fails, the
+        // error is logged, the commit holds the uninitialized copy, and `failedToInitialize`
+        // returns `true`
+        Asynchronous,
+
+        NUM_OPTIONS,
+    };
+
     // immutable, reference-counted handle to a "Model+State commit", which is effectively
     // what is saved upon each user action
     class ModelStateCommit final {
     public:
         ModelStateCommit(VirtualConstModelStatePair const&, std::string_view message);
         ModelStateCommit(VirtualConstModelStatePair const&, std::string_view message, UID parent);
+        ModelStateCommit(VirtualConstModelStatePair const&, std::string_view message, UID parent, ModelStateCommitStrategy);
         ModelStateCommit(ModelStateCommit const&);
         ModelStateCommit(ModelStateCommit&&) noexcept;
         ModelStateCommit& operator=(ModelStateCommit const&);
@@ -31,10 +50,29 @@ namespace osc
         UID getParentID() const;
         std::chrono::system_clock::time_point getCommitTime() const;
         CStringView getCommitMessage() const;
+
+        // returns `true` if the commit's model has been initialized (i.e. `getModel` won't wait)
+        bool isReady() const;
+
+        // returns `true` if the commit's (asynchronous) initialization failed, which means that its
+        // model isn't usable (e.g. it shouldn't be checked out). Waits for the initialization to finish
+        bool failedToInitialize() const;
         SynchronizedValueGuard<OpenSim::Model const> getModel() const;
         UID getModelVersion() const;
         float getFixupScaleFactor() const;
 
+        // reduces the memory used by the commit by storing its model as a serialized document,
+        // which is a (line-based) delta against `maybeDeltaBase`'s document, if provided
+        //
+        // unless `keepModel` is `true`, the commit's (initialized) model is also dropped, which
+        // means that the next call to `getModel` reconstructs it. This can be slow, so callers
+        // should compact on a background thread. Deltas must always be against newer commits
+        void compact(ModelStateCommit const* maybeDeltaBase, bool keepModel) const;
+
+        // returns the (approximate) number of bytes used by the commit's serialized document
+        // (i.e. excluding its initialized model, if it has one)
+        size_t getNumSerializedBytes() const;
+
     private:
         friend bool operator==(ModelStateCommit const& a, ModelStateCommit const& b);
 
@@ -1,5 +1,6 @@
 #include "OpenSimHelpers.hpp"
 
+#include "OpenSimCreator/ComponentPathIndex.hpp"
 #include "OpenSimCreator/SimTKHelpers.hpp"
 #include "OpenSimCreator/UndoableModelStatePair.hpp"
 
@@ -12,6 +13,7 @@
 #include <oscar/Utils/Cpp20Shims.hpp>
 #include <oscar/Utils/CStringView.hpp>
 #include <oscar/Utils/Perf.hpp>
+#include <oscar/Utils/UID.hpp>
 
 #include <glm/glm.hpp>
 #include <glm/vec3.hpp>
@@ -481,6 +483,27 @@ OpenSim::Component const* osc::FindComponent(
     return osc::FindComponent(model, OpenSim::ComponentPath{absPath});
 }
 
+OpenSim::Component const* osc::FindComponent(
+    ComponentPathIndex& index,
+    OpenSim::Component const& root,
+    UID rootVersion,
+    OpenSim::ComponentPath const& cp)
+{
+    if (IsEmpty(cp))
+    {
+        return nullptr;
+    }
+
+    std::string const path = cp.toString();
+    if (path.empty() || path.front() != '/' || root.hasOwner())
+    {
+        // the index only contains absolute paths from a root
+        return FindComponent(root, cp);
+    }
+
+    return index.find(root, rootVersion, path);
+}
+
 OpenSim::Component* osc::FindComponentMut(
     OpenSim::Component& c,
     OpenSim::ComponentPath const& cp)
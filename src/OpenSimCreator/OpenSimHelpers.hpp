@@ -29,7 +29,9 @@ namespace OpenSim { class Joint; }
 namespace OpenSim { class Mesh; }
 namespace OpenSim { class Model; }
 namespace OpenSim { class Muscle; }
+namespace osc { class ComponentPathIndex; }
 namespace osc { class UndoableModelStatePair; }
+namespace osc { class UID; }
 namespace SimTK { class State; }
 
 // OpenSimHelpers: a collection of various helper functions that are used by `osc`
@@ -184,6 +186,18 @@ namespace osc
         return dynamic_cast<T const*>(FindComponent(root, cp));
     }
 
+    // returns a pointer if the given path resolves a component relative to root
+    //
+    // absolute paths are resolved via the (lazily-built) index, rather than by traversing root's
+    // components, which is much faster for repeated lookups (e.g. once per frame). The index is
+    // rebuilt whenever `rootVersion` changes, so it must change whenever root's components are edited
+    OpenSim::Component const* FindComponent(
+        ComponentPathIndex&,
+        OpenSim::Component const& root,
+        UID rootVersion,
+        OpenSim::ComponentPath const&
+    );
+
     // returns a mutable pointer if the given path resolves a component relative to root
     OpenSim::Component* FindComponentMut(
         OpenSim::Component& root,
@@ -63,6 +63,11 @@ namespace osc
             return m_Output->getValueString(c, r);
         }
 
+        std::function<float(SimulationReport const&)> bindValueFloat(OpenSim::Component const& c) const final
+        {
+            return m_Output->bindValueFloat(c);
+        }
+
         size_t getHash() const final
         {
             return m_Output->getHash();
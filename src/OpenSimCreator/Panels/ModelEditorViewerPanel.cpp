@@ -377,7 +377,7 @@ private:
         {
             m_State.maybeHoveredComponent = osc::FindComponent(
                 m_Parameters.getModelSharedPtr()->getModel(),
-                m_State.maybeBaseLayerHittest->decorationID
+                m_State.maybeBaseLayerHittest->decorationID.str()
             );
         }
         else
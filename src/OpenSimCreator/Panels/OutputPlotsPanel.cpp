@@ -6,6 +6,7 @@
 #include "OpenSimCreator/Widgets/SimulationOutputPlot.hpp"
 #include "OpenSimCreator/OutputExtractor.hpp"
 
+#include <oscar/Bindings/ImGuiHelpers.hpp>
 #include <oscar/Panels/StandardPanel.hpp>
 #include <oscar/Platform/os.hpp>
 
@@ -73,6 +74,18 @@ private:
                     }
                 }
 
+                if (ImGui::MenuItem("as binary columns"))
+                {
+                    osc::TryPromptAndSaveAllUserDesiredOutputsAsColumnarBinary(*m_SimulatorUIAPI, osc::ColumnarBinaryCompression::None);
+                }
+                osc::DrawTooltipIfItemHovered("as binary columns", "Saves the numeric outputs as contiguous binary columns (.bcol), which is much faster to write and read than CSV, and smaller. Saved files can be loaded as plot overlays.");
+
+                if (ImGui::MenuItem("as binary columns (compressed)"))
+                {
+                    osc::TryPromptAndSaveAllUserDesiredOutputsAsColumnarBinary(*m_SimulatorUIAPI, osc::ColumnarBinaryCompression::ShuffledRunLength);
+                }
+                osc::DrawTooltipIfItemHovered("as binary columns (compressed)", "Same as 'as binary columns', but the columns are (losslessly) compressed, which is slower to write but typically produces smaller files.");
+
                 ImGui::EndPopup();
             }
         }
@@ -97,6 +97,18 @@ private:
                     }
                 }
 
+                if (ImGui::MenuItem("as binary columns"))
+                {
+                    osc::TryPromptAndSaveOutputsAsColumnarBinary(*m_SimulatorUIAPI, outputs, osc::ColumnarBinaryCompression::None);
+                }
+                osc::DrawTooltipIfItemHovered("as binary columns", "Saves the numeric outputs as contiguous binary columns (.bcol), which is much faster to write and read than CSV, and smaller. Saved files can be loaded as plot overlays.");
+
+                if (ImGui::MenuItem("as binary columns (compressed)"))
+                {
+                    osc::TryPromptAndSaveOutputsAsColumnarBinary(*m_SimulatorUIAPI, outputs, osc::ColumnarBinaryCompression::ShuffledRunLength);
+                }
+                osc::DrawTooltipIfItemHovered("as binary columns (compressed)", "Same as 'as binary columns', but the columns are (losslessly) compressed, which is slower to write but typically produces smaller files.");
+
                 ImGui::EndPopup();
             }
         }
@@ -43,7 +43,7 @@ private:
         std::optional<SceneCollision> const maybeCollision = m_Viewer.draw(*m_Model);
 
         OpenSim::Component const* maybeHover = maybeCollision ?
-            osc::FindComponent(m_Model->getModel(), maybeCollision->decorationID) :
+            osc::FindComponent(m_Model->getModel(), maybeCollision->decorationID.str()) :
             nullptr;
 
         // care: this code must check whether the hover != current hover (even if
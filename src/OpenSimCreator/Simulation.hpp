@@ -6,10 +6,12 @@
 #include "OpenSimCreator/SimulationReport.hpp"
 
 #include <oscar/Utils/SynchronizedValue.hpp>
+#include <oscar/Utils/UID.hpp>
 
 #include <nonstd/span.hpp>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace osc { class OutputExtractor; }
@@ -31,11 +33,13 @@ namespace osc
         {
         }
 
+        UID getID() const { return m_Simulation->getID(); }
         SynchronizedValueGuard<OpenSim::Model const> getModel() const { return m_Simulation->getModel(); }
 
         int getNumReports() { return m_Simulation->getNumReports(); }
         SimulationReport getSimulationReport(int reportIndex) { return m_Simulation->getSimulationReport(std::move(reportIndex)); }
-        std::vector<SimulationReport> getAllSimulationReports() const { return m_Simulation->getAllSimulationReports(); }
+        nonstd::span<SimulationReport const> getAllSimulationReports() const { return m_Simulation->getAllSimulationReports(); }
+        nonstd::span<double const> getReportTimes() const { return m_Simulation->getReportTimes(); }
 
         SimulationStatus getStatus() const { return m_Simulation->getStatus(); }
         SimulationClock::time_point getCurTime() { return m_Simulation->getCurTime(); }
@@ -44,6 +48,7 @@ namespace osc
         float getProgress() const { return m_Simulation->getProgress(); }
         ParamBlock const& getParams() const { return m_Simulation->getParams(); }
         nonstd::span<OutputExtractor const> getOutputs() const { return m_Simulation->getOutputExtractors(); }
+        std::optional<nonstd::span<float const>> getPrecomputedOutputValues(OutputExtractor const& output) const { return m_Simulation->getPrecomputedOutputValues(output); }
 
         void requestStop() { m_Simulation->requestStop(); }
         void stop() { m_Simulation->stop(); }
@@ -0,0 +1,139 @@
+#include "SimulationHelpers.hpp"
+
+#include "OpenSimCreator/SimulationClock.hpp"
+#include "OpenSimCreator/SimulationReport.hpp"
+#include "OpenSimCreator/VirtualSimulation.hpp"
+
+#include <nonstd/span.hpp>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <SimTKcommon.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+    double ToDouble(osc::SimulationClock::time_point t)
+    {
+        return t.time_since_epoch().count();
+    }
+
+    // returns `a + alpha*(b - a)`, element-wise
+    SimTK::Vector Lerp(SimTK::Vector const& a, SimTK::Vector const& b, double alpha)
+    {
+        SimTK::Vector rv = b;
+        rv -= a;
+        rv *= alpha;
+        rv += a;
+        return rv;
+    }
+}
+
+std::optional<size_t> osc::TryFindReportIndexAtOrAfter(
+    nonstd::span<double const> sortedTimes,
+    SimulationClock::time_point t)
+{
+    if (sortedTimes.empty())
+    {
+        return std::nullopt;
+    }
+
+    auto const it = std::lower_bound(sortedTimes.begin(), sortedTimes.end(), ToDouble(t));
+    if (it == sortedTimes.end())
+    {
+        return sortedTimes.size() - 1;
+    }
+    return static_cast<size_t>(std::distance(sortedTimes.begin(), it));
+}
+
+std::optional<osc::SimulationReport> osc::TryFindNthReportAfter(
+    VirtualSimulation& sim,
+    SimulationClock::time_point t,
+    int offset)
+{
+    nonstd::span<double const> const times = sim.getReportTimes();
+    std::optional<size_t> const zeroethReportIndex = TryFindReportIndexAtOrAfter(times, t);
+    if (!zeroethReportIndex)
+    {
+        return std::nullopt;
+    }
+
+    ptrdiff_t const reportIndex = static_cast<ptrdiff_t>(*zeroethReportIndex) + offset;
+    if (0 <= reportIndex && reportIndex < static_cast<ptrdiff_t>(times.size()))
+    {
+        return sim.getSimulationReport(static_cast<int>(reportIndex));
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+std::optional<osc::SimulationReport> osc::TryGetInterpolatedReport(
+    VirtualSimulation& sim,
+    SimulationClock::time_point t)
+{
+    nonstd::span<double const> const times = sim.getReportTimes();
+    std::optional<size_t> const maybeAfterIndex = TryFindReportIndexAtOrAfter(times, t);
+    if (!maybeAfterIndex)
+    {
+        return std::nullopt;
+    }
+    size_t const afterIndex = *maybeAfterIndex;
+
+    double const tAfter = times[afterIndex];
+    if (afterIndex == 0 || tAfter <= ToDouble(t))
+    {
+        // `t` is at a report, or outside the reports' time range: nothing to interpolate
+        return sim.getSimulationReport(static_cast<int>(afterIndex));
+    }
+
+    double const tBefore = times[afterIndex - 1];
+    double const alpha = (ToDouble(t) - tBefore) / (tAfter - tBefore);
+
+    // care: `times` may be invalidated by calls into the simulation
+    SimulationReport const before = sim.getSimulationReport(static_cast<int>(afterIndex - 1));
+    SimulationReport const after = sim.getSimulationReport(static_cast<int>(afterIndex));
+
+    SimTK::State st = before.getState();
+    st.setTime(ToDouble(t));
+    st.updQ() = Lerp(before.getState().getQ(), after.getState().getQ(), alpha);
+    st.updU() = Lerp(before.getState().getU(), after.getState().getU(), alpha);
+
+    // linearly-interpolated quaternions (e.g. from ball joints) aren't unit-length
+    sim.getModel()->getMatterSubsystem().normalizeQuaternions(st);
+
+    std::unordered_map<UID, float> auxiliaryValues;
+    for (auto const& [id, value] : before.getAuxiliaryValues())
+    {
+        auxiliaryValues.emplace(id, value);
+    }
+    return SimulationReport{std::move(st), std::move(auxiliaryValues)};
+}
+
+std::optional<osc::SimulationReport> osc::TryGetInterpolatedReport(
+    VirtualSimulation& sim,
+    SimulationClock::time_point t,
+    InterpolatedReportCache& cache)
+{
+    std::optional<size_t> const maybeAfterIndex = TryFindReportIndexAtOrAfter(sim.getReportTimes(), t);
+    if (!maybeAfterIndex)
+    {
+        return std::nullopt;
+    }
+
+    if (cache.report && cache.simulation == &sim && cache.time == t && cache.afterIndex == *maybeAfterIndex)
+    {
+        return cache.report;
+    }
+
+    cache.simulation = &sim;
+    cache.time = t;
+    cache.afterIndex = *maybeAfterIndex;
+    cache.report = TryGetInterpolatedReport(sim, t);
+    return cache.report;
+}
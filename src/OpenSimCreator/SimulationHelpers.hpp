@@ -0,0 +1,59 @@
+#pragma once
+
+#include "OpenSimCreator/SimulationClock.hpp"
+#include "OpenSimCreator/SimulationReport.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <optional>
+
+namespace osc { class VirtualSimulation; }
+
+namespace osc
+{
+    // returns the index of the first time in `sortedTimes` that is >= `t`, or the last index
+    // if all times are < `t`, or `std::nullopt` if `sortedTimes` is empty
+    //
+    // O(log n): `sortedTimes` must be sorted in ascending order (e.g. `VirtualSimulation::getReportTimes`)
+    std::optional<size_t> TryFindReportIndexAtOrAfter(
+        nonstd::span<double const> sortedTimes,
+        SimulationClock::time_point t
+    );
+
+    // returns the report that is `offset` reports away from the first report that is at, or
+    // after, `t` (or the last report, if all reports are before `t`)
+    std::optional<SimulationReport> TryFindNthReportAfter(
+        VirtualSimulation&,
+        SimulationClock::time_point t,
+        int offset = 0
+    );
+
+    // returns a report at exactly time `t`, where the generalized coordinates (Q) and speeds
+    // (U) are linearly interpolated between the reports either side of `t`
+    //
+    // this is only intended for visualization (e.g. smooth playback between reports): other
+    // state variables, and any auxiliary values, are taken from the report before `t`. If `t`
+    // is outside of the simulation's reports, the nearest report is returned as-is
+    std::optional<SimulationReport> TryGetInterpolatedReport(
+        VirtualSimulation&,
+        SimulationClock::time_point t
+    );
+
+    // the most recent report that was interpolated via `TryGetInterpolatedReport`
+    struct InterpolatedReportCache final {
+        VirtualSimulation const* simulation = nullptr;
+        SimulationClock::time_point time{};
+        size_t afterIndex = 0;
+        std::optional<SimulationReport> report;
+    };
+
+    // as above, but returns the cached report if it was interpolated at the same time between the
+    // same reports (e.g. on each frame while playback is paused), so that callers see the same
+    // report (and, therefore, state version) rather than a new one
+    std::optional<SimulationReport> TryGetInterpolatedReport(
+        VirtualSimulation&,
+        SimulationClock::time_point t,
+        InterpolatedReportCache&
+    );
+}
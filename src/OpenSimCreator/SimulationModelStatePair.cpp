@@ -1,5 +1,6 @@
 #include "SimulationModelStatePair.hpp"
 
+#include "OpenSimCreator/ComponentPathIndex.hpp"
 #include "OpenSimCreator/OpenSimHelpers.hpp"
 #include "OpenSimCreator/Simulation.hpp"
 #include "OpenSimCreator/SimulationReport.hpp"
@@ -51,7 +52,7 @@ public:
 
     OpenSim::Component const* getSelected() const
     {
-        return FindComponent(getModel(), m_Selected);
+        return FindComponent(m_PathIndex, getModel(), m_ModelVersion, m_Selected);
     }
 
     void setSelected(OpenSim::Component const* c)
@@ -61,7 +62,7 @@ public:
 
     OpenSim::Component const* getHovered() const
     {
-        return FindComponent(getModel(), m_Hovered);
+        return FindComponent(m_PathIndex, getModel(), m_ModelVersion, m_Hovered);
     }
 
     void setHovered(OpenSim::Component const* c)
@@ -114,6 +115,9 @@ private:
     OpenSim::ComponentPath m_Hovered;
     std::shared_ptr<Simulation> m_Simulation;
     SimulationReport m_SimulationReport;
+
+    // (a simulation's model isn't edited, so the index only changes when the simulation does)
+    mutable ComponentPathIndex m_PathIndex;
 };
 
 
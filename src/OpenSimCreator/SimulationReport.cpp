@@ -1,15 +1,23 @@
 #include "SimulationReport.hpp"
 
+#include "OpenSimCreator/SimulationReportStore.hpp"
+
 #include <SimTKcommon.h>
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 class osc::SimulationReport::Impl final {
 public:
-    Impl() = default;
+    Impl() :
+        m_State{SimTK::State{}}
+    {
+    }
 
     explicit Impl(SimTK::State&& st) :
         m_State{std::move(st)}
@@ -22,6 +30,12 @@ public:
     {
     }
 
+    Impl(std::shared_ptr<SimulationReportStore const> store, size_t reportIndex) :
+        m_Store{std::move(store)},
+        m_ReportIndex{reportIndex}
+    {
+    }
+
     std::unique_ptr<Impl> clone() const
     {
         return std::make_unique<Impl>(*this);
@@ -29,27 +43,77 @@ public:
 
     SimulationClock::time_point getTime() const
     {
-        return SimulationClock::start() + SimulationClock::duration{getState().getTime()};
+        double const t = m_Store ? m_Store->getTimes()[m_ReportIndex] : getState().getTime();
+        return SimulationClock::start() + SimulationClock::duration{t};
     }
 
     SimTK::State const& getState() const
     {
-        return m_State;
+        if (m_Store && !m_State)
+        {
+            // share the store's (immutable) restored state, rather than copying it
+            if (!m_RestoredState)
+            {
+                m_RestoredState = m_Store->restoreStateCached(m_ReportIndex);
+            }
+            return *m_RestoredState;
+        }
+        return *m_State;
     }
 
     SimTK::State& updStateHACK()
     {
-        return m_State;
+        if (m_Store && !m_State)
+        {
+            // the store's restored state may be shared with other reports, so edit a copy
+            m_State = getState();
+        }
+        return *m_State;
     }
 
     std::optional<float> getAuxiliaryValue(UID id) const
     {
+        if (m_Store)
+        {
+            return m_Store->getAuxiliaryValue(id, m_ReportIndex);
+        }
+
         auto it = m_AuxiliaryValues.find(id);
         return it != m_AuxiliaryValues.end() ? std::optional<float>{it->second} : std::nullopt;
     }
 
+    std::vector<std::pair<UID, float>> getAuxiliaryValues() const
+    {
+        std::vector<std::pair<UID, float>> rv;
+        if (m_Store)
+        {
+            for (UID const& id : m_Store->getAuxiliaryValueIDs())
+            {
+                if (std::optional<float> v = m_Store->getAuxiliaryValue(id, m_ReportIndex))
+                {
+                    rv.emplace_back(id, *v);
+                }
+            }
+        }
+        else
+        {
+            rv.assign(m_AuxiliaryValues.begin(), m_AuxiliaryValues.end());
+        }
+        return rv;
+    }
+
 private:
-    SimTK::State m_State;
+    // only set if the report is backed by a store
+    std::shared_ptr<SimulationReportStore const> m_Store;
+    size_t m_ReportIndex = 0;
+
+    // only set if the report is backed by a store and its state has been read: it's shared
+    // with the store (and other readers), so it must not be edited
+    mutable std::shared_ptr<SimTK::State const> m_RestoredState;
+
+    // set if the report isn't backed by a store, or if a store-backed report's state has been
+    // edited (via `updStateHACK`)
+    std::optional<SimTK::State> m_State;
     std::unordered_map<UID, float> m_AuxiliaryValues;
 };
 
@@ -69,6 +133,10 @@ osc::SimulationReport::SimulationReport(SimTK::State&& st, std::unordered_map<UI
     m_Impl{std::make_shared<Impl>(std::move(st), std::move(auxiliaryValues))}
 {
 }
+osc::SimulationReport::SimulationReport(std::shared_ptr<SimulationReportStore const> store, size_t reportIndex) :
+    m_Impl{std::make_shared<Impl>(std::move(store), reportIndex)}
+{
+}
 osc::SimulationReport::SimulationReport(SimulationReport const&) = default;
 osc::SimulationReport::SimulationReport(SimulationReport&&) noexcept = default;
 osc::SimulationReport& osc::SimulationReport::operator=(SimulationReport const&) = default;
@@ -94,3 +162,8 @@ std::optional<float> osc::SimulationReport::getAuxiliaryValue(UID id) const
 {
     return m_Impl->getAuxiliaryValue(std::move(id));
 }
+
+std::vector<std::pair<osc::UID, float>> osc::SimulationReport::getAuxiliaryValues() const
+{
+    return m_Impl->getAuxiliaryValues();
+}
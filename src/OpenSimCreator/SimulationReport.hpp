@@ -4,10 +4,14 @@
 
 #include <oscar/Utils/UID.hpp>
 
+#include <cstddef>
 #include <optional>
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+namespace osc { class SimulationReportStore; }
 namespace SimTK { class State; }
 
 namespace osc
@@ -18,6 +22,17 @@ namespace osc
         SimulationReport();
         explicit SimulationReport(SimTK::State&&);
         SimulationReport(SimTK::State&&, std::unordered_map<UID, float> auxiliaryValues);
+
+        // a report that's backed by a row in a (columnar) report store
+        //
+        // the report's `SimTK::State` is only rebuilt (via `SimulationReportStore::restoreStateCached`)
+        // when something first calls `getState`/`updStateHACK`, after which the report keeps it
+        // (`updStateHACK` edits a copy, so edits aren't seen by other reports). Times and auxiliary
+        // values are read directly from the store's columns
+        //
+        // care: the store isn't synchronized, so store-backed reports should only be used on
+        // the thread that appends to the store
+        SimulationReport(std::shared_ptr<SimulationReportStore const>, size_t reportIndex);
         SimulationReport(SimulationReport const&);
         SimulationReport(SimulationReport&&) noexcept;
         SimulationReport& operator=(SimulationReport const&);
@@ -28,6 +43,7 @@ namespace osc
         SimTK::State const& getState() const;
         SimTK::State& updStateHACK();  // necessary because of a bug in OpenSim PathWrap
         std::optional<float> getAuxiliaryValue(UID) const;
+        std::vector<std::pair<UID, float>> getAuxiliaryValues() const;
 
     private:
         friend bool operator==(SimulationReport const&, SimulationReport const&);
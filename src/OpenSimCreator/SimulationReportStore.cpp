@@ -0,0 +1,336 @@
+#include "SimulationReportStore.hpp"
+
+#include "OpenSimCreator/SimulationReport.hpp"
+
+#include <oscar/Utils/Assertions.hpp>
+#include <oscar/Utils/UID.hpp>
+
+#include <nonstd/span.hpp>
+#include <SimTKcommon.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // number of reports' worth of state variables that are held per chunk
+    //
+    // chunks are allocated up-front and never moved, so appending a report never
+    // requires copying previously-stored state variables
+    constexpr size_t c_NumReportsPerChunk = 256;
+
+    // value used to fill auxiliary columns for reports that didn't emit that value
+    constexpr float c_MissingAuxiliaryValue = std::numeric_limits<float>::quiet_NaN();
+
+    // maximum number of restored states that are kept by `restoreStateCached`
+    constexpr size_t c_MaxRecentlyRestoredStates = 8;
+}
+
+class osc::SimulationReportStore::Impl final {
+public:
+    explicit Impl(std::function<void(SimTK::State&)> stateRealizer) :
+        m_StateRealizer{std::move(stateRealizer)}
+    {
+    }
+
+    Impl(SimTK::State const& templateState, std::function<void(SimTK::State&)> stateRealizer) :
+        m_StateRealizer{std::move(stateRealizer)},
+        m_TemplateState{templateState},
+        m_NumStateVariables{static_cast<size_t>(templateState.getNY())}
+    {
+    }
+
+    size_t size() const
+    {
+        return m_Times.size();
+    }
+
+    bool empty() const
+    {
+        return m_Times.empty();
+    }
+
+    void reserve(size_t numReports)
+    {
+        m_ReservedCapacity = std::max(m_ReservedCapacity, numReports);
+        m_Times.reserve(m_ReservedCapacity);
+        m_StateVariableChunks.reserve((m_ReservedCapacity + c_NumReportsPerChunk - 1) / c_NumReportsPerChunk);
+        for (std::vector<float>& column : m_AuxiliaryColumns)
+        {
+            column.reserve(m_ReservedCapacity);
+        }
+    }
+
+    void append(SimulationReport const& report)
+    {
+        SimTK::State const& st = report.getState();
+
+        if (!m_TemplateState)
+        {
+            m_TemplateState = st;
+            m_NumStateVariables = static_cast<size_t>(st.getNY());
+        }
+        OSC_ASSERT(static_cast<size_t>(st.getNY()) == m_NumStateVariables && "all reports in a store must have the same number of state variables");
+
+        size_t const reportIndex = appendRow(st.getTime());
+
+        // state variables (Q, U, Z)
+        {
+            double* const dest = updStateVariablesPtr(reportIndex);
+            SimTK::Vector const& y = st.getY();
+            for (size_t i = 0; i < m_NumStateVariables; ++i)
+            {
+                dest[i] = y[static_cast<int>(i)];
+            }
+        }
+
+        // auxiliary columns
+        for (auto const& [id, value] : report.getAuxiliaryValues())
+        {
+            updAuxiliaryColumn(id)[reportIndex] = value;
+        }
+    }
+
+    void append(double time, nonstd::span<double const> stateVariables)
+    {
+        OSC_ASSERT(m_TemplateState && "a template state is required to append raw state variables: construct the store with one, or append a report first");
+        OSC_ASSERT(stateVariables.size() == m_NumStateVariables && "all reports in a store must have the same number of state variables");
+
+        size_t const reportIndex = appendRow(time);
+        std::copy(stateVariables.begin(), stateVariables.end(), updStateVariablesPtr(reportIndex));
+    }
+
+    nonstd::span<double const> getTimes() const
+    {
+        return m_Times;
+    }
+
+    size_t getNumStateVariables() const
+    {
+        return m_NumStateVariables;
+    }
+
+    nonstd::span<double const> getStateVariables(size_t reportIndex) const
+    {
+        OSC_ASSERT(reportIndex < size());
+        double const* const chunk = m_StateVariableChunks[reportIndex / c_NumReportsPerChunk].get();
+        return {chunk + (reportIndex % c_NumReportsPerChunk) * m_NumStateVariables, m_NumStateVariables};
+    }
+
+    nonstd::span<UID const> getAuxiliaryValueIDs() const
+    {
+        return m_AuxiliaryColumnIDs;
+    }
+
+    nonstd::span<float const> getAuxiliaryValues(UID id) const
+    {
+        auto const it = m_AuxiliaryColumnLookup.find(id);
+        return it != m_AuxiliaryColumnLookup.end() ? nonstd::span<float const>{m_AuxiliaryColumns[it->second]} : nonstd::span<float const>{};
+    }
+
+    std::optional<float> getAuxiliaryValue(UID id, size_t reportIndex) const
+    {
+        nonstd::span<float const> const column = getAuxiliaryValues(id);
+        if (reportIndex >= column.size() || std::isnan(column[reportIndex]))
+        {
+            return std::nullopt;
+        }
+        return column[reportIndex];
+    }
+
+    SimTK::State restoreState(size_t reportIndex) const
+    {
+        OSC_ASSERT(m_TemplateState && "cannot restore a state from an empty store");
+
+        nonstd::span<double const> const vals = getStateVariables(reportIndex);
+        SimTK::Vector y(static_cast<int>(vals.size()));
+        for (size_t i = 0; i < vals.size(); ++i)
+        {
+            y[static_cast<int>(i)] = vals[i];
+        }
+
+        SimTK::State rv = *m_TemplateState;
+        rv.setTime(m_Times[reportIndex]);
+        rv.setY(y);
+        rv.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+
+        if (m_StateRealizer)
+        {
+            m_StateRealizer(rv);
+        }
+
+        return rv;
+    }
+
+    std::shared_ptr<SimTK::State const> restoreStateCached(size_t reportIndex) const
+    {
+        std::lock_guard lock{m_RecentlyRestoredMutex};
+
+        // (most-recently-used last)
+        auto const it = std::find_if(m_RecentlyRestored.begin(), m_RecentlyRestored.end(), [reportIndex](auto const& entry)
+        {
+            return entry.first == reportIndex;
+        });
+        if (it != m_RecentlyRestored.end())
+        {
+            std::rotate(it, it + 1, m_RecentlyRestored.end());
+            return m_RecentlyRestored.back().second;
+        }
+
+        if (m_RecentlyRestored.size() >= c_MaxRecentlyRestoredStates)
+        {
+            m_RecentlyRestored.erase(m_RecentlyRestored.begin());
+        }
+        m_RecentlyRestored.emplace_back(reportIndex, std::make_shared<SimTK::State>(restoreState(reportIndex)));
+        return m_RecentlyRestored.back().second;
+    }
+
+private:
+    // appends a new row (time, uninitialized state variables, missing auxiliary values)
+    // and returns its index
+    size_t appendRow(double time)
+    {
+        size_t const reportIndex = size();
+
+        m_Times.push_back(time);
+
+        if (reportIndex % c_NumReportsPerChunk == 0)
+        {
+            m_StateVariableChunks.push_back(std::make_unique<double[]>(c_NumReportsPerChunk * m_NumStateVariables));
+        }
+
+        for (std::vector<float>& column : m_AuxiliaryColumns)
+        {
+            column.push_back(c_MissingAuxiliaryValue);
+        }
+
+        return reportIndex;
+    }
+
+    double* updStateVariablesPtr(size_t reportIndex)
+    {
+        double* const chunk = m_StateVariableChunks[reportIndex / c_NumReportsPerChunk].get();
+        return chunk + (reportIndex % c_NumReportsPerChunk) * m_NumStateVariables;
+    }
+
+    std::vector<float>& updAuxiliaryColumn(UID id)
+    {
+        auto [it, inserted] = m_AuxiliaryColumnLookup.try_emplace(id, m_AuxiliaryColumns.size());
+        if (inserted)
+        {
+            // new column: backfill earlier reports with "missing"
+            m_AuxiliaryColumnIDs.push_back(id);
+            std::vector<float>& column = m_AuxiliaryColumns.emplace_back();
+            column.reserve(std::max(m_ReservedCapacity, size() + 1));
+            column.resize(size(), c_MissingAuxiliaryValue);
+        }
+        return m_AuxiliaryColumns[it->second];
+    }
+
+    std::function<void(SimTK::State&)> m_StateRealizer;
+    std::optional<SimTK::State> m_TemplateState;
+    size_t m_NumStateVariables = 0;
+    size_t m_ReservedCapacity = 0;
+
+    std::vector<double> m_Times;
+    std::vector<std::unique_ptr<double[]>> m_StateVariableChunks;
+
+    std::vector<UID> m_AuxiliaryColumnIDs;
+    std::vector<std::vector<float>> m_AuxiliaryColumns;
+    std::unordered_map<UID, size_t> m_AuxiliaryColumnLookup;
+
+    mutable std::mutex m_RecentlyRestoredMutex;
+    mutable std::vector<std::pair<size_t, std::shared_ptr<SimTK::State const>>> m_RecentlyRestored;
+};
+
+
+// public API (PIMPL)
+
+osc::SimulationReportStore::SimulationReportStore(std::function<void(SimTK::State&)> stateRealizer) :
+    m_Impl{std::make_unique<Impl>(std::move(stateRealizer))}
+{
+}
+osc::SimulationReportStore::SimulationReportStore(
+    SimTK::State const& templateState,
+    std::function<void(SimTK::State&)> stateRealizer) :
+
+    m_Impl{std::make_unique<Impl>(templateState, std::move(stateRealizer))}
+{
+}
+osc::SimulationReportStore::SimulationReportStore(SimulationReportStore&&) noexcept = default;
+osc::SimulationReportStore& osc::SimulationReportStore::operator=(SimulationReportStore&&) noexcept = default;
+osc::SimulationReportStore::~SimulationReportStore() noexcept = default;
+
+size_t osc::SimulationReportStore::size() const
+{
+    return m_Impl->size();
+}
+
+bool osc::SimulationReportStore::empty() const
+{
+    return m_Impl->empty();
+}
+
+void osc::SimulationReportStore::reserve(size_t numReports)
+{
+    m_Impl->reserve(numReports);
+}
+
+void osc::SimulationReportStore::append(SimulationReport const& report)
+{
+    m_Impl->append(report);
+}
+
+void osc::SimulationReportStore::append(double time, nonstd::span<double const> stateVariables)
+{
+    m_Impl->append(time, stateVariables);
+}
+
+nonstd::span<double const> osc::SimulationReportStore::getTimes() const
+{
+    return m_Impl->getTimes();
+}
+
+size_t osc::SimulationReportStore::getNumStateVariables() const
+{
+    return m_Impl->getNumStateVariables();
+}
+
+nonstd::span<double const> osc::SimulationReportStore::getStateVariables(size_t reportIndex) const
+{
+    return m_Impl->getStateVariables(reportIndex);
+}
+
+nonstd::span<osc::UID const> osc::SimulationReportStore::getAuxiliaryValueIDs() const
+{
+    return m_Impl->getAuxiliaryValueIDs();
+}
+
+nonstd::span<float const> osc::SimulationReportStore::getAuxiliaryValues(UID id) const
+{
+    return m_Impl->getAuxiliaryValues(id);
+}
+
+std::optional<float> osc::SimulationReportStore::getAuxiliaryValue(UID id, size_t reportIndex) const
+{
+    return m_Impl->getAuxiliaryValue(id, reportIndex);
+}
+
+SimTK::State osc::SimulationReportStore::restoreState(size_t reportIndex) const
+{
+    return m_Impl->restoreState(reportIndex);
+}
+
+std::shared_ptr<SimTK::State> osc::SimulationReportStore::restoreStateCached(size_t reportIndex) const
+{
+    return m_Impl->restoreStateCached(reportIndex);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <oscar/Utils/UID.hpp>
+
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace osc { class SimulationReport; }
+namespace SimTK { class State; }
+
+namespace osc
+{
+    // an append-only, columnar, store of simulation reports
+    //
+    // rather than holding onto a full `SimTK::State` per report, the store keeps:
+    //
+    // - one time column
+    // - one contiguous block of state variable values (Q, U, and Z) per report, held
+    //   in fixed-size chunks, so that appending never moves previously-stored data
+    // - one column per auxiliary value (e.g. wall time, integrator step count)
+    //
+    // callers that only need times or auxiliary values (plots of integrator stats,
+    // scrubbing, etc.) can read the columns directly via the span-based accessors. A
+    // full `SimTK::State` is only rebuilt (`restoreState`) when something actually
+    // needs one (e.g. a viewer showing the model at a particular report)
+    //
+    // care: the store is not internally synchronized, and any span returned by an
+    // accessor is only valid until the next call to `append`
+    class SimulationReportStore final {
+    public:
+        // `stateRealizer` is called on each state that's rebuilt by `restoreState`,
+        // which gives callers a chance to realize it against an appropriate model
+        explicit SimulationReportStore(std::function<void(SimTK::State&)> stateRealizer = {});
+
+        // a store that uses the provided state as its "template" state (see `append`), which
+        // means that raw state variables can be appended to it without first appending a report
+        explicit SimulationReportStore(
+            SimTK::State const& templateState,
+            std::function<void(SimTK::State&)> stateRealizer = {}
+        );
+        SimulationReportStore(SimulationReportStore const&) = delete;
+        SimulationReportStore(SimulationReportStore&&) noexcept;
+        SimulationReportStore& operator=(SimulationReportStore const&) = delete;
+        SimulationReportStore& operator=(SimulationReportStore&&) noexcept;
+        ~SimulationReportStore() noexcept;
+
+        size_t size() const;
+        bool empty() const;
+
+        // preallocates the columns for (at least) `numReports` reports, so that appending
+        // up to that many reports doesn't reallocate them (e.g. if the caller knows how
+        // many reports a simulation is going to produce)
+        void reserve(size_t numReports);
+
+        // appends the state variables, time, and auxiliary values of the report
+        //
+        // the first appended report's state is retained as a "template" state, which
+        // is used to rebuild subsequent states, so all reports must come from the same
+        // underlying system
+        void append(SimulationReport const&);
+
+        // appends a report with the given time and state variables (Y), and no auxiliary values
+        //
+        // requires that the store already has a template state, and that `stateVariables` has
+        // the same number of elements as the template state's Y
+        void append(double time, nonstd::span<double const> stateVariables);
+
+        nonstd::span<double const> getTimes() const;
+        size_t getNumStateVariables() const;
+        nonstd::span<double const> getStateVariables(size_t reportIndex) const;
+        nonstd::span<UID const> getAuxiliaryValueIDs() const;
+        nonstd::span<float const> getAuxiliaryValues(UID) const;  // empty if the ID isn't in the store
+        std::optional<float> getAuxiliaryValue(UID, size_t reportIndex) const;
+
+        // rebuilds a full (realized, if a realizer was provided) `SimTK::State` for
+        // the given report
+        SimTK::State restoreState(size_t reportIndex) const;
+
+        // like `restoreState`, but the store keeps a few of the most-recently-restored states, so
+        // that repeatedly restoring the same reports (e.g. the one a viewer is showing) doesn't
+        // rebuild them each time, without keeping every restored state in memory
+        //
+        // the returned state is shared with other callers, so it's immutable: callers that need
+        // to edit it must edit a copy
+        std::shared_ptr<SimTK::State const> restoreStateCached(size_t reportIndex) const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
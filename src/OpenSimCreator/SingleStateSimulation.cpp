@@ -28,7 +28,12 @@ public:
         throw std::runtime_error{"invalid method call on a SingleStateSimulation"};
     }
 
-    std::vector<SimulationReport> getAllSimulationReports() const
+    nonstd::span<SimulationReport const> getAllSimulationReports() const
+    {
+        return {};
+    }
+
+    nonstd::span<double const> getReportTimes() const
     {
         return {};
     }
@@ -117,11 +122,16 @@ osc::SimulationReport osc::SingleStateSimulation::implGetSimulationReport(int re
     return m_Impl->getSimulationReport(reportIndex);
 }
 
-std::vector<osc::SimulationReport> osc::SingleStateSimulation::implGetAllSimulationReports() const
+nonstd::span<osc::SimulationReport const> osc::SingleStateSimulation::implGetAllSimulationReports() const
 {
     return m_Impl->getAllSimulationReports();
 }
 
+nonstd::span<double const> osc::SingleStateSimulation::implGetReportTimes() const
+{
+    return m_Impl->getReportTimes();
+}
+
 osc::SimulationStatus osc::SingleStateSimulation::implGetStatus() const
 {
     return m_Impl->getStatus();
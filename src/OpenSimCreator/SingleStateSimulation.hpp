@@ -31,7 +31,8 @@ namespace osc
 
         int implGetNumReports() const final;
         SimulationReport implGetSimulationReport(int reportIndex) const final;
-        std::vector<SimulationReport> implGetAllSimulationReports() const final;
+        nonstd::span<SimulationReport const> implGetAllSimulationReports() const final;
+        nonstd::span<double const> implGetReportTimes() const final;
 
         SimulationStatus implGetStatus() const final;
         SimulationClock::time_point implGetCurTime() const final;
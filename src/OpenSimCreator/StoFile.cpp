@@ -0,0 +1,363 @@
+#include "StoFile.hpp"
+
+#include <oscar/Platform/MemoryMappedFile.hpp>
+#include <oscar/Utils/Algorithms.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    bool EqualsCaseInsensitive(std::string_view a, std::string_view b)
+    {
+        auto const equalsIgnoringCase = [](char c1, char c2)
+        {
+            return std::tolower(static_cast<unsigned char>(c1)) == std::tolower(static_cast<unsigned char>(c2));
+        };
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), equalsIgnoringCase);
+    }
+
+    bool IsWhitespace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+    }
+
+    // pops the next line (excluding any trailing '\r' or '\n') from the front of `content`
+    std::string_view PopLine(std::string_view& content)
+    {
+        size_t const newlinePos = content.find('\n');
+        std::string_view line = content.substr(0, newlinePos);
+        content = newlinePos == std::string_view::npos ? std::string_view{} : content.substr(newlinePos + 1);
+
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+        return line;
+    }
+
+    // pops the next whitespace-delimited token from the front of `line`
+    std::string_view PopToken(std::string_view& line)
+    {
+        size_t i = 0;
+        while (i < line.size() && IsWhitespace(line[i]))
+        {
+            ++i;
+        }
+        size_t const start = i;
+        while (i < line.size() && !IsWhitespace(line[i]))
+        {
+            ++i;
+        }
+        std::string_view const token = line.substr(start, i - start);
+        line = line.substr(i);
+        return token;
+    }
+
+    // tries to parse `token` as a decimal floating point number via the "fast path" (e.g.
+    // Clinger, 1990), which is exact when the decimal significand fits in 53 bits and the
+    // decimal exponent is small enough that the power of ten is exactly representable
+    //
+    // returns `std::nullopt` if the fast path doesn't apply (the caller should fall back
+    // to a slower, but fully general, parser)
+    std::optional<double> TryParseDoubleFastPath(std::string_view token)
+    {
+        static constexpr std::array<double, 23> c_ExactPowersOfTen =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+        };
+        static constexpr uint64_t c_MaxExactSignificand = uint64_t{1} << 53;
+
+        size_t i = 0;
+        bool negative = false;
+        if (i < token.size() && (token[i] == '-' || token[i] == '+'))
+        {
+            negative = token[i] == '-';
+            ++i;
+        }
+
+        uint64_t significand = 0;
+        int numSignificandDigits = 0;
+        int exponent = 0;
+        bool anyDigits = false;
+
+        // integer part
+        for (; i < token.size() && '0' <= token[i] && token[i] <= '9'; ++i)
+        {
+            anyDigits = true;
+            if (significand == 0 && token[i] == '0')
+            {
+                continue;  // leading zero
+            }
+            if (++numSignificandDigits > 19)
+            {
+                return std::nullopt;  // significand might overflow
+            }
+            significand = 10*significand + static_cast<uint64_t>(token[i] - '0');
+        }
+
+        // fractional part
+        if (i < token.size() && token[i] == '.')
+        {
+            ++i;
+            for (; i < token.size() && '0' <= token[i] && token[i] <= '9'; ++i)
+            {
+                anyDigits = true;
+                --exponent;
+                if (significand == 0 && token[i] == '0')
+                {
+                    continue;  // leading zero
+                }
+                if (++numSignificandDigits > 19)
+                {
+                    return std::nullopt;  // significand might overflow
+                }
+                significand = 10*significand + static_cast<uint64_t>(token[i] - '0');
+            }
+        }
+
+        if (!anyDigits)
+        {
+            return std::nullopt;  // e.g. "nan", "inf"
+        }
+
+        // exponent part
+        if (i < token.size() && (token[i] == 'e' || token[i] == 'E'))
+        {
+            ++i;
+            bool negativeExponent = false;
+            if (i < token.size() && (token[i] == '-' || token[i] == '+'))
+            {
+                negativeExponent = token[i] == '-';
+                ++i;
+            }
+
+            int explicitExponent = 0;
+            bool anyExponentDigits = false;
+            for (; i < token.size() && '0' <= token[i] && token[i] <= '9'; ++i)
+            {
+                anyExponentDigits = true;
+                if (explicitExponent > 1000)
+                {
+                    return std::nullopt;  // way outside of the fast path's range
+                }
+                explicitExponent = 10*explicitExponent + (token[i] - '0');
+            }
+            if (!anyExponentDigits)
+            {
+                return std::nullopt;
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        }
+
+        if (i != token.size())
+        {
+            return std::nullopt;  // trailing junk
+        }
+
+        if (significand > c_MaxExactSignificand || exponent < -22 || exponent > 22)
+        {
+            return std::nullopt;  // the result might not be exact
+        }
+
+        double v = static_cast<double>(significand);
+        if (exponent < 0)
+        {
+            v /= c_ExactPowersOfTen[static_cast<size_t>(-exponent)];
+        }
+        else
+        {
+            v *= c_ExactPowersOfTen[static_cast<size_t>(exponent)];
+        }
+        return negative ? -v : v;
+    }
+
+    std::optional<double> TryParseDouble(std::string_view token)
+    {
+        if (std::optional<double> const fast = TryParseDoubleFastPath(token))
+        {
+            return fast;
+        }
+
+        // slow path: handles everything else (long significands, large exponents, nan, inf)
+        std::string const nullTerminated{token};
+        char* end = nullptr;
+        double const v = std::strtod(nullTerminated.c_str(), &end);
+        if (end != nullTerminated.c_str() + nullTerminated.size())
+        {
+            return std::nullopt;
+        }
+        return v;
+    }
+
+    [[noreturn]] void ThrowParseError(size_t lineNumber, std::string_view reason)
+    {
+        std::stringstream ss;
+        ss << "line " << lineNumber << ": " << reason;
+        throw std::runtime_error{std::move(ss).str()};
+    }
+
+    // parses the header (everything up to, and including, `endheader`)
+    void ParseHeader(std::string_view& content, size_t& lineNumber, osc::StoFileContents& out)
+    {
+        while (!content.empty())
+        {
+            std::string_view const line = osc::TrimLeadingAndTrailingWhitespace(PopLine(content));
+            ++lineNumber;
+
+            if (EqualsCaseInsensitive(line, "endheader"))
+            {
+                return;
+            }
+
+            size_t const equalsPos = line.find('=');
+            if (equalsPos != std::string_view::npos)
+            {
+                std::string_view const key = osc::TrimLeadingAndTrailingWhitespace(line.substr(0, equalsPos));
+                std::string_view const value = osc::TrimLeadingAndTrailingWhitespace(line.substr(equalsPos + 1));
+                if (EqualsCaseInsensitive(key, "inDegrees"))
+                {
+                    out.inDegrees = EqualsCaseInsensitive(value, "yes");
+                }
+            }
+        }
+        ThrowParseError(lineNumber, "the file does not contain an 'endheader' line");
+    }
+
+    // parses the column labels line (the first non-empty line after the header)
+    void ParseColumnLabels(std::string_view& content, size_t& lineNumber, osc::StoFileContents& out)
+    {
+        std::string_view line;
+        while (line.empty() && !content.empty())
+        {
+            line = osc::TrimLeadingAndTrailingWhitespace(PopLine(content));
+            ++lineNumber;
+        }
+
+        // labels are tab-delimited (so they may contain spaces), but older files might use spaces
+        char const delimiter = line.find('\t') != std::string_view::npos ? '\t' : ' ';
+        std::vector<std::string> labels;
+        while (!line.empty())
+        {
+            size_t const delimiterPos = line.find(delimiter);
+            std::string_view const label = osc::TrimLeadingAndTrailingWhitespace(line.substr(0, delimiterPos));
+            if (!label.empty())
+            {
+                labels.emplace_back(label);
+            }
+            line = delimiterPos == std::string_view::npos ? std::string_view{} : line.substr(delimiterPos + 1);
+        }
+
+        if (labels.empty() || !EqualsCaseInsensitive(labels.front(), "time"))
+        {
+            ThrowParseError(lineNumber, "the first column of the file is not a 'time' column");
+        }
+
+        out.columnLabels.assign(std::make_move_iterator(labels.begin() + 1), std::make_move_iterator(labels.end()));
+        out.columns.resize(out.columnLabels.size());
+    }
+
+    void ParseRows(std::string_view content, size_t& lineNumber, osc::StoFileContents& out)
+    {
+        size_t const numColumns = out.columns.size();
+
+        // use the first row's length to guess how many rows the file has, so that the
+        // columns don't have to repeatedly reallocate as rows are parsed
+        {
+            std::string_view remaining = content;
+            std::string_view firstRow;
+            while (firstRow.empty() && !remaining.empty())
+            {
+                firstRow = osc::TrimLeadingAndTrailingWhitespace(PopLine(remaining));
+            }
+            if (!firstRow.empty())
+            {
+                size_t const estimatedNumRows = content.size() / (firstRow.size() + 1) + 1;
+                out.times.reserve(estimatedNumRows);
+                for (std::vector<double>& column : out.columns)
+                {
+                    column.reserve(estimatedNumRows);
+                }
+            }
+        }
+
+        while (!content.empty())
+        {
+            std::string_view line = PopLine(content);
+            ++lineNumber;
+
+            std::string_view token = PopToken(line);
+            if (token.empty())
+            {
+                continue;  // skip blank lines
+            }
+
+            std::optional<double> const time = TryParseDouble(token);
+            if (!time)
+            {
+                ThrowParseError(lineNumber, "cannot parse time value");
+            }
+            out.times.push_back(*time);
+
+            for (size_t column = 0; column < numColumns; ++column)
+            {
+                token = PopToken(line);
+                if (token.empty())
+                {
+                    ThrowParseError(lineNumber, "the row has fewer values than there are column labels");
+                }
+
+                std::optional<double> const value = TryParseDouble(token);
+                if (!value)
+                {
+                    ThrowParseError(lineNumber, "cannot parse a value in the row");
+                }
+                out.columns[column].push_back(*value);
+            }
+
+            if (!PopToken(line).empty())
+            {
+                ThrowParseError(lineNumber, "the row has more values than there are column labels");
+            }
+        }
+    }
+}
+
+osc::StoFileContents osc::ParseStoFile(std::string_view content)
+{
+    StoFileContents rv;
+    size_t lineNumber = 0;
+    ParseHeader(content, lineNumber, rv);
+    ParseColumnLabels(content, lineNumber, rv);
+    ParseRows(content, lineNumber, rv);
+    return rv;
+}
+
+osc::StoFileContents osc::ReadStoFile(std::filesystem::path const& p)
+{
+    MemoryMappedFile const file{p};
+    try
+    {
+        return ParseStoFile(file.getChars());
+    }
+    catch (std::exception const& ex)
+    {
+        std::stringstream ss;
+        ss << p.string() << ": " << ex.what();
+        throw std::runtime_error{std::move(ss).str()};
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace osc
+{
+    // the (columnar) numeric contents of an OpenSim STO/MOT file
+    struct StoFileContents final {
+
+        size_t getNumRows() const { return times.size(); }
+
+        // column labels (excluding the leading `time` column)
+        std::vector<std::string> columnLabels;
+
+        // `true` if the header contains `inDegrees=yes`
+        bool inDegrees = false;
+
+        // the `time` column
+        std::vector<double> times;
+
+        // one column per label, each containing one value per row
+        std::vector<std::vector<double>> columns;
+    };
+
+    // parses the content of an OpenSim STO/MOT file
+    //
+    // throws a `std::runtime_error` if the content cannot be parsed (e.g. no `endheader`
+    // line, the first column isn't `time`, or a row has the wrong number of values)
+    StoFileContents ParseStoFile(std::string_view content);
+
+    // memory-maps and parses the given STO/MOT file
+    //
+    // the file is parsed directly from the mapping (i.e. without first reading it into a
+    // buffer), and with a fast number parser, so that large files with many (e.g. micro-
+    // sampled) rows can be loaded at their native resolution
+    StoFileContents ReadStoFile(std::filesystem::path const&);
+}
@@ -1,10 +1,13 @@
 #include "StoFileSimulation.hpp"
 
+#include "OpenSimCreator/BasicModelStatePair.hpp"
 #include "OpenSimCreator/OpenSimHelpers.hpp"
 #include "OpenSimCreator/ParamBlock.hpp"
 #include "OpenSimCreator/SimulationClock.hpp"
 #include "OpenSimCreator/SimulationReport.hpp"
+#include "OpenSimCreator/SimulationReportStore.hpp"
 #include "OpenSimCreator/SimulationStatus.hpp"
+#include "OpenSimCreator/StoFile.hpp"
 
 #include <oscar/Platform/Log.hpp>
 #include <oscar/Utils/Algorithms.hpp>
@@ -15,12 +18,9 @@
 #include <OpenSim/Common/Array.h>
 #include <OpenSim/Common/Component.h>
 #include <OpenSim/Common/ComponentList.h>
-#include <OpenSim/Common/StateVector.h>
-#include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
-#include <OpenSim/Simulation/SimbodyEngine/SimbodyEngine.h>
 #include <SimTKcommon.h>
 #include <SimTKcommon/Orientation.h>
 #include <SimTKcommon/Scalar.h>
@@ -84,22 +84,33 @@ namespace
         return NumUniqueEntriesIn(v) == v.size();
     }
 
+    // returns the STO file's column labels, including the leading `time` column, in the
+    // format that OpenSim's label-matching APIs expect
+    OpenSim::Array<std::string> GetColumnLabelsIncludingTime(osc::StoFileContents const& sto)
+    {
+        OpenSim::Array<std::string> rv;
+        rv.ensureCapacity(static_cast<int>(sto.columnLabels.size()) + 1);
+        rv.append("time");
+        for (std::string const& label : sto.columnLabels)
+        {
+            rv.append(label);
+        }
+        return rv;
+    }
+
     std::unordered_map<int, int> CreateStorageIndexToModelSvIndexLUT(
         OpenSim::Model const& model,
-        OpenSim::Storage const& storage)
+        osc::StoFileContents const& sto)
     {
         std::unordered_map<int, int> rv;
 
-        if (storage.getColumnLabels().size() <= 1)
+        if (sto.columnLabels.empty())
         {
             osc::log::warn("the provided STO file does not contain any state variable data");
             return rv;
         }
 
-        if (!osc::IsEqualCaseInsensitive(storage.getColumnLabels()[0], "time"))
-        {
-            throw std::runtime_error{"the provided STO file does not contain a 'time' column as its first column: it cannot be processed"};
-        }
+        // (the parser has already checked that the first column is `time`)
 
         // care: the storage column labels do not match the state variable names
         // in the model 1:1
@@ -108,7 +119,7 @@ namespace
         // etc for the column labels, so you *need* to map the storage column strings
         // carefully onto the model statevars
         std::vector<std::string> missing;
-        OpenSim::Array<std::string> const& storageColumnsIncludingTime = storage.getColumnLabels();
+        OpenSim::Array<std::string> const storageColumnsIncludingTime = GetColumnLabelsIncludingTime(sto);
         OpenSim::Array<std::string> modelStateVars = model.getStateVariableNames();
 
         if (!AllElementsUnique(storageColumnsIncludingTime))
@@ -155,24 +166,58 @@ namespace
         return rv;
     }
 
-    std::vector<osc::SimulationReport> ExtractReports(
-        OpenSim::Model& model,
-        std::filesystem::path const& stoFilePath)
+    // returns the indices (in `model.getStateVariableNames()`) of state variables that are
+    // affected by an STO file's `inDegrees` flag (i.e. rotational coordinate values + speeds)
+    std::unordered_set<int> GetRotationalStateVariableIndices(OpenSim::Model const& model)
     {
-        OpenSim::Storage storage{stoFilePath.string()};
+        std::unordered_set<std::string> rotationalStateVariableNames;
+        for (OpenSim::Coordinate const& c : model.getComponentList<OpenSim::Coordinate>())
+        {
+            if (c.getMotionType() == OpenSim::Coordinate::Rotational)
+            {
+                rotationalStateVariableNames.insert(c.getAbsolutePathString() + "/value");
+                rotationalStateVariableNames.insert(c.getAbsolutePathString() + "/speed");
+            }
+        }
 
-        if (storage.isInDegrees())
+        std::unordered_set<int> rv;
+        OpenSim::Array<std::string> const modelStateVars = model.getStateVariableNames();
+        for (int i = 0; i < modelStateVars.size(); ++i)
         {
-            model.getSimbodyEngine().convertDegreesToRadians(storage);
+            if (rotationalStateVariableNames.find(modelStateVars[i]) != rotationalStateVariableNames.end())
+            {
+                rv.insert(i);
+            }
         }
+        return rv;
+    }
 
-        // TODO: some files can contain thousands of micro-sampled states from OpenSim-GUI
-        //
-        // the fix for this is to implement a faster way of holding sequences of model states
-        storage.resampleLinear(1.0/100.0);
+    // loads the STO file into a (columnar) report store
+    //
+    // the file's rows are loaded at their native resolution: full `SimTK::State`s are only
+    // rebuilt (+ realized) by the store when something requests a particular report
+    std::shared_ptr<osc::SimulationReportStore> ExtractReports(
+        OpenSim::Model& model,
+        std::filesystem::path const& stoFilePath)
+    {
+        osc::StoFileContents const sto = osc::ReadStoFile(stoFilePath);
 
-        std::unordered_map<int, int> lut =
-            CreateStorageIndexToModelSvIndexLUT(model, storage);
+        std::unordered_map<int, int> const lut =
+            CreateStorageIndexToModelSvIndexLUT(model, sto);
+
+        // if necessary, figure out which columns need to be converted from degrees to radians
+        std::vector<double> columnScaleFactors(sto.columnLabels.size(), 1.0);
+        if (sto.inDegrees)
+        {
+            std::unordered_set<int> const rotationalStateVars = GetRotationalStateVariableIndices(model);
+            for (auto [valueIdx, modelIdx] : lut)
+            {
+                if (rotationalStateVars.find(modelIdx) != rotationalStateVars.end())
+                {
+                    columnScaleFactors.at(valueIdx) = SimTK_DEGREE_TO_RADIAN;
+                }
+            }
+        }
 
         // temporarily unlock coords
         std::vector<OpenSim::Coordinate*> lockedCoords = GetLockedCoordinates(model);
@@ -182,36 +227,60 @@ namespace
         osc::InitializeModel(model);
         osc::InitializeState(model);
 
-        std::vector<osc::SimulationReport> rv;
-        rv.reserve(storage.getSize());
-
-        for (int row = 0; row < storage.getSize(); ++row)
+        // care: the model's state variable order (which the LUT maps into) isn't the same
+        // as the order of the state's Y vector, so each row is written into a scratch state
+        // via OpenSim's API and then read back out as Y
+        SimTK::State scratchState = model.getWorkingState();
+        SimTK::Vector const defaultStateVals = model.getStateVariableValues(scratchState);
+        //
+        // the store's reports can outlive this model (and the simulation that owns it), so
+        // restored states are realized against the store's own (immutable) copy of the model
+        auto realizerModel = std::make_shared<osc::BasicModelStatePair const>(model, scratchState);
+        auto rv = std::make_shared<osc::SimulationReportStore>(scratchState, [realizerModel](SimTK::State& st)
         {
-            OpenSim::StateVector* sv = storage.getStateVector(row);
-            OpenSim::Array<double> const& cols = sv->getData();
+            realizerModel->getModel().realizeReport(st);
+        });
+        rv->reserve(sto.getNumRows());
 
-            SimTK::Vector stateValsBuf = model.getStateVariableValues(model.getWorkingState());
+        SimTK::Vector stateValsBuf = defaultStateVals;
+        std::vector<double> yBuf(static_cast<size_t>(scratchState.getNY()));
+        for (size_t row = 0; row < sto.getNumRows(); ++row)
+        {
             for (auto [valueIdx, modelIdx] : lut)
             {
-                if (0 <= valueIdx && valueIdx < cols.size() && 0 <= modelIdx && modelIdx < stateValsBuf.size())
+                if (0 <= valueIdx && static_cast<size_t>(valueIdx) < sto.columns.size() && 0 <= modelIdx && modelIdx < stateValsBuf.size())
                 {
-                    stateValsBuf[modelIdx] = cols[valueIdx];
+                    stateValsBuf[modelIdx] = columnScaleFactors[valueIdx] * sto.columns[valueIdx][row];
                 }
                 else
                 {
                     throw std::runtime_error{"an index in the stroage lookup was invalid: this is probably a developer error that needs to be investigated (report it)"};
                 }
             }
+            model.setStateVariableValues(scratchState, stateValsBuf);
 
-            osc::SimulationReport& report = rv.emplace_back(SimTK::State{model.getWorkingState()});
-            SimTK::State& st = report.updStateHACK();
-            st.setTime(sv->getTime());
-            model.setStateVariableValues(st, stateValsBuf);
-            model.realizeReport(st);
+            SimTK::Vector const& y = scratchState.getY();
+            for (size_t i = 0; i < yBuf.size(); ++i)
+            {
+                yBuf[i] = y[static_cast<int>(i)];
+            }
+            rv->append(sto.times[row], yBuf);
         }
 
         return rv;
     }
+
+    // returns store-backed reports for each report in the store
+    std::vector<osc::SimulationReport> CreateStoreBackedReports(std::shared_ptr<osc::SimulationReportStore const> const& store)
+    {
+        std::vector<osc::SimulationReport> rv;
+        rv.reserve(store->size());
+        for (size_t i = 0; i < store->size(); ++i)
+        {
+            rv.emplace_back(store, i);
+        }
+        return rv;
+    }
 }
 
 class osc::StoFileSimulation::Impl final {
@@ -222,7 +291,7 @@ public:
         float fixupScaleFactor) :
 
         m_Model{std::move(model)},
-        m_SimulationReports{ExtractReports(*m_Model, stoFilePath)},
+        m_ReportStore{ExtractReports(*m_Model, stoFilePath)},
         m_FixupScaleFactor{std::move(fixupScaleFactor)}
     {
     }
@@ -242,11 +311,16 @@ public:
         return m_SimulationReports.at(reportIndex);
     }
 
-    std::vector<SimulationReport> getAllSimulationReports() const
+    nonstd::span<SimulationReport const> getAllSimulationReports() const
     {
         return m_SimulationReports;
     }
 
+    nonstd::span<double const> getReportTimes() const
+    {
+        return m_ReportStore->getTimes();
+    }
+
     SimulationStatus getStatus() const
     {
         return SimulationStatus::Completed;
@@ -305,7 +379,8 @@ public:
 private:
     mutable std::mutex m_ModelMutex;
     std::unique_ptr<OpenSim::Model> m_Model;
-    std::vector<SimulationReport> m_SimulationReports;
+    std::shared_ptr<SimulationReportStore> m_ReportStore;
+    std::vector<SimulationReport> m_SimulationReports = CreateStoreBackedReports(m_ReportStore);
     SimulationClock::time_point m_Start = m_SimulationReports.empty() ? SimulationClock::start() : m_SimulationReports.front().getTime();
     SimulationClock::time_point m_End = m_SimulationReports.empty() ? SimulationClock::start() : m_SimulationReports.back().getTime();
     ParamBlock m_ParamBlock;
@@ -335,11 +410,16 @@ osc::SimulationReport osc::StoFileSimulation::implGetSimulationReport(int report
 {
     return m_Impl->getSimulationReport(std::move(reportIndex));
 }
-std::vector<osc::SimulationReport> osc::StoFileSimulation::implGetAllSimulationReports() const
+nonstd::span<osc::SimulationReport const> osc::StoFileSimulation::implGetAllSimulationReports() const
 {
     return m_Impl->getAllSimulationReports();
 }
 
+nonstd::span<double const> osc::StoFileSimulation::implGetReportTimes() const
+{
+    return m_Impl->getReportTimes();
+}
+
 osc::SimulationStatus osc::StoFileSimulation::implGetStatus() const
 {
     return m_Impl->getStatus();
@@ -22,6 +22,7 @@
 #include <oscar/Utils/Algorithms.hpp>
 #include <oscar/Utils/Assertions.hpp>
 #include <oscar/Utils/CStringView.hpp>
+#include <oscar/Utils/InternedString.hpp>
 
 #include <glm/vec2.hpp>
 #include <imgui.h>
@@ -418,7 +419,7 @@ namespace
                 osc::App::singleton<osc::MeshCache>()->getCylinderMesh(),
                 t,
                 arrow.color,
-                arrow.label,
+                osc::InternedString{arrow.label},
                 osc::SceneDecorationFlags_None,
             });
         }
@@ -435,7 +436,7 @@ namespace
                 osc::App::singleton<osc::MeshCache>()->getConeMesh(),
                 t,
                 arrow.color,
-                arrow.label,
+                osc::InternedString{arrow.label},
                 osc::SceneDecorationFlags_None,
             });
         }
@@ -1265,8 +1265,7 @@ namespace
                 osc::App::get().getMSXAASamplesRecommended(),
                 renderDimensions
             );
-            std::vector<osc::SceneDecoration> const decorations = generateDecorations(maybeHoveredLandmark);
-            return m_CachedRenderer.draw(decorations, params);
+            return m_CachedRenderer.draw(generateDecorations(maybeHoveredLandmark), params);
         }
 
         // returns a fresh list of 3D decorations for this panel's 3D render
@@ -1970,8 +1969,7 @@ namespace
                 osc::App::get().getMSXAASamplesRecommended(),
                 dims
             );
-            std::vector<osc::SceneDecoration> const decorations = generateDecorations(maybeMeshCollision, maybeLandmarkCollision);
-            return m_CachedRenderer.draw(decorations, params);
+            return m_CachedRenderer.draw(generateDecorations(maybeMeshCollision, maybeLandmarkCollision), params);
         }
 
         // returns a fresh list of 3D decorations for this panel's 3D render
@@ -2256,13 +2254,12 @@ namespace
         // renders a panel to a texture via its renderer and returns a reference to the rendered texture
         osc::RenderTexture& renderScene(glm::vec2 dims)
         {
-            std::vector<osc::SceneDecoration> const decorations = generateDecorations();
             osc::SceneRendererParams const params = CalcStandardDarkSceneRenderParams(
                 m_Camera,
                 osc::App::get().getMSXAASamplesRecommended(),
                 dims
             );
-            return m_CachedRenderer.draw(decorations, params);
+            return m_CachedRenderer.draw(generateDecorations(), params);
         }
 
         std::shared_ptr<TPSTabSharedState> m_State;
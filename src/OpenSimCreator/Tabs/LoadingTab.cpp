@@ -1,11 +1,13 @@
 #include "LoadingTab.hpp"
 
+#include "OpenSimCreator/Graphics/SimTKMeshLoader.hpp"
 #include "OpenSimCreator/MiddlewareAPIs/MainUIStateAPI.hpp"
 #include "OpenSimCreator/Tabs/ModelEditorTab.hpp"
 #include "OpenSimCreator/OpenSimHelpers.hpp"
 #include "OpenSimCreator/UndoableModelStatePair.hpp"
 
 #include <oscar/Bindings/ImGuiHelpers.hpp>
+#include <oscar/Graphics/MeshCache.hpp>
 #include <oscar/Maths/MathHelpers.hpp>
 #include <oscar/Maths/Rect.hpp>
 #include <oscar/Platform/App.hpp>
@@ -14,6 +16,8 @@
 
 #include <glm/vec2.hpp>
 #include <imgui.h>
+#include <OpenSim/Simulation/Model/Geometry.h>
+#include <OpenSim/Simulation/Model/Model.h>
 #include <SDL_events.h>
 
 #include <chrono>
@@ -21,9 +25,33 @@
 #include <filesystem>
 #include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
+namespace
+{
+    // loads the model and then starts loading all of its mesh files in parallel, so that
+    // they are (hopefully) already loaded when the model is first rendered
+    std::unique_ptr<osc::UndoableModelStatePair> LoadOsimAndPrefetchMeshes(
+        std::filesystem::path const& path,
+        std::shared_ptr<osc::MeshCache> const& meshCache)
+    {
+        std::unique_ptr<osc::UndoableModelStatePair> rv = osc::LoadOsimIntoUndoableModel(path);
+
+        OpenSim::Model const& model = rv->getModel();
+        for (OpenSim::Mesh const& mesh : model.getComponentList<OpenSim::Mesh>())
+        {
+            if (std::optional<std::filesystem::path> const meshPath = osc::FindGeometryFileAbsPath(model, mesh))
+            {
+                meshCache->prefetchFromFile(*meshPath, osc::LoadMeshViaSimTK);
+            }
+        }
+
+        return rv;
+    }
+}
+
 class osc::LoadingTab::Impl final {
 public:
 
@@ -33,7 +61,7 @@ public:
 
         m_Parent{std::move(parent_)},
         m_OsimPath{std::move(path_)},
-        m_LoadingResult{std::async(std::launch::async, osc::LoadOsimIntoUndoableModel, m_OsimPath)}
+        m_LoadingResult{std::async(std::launch::async, LoadOsimAndPrefetchMeshes, m_OsimPath, App::singleton<MeshCache>())}
     {
     }
 
@@ -12,13 +12,14 @@
 #include <oscar/Bindings/GlmHelpers.hpp>
 #include <oscar/Bindings/ImGuiHelpers.hpp>
 #include <oscar/Bindings/ImGuizmoHelpers.hpp>
+#include <oscar/Graphics/CachedSceneRenderer.hpp>
 #include <oscar/Graphics/GraphicsHelpers.hpp>
 #include <oscar/Graphics/MeshCache.hpp>
 #include <oscar/Graphics/Mesh.hpp>
 #include <oscar/Graphics/MeshGen.hpp>
+#include <oscar/Graphics/RenderTexture.hpp>
 #include <oscar/Graphics/ShaderCache.hpp>
 #include <oscar/Graphics/SceneDecoration.hpp>
-#include <oscar/Graphics/SceneRenderer.hpp>
 #include <oscar/Graphics/SceneRendererParams.hpp>
 #include <oscar/Maths/AABB.hpp>
 #include <oscar/Maths/CollisionTests.hpp>
@@ -519,7 +520,10 @@ namespace
 
         void send(MeshLoadRequest req)
         {
-            m_Worker.send(std::move(req));
+            if (!m_Worker.send(std::move(req)))
+            {
+                osc::log::error("too many mesh load requests are waiting for the mesh loader: the request was dropped");
+            }
         }
 
         std::optional<MeshLoadResponse> poll()
@@ -1911,122 +1915,226 @@ namespace
 // - Must have value semantics, so that other code such as the undo/redo buffer can
 //   copy an entire ModelGraph somewhere else in memory without having to worry about
 //   aliased mutations
+//
+// - Must be cheap to copy, because the undo/redo buffer copies the ModelGraph on each
+//   commit. Copies share their (copy-on-write) elements, so a commit only costs as much as
+//   the number of elements that are subsequently edited
 namespace
 {
-    class ModelGraph final {
+    // storage for a model graph's elements
+    //
+    // elements are reference-counted and copy-on-write, so copying a table only copies pointers
+    // and an element is only cloned when it's updated via a table that shares it. Each table
+    // also keeps a (UID-ordered) per-class index of its elements, so that typed iteration only
+    // visits elements of that type
+    class SceneElTable final {
+    public:
+        using Storage = std::map<UID, std::shared_ptr<SceneEl>>;
+        using Index = std::vector<Storage::iterator>;
 
-        // helper class for iterating over model graph elements
-        template<bool IsConst, typename T = SceneEl>
-        class Iterator final {
-        public:
-            Iterator(
-                std::map<UID, ClonePtr<SceneEl>>::iterator pos,
-                std::map<UID, ClonePtr<SceneEl>>::iterator end) :
-                m_Pos{pos},
-                m_End{end}
-            {
-                // ensure iterator initially points at an element with the correct type
-                while (m_Pos != m_End) {
-                    if (dynamic_cast<T const*>(m_Pos->second.get())) {
-                        break;
-                    }
-                    ++m_Pos;
-                }
+        SceneElTable() = default;
+
+        SceneElTable(SceneElTable const& src) :
+            m_Els{src.m_Els}
+        {
+            // (the index points into the source's storage, so it has to be rebuilt)
+            for (auto it = m_Els.begin(); it != m_Els.end(); ++it)
+            {
+                m_AllIndex.push_back(it);
+                m_ClassIndices[&it->second->GetClass()].push_back(it);
             }
+        }
 
-            // implict conversion from non-const- to const-iterator
+        SceneElTable(SceneElTable&&) = delete;
+        SceneElTable& operator=(SceneElTable const&) = delete;
+        SceneElTable& operator=(SceneElTable&&) = delete;
+        ~SceneElTable() noexcept = default;
 
-            template<bool IsConst_ = IsConst>
-            operator typename std::enable_if_t<!IsConst_, Iterator<true, T>>() const noexcept
+        SceneEl const* TryGet(UID id) const
+        {
+            auto it = m_Els.find(id);
+            return it != m_Els.end() ? it->second.get() : nullptr;
+        }
+
+        SceneEl* TryUpd(UID id)
+        {
+            auto it = m_Els.find(id);
+            return it != m_Els.end() ? &Upd(it) : nullptr;
+        }
+
+        // returns a mutable reference to the element, cloning it first if it's shared
+        static SceneEl& Upd(Storage::iterator it)
+        {
+            if (it->second.use_count() > 1)
             {
-                return Iterator<true, T>{m_Pos, m_End};
+                it->second = it->second->clone();
             }
+            return *it->second;
+        }
 
-            // LegacyIterator
+        // returns all elements, or all elements of the given class, in UID order
+        Index const& GetIndex(SceneElClass const* maybeClass) const
+        {
+            if (!maybeClass)
+            {
+                return m_AllIndex;
+            }
+            static Index const s_EmptyIndex;
+            auto it = m_ClassIndices.find(maybeClass);
+            return it != m_ClassIndices.end() ? it->second : s_EmptyIndex;
+        }
 
-            Iterator& operator++() noexcept
+        SceneEl& Insert(std::unique_ptr<SceneEl> el)
+        {
+            auto [it, inserted] = m_Els.emplace(el->GetID(), std::move(el));
+            if (inserted)
             {
-                while (++m_Pos != m_End) {
-                    if (dynamic_cast<T const*>(m_Pos->second.get())) {
-                        break;
-                    }
-                }
-                return *this;
+                InsertIntoIndex(m_AllIndex, it);
+                InsertIntoIndex(m_ClassIndices[&it->second->GetClass()], it);
             }
+            return *it->second;
+        }
 
-            template<bool IsConst_ = IsConst>
-            typename std::enable_if_t<IsConst_, T const&> operator*() const noexcept
+        // removes the element from the table and returns it (or `nullptr`, if it doesn't exist)
+        std::shared_ptr<SceneEl> Erase(UID id)
+        {
+            auto it = m_Els.find(id);
+            if (it == m_Els.end())
             {
-                return dynamic_cast<T const&>(*m_Pos->second);
+                return nullptr;
             }
 
-            template<bool IsConst_ = IsConst>
-            typename std::enable_if_t<!IsConst_, T&> operator*() const noexcept
+            EraseFromIndex(m_AllIndex, id);
+            EraseFromIndex(m_ClassIndices[&it->second->GetClass()], id);
+
+            std::shared_ptr<SceneEl> rv = std::move(it->second);
+            m_Els.erase(it);
+            return rv;
+        }
+
+    private:
+        static Index::iterator LowerBound(Index& index, UID id)
+        {
+            return std::lower_bound(index.begin(), index.end(), id, [](Storage::iterator const& it, UID const& v)
+            {
+                return it->first < v;
+            });
+        }
+
+        static void InsertIntoIndex(Index& index, Storage::iterator it)
+        {
+            // (usually a push back, because new elements usually have the highest UIDs)
+            index.insert(LowerBound(index, it->first), it);
+        }
+
+        static void EraseFromIndex(Index& index, UID id)
+        {
+            auto it = LowerBound(index, id);
+            if (it != index.end() && (*it)->first == id)
             {
-                return dynamic_cast<T&>(*m_Pos->second);
+                index.erase(it);
             }
+        }
 
-            // EqualityComparable
+        Storage m_Els;
+        Index m_AllIndex;
+        std::unordered_map<SceneElClass const*, Index> m_ClassIndices;
+    };
+
+    class ModelGraph final {
 
-            template<bool OtherConst>
-            bool operator!=(Iterator<OtherConst, T> const& other) const noexcept
+        // helper class for iterating over (the indexed) model graph elements
+        template<typename T = SceneEl>
+        class Iterator final {
+        public:
+            explicit Iterator(SceneElTable::Index::const_iterator pos) :
+                m_Pos{pos}
             {
-                return m_Pos != other.m_Pos;
             }
 
-            template<bool OtherConst>
-            bool operator==(Iterator<OtherConst> const& other) const noexcept
+            // LegacyIterator
+
+            Iterator& operator++() noexcept
             {
-                return !(*this != other);
+                ++m_Pos;
+                return *this;
             }
 
-            // LegacyInputIterator
+            T const& operator*() const noexcept
+            {
+                // (the index only contains elements of type `T`)
+                return static_cast<T const&>(*(*m_Pos)->second);
+            }
 
-            template<bool IsConst_ = IsConst>
-            typename std::enable_if_t<IsConst_, T const*> operator->() const noexcept
+            // EqualityComparable
+
+            bool operator!=(Iterator const& other) const noexcept
             {
+                return m_Pos != other.m_Pos;
+            }
 
-                return &dynamic_cast<T const&>(*m_Pos->second);
+            bool operator==(Iterator const& other) const noexcept
+            {
+                return !(*this != other);
             }
 
-            template<bool IsConst_ = IsConst>
-            typename std::enable_if_t<!IsConst_, T*> operator->() const noexcept
+            // LegacyInputIterator
+
+            T const* operator->() const noexcept
             {
-                return &dynamic_cast<T&>(*m_Pos->second);
+                return &**this;
             }
 
         private:
-            std::map<UID, ClonePtr<SceneEl>>::iterator m_Pos;
-            std::map<UID, ClonePtr<SceneEl>>::iterator m_End;  // needed because of multi-step advances
+            SceneElTable::Index::const_iterator m_Pos;
         };
 
         // helper class for an iterable object with a beginning + end
-        template<bool IsConst, typename T = SceneEl>
+        template<typename T = SceneEl>
         class Iterable final {
         public:
-            Iterable(std::map<UID, ClonePtr<SceneEl>>& els) :
-                m_Begin{els.begin(), els.end()},
-                m_End{els.end(), els.end()}
+            Iterable(SceneElTable::Index const& index) :
+                m_Begin{index.begin()},
+                m_End{index.end()}
             {
             }
 
-            Iterator<IsConst, T> begin() { return m_Begin; }
-            Iterator<IsConst, T> end() { return m_End; }
+            Iterator<T> begin() { return m_Begin; }
+            Iterator<T> end() { return m_End; }
 
         private:
-            Iterator<IsConst, T> m_Begin;
-            Iterator<IsConst, T> m_End;
+            Iterator<T> m_Begin;
+            Iterator<T> m_End;
         };
 
+        // returns the class that `T` indexes into, or `nullptr` if `T` is the base class
+        template<typename T>
+        static SceneElClass const* GetIndexClass()
+        {
+            static_assert(std::is_base_of_v<SceneEl, T>);
+            if constexpr (std::is_same_v<T, SceneEl>)
+            {
+                return nullptr;
+            }
+            else
+            {
+                static_assert(std::is_final_v<T>, "typed iteration is only supported for concrete (final) scene element types");
+                return &T::Class();
+            }
+        }
+
     public:
 
         ModelGraph() :
+            m_Els{std::make_shared<SceneElTable>()}
+        {
             // insert a senteniel ground element into the model graph (it should always
             // be there)
-            m_Els{{c_GroundID, ClonePtr<SceneEl>{GroundEl{}}}}
-        {
+            m_Els->Insert(std::make_unique<GroundEl>());
         }
 
+        // copies share the element table (and, therefore, all elements) until either copy
+        // is updated
         std::unique_ptr<ModelGraph> clone() const
         {
             return std::make_unique<ModelGraph>(*this);
@@ -2035,14 +2143,7 @@ namespace
 
         SceneEl* TryUpdElByID(UID id)
         {
-            auto it = m_Els.find(id);
-
-            if (it == m_Els.end())
-            {
-                return nullptr;  // ID does not exist in the element collection
-            }
-
-            return it->second.get();
+            return UpdTable().TryUpd(id);
         }
 
         template<typename T = SceneEl>
@@ -2050,15 +2151,23 @@ namespace
         {
             static_assert(std::is_base_of_v<SceneEl, T>);
 
-            SceneEl* p = TryUpdElByID(id);
+            // check the type first, so that a type mismatch doesn't clone the element
+            if (!TryGetElByID<T>(id))
+            {
+                return nullptr;
+            }
 
-            return p ? dynamic_cast<T*>(p) : nullptr;
+            return dynamic_cast<T*>(TryUpdElByID(id));
         }
 
         template<typename T = SceneEl>
         T const* TryGetElByID(UID id) const
         {
-            return const_cast<ModelGraph&>(*this).TryUpdElByID<T>(id);
+            static_assert(std::is_base_of_v<SceneEl, T>);
+
+            SceneEl const* p = m_Els->TryGet(id);
+
+            return p ? dynamic_cast<T const*>(p) : nullptr;
         }
 
         template<typename T = SceneEl>
@@ -2068,9 +2177,7 @@ namespace
 
             if (!ptr)
             {
-                std::stringstream msg;
-                msg << "could not find a scene element of type " << typeid(T).name() << " with ID = " << id;
-                throw std::runtime_error{std::move(msg).str()};
+                ThrowElNotFound<T>(id);
             }
 
             return *ptr;
@@ -2079,7 +2186,14 @@ namespace
         template<typename T = SceneEl>
         T const& GetElByID(UID id) const
         {
-            return const_cast<ModelGraph&>(*this).UpdElByID<T>(id);
+            T const* ptr = TryGetElByID<T>(id);
+
+            if (!ptr)
+            {
+                ThrowElNotFound<T>(id);
+            }
+
+            return *ptr;
         }
 
         template<typename T = SceneEl>
@@ -2094,16 +2208,12 @@ namespace
             return ContainsEl<T>(e.GetID());
         }
 
+        // (there's intentionally no mutable iteration, because it would have to clone each
+        // element that's shared with another model graph)
         template<typename T = SceneEl>
-        Iterable<false, T> iter()
+        Iterable<T> iter() const
         {
-            return Iterable<false, T>{m_Els};
-        }
-
-        template<typename T = SceneEl>
-        Iterable<true, T> iter() const
-        {
-            return Iterable<true, T>{const_cast<ModelGraph&>(*this).m_Els};
+            return Iterable<T>{m_Els->GetIndex(GetIndexClass<T>())};
         }
 
         SceneEl& AddEl(std::unique_ptr<SceneEl> el)
@@ -2121,7 +2231,7 @@ namespace
                 }
             }
 
-            return *m_Els.emplace(el->GetID(), std::move(el)).first->second;
+            return UpdTable().Insert(std::move(el));
         }
 
         template<typename T, typename... Args>
@@ -2152,11 +2262,9 @@ namespace
                 // so that code that relies on references to the to-be-deleted element
                 // still works until an explicit `.GarbageCollect()` call
 
-                auto it = m_Els.find(deletedID);
-                if (it != m_Els.end())
+                if (std::shared_ptr<SceneEl> deleted = UpdTable().Erase(deletedID))
                 {
-                    m_DeletedEls->push_back(std::move(it->second));
-                    m_Els.erase(it);
+                    m_DeletedEls->push_back(std::move(deleted));
                 }
             }
 
@@ -2260,9 +2368,27 @@ namespace
             }
         }
 
-        std::map<UID, ClonePtr<SceneEl>> m_Els;
+        // returns the element table, copying it first if it's shared with another model graph
+        SceneElTable& UpdTable()
+        {
+            if (m_Els.use_count() > 1)
+            {
+                m_Els = std::make_shared<SceneElTable>(*m_Els);
+            }
+            return *m_Els;
+        }
+
+        template<typename T>
+        [[noreturn]] static void ThrowElNotFound(UID id)
+        {
+            std::stringstream msg;
+            msg << "could not find a scene element of type " << typeid(T).name() << " with ID = " << id;
+            throw std::runtime_error{std::move(msg).str()};
+        }
+
+        std::shared_ptr<SceneElTable> m_Els;
         std::unordered_set<UID> m_SelectedEls;
-        osc::DefaultConstructOnCopy<std::vector<ClonePtr<SceneEl>>> m_DeletedEls;
+        osc::DefaultConstructOnCopy<std::vector<std::shared_ptr<SceneEl>>> m_DeletedEls;
     };
 
     void SelectOnly(ModelGraph& mg, SceneEl const& e)
@@ -4487,11 +4613,12 @@ namespace
                 decs.emplace_back(dt.mesh, dt.transform, dt.color, std::string{}, dt.flags, dt.maybeMaterial, dt.maybePropertyBlock);
             }
 
-            // render
-            m_SceneRenderer.draw(decs, p);
+            // render (the cached renderer only re-renders if the scene changed, and takes
+            // ownership of the decorations when it does)
+            osc::RenderTexture& renderTexture = m_SceneRenderer.draw(std::move(decs), p);
 
             // send texture to ImGui
-            osc::DrawTextureAsImGuiImage(m_SceneRenderer.updRenderTexture(), m_SceneRenderer.getDimensions());
+            osc::DrawTextureAsImGuiImage(renderTexture, p.dimensions);
 
             // handle hittesting, etc.
             SetIsRenderHovered(ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenBlockedByPopup));
@@ -4537,11 +4664,6 @@ namespace
             m_3DSceneCamera.focusPoint = -focusPoint;
         }
 
-        osc::RenderTexture& UpdSceneTex()
-        {
-            return m_SceneRenderer.updRenderTexture();
-        }
-
         nonstd::span<osc::Color const> GetColors() const
         {
             static_assert(alignof(decltype(m_Colors)) == alignof(osc::Color));
@@ -5230,7 +5352,7 @@ namespace
         osc::Rect m_3DSceneRect = {};
 
         // renderer that draws the scene
-        osc::SceneRenderer m_SceneRenderer{osc::App::config(), *osc::App::singleton<osc::MeshCache>(), *osc::App::singleton<osc::ShaderCache>()};
+        osc::CachedSceneRenderer m_SceneRenderer{osc::App::config(), *osc::App::singleton<osc::MeshCache>(), *osc::App::singleton<osc::ShaderCache>()};
 
         // COLORS
         //
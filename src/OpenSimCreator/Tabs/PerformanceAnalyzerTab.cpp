@@ -2,17 +2,19 @@
 
 #include "OpenSimCreator/Widgets/ParamBlockEditorPopup.hpp"
 #include "OpenSimCreator/BasicModelStatePair.hpp"
-#include "OpenSimCreator/ForwardDynamicSimulation.hpp"
+#include "OpenSimCreator/BatchSimulator.hpp"
 #include "OpenSimCreator/ForwardDynamicSimulator.hpp"
 #include "OpenSimCreator/ForwardDynamicSimulatorParams.hpp"
 #include "OpenSimCreator/IntegratorMethod.hpp"
 #include "OpenSimCreator/OutputExtractor.hpp"
 #include "OpenSimCreator/ParamBlock.hpp"
 #include "OpenSimCreator/ParamValue.hpp"
+#include "OpenSimCreator/SimulationReport.hpp"
 #include "OpenSimCreator/SimulationStatus.hpp"
 
+#include <oscar/Platform/App.hpp>
 #include <oscar/Platform/os.hpp>
-#include <oscar/Utils/SynchronizedValue.hpp>
+#include <oscar/Utils/WorkStealingThreadPool.hpp>
 
 #include <SDL_events.h>
 #include <IconsFontAwesome5.h>
@@ -21,7 +23,9 @@
 #include <OpenSim/Simulation/Model/Model.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -55,6 +59,9 @@ public:
         m_BaseModel{std::move(baseModel)},
         m_BaseParams{params}
     {
+        // start sweeping through the integrators straight away (the user can edit the params
+        // and restart it)
+        restartBatch();
     }
 
     UID getID() const
@@ -69,7 +76,11 @@ public:
 
     void onTick()
     {
-        startSimsIfNecessary();
+        // keep redrawing while the batch is running, so that the progress bars update
+        if (m_Batch && !m_Batch->isFinished())
+        {
+            App::upd().requestRedraw();
+        }
     }
 
     void onDraw()
@@ -81,7 +92,10 @@ public:
 
         ImGui::Begin("Inputs");
 
-        ImGui::InputInt("parallelism", &m_Parallelism);
+        if (ImGui::InputInt("parallelism", &m_Parallelism))
+        {
+            m_Parallelism = std::max(m_Parallelism, 1);
+        }
         if (ImGui::Button("edit base params"))
         {
             m_ParamEditor.open();
@@ -89,14 +103,14 @@ public:
 
         if (ImGui::Button("(re)start"))
         {
-            populateParamsFromParamBlock();
+            restartBatch();
         }
 
         ImGui::End();
 
         ImGui::Begin("Outputs");
 
-        if (!m_Sims.empty() && ImGui::BeginTable("simulations", 4))
+        if (m_Batch && ImGui::BeginTable("simulations", 4))
         {
             ImGui::TableSetupColumn("Integrator");
             ImGui::TableSetupColumn("Progress");
@@ -104,24 +118,24 @@ public:
             ImGui::TableSetupColumn("NumStepsTaken");
             ImGui::TableHeadersRow();
 
-            for (osc::ForwardDynamicSimulation const& sim : m_Sims)
+            for (size_t i = 0; i < m_Batch->getNumJobs(); ++i)
             {
-                auto reports = sim.getAllSimulationReports();
-                if (reports.empty())
+                BatchSimulationJobProgress const progress = m_Batch->getJobProgress(i);
+                if (!progress.latestReport)
                 {
                     continue;
                 }
 
-                IntegratorMethod m = std::get<IntegratorMethod>(sim.getParams().findValue("Integrator Method").value());
-                float t = m_WalltimeExtractor.getValueFloat(*sim.getModel(), reports.back());
-                float steps = m_StepsTakenExtractor.getValueFloat(*sim.getModel(), reports.back());
+                IntegratorMethod m = m_Batch->getJobParams(i).integratorMethodUsed;
+                float t = m_WalltimeExtractor.getValueFloat(m_BaseModel.getModel(), *progress.latestReport);
+                float steps = m_StepsTakenExtractor.getValueFloat(m_BaseModel.getModel(), *progress.latestReport);
 
                 ImGui::TableNextRow();
                 int column = 0;
                 ImGui::TableSetColumnIndex(column++);
                 ImGui::TextUnformatted(GetIntegratorMethodString(m).c_str());
                 ImGui::TableSetColumnIndex(column++);
-                ImGui::ProgressBar(sim.getProgress());
+                ImGui::ProgressBar(progress.progress);
                 ImGui::TableSetColumnIndex(column++);
                 ImGui::Text("%f", t);
                 ImGui::TableSetColumnIndex(column++);
@@ -167,65 +181,40 @@ private:
 
         fout << "Integrator,Wall Time (sec),NumStepsTaken\n";
 
-        for (osc::ForwardDynamicSimulation const& sim : m_Sims)
+        for (size_t i = 0; i < m_Batch->getNumJobs(); ++i)
         {
-            auto reports = sim.getAllSimulationReports();
-            if (reports.empty())
+            BatchSimulationJobProgress const progress = m_Batch->getJobProgress(i);
+            if (!progress.latestReport)
             {
                 continue;
             }
 
-            IntegratorMethod m = std::get<IntegratorMethod>(sim.getParams().findValue("Integrator Method").value());
+            IntegratorMethod m = m_Batch->getJobParams(i).integratorMethodUsed;
             CStringView const integratorMethodStr = GetIntegratorMethodString(m);
-            float t = m_WalltimeExtractor.getValueFloat(*sim.getModel(), reports.back());
-            float steps = m_StepsTakenExtractor.getValueFloat(*sim.getModel(), reports.back());
+            float t = m_WalltimeExtractor.getValueFloat(m_BaseModel.getModel(), *progress.latestReport);
+            float steps = m_StepsTakenExtractor.getValueFloat(m_BaseModel.getModel(), *progress.latestReport);
 
             fout << integratorMethodStr << ',' << t << ',' << steps << '\n';
         }
     }
 
-    // populate the list of input parameters
-    void populateParamsFromParamBlock()
-    {
-        m_Params.clear();
-        m_Sims.clear();
-
-        osc::ForwardDynamicSimulatorParams params = osc::FromParamBlock(m_BaseParams);
-
-        // for now, just permute through integration methods
-        for (osc::IntegratorMethod m : osc::GetAllIntegratorMethods())
-        {
-            params.integratorMethodUsed = m;
-            m_Params.push_back(params);
-        }
-    }
-
-    // dequeue any queued sims
-    void startSimsIfNecessary()
+    // cancel any running simulations and start a new batch that permutes through
+    // the integration methods
+    void restartBatch()
     {
-        int nAvail = static_cast<int>(m_Params.size()) - static_cast<int>(m_Sims.size());
-        int nActive = static_cast<int>(std::count_if(m_Sims.begin(), m_Sims.end(), [](auto const& sim) { return sim.getStatus() == SimulationStatus::Running || sim.getStatus() == SimulationStatus::Initializing; }));
-        int nToStart = std::min(nAvail, m_Parallelism - nActive);
-
-        if (nToStart <= 0)
-        {
-            return;  // nothing to start
-        }
+        BatchSimulatorParams batchParams;
+        batchParams.numThreads = static_cast<size_t>(m_Parallelism);
 
-        // load model and enqueue sims
-        for (auto it = m_Params.end() - nAvail, end = it + nToStart; it != end; ++it)
-        {
-            m_Sims.emplace_back(m_BaseModel, *it);
-        }
+        m_Batch.reset();  // cancel + join existing batch before starting a new one
+        m_Batch = std::make_unique<BatchSimulator>(GenerateIntegratorSweepJobs(m_BaseModel, FromParamBlock(m_BaseParams)), batchParams);
     }
 
     UID m_TabID;
 
-    int m_Parallelism = 1;
     BasicModelStatePair m_BaseModel;
     ParamBlock m_BaseParams;
-    std::vector<ForwardDynamicSimulatorParams> m_Params;
-    std::vector<ForwardDynamicSimulation> m_Sims;
+    int m_Parallelism = static_cast<int>(GetDefaultNumWorkerThreads());
+    std::unique_ptr<BatchSimulator> m_Batch;
 
     OutputExtractor m_WalltimeExtractor = GetSimulatorOutputExtractor("Wall time");
     OutputExtractor m_StepsTakenExtractor = GetSimulatorOutputExtractor("NumStepsTaken");
@@ -17,6 +17,7 @@
 #include "OpenSimCreator/OpenSimHelpers.hpp"
 #include "OpenSimCreator/Simulation.hpp"
 #include "OpenSimCreator/SimulationClock.hpp"
+#include "OpenSimCreator/SimulationHelpers.hpp"
 #include "OpenSimCreator/SimulationModelStatePair.hpp"
 #include "OpenSimCreator/SimulationReport.hpp"
 #include "OpenSimCreator/VirtualOutputExtractor.hpp"
@@ -172,6 +173,11 @@ public:
 
     void onTick()
     {
+        // pop any reports that the simulation has produced, even if this tab isn't
+        // being drawn, so that the background simulator thread isn't blocked by a
+        // full report channel (backpressure)
+        m_Simulation->getNumReports();
+
         if (m_IsPlayingBack)
         {
             SimulationClock::time_point const playbackPos = implGetSimulationScrubTime();
@@ -208,37 +214,6 @@ public:
     }
 
 private:
-    std::optional<SimulationReport> tryFindNthReportAfter(SimulationClock::time_point t, int offset = 0)
-    {
-        int const numSimulationReports = m_Simulation->getNumReports();
-
-        if (numSimulationReports <= 0)
-        {
-            return std::nullopt;
-        }
-
-        int zeroethReportIndex = numSimulationReports - 1;
-        for (int i = 0; i < numSimulationReports; ++i)
-        {
-            SimulationReport r = m_Simulation->getSimulationReport(i);
-            if (r.getTime() >= t)
-            {
-                zeroethReportIndex = i;
-                break;
-            }
-        }
-
-        int const reportIndex = zeroethReportIndex + offset;
-        if (0 <= reportIndex && reportIndex < numSimulationReports)
-        {
-            return m_Simulation->getSimulationReport(reportIndex);
-        }
-        else
-        {
-            return std::nullopt;
-        }
-    }
-
     VirtualSimulation& implUpdSimulation() final
     {
         return *m_Simulation;
@@ -273,6 +248,16 @@ private:
         m_PlaybackSpeed = v;
     }
 
+    bool implGetSimulationStateInterpolation() final
+    {
+        return m_InterpolateStates;
+    }
+
+    void implSetSimulationStateInterpolation(bool v) final
+    {
+        m_InterpolateStates = v;
+    }
+
     SimulationClock::time_point implGetSimulationScrubTime() final
     {
         if (!m_IsPlayingBack)
@@ -281,8 +266,8 @@ private:
         }
         // map wall time onto sim time
 
-        int nReports = m_Simulation->getNumReports();
-        if (nReports <= 0)
+        nonstd::span<double const> const reportTimes = m_Simulation->getReportTimes();
+        if (reportTimes.empty())
         {
             return m_Simulation->getStartTime();
         }
@@ -293,8 +278,8 @@ private:
 
             SimulationClock::duration const simDur = m_PlaybackSpeed * SimulationClock::duration{wallDur};
             SimulationClock::time_point const simNow = m_PlaybackStartSimtime + simDur;
-            SimulationClock::time_point const simEarliest = m_Simulation->getSimulationReport(0).getTime();
-            SimulationClock::time_point const simLatest = m_Simulation->getSimulationReport(nReports - 1).getTime();
+            SimulationClock::time_point const simEarliest = SimulationClock::start() + SimulationClock::duration{reportTimes.front()};
+            SimulationClock::time_point const simLatest = SimulationClock::start() + SimulationClock::duration{reportTimes.back()};
 
             if (simNow < simEarliest)
             {
@@ -319,7 +304,7 @@ private:
 
     void implStepBack() final
     {
-        std::optional<SimulationReport> const maybePrev = tryFindNthReportAfter(getSimulationScrubTime(), -1);
+        std::optional<SimulationReport> const maybePrev = TryFindNthReportAfter(*m_Simulation, getSimulationScrubTime(), -1);
         if (maybePrev)
         {
             setSimulationScrubTime(maybePrev->getTime());
@@ -328,7 +313,7 @@ private:
 
     void implStepForward() final
     {
-        std::optional<SimulationReport> const maybeNext = tryFindNthReportAfter(getSimulationScrubTime(), 1);
+        std::optional<SimulationReport> const maybeNext = TryFindNthReportAfter(*m_Simulation, getSimulationScrubTime(), 1);
         if (maybeNext)
         {
             setSimulationScrubTime(maybeNext->getTime());
@@ -337,7 +322,14 @@ private:
 
     std::optional<SimulationReport> implTrySelectReportBasedOnScrubbing() final
     {
-        return tryFindNthReportAfter(getSimulationScrubTime());
+        if (m_InterpolateStates)
+        {
+            return TryGetInterpolatedReport(*m_Simulation, getSimulationScrubTime(), m_InterpolatedReportCache);
+        }
+        else
+        {
+            return TryFindNthReportAfter(*m_Simulation, getSimulationScrubTime());
+        }
     }
 
     int implGetNumUserOutputExtractors() const final
@@ -439,6 +431,8 @@ private:
     // scrubbing state
     bool m_IsPlayingBack = true;
     float m_PlaybackSpeed = 1.0f;
+    bool m_InterpolateStates = false;
+    InterpolatedReportCache m_InterpolatedReportCache;  // so that the shown state (and its decorations) are reused while paused
     SimulationClock::time_point m_PlaybackStartSimtime = m_Simulation->getStartTime();
     std::chrono::system_clock::time_point m_PlaybackStartWallTime = std::chrono::system_clock::now();
 
@@ -1,5 +1,6 @@
 #include "UndoableModelStatePair.hpp"
 
+#include "OpenSimCreator/ComponentPathIndex.hpp"
 #include "OpenSimCreator/ModelStateCommit.hpp"
 #include "OpenSimCreator/OpenSimHelpers.hpp"
 
@@ -8,6 +9,7 @@
 #include <oscar/Utils/Perf.hpp>
 #include <oscar/Utils/SynchronizedValue.hpp>
 #include <oscar/Utils/UID.hpp>
+#include <oscar/Utils/WorkStealingThreadPool.hpp>
 
 #include <OpenSim/Common/ComponentPath.h>
 #include <OpenSim/Common/ModelDisplayHints.h>
@@ -15,23 +17,180 @@
 #include <OpenSim/Common/Set.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <condition_variable>
+#include <cstddef>
 #include <exception>
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
-// maximum distance between the current commit and the "root" commit (i.e. a commit with no parent)
-static inline int constexpr c_MaxUndo = 32;
+// default maximum number of bytes that the (compacted) undo/redo history may use before older commits are erased
+static inline size_t constexpr c_DefaultHistoryMemoryBudget = 64*1024*1024;
 
-// maximum distance between the branch head and the current commit (i.e. how big the redo buffer can be)
-static inline int constexpr c_MaxRedo = 32;
+// minimum distance between the current commit and the "root" commit that is kept, regardless of the memory budget
+static inline int constexpr c_MinUndo = 1;
 
 namespace
 {
+    // the pool that commit histories are compacted on
+    osc::WorkStealingThreadPool& GetHistoryCompactionThreadPool()
+    {
+        static osc::WorkStealingThreadPool s_Pool{1};
+        return s_Pool;
+    }
+
+    // a snapshot of a commit history that should be compacted
+    struct HistoryCompactionRequest final {
+        std::vector<osc::ModelStateCommit> branch;  // newest to oldest
+        osc::UID currentHead;
+        size_t memoryBudget;
+    };
+
+    // compacts the given history, so that each commit is stored as a delta against its child
+    // commit, rather than as a full (initialized) model
+    //
+    // returns the newest commit that, along with its ancestors, should be erased to keep the
+    // (compacted) history within the memory budget, if any
+    std::optional<osc::UID> CompactHistory(HistoryCompactionRequest const& req)
+    {
+        static_assert(c_MinUndo >= 0);
+
+        std::vector<osc::ModelStateCommit> const& branch = req.branch;
+        for (size_t i = 0; i < branch.size(); ++i)
+        {
+            // the models of the current head and its neighbours are kept, so that a single
+            // undo/redo doesn't have to reconstruct a model
+            bool const keepModel =
+                branch[i].getID() == req.currentHead ||
+                (i > 0 && branch[i-1].getID() == req.currentHead) ||
+                (i+1 < branch.size() && branch[i+1].getID() == req.currentHead);
+
+            branch[i].compact(i > 0 ? &branch[i-1] : nullptr, keepModel);
+        }
+
+        size_t numBytes = 0;
+        int numUndos = -1;  // i.e. the current head hasn't been reached yet
+        for (osc::ModelStateCommit const& c : branch)
+        {
+            if (c.getID() == req.currentHead)
+            {
+                numUndos = 0;
+            }
+            else if (numUndos >= 0)
+            {
+                ++numUndos;
+            }
+
+            numBytes += c.getNumSerializedBytes();
+
+            if (numBytes > req.memoryBudget && numUndos > c_MinUndo)
+            {
+                return c.getID();
+            }
+        }
+        return std::nullopt;
+    }
+
+    // compacts a commit history on a background thread
+    //
+    // requests are coalesced: if compactions are requested while one is running, then only the
+    // latest request runs after it, so that (e.g.) a quick sequence of undos doesn't compact
+    // against a stale current head
+    class HistoryCompactor final {
+    public:
+        HistoryCompactor() = default;
+
+        // copies don't share (or wait for) the original's compactions
+        HistoryCompactor(HistoryCompactor const&) :
+            HistoryCompactor{}
+        {
+        }
+        HistoryCompactor(HistoryCompactor&&) noexcept = default;
+        HistoryCompactor& operator=(HistoryCompactor const&)
+        {
+            m_Shared = std::make_shared<Shared>();
+            return *this;
+        }
+        HistoryCompactor& operator=(HistoryCompactor&&) noexcept = default;
+        ~HistoryCompactor() noexcept = default;
+
+        void request(HistoryCompactionRequest req)
+        {
+            {
+                std::lock_guard lock{m_Shared->mutex};
+                m_Shared->maybePending = std::move(req);
+                if (m_Shared->isRunning)
+                {
+                    return;  // the running task picks up the request once it's done
+                }
+                m_Shared->isRunning = true;
+            }
+            GetHistoryCompactionThreadPool().submit([shared = m_Shared]() { Run(*shared); });
+        }
+
+        // blocks until all requested compactions have finished
+        void wait()
+        {
+            std::unique_lock lock{m_Shared->mutex};
+            m_Shared->condition.wait(lock, [this]() { return !m_Shared->isRunning; });
+        }
+
+        // returns (and clears) the erase point that the most recent compaction found, if any
+        std::optional<osc::UID> takeGarbageCollectionPoint()
+        {
+            std::lock_guard lock{m_Shared->mutex};
+            return std::exchange(m_Shared->maybeGarbageCollectionPoint, std::nullopt);
+        }
+
+    private:
+        struct Shared final {
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::optional<HistoryCompactionRequest> maybePending;
+            bool isRunning = false;
+            std::optional<osc::UID> maybeGarbageCollectionPoint;
+        };
+
+        static void Run(Shared& shared)
+        {
+            while (true)
+            {
+                std::optional<HistoryCompactionRequest> req;
+                {
+                    std::lock_guard lock{shared.mutex};
+                    req = std::exchange(shared.maybePending, std::nullopt);
+                    if (!req)
+                    {
+                        shared.isRunning = false;
+                        shared.condition.notify_all();
+                        return;
+                    }
+                }
+
+                std::optional<osc::UID> gcPoint;
+                try
+                {
+                    gcPoint = CompactHistory(*req);
+                }
+                catch (std::exception const& ex)
+                {
+                    osc::log::error("exception occurred while compacting a model's undo/redo history: %s", ex.what());
+                }
+
+                std::lock_guard lock{shared.mutex};
+                shared.maybeGarbageCollectionPoint = gcPoint;
+            }
+        }
+
+        std::shared_ptr<Shared> m_Shared = std::make_shared<Shared>();
+    };
+
     std::unique_ptr<OpenSim::Model> makeNewModel()
     {
         auto rv = std::make_unique<OpenSim::Model>();
@@ -55,6 +214,7 @@ namespace
         UiModelStatePair(std::unique_ptr<OpenSim::Model> _model) :
             m_Model{std::move(_model)},
             m_ModelVersion{},
+            m_StateVersion{},
             m_FixupScaleFactor{1.0f},
             m_MaybeSelected{},
             m_MaybeHovered{}
@@ -66,6 +226,7 @@ namespace
         UiModelStatePair(UiModelStatePair const& other) :
             m_Model{std::make_unique<OpenSim::Model>(*other.m_Model)},
             m_ModelVersion{},
+            m_StateVersion{},
             m_FixupScaleFactor{other.m_FixupScaleFactor},
             m_MaybeSelected{other.m_MaybeSelected},
             m_MaybeHovered{other.m_MaybeHovered}
@@ -86,10 +247,77 @@ namespace
 
         OpenSim::Model& updModel()
         {
+            // the caller is expected to (re)initialize the model, which supersedes any preview
             m_ModelVersion = osc::UID{};
+            m_StateVersion = m_ModelVersion;
+            m_IsPreviewing = false;
+            m_IsBeingEdited = true;
+            m_SystemBeforeEdit = m_Model->hasSystem() ? &m_Model->getSystem() : nullptr;
+            return *m_Model;
+        }
+
+        // returns `true` if the model was (successfully) re-initialized (e.g. by `osc::InitializeModel`)
+        // after the caller was last given mutable access to it via `updModel`
+        //
+        // (initializing the model rebuilds its system, so this is detected by the system changing)
+        bool wasReinitializedSinceUpdModel() const
+        {
+            return
+                m_IsBeingEdited &&
+                m_Model->hasSystem() &&
+                &m_Model->getSystem() != m_SystemBeforeEdit &&
+                m_Model->isObjectUpToDateWithProperties();
+        }
+
+        OpenSim::Model& updModelForPreview()
+        {
+            m_StateVersion = osc::UID{};
+            m_IsPreviewing = true;
+            m_IsBeingEdited = true;
             return *m_Model;
         }
 
+        void realizePreview()
+        {
+            SimTK::State const& state = m_Model->getWorkingState();
+
+            // the edit may have changed properties that the (already realized) position stage
+            // depends on (e.g. a station's location), so it has to be recomputed
+            state.invalidateAllCacheAtOrAbove(SimTK::Stage::Position);
+            m_Model->realizePosition(state);
+
+            m_StateVersion = osc::UID{};
+            m_IsPreviewing = true;
+        }
+
+        bool isPreviewing() const
+        {
+            return m_IsPreviewing;
+        }
+
+        void finishPreview()
+        {
+            if (!m_IsPreviewing)
+            {
+                return;
+            }
+
+            OSC_PERF("UiModelStatePair/finishPreview");
+            SimTK::State& state = m_Model->updWorkingState();
+            m_Model->equilibrateMuscles(state);
+            m_Model->realizeDynamics(state);
+
+            m_StateVersion = osc::UID{};
+            m_IsPreviewing = false;
+        }
+
+        // called when the caller has finished editing the model (e.g. because it was committed)
+        void finishEditing()
+        {
+            finishPreview();
+            m_IsBeingEdited = false;
+        }
+
         osc::UID implGetModelVersion() const final
         {
             return m_ModelVersion;
@@ -97,17 +325,33 @@ namespace
 
         void setModelVersion(osc::UID version)
         {
+            // (e.g. a rollback): the caller has finished editing the model
             m_ModelVersion = version;
+            m_IsBeingEdited = false;
         }
 
         SimTK::State const& implGetState() const final
+        {
+            SimTK::State const& state = m_Model->getWorkingState();
+            if (m_IsPreviewing && state.getSystemStage() < SimTK::Stage::Dynamics)
+            {
+                // a preview is only realized to `SimTK::Stage::Position`, but general readers
+                // (e.g. output plots) may read velocity- or force-dependent outputs, so realize
+                // the rest of it lazily (muscles are still equilibrated by `finishPreview`)
+                OSC_PERF("UiModelStatePair/implGetState: realize preview to Dynamics");
+                m_Model->realizeDynamics(state);
+            }
+            return state;
+        }
+
+        SimTK::State const& implGetStateForRendering() const final
         {
             return m_Model->getWorkingState();
         }
 
         osc::UID implGetStateVersion() const final
         {
-            return m_ModelVersion;
+            return m_StateVersion;
         }
 
         float implGetFixupScaleFactor() const final
@@ -132,7 +376,7 @@ namespace
 
         OpenSim::Component const* implGetSelected() const final
         {
-            return osc::FindComponent(*m_Model, m_MaybeSelected);
+            return findComponent(m_MaybeSelected);
         }
 
         void implSetSelected(OpenSim::Component const* c) final
@@ -152,7 +396,7 @@ namespace
 
         OpenSim::Component const* implGetHovered() const final
         {
-            return osc::FindComponent(*m_Model, m_MaybeHovered);
+            return findComponent(m_MaybeHovered);
         }
 
         void implSetHovered(OpenSim::Component const* c) final
@@ -161,9 +405,34 @@ namespace
         }
 
     private:
+        OpenSim::Component const* findComponent(OpenSim::ComponentPath const& p) const
+        {
+            if (m_IsBeingEdited)
+            {
+                // the caller may be adding/removing components without (yet) changing the
+                // version, so the index can't be trusted
+                return osc::FindComponent(*m_Model, p);
+            }
+            return osc::FindComponent(m_PathIndex, *m_Model, m_ModelVersion, p);
+        }
+
         // the model, finalized from its properties
         std::unique_ptr<OpenSim::Model> m_Model;
         osc::UID m_ModelVersion;
+        osc::UID m_StateVersion;
+
+        // `true` if the working state has only been realized for a preview (see `realizePreview`)
+        bool m_IsPreviewing = false;
+
+        // `true` if the model may have been edited since the model version was last changed, i.e.
+        // since a caller was given mutable access to it and hasn't yet committed (or rolled back)
+        bool m_IsBeingEdited = false;
+
+        // the model's system when a caller was last given mutable access via `updModel` (if any)
+        SimTK::MultibodySystem const* m_SystemBeforeEdit = nullptr;
+
+        // lazily-built lookup for the selection/hover paths, which are resolved at least once per frame
+        mutable osc::ComponentPathIndex m_PathIndex;
 
         // fixup scale factor of the model
         //
@@ -310,8 +579,15 @@ public:
             return false;  // commit isn't in this model's storage (is it from another model?)
         }
 
+        if (!dropIfInitializationFailed(commit.getID()))
+        {
+            return false;
+        }
+
         m_CurrentHead = commit.getID();
         checkout();
+        garbageCollectOverBudget();
+        compactHistory();
         return true;
     }
 
@@ -332,6 +608,26 @@ public:
         m_Scratch = std::move(p);
     }
 
+    OpenSim::Model& updModelForPreview()
+    {
+        return m_Scratch.updModelForPreview();
+    }
+
+    void realizePreview()
+    {
+        m_Scratch.realizePreview();
+    }
+
+    bool isPreviewing() const
+    {
+        return m_Scratch.isPreviewing();
+    }
+
+    void finishPreview()
+    {
+        m_Scratch.finishPreview();
+    }
+
     UID getModelVersion() const
     {
         return m_Scratch.getModelVersion();
@@ -347,6 +643,11 @@ public:
         return m_Scratch.getState();
     }
 
+    SimTK::State const& getStateForRendering() const
+    {
+        return m_Scratch.getStateForRendering();
+    }
+
     UID getStateVersion() const
     {
         return m_Scratch.getStateVersion();
@@ -382,11 +683,41 @@ public:
         m_Scratch.setHovered(c);
     }
 
+    size_t getHistoryMemoryBudget() const
+    {
+        return m_HistoryMemoryBudget;
+    }
+
+    void setHistoryMemoryBudget(size_t numBytes)
+    {
+        m_HistoryMemoryBudget = numBytes;
+        garbageCollect();
+    }
+
+    void waitForHistoryCompaction()
+    {
+        m_Compactor.wait();
+        garbageCollectOverBudget();
+    }
+
 private:
 
     UID doCommit(std::string_view message)
     {
-        auto commit = ModelStateCommit{m_Scratch, std::move(message), m_CurrentHead};
+        // if the action that's being committed just (successfully) initialized the scratch model
+        // after editing it, then initializing a copy of it is very likely to succeed, so the
+        // (slow) initialization can happen in the background while the user carries on. The
+        // commit is still immediately added to the commit graph, so that undo/redo behave
+        // the same: they just wait for the commit to be ready if they need its model (and
+        // drop it if its initialization failed anyway, see `dropIfInitializationFailed`)
+        ModelStateCommitStrategy const strategy = m_Scratch.wasReinitializedSinceUpdModel() ?
+            ModelStateCommitStrategy::Asynchronous :
+            ModelStateCommitStrategy::Synchronous;
+
+        // finish any preview edit, so that the (committed) scratch state is fully realized
+        m_Scratch.finishEditing();
+
+        auto commit = ModelStateCommit{m_Scratch, std::move(message), m_CurrentHead, strategy};
         UID commitID = commit.getID();
 
         m_Commits.try_emplace(commitID, std::move(commit));
@@ -479,13 +810,6 @@ private:
         return c;
     }
 
-    // returns the UID that is the nth ancestor from `a`, or empty if there are insufficient ancestors
-    UID nthAncestorID(UID a, int n) const
-    {
-        ModelStateCommit const* c = nthAncestor(a, n);
-        return c ? c->getID() : UID::empty();
-    }
-
     // returns `true` if `maybeAncestor` is an ancestor of `id`
     bool isAncestor(UID maybeAncestor, UID id)
     {
@@ -513,31 +837,55 @@ private:
         }
     }
 
-    // garbage collect (erase) commits that fall outside the maximum undo depth
-    void garbageCollectMaxUndo()
+    // returns `true` if the commit's model is usable (i.e. it can be checked out)
+    //
+    // if the commit's (background) initialization failed, it's dropped from the history and
+    // `false` is returned. Dropping a commit also drops the commits that can only be reached
+    // through it: its ancestors (if it's older than the current head) or its descendants (if
+    // it's the current head, which moves to its parent, or a redoable commit)
+    bool dropIfInitializationFailed(UID id)
     {
-        static_assert(c_MaxUndo >= 0);
+        ModelStateCommit const* c = tryGetCommitByID(id);
+        if (!c)
+        {
+            return false;
+        }
+        if (!c->failedToInitialize())
+        {
+            return true;
+        }
+
+        log::error("the model of the '%s' commit couldn't be initialized: dropping it from the undo/redo history", c->getCommitMessage().c_str());
 
-        UID firstBadCommitIDOrEmpty = nthAncestorID(m_CurrentHead, c_MaxUndo + 1);
-        eraseCommitRange(firstBadCommitIDOrEmpty, UID::empty());
+        UID const parent = c->getParentID();
+        if (id != m_CurrentHead && isAncestor(id, m_CurrentHead))
+        {
+            eraseCommitRange(id, UID::empty());
+        }
+        else if (id != m_CurrentHead || hasCommit(parent))
+        {
+            if (id == m_CurrentHead)
+            {
+                m_CurrentHead = parent;
+            }
+            m_BranchHead = parent;
+            garbageCollectUnreachable();
+        }
+        return false;
     }
 
-    // garbage collect (erase) commits that fall outside the maximum redo depth
-    void garbageCollectMaxRedo()
+    // garbage collect (erase) the oldest commits that the last (background) compaction found
+    // to be over the memory budget
+    //
+    // the erase point is re-checked against the current head, because the user may have
+    // undone/redone/committed since the compaction's snapshot was taken
+    void garbageCollectOverBudget()
     {
-        static_assert(c_MaxRedo >= 0);
-
-        int numRedos = distance(m_BranchHead, m_CurrentHead);
-        int numDeletions = numRedos - c_MaxRedo;
-
-        if (numDeletions <= 0)
+        std::optional<UID> const maybeEraseFrom = m_Compactor.takeGarbageCollectionPoint();
+        if (maybeEraseFrom && distance(m_CurrentHead, *maybeEraseFrom) > c_MinUndo)
         {
-            return;
+            eraseCommitRange(*maybeEraseFrom, UID::empty());
         }
-
-        UID newBranchHead = nthAncestorID(m_BranchHead, numDeletions);
-        eraseCommitRange(m_BranchHead, newBranchHead);
-        m_BranchHead = newBranchHead;
     }
 
     void garbageCollectUnreachable()
@@ -558,9 +906,23 @@ private:
     // remove out-of-bounds, deleted, out-of-date, etc. commits
     void garbageCollect()
     {
-        garbageCollectMaxUndo();
-        garbageCollectMaxRedo();
         garbageCollectUnreachable();
+        garbageCollectOverBudget();
+        compactHistory();
+    }
+
+    // compacts the branch's commits on a background thread (see `CompactHistory`)
+    //
+    // any commits that the compaction finds to be over the memory budget are erased by the
+    // next call to `garbageCollectOverBudget`
+    void compactHistory()
+    {
+        HistoryCompactionRequest req{{}, m_CurrentHead, m_HistoryMemoryBudget};
+        for (ModelStateCommit const* c = tryGetCommitByID(m_BranchHead); c; c = tryGetCommitByID(c->getParentID()))
+        {
+            req.branch.push_back(*c);
+        }
+        m_Compactor.request(std::move(req));
     }
 
     // returns commit ID of the currently active checkout
@@ -578,6 +940,15 @@ private:
         // scratch space - things like reset and scaling state, which the
         // user might expect to be maintained even if a crash happened
 
+        // (if the head's initialization failed, then it's dropped and its parent is checked out)
+        for (UID head = m_CurrentHead; !dropIfInitializationFailed(m_CurrentHead); head = m_CurrentHead)
+        {
+            if (m_CurrentHead == head)
+            {
+                return;  // nothing (usable) to checkout
+            }
+        }
+
         ModelStateCommit const* c = tryGetCommitByID(m_CurrentHead);
 
         if (c)
@@ -603,7 +974,7 @@ private:
 
         ModelStateCommit const* parent = tryGetCommitByID(c->getParentID());
 
-        if (!parent)
+        if (!parent || !dropIfInitializationFailed(parent->getID()))
         {
             return;
         }
@@ -618,6 +989,9 @@ private:
 
         m_Scratch = std::move(newModel);
         m_CurrentHead = parent->getID();
+
+        garbageCollectOverBudget();
+        compactHistory();
     }
 
     // performs a redo, if possible
@@ -632,7 +1006,7 @@ private:
 
         ModelStateCommit const* c = nthAncestor(m_BranchHead, dist - 1);
 
-        if (!c)
+        if (!c || !dropIfInitializationFailed(c->getID()))
         {
             return;
         }
@@ -647,6 +1021,9 @@ private:
 
         m_Scratch = std::move(newModel);
         m_CurrentHead = c->getID();
+
+        garbageCollectOverBudget();
+        compactHistory();
     }
 
     std::filesystem::path const& getFilesystemLocation() const
@@ -685,6 +1062,12 @@ private:
 
     // (maybe) the version of the model that was last saved to disk
     UID m_MaybeCommitSavedToDisk = UID::empty();
+
+    // maximum number of bytes that the (compacted) commits may use before older commits are erased
+    size_t m_HistoryMemoryBudget = c_DefaultHistoryMemoryBudget;
+
+    // compacts (and measures) the history in the background
+    HistoryCompactor m_Compactor;
 };
 
 
@@ -797,11 +1180,46 @@ bool osc::UndoableModelStatePair::tryCheckout(ModelStateCommit const& commit)
     return m_Impl->tryCheckout(commit);
 }
 
+size_t osc::UndoableModelStatePair::getHistoryMemoryBudget() const
+{
+    return m_Impl->getHistoryMemoryBudget();
+}
+
+void osc::UndoableModelStatePair::setHistoryMemoryBudget(size_t numBytes)
+{
+    m_Impl->setHistoryMemoryBudget(numBytes);
+}
+
+void osc::UndoableModelStatePair::waitForHistoryCompaction()
+{
+    m_Impl->waitForHistoryCompaction();
+}
+
 OpenSim::Model& osc::UndoableModelStatePair::updModel()
 {
     return m_Impl->updModel();
 }
 
+OpenSim::Model& osc::UndoableModelStatePair::updModelForPreview()
+{
+    return m_Impl->updModelForPreview();
+}
+
+void osc::UndoableModelStatePair::realizePreview()
+{
+    m_Impl->realizePreview();
+}
+
+bool osc::UndoableModelStatePair::isPreviewing() const
+{
+    return m_Impl->isPreviewing();
+}
+
+void osc::UndoableModelStatePair::finishPreview()
+{
+    m_Impl->finishPreview();
+}
+
 void osc::UndoableModelStatePair::setModel(std::unique_ptr<OpenSim::Model> newModel)
 {
     m_Impl->setModel(std::move(newModel));
@@ -827,6 +1245,11 @@ SimTK::State const& osc::UndoableModelStatePair::implGetState() const
     return m_Impl->getState();
 }
 
+SimTK::State const& osc::UndoableModelStatePair::implGetStateForRendering() const
+{
+    return m_Impl->getStateForRendering();
+}
+
 osc::UID osc::UndoableModelStatePair::implGetStateVersion() const
 {
     return m_Impl->getStateVersion();
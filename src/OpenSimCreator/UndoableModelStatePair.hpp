@@ -4,6 +4,7 @@
 
 #include <oscar/Utils/UID.hpp>
 
+#include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <string_view>
@@ -87,6 +88,18 @@ namespace osc
         // try to checkout the given commit as the latest commit
         bool tryCheckout(ModelStateCommit const&);
 
+        // get/set the (approximate) maximum number of bytes that the undo/redo history may use
+        //
+        // the history is compacted (and measured) in the background, so older commits are erased
+        // by the next commit/undo/redo after the (compacted) history exceeds the budget, but at
+        // least one undo is always kept
+        size_t getHistoryMemoryBudget() const;
+        void setHistoryMemoryBudget(size_t);
+
+        // blocks until the history's background compaction has finished, and then erases any
+        // commits that it found to be over the budget (handy for testing)
+        void waitForHistoryCompaction();
+
         // read/manipulate underlying OpenSim::Model
         //
         // note: mutating anything may trigger an automatic undo/redo save if `isDirty` returns `true`
@@ -94,11 +107,27 @@ namespace osc
         void setModel(std::unique_ptr<OpenSim::Model>);
         void setModelVersion(UID);
 
+        // transient ("preview") edits, for continuous interactions (e.g. each tick of a
+        // coordinate or gizmo drag) that are committed once the interaction ends
+        //
+        // unlike `updModel`, `updModelForPreview` only bumps the state version, so caches that
+        // depend on the model (e.g. decorations) survive each tick. It should only be used for
+        // edits that don't require reinitializing the model (e.g. coordinate values, station
+        // locations). `realizePreview` only realizes the edited state to `SimTK::Stage::Position`,
+        // which is enough to render the model (see `getStateForRendering`): `getState` realizes
+        // the rest of a preview's state on demand, and muscle equilibration is deferred until
+        // `finishPreview` (or `commit`) is called
+        OpenSim::Model& updModelForPreview();
+        void realizePreview();
+        bool isPreviewing() const;
+        void finishPreview();
+
     private:
         OpenSim::Model const& implGetModel() const final;
         UID implGetModelVersion() const final;
 
         SimTK::State const& implGetState() const final;
+        SimTK::State const& implGetStateForRendering() const final;
         UID implGetStateVersion() const final;
 
         float implGetFixupScaleFactor() const final;
@@ -33,6 +33,17 @@ namespace osc
             return implGetState();
         }
 
+        // returns a state that's realized to at least `SimTK::Stage::Position`, which is enough
+        // to render the model
+        //
+        // renderers should prefer this over `getState`, because implementations that defer
+        // realizing the rest of the state (e.g. while previewing an edit) can return it without
+        // realizing it any further
+        SimTK::State const& getStateForRendering() const
+        {
+            return implGetStateForRendering();
+        }
+
         // used for UI caching
         UID getModelVersion() const
         {
@@ -70,6 +81,10 @@ namespace osc
     private:
         virtual OpenSim::Model const& implGetModel() const = 0;
         virtual SimTK::State const& implGetState() const = 0;
+        virtual SimTK::State const& implGetStateForRendering() const
+        {
+            return implGetState();
+        }
         virtual UID implGetModelVersion() const
         {
             // assume the version always changes, unless the concrete implementation
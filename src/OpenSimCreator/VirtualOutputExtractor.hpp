@@ -2,6 +2,7 @@
 
 #include <nonstd/span.hpp>
 
+#include <functional>
 #include <string>
 
 namespace OpenSim { class Component; }
@@ -46,6 +47,18 @@ namespace osc
         virtual std::string getValueString(OpenSim::Component const&,
                                            SimulationReport const&) const = 0;
 
+        // returns a function that extracts a float from a report that was produced by
+        // (a state of) the given component
+        //
+        // implementations may resolve anything that only depends on the component (e.g.
+        // path lookups) once, up-front, so that calling the function is cheaper than
+        // repeatedly calling `getValueFloat`. The returned function refers to both this
+        // extractor and the component, so it must not outlive either of them
+        virtual std::function<float(SimulationReport const&)> bindValueFloat(OpenSim::Component const& c) const
+        {
+            return [this, &c](SimulationReport const& r) { return getValueFloat(c, r); };
+        }
+
         virtual std::size_t getHash() const = 0;
         virtual bool equals(VirtualOutputExtractor const&) const = 0;
     };
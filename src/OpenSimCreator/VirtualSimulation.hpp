@@ -5,10 +5,11 @@
 #include "OpenSimCreator/SimulationStatus.hpp"
 
 #include <oscar/Utils/SynchronizedValue.hpp>
+#include <oscar/Utils/UID.hpp>
 
 #include <nonstd/span.hpp>
 
-#include <vector>
+#include <optional>
 
 namespace osc { class OutputExtractor; }
 namespace osc { class ParamBlock; }
@@ -26,13 +27,28 @@ namespace osc
     class VirtualSimulation {
     protected:
         VirtualSimulation() = default;
-        VirtualSimulation(VirtualSimulation const&) = default;
+        VirtualSimulation(VirtualSimulation const&)  // copies are different simulations
+        {
+        }
         VirtualSimulation(VirtualSimulation&&) noexcept = default;
-        VirtualSimulation& operator=(VirtualSimulation const&) = default;
+        VirtualSimulation& operator=(VirtualSimulation const&)
+        {
+            m_ID.reset();
+            return *this;
+        }
         VirtualSimulation& operator=(VirtualSimulation&&) noexcept = default;
     public:
         virtual ~VirtualSimulation() noexcept = default;
 
+        // returns an ID that is unique to this simulation for the lifetime of the process
+        //
+        // unlike the simulation's address, the ID is never reused by a later simulation, so
+        // callers can use it to key data they cache between frames (e.g. output values)
+        UID getID() const
+        {
+            return m_ID;
+        }
+
         // the reason why the model is mutex-guarded is because OpenSim has a bunch of
         // `const-` interfaces that are only "logically const" in a single-threaded
         // environment.
@@ -54,11 +70,20 @@ namespace osc
             return implGetSimulationReport(reportIndex);
         }
 
-        std::vector<SimulationReport> getAllSimulationReports() const
+        // care: the returned span is only valid until the next call into the simulation
+        nonstd::span<SimulationReport const> getAllSimulationReports() const
         {
             return implGetAllSimulationReports();
         }
 
+        // returns the time of each report, in report order (i.e. ascending)
+        //
+        // care: the returned span is only valid until the next call into the simulation
+        nonstd::span<double const> getReportTimes() const
+        {
+            return implGetReportTimes();
+        }
+
         SimulationStatus getStatus() const
         {
             return implGetStatus();
@@ -94,6 +119,17 @@ namespace osc
             return implGetOutputExtractors();
         }
 
+        // returns the value of the given output for each report in the simulation, if
+        // the simulation computed those values while it was producing the reports (e.g.
+        // on a background thread), or `std::nullopt` if the caller should extract them
+        // from the reports itself
+        //
+        // care: the returned span is only valid until the next call into the simulation
+        std::optional<nonstd::span<float const>> getPrecomputedOutputValues(OutputExtractor const& output) const
+        {
+            return implGetPrecomputedOutputValues(output);
+        }
+
         void requestStop()
         {
             implRequestStop();
@@ -120,7 +156,8 @@ namespace osc
 
         virtual int implGetNumReports() const = 0;
         virtual SimulationReport implGetSimulationReport(int reportIndex) const = 0;
-        virtual std::vector<SimulationReport> implGetAllSimulationReports() const = 0;
+        virtual nonstd::span<SimulationReport const> implGetAllSimulationReports() const = 0;
+        virtual nonstd::span<double const> implGetReportTimes() const = 0;
 
         virtual SimulationStatus implGetStatus() const = 0;
         virtual SimulationClock::time_point implGetCurTime() const = 0;
@@ -129,11 +166,17 @@ namespace osc
         virtual float implGetProgress() const = 0;
         virtual ParamBlock const& implGetParams() const = 0;
         virtual nonstd::span<OutputExtractor const> implGetOutputExtractors() const = 0;
+        virtual std::optional<nonstd::span<float const>> implGetPrecomputedOutputValues(OutputExtractor const&) const
+        {
+            return std::nullopt;  // by default, nothing is precomputed
+        }
 
         virtual void implRequestStop() = 0;
         virtual void implStop() = 0;
 
         virtual float implGetFixupScaleFactor() const = 0;
         virtual void implSetFixupScaleFactor(float) = 0;
+
+        UID m_ID;
     };
 }
@@ -8,11 +8,13 @@
 #include "OpenSimCreator/VirtualOutputExtractor.hpp"
 
 #include <oscar/Bindings/ImGuiHelpers.hpp>
+#include <oscar/Formats/ColumnarBinary.hpp>
 #include <oscar/Platform/Log.hpp>
 #include <oscar/Platform/os.hpp>
 #include <oscar/Utils/Assertions.hpp>
 #include <oscar/Utils/Perf.hpp>
 #include <oscar/Utils/SynchronizedValue.hpp>
+#include <oscar/Utils/UID.hpp>
 
 #include <glm/vec2.hpp>
 #include <imgui.h>
@@ -23,12 +25,17 @@
 #include <SimTKcommon.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <optional>
 #include <ostream>
 #include <ratio>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -91,15 +98,99 @@ namespace
         return csvPath.string();
     }
 
-    std::vector<float> PopulateFirstNNumericOutputValues(
-        OpenSim::Model const& model,
-        nonstd::span<osc::SimulationReport const> reports,
-        osc::VirtualOutputExtractor const& output)
+    // the value of an output for each report in a simulation, cached between frames
+    //
+    // a simulation's reports are append-only, so updating the cache only extracts (or copies)
+    // the values of the reports that were added since the previous update
+    class CachedOutputValues final {
+    public:
+        CachedOutputValues(osc::UID simulationID, osc::OutputExtractor output) :
+            m_SimulationID{simulationID},
+            m_Output{std::move(output)}
+        {
+        }
+
+        bool isFor(osc::VirtualSimulation const& sim, osc::OutputExtractor const& output) const
+        {
+            return sim.getID() == m_SimulationID && output == m_Output;
+        }
+
+        nonstd::span<float const> update(osc::VirtualSimulation& sim)
+        {
+            OSC_ASSERT(sim.getID() == m_SimulationID);
+
+            if (std::optional<nonstd::span<float const>> const precomputed = sim.getPrecomputedOutputValues(m_Output))
+            {
+                appendNewValues(*precomputed);
+            }
+            else
+            {
+                nonstd::span<osc::SimulationReport const> const reports = sim.getAllSimulationReports();
+                if (reports.size() < m_Values.size())
+                {
+                    m_Values.clear();
+                }
+                size_t const numExisting = m_Values.size();
+                m_Values.resize(reports.size());
+                m_Output.getValuesFloat(
+                    *sim.getModel(),
+                    reports.subspan(numExisting),
+                    nonstd::span<float>{m_Values}.subspan(numExisting)
+                );
+            }
+
+            return m_Values;
+        }
+
+    private:
+        void appendNewValues(nonstd::span<float const> allValues)
+        {
+            if (allValues.size() < m_Values.size())
+            {
+                m_Values.clear();
+            }
+            auto const newValues = allValues.subspan(m_Values.size());
+            m_Values.insert(m_Values.end(), newValues.begin(), newValues.end());
+        }
+
+        osc::UID m_SimulationID;
+        osc::OutputExtractor m_Output;
+        std::vector<float> m_Values;
+    };
+
+    // returns the value of `output` for each report in the simulation
+    //
+    // the values are cached in a (UI-thread-only) cache that's shared by the plots and the
+    // exporters, so exporting an output only extracts the values that haven't been cached
+    // yet (e.g. by a plot of the same output)
+    //
+    // care: the returned span is only valid until the next call to this function
+    nonstd::span<float const> GetOutputValuesCached(
+        osc::VirtualSimulation& sim,
+        osc::OutputExtractor const& output)
     {
-        std::vector<float> rv;
-        rv.resize(reports.size());
-        output.getValuesFloat(model, reports, rv);
-        return rv;
+        constexpr size_t c_MaxCachedOutputs = 256;
+        static std::vector<CachedOutputValues> s_Caches;  // most-recently-used first
+
+        auto const it = std::find_if(s_Caches.begin(), s_Caches.end(), [&sim, &output](CachedOutputValues const& c)
+        {
+            return c.isFor(sim, output);
+        });
+
+        if (it != s_Caches.end())
+        {
+            std::rotate(s_Caches.begin(), it, it + 1);
+        }
+        else
+        {
+            if (s_Caches.size() >= c_MaxCachedOutputs)
+            {
+                s_Caches.pop_back();  // evict least-recently-used (e.g. a since-deleted simulation)
+            }
+            s_Caches.emplace(s_Caches.begin(), sim.getID(), output);
+        }
+
+        return s_Caches.front().update(sim);
     }
 
     std::vector<float> PopulateFirstNTimeValues(nonstd::span<osc::SimulationReport const> reports)
@@ -108,24 +199,53 @@ namespace
         times.reserve(reports.size());
         for (osc::SimulationReport const& r : reports)
         {
-            times.push_back(static_cast<float>(r.getState().getTime()));
+            times.push_back(static_cast<float>(r.getTime().time_since_epoch().count()));
         }
         return times;
     }
 
+    // the time of each report in a simulation, cached between frames
+    //
+    // keyed on the simulation's ID and number of reports, so that updating the cache only
+    // converts the times of the reports that were added since the previous update
+    class CachedReportTimes final {
+    public:
+        nonstd::span<float const> update(osc::VirtualSimulation const& sim)
+        {
+            nonstd::span<osc::SimulationReport const> const reports = sim.getAllSimulationReports();
+            if (sim.getID() != m_SimulationID || reports.size() < m_Times.size())
+            {
+                m_SimulationID = sim.getID();
+                m_Times.clear();
+            }
+
+            m_Times.reserve(reports.size());
+            for (osc::SimulationReport const& r : reports.subspan(m_Times.size()))
+            {
+                m_Times.push_back(static_cast<float>(r.getTime().time_since_epoch().count()));
+            }
+            return m_Times;
+        }
+
+    private:
+        osc::UID m_SimulationID = osc::UID::empty();
+        std::vector<float> m_Times;
+    };
+
     std::string TryExportNumericOutputToCSV(
         osc::VirtualSimulation& sim,
-        osc::VirtualOutputExtractor const& output)
+        osc::OutputExtractor const& output)
     {
         OSC_ASSERT(output.getOutputType() == osc::OutputType::Float);
 
-        std::vector<osc::SimulationReport> reports = sim.getAllSimulationReports();
-        std::vector<float> values = PopulateFirstNNumericOutputValues(*sim.getModel(), reports, output);
-        std::vector<float> times = PopulateFirstNTimeValues(reports);
+        std::vector<float> times = PopulateFirstNTimeValues(sim.getAllSimulationReports());
+        nonstd::span<float const> values = GetOutputValuesCached(sim, output);
 
+        // care: the simulation may have produced more reports in-between collecting
+        // the values and the times
         return ExportTimeseriesToCSV(times.data(),
             values.data(),
-            times.size(),
+            std::min(times.size(), values.size()),
             output.getName().c_str());
     }
 
@@ -173,10 +293,52 @@ namespace
         DrawToggleWatchOutputMenuItem(api, output);
     }
 
+    // the values of some outputs, collected column-by-column
+    struct CollectedOutputColumns final {
+        std::vector<double> times;
+        std::vector<std::vector<float>> columns;  // empty for non-float outputs
+        size_t numRows = 0;
+    };
+
+    CollectedOutputColumns CollectOutputColumns(osc::VirtualSimulation& sim, nonstd::span<osc::OutputExtractor const> outputs)
+    {
+        CollectedOutputColumns rv;
+
+        // collect all data column-by-column
+        //
+        // care: the simulation may produce more reports while the columns are being
+        // collected, so only the first N rows (that all columns have) are usable
+        rv.columns.reserve(outputs.size());
+        for (osc::OutputExtractor const& o : outputs)
+        {
+            if (o.getOutputType() == osc::OutputType::Float)
+            {
+                nonstd::span<float const> const values = GetOutputValuesCached(sim, o);
+                rv.columns.emplace_back(values.begin(), values.end());
+            }
+            else
+            {
+                rv.columns.emplace_back();
+            }
+        }
+        nonstd::span<double const> const times = sim.getReportTimes();
+        rv.times.assign(times.begin(), times.end());
+
+        rv.numRows = rv.times.size();
+        for (size_t i = 0; i < outputs.size(); ++i)
+        {
+            if (outputs[i].getOutputType() == osc::OutputType::Float)
+            {
+                rv.numRows = std::min(rv.numRows, rv.columns[i].size());
+            }
+        }
+
+        return rv;
+    }
+
     std::filesystem::path TryExportOutputsToCSV(osc::VirtualSimulation& sim, nonstd::span<osc::OutputExtractor const> outputs)
     {
-        std::vector<osc::SimulationReport> reports = sim.getAllSimulationReports();
-        std::vector<float> times = PopulateFirstNTimeValues(reports);
+        CollectedOutputColumns const data = CollectOutputColumns(sim, outputs);
 
         // try prompt user for save location
         std::optional<std::filesystem::path> const maybeCSVPath =
@@ -207,15 +369,13 @@ namespace
 
 
         // data lines
-        auto guard = sim.getModel();
-        for (size_t i = 0; i < reports.size(); ++i)
+        for (size_t row = 0; row < data.numRows; ++row)
         {
-            fout << times.at(i);  // time column
+            fout << data.times[row];  // time column
 
-            osc::SimulationReport r = reports[i];
-            for (osc::OutputExtractor const& o : outputs)
+            for (std::vector<float> const& column : data.columns)
             {
-                fout << ',' << o.getValueFloat(*guard, r);
+                fout << ',' << (row < column.size() ? column[row] : NAN);
             }
 
             fout << '\n';
@@ -228,6 +388,91 @@ namespace
 
         return csvPath;
     }
+
+    std::filesystem::path TryExportOutputsToColumnarBinary(
+        osc::VirtualSimulation& sim,
+        nonstd::span<osc::OutputExtractor const> outputs,
+        osc::ColumnarBinaryCompression compression)
+    {
+        CollectedOutputColumns const data = CollectOutputColumns(sim, outputs);
+
+        // try prompt user for save location
+        std::optional<std::filesystem::path> const maybePath =
+            osc::PromptUserForFileSaveLocationAndAddExtensionIfNecessary(osc::c_ColumnarBinaryFileExtension);
+
+        if (!maybePath)
+        {
+            // user probably cancelled out
+            return "";
+        }
+        std::filesystem::path const& path = *maybePath;
+
+        // only the float outputs are written: the format only contains numeric columns
+        std::vector<osc::ColumnarBinaryColumnView> columns;
+        columns.reserve(outputs.size() + 1);
+        columns.emplace_back("time", nonstd::span<double const>{data.times}.first(data.numRows));
+        for (size_t i = 0; i < outputs.size(); ++i)
+        {
+            if (outputs[i].getOutputType() == osc::OutputType::Float)
+            {
+                columns.emplace_back(outputs[i].getName(), nonstd::span<float const>{data.columns[i]}.first(data.numRows));
+            }
+        }
+
+        std::ofstream fout{path, std::ios::binary};
+
+        if (!fout)
+        {
+            osc::log::error("%s: error opening file for writing", path.string().c_str());
+            return "";  // error opening output file for writing
+        }
+
+        try
+        {
+            osc::WriteColumnarBinary(fout, columns, compression);
+        }
+        catch (std::exception const& ex)
+        {
+            osc::log::error("%s: error encountered while writing output data: %s", path.string().c_str(), ex.what());
+            return "";
+        }
+
+        if (!fout)
+        {
+            osc::log::warn("%s: encountered error while writing output data: some of the data may have been written, but maybe not all of it", path.string().c_str());
+        }
+
+        return path;
+    }
+
+    // a timeseries, loaded from a (previously-exported) file, that is drawn over an output plot
+    struct OutputPlotOverlay final {
+        std::filesystem::path sourcePath;
+        std::vector<float> times;
+        std::vector<float> values;
+    };
+
+    // loads the column named `outputName` from a columnar binary file
+    //
+    // throws if the file cannot be loaded, or doesn't contain the necessary columns
+    OutputPlotOverlay LoadOutputPlotOverlay(std::filesystem::path const& path, std::string const& outputName)
+    {
+        std::ifstream fin{path, std::ios::binary};
+        if (!fin)
+        {
+            throw std::runtime_error{"error opening file for reading"};
+        }
+
+        osc::ColumnarBinaryContents const contents = osc::ReadColumnarBinary(fin);
+        osc::ColumnarBinaryColumn const* const times = osc::FindColumn(contents, "time");
+        osc::ColumnarBinaryColumn const* const values = osc::FindColumn(contents, outputName);
+        if (!times || !values)
+        {
+            throw std::runtime_error{"the file does not contain both a 'time' column and a column named '" + outputName + "'"};
+        }
+
+        return OutputPlotOverlay{path, osc::GetValuesAsFloats(*times), osc::GetValuesAsFloats(*values)};
+    }
 }
 
 class osc::SimulationOutputPlot::Impl final {
@@ -290,12 +535,10 @@ private:
             return;
         }
 
-        std::vector<float> buf;
+        nonstd::span<float const> buf;
         {
             OSC_PERF("collect output data");
-            std::vector<osc::SimulationReport> reports = sim.getAllSimulationReports();
-            buf.resize(reports.size());
-            m_OutputExtractor.getValuesFloat(*sim.getModel(), reports, buf);
+            buf = GetOutputValuesCached(sim, m_OutputExtractor);
         }
 
         // draw plot
@@ -312,13 +555,41 @@ private:
 
             if (ImPlot::BeginPlot("##", ImVec2(plotWidth, m_Height), ImPlotFlags_NoTitle | ImPlotFlags_NoLegend | ImPlotFlags_NoInputs | ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect | ImPlotFlags_NoChild | ImPlotFlags_NoFrame))
             {
-                ImPlot::SetupAxis(ImAxis_X1, nullptr, ImPlotAxisFlags_NoDecorations | ImPlotAxisFlags_NoMenus | ImPlotAxisFlags_AutoFit);
+                if (m_Overlay)
+                {
+                    // the overlay may have been sampled at different times, so plot both lines
+                    // against time over the simulation's time range
+                    ImPlot::SetupAxis(ImAxis_X1, nullptr, ImPlotAxisFlags_NoDecorations | ImPlotAxisFlags_NoMenus);
+                    ImPlot::SetupAxisLimits(ImAxis_X1, sim.getSimulationReport(0).getTime().time_since_epoch().count(), sim.getSimulationReport(nReports-1).getTime().time_since_epoch().count(), ImPlotCond_Always);
+                }
+                else
+                {
+                    ImPlot::SetupAxis(ImAxis_X1, nullptr, ImPlotAxisFlags_NoDecorations | ImPlotAxisFlags_NoMenus | ImPlotAxisFlags_AutoFit);
+                }
                 ImPlot::SetupAxis(ImAxis_Y1, nullptr, ImPlotAxisFlags_NoDecorations | ImPlotAxisFlags_NoMenus | ImPlotAxisFlags_AutoFit);
                 ImPlot::PushStyleColor(ImPlotCol_Line, ImVec4{1.0f, 1.0f, 1.0f, 0.7f});
                 ImPlot::PushStyleColor(ImPlotCol_PlotBg, ImVec4{0.0f, 0.0f, 0.0f, 0.0f});
-                ImPlot::PlotLine("##",
-                    buf.data(),
-                    static_cast<int>(buf.size()));
+                if (m_Overlay)
+                {
+                    nonstd::span<float const> const times = m_CachedTimes.update(sim);
+                    ImPlot::PlotLine("##",
+                        times.data(),
+                        buf.data(),
+                        static_cast<int>(std::min(times.size(), buf.size())));
+
+                    ImPlot::PushStyleColor(ImPlotCol_Line, ImVec4{1.0f, 0.5f, 0.0f, 0.7f});
+                    ImPlot::PlotLine("##overlay",
+                        m_Overlay->times.data(),
+                        m_Overlay->values.data(),
+                        static_cast<int>(std::min(m_Overlay->times.size(), m_Overlay->values.size())));
+                    ImPlot::PopStyleColor();
+                }
+                else
+                {
+                    ImPlot::PlotLine("##",
+                        buf.data(),
+                        static_cast<int>(buf.size()));
+                }
                 ImPlot::PopStyleColor();
                 ImPlot::PopStyleColor();
                 plotTopLeft = ImPlot::GetPlotPos();
@@ -332,13 +603,6 @@ private:
         }
 
 
-        // draw context menu (if user right clicks)
-        if (ImGui::BeginPopupContextItem("plotcontextmenu"))
-        {
-            DrawGenericNumericOutputContextMenuItems(*m_API, sim, m_OutputExtractor);
-            ImGui::EndPopup();
-        }
-
         // (the rest): handle scrubber overlay
         OSC_PERF("draw output plot overlay");
 
@@ -392,11 +656,57 @@ private:
                 m_API->setSimulationScrubTime(timeLoc);
             }
         }
+
+        // draw context menu (if user right clicks)
+        //
+        // care: this is drawn last because exporting the output updates the cache that `buf` points into
+        if (ImGui::BeginPopupContextItem("plotcontextmenu"))
+        {
+            DrawGenericNumericOutputContextMenuItems(*m_API, sim, m_OutputExtractor);
+            drawOverlayContextMenuItems();
+            ImGui::EndPopup();
+        }
+    }
+
+    void drawOverlayContextMenuItems()
+    {
+        if (ImGui::MenuItem(ICON_FA_FOLDER_OPEN " Load Overlay"))
+        {
+            tryLoadOverlay();
+        }
+        osc::DrawTooltipIfItemHovered("Load Overlay", "Draws a previously-exported output (from a binary columns file) over this plot, so that it can be compared to this simulation's output. The file must contain a 'time' column and a column with the same name as this output.");
+
+        if (m_Overlay && ImGui::MenuItem(ICON_FA_TIMES " Clear Overlay"))
+        {
+            m_Overlay.reset();
+        }
+    }
+
+    void tryLoadOverlay()
+    {
+        std::optional<std::filesystem::path> const maybePath =
+            osc::PromptUserForFile(osc::c_ColumnarBinaryFileExtension);
+
+        if (!maybePath)
+        {
+            return;  // user probably cancelled out
+        }
+
+        try
+        {
+            m_Overlay = LoadOutputPlotOverlay(*maybePath, m_OutputExtractor.getName());
+        }
+        catch (std::exception const& ex)
+        {
+            osc::log::error("%s: error loading output plot overlay: %s", maybePath->string().c_str(), ex.what());
+        }
     }
 
     SimulatorUIAPI* m_API;
     OutputExtractor m_OutputExtractor;
     float m_Height;
+    CachedReportTimes m_CachedTimes;
+    std::optional<OutputPlotOverlay> m_Overlay;
 };
 
 
@@ -426,3 +736,19 @@ std::filesystem::path osc::TryPromptAndSaveAllUserDesiredOutputsAsCSV(SimulatorU
     auto outputs = GetAllUserDesiredOutputs(api);
     return TryExportOutputsToCSV(api.updSimulation(), outputs);
 }
+
+std::filesystem::path osc::TryPromptAndSaveOutputsAsColumnarBinary(
+    SimulatorUIAPI& api,
+    nonstd::span<OutputExtractor const> outputs,
+    ColumnarBinaryCompression compression)
+{
+    return TryExportOutputsToColumnarBinary(api.updSimulation(), outputs, compression);
+}
+
+std::filesystem::path osc::TryPromptAndSaveAllUserDesiredOutputsAsColumnarBinary(
+    SimulatorUIAPI& api,
+    ColumnarBinaryCompression compression)
+{
+    auto outputs = GetAllUserDesiredOutputs(api);
+    return TryExportOutputsToColumnarBinary(api.updSimulation(), outputs, compression);
+}
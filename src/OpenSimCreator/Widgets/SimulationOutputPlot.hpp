@@ -2,6 +2,8 @@
 
 #include "OpenSimCreator/OutputExtractor.hpp"
 
+#include <oscar/Formats/ColumnarBinary.hpp>
+
 #include <nonstd/span.hpp>
 
 #include <filesystem>
@@ -30,4 +32,10 @@ namespace osc
     // returns empty path if not saved
     std::filesystem::path TryPromptAndSaveOutputsAsCSV(SimulatorUIAPI&, nonstd::span<OutputExtractor const>);
     std::filesystem::path TryPromptAndSaveAllUserDesiredOutputsAsCSV(SimulatorUIAPI&);
+
+    // returns empty path if not saved
+    //
+    // only numeric outputs are saved (non-numeric outputs are skipped)
+    std::filesystem::path TryPromptAndSaveOutputsAsColumnarBinary(SimulatorUIAPI&, nonstd::span<OutputExtractor const>, ColumnarBinaryCompression);
+    std::filesystem::path TryPromptAndSaveAllUserDesiredOutputsAsColumnarBinary(SimulatorUIAPI&, ColumnarBinaryCompression);
 }
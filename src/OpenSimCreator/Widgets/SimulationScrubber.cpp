@@ -42,6 +42,9 @@ public:
         drawPlaybackSpeedSelector();
         ImGui::SameLine();
 
+        drawInterpolationToggle();
+        ImGui::SameLine();
+
         drawStartTimeText();
         ImGui::SameLine();
 
@@ -143,6 +146,16 @@ private:
         }
     }
 
+    void drawInterpolationToggle()
+    {
+        bool interpolate = m_SimulatorAPI->getSimulationStateInterpolation();
+        if (ImGui::Checkbox("interpolate", &interpolate))
+        {
+            m_SimulatorAPI->setSimulationStateInterpolation(interpolate);
+        }
+        DrawTooltipIfItemHovered("Interpolate States", "Linearly interpolate the shown state between the simulation's reports, so that playback is smooth at any playback speed. Interpolated states are only approximations of what the simulation computed");
+    }
+
     void drawScrubber()
     {
         SimulationClock::time_point const tStart = m_Simulation->getStartTime();
@@ -0,0 +1,506 @@
+#include "ColumnarBinary.hpp"
+
+#include "oscar/Utils/Assertions.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace
+{
+    constexpr std::string_view c_Magic{"OSCBCOL\0", 8};
+    constexpr uint32_t c_Version = 1;
+
+    bool IsLittleEndianHost()
+    {
+        uint16_t const v = 1;
+        unsigned char firstByte = 0;
+        std::memcpy(&firstByte, &v, 1);
+        return firstByte == 1;
+    }
+
+    // the unsigned integer type that has the same size as `T`
+    template<typename T>
+    using BitsOf = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+
+    // writing
+
+    template<typename UInt>
+    void AppendLittleEndian(std::vector<char>& buf, UInt v)
+    {
+        static_assert(std::is_unsigned_v<UInt>);
+        for (size_t i = 0; i < sizeof(UInt); ++i)
+        {
+            buf.push_back(static_cast<char>((v >> (8*i)) & 0xff));
+        }
+    }
+
+    // returns the `byteIndex`th least-significant byte of `v`
+    template<typename T>
+    uint8_t GetLittleEndianByte(T v, size_t byteIndex)
+    {
+        BitsOf<T> bits{};
+        std::memcpy(&bits, &v, sizeof(T));
+        return static_cast<uint8_t>((bits >> (8*byteIndex)) & 0xff);
+    }
+
+    template<typename T>
+    void AppendUncompressed(std::vector<char>& buf, nonstd::span<T const> values)
+    {
+        if (IsLittleEndianHost())
+        {
+            size_t const offset = buf.size();
+            buf.resize(offset + values.size()*sizeof(T));
+            std::memcpy(buf.data() + offset, values.data(), values.size()*sizeof(T));
+        }
+        else
+        {
+            for (T v : values)
+            {
+                BitsOf<T> bits{};
+                std::memcpy(&bits, &v, sizeof(T));
+                AppendLittleEndian(buf, bits);
+            }
+        }
+    }
+
+    // run-length encodes `in` into `out`
+    //
+    // the encoding is a sequence of packets that each start with a control byte `c`:
+    //
+    // - c < 128: `c+1` literal bytes follow
+    // - c >= 128: the next byte should be repeated `c-126` times (i.e. [2, 129] times)
+    void AppendRunLengthEncoded(std::vector<char>& out, nonstd::span<uint8_t const> in)
+    {
+        constexpr size_t c_MaxRun = 129;
+        constexpr size_t c_MaxLiteral = 128;
+
+        auto const startsRun = [in](size_t i)
+        {
+            return i+2 < in.size() && in[i] == in[i+1] && in[i] == in[i+2];
+        };
+
+        size_t i = 0;
+        while (i < in.size())
+        {
+            if (startsRun(i))
+            {
+                size_t run = 3;
+                while (i+run < in.size() && run < c_MaxRun && in[i+run] == in[i])
+                {
+                    ++run;
+                }
+                out.push_back(static_cast<char>(run + 126));
+                out.push_back(static_cast<char>(in[i]));
+                i += run;
+            }
+            else
+            {
+                size_t const start = i;
+                do
+                {
+                    ++i;
+                }
+                while (i < in.size() && i-start < c_MaxLiteral && !startsRun(i));
+
+                out.push_back(static_cast<char>(i - start - 1));
+                out.insert(out.end(), in.begin() + start, in.begin() + i);
+            }
+        }
+    }
+
+    template<typename T>
+    void AppendShuffledRunLength(std::vector<char>& buf, nonstd::span<T const> values)
+    {
+        // shuffle the values into byte planes, so that (e.g.) the slowly-changing sign
+        // and exponent bytes of each value end up next to each other
+        std::vector<uint8_t> planes(values.size() * sizeof(T));
+        for (size_t byte = 0; byte < sizeof(T); ++byte)
+        {
+            uint8_t* const plane = planes.data() + byte*values.size();
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                plane[i] = GetLittleEndianByte(values[i], byte);
+            }
+        }
+        AppendRunLengthEncoded(buf, planes);
+    }
+
+    template<typename T>
+    void AppendColumnPayload(
+        std::vector<char>& buf,
+        nonstd::span<T const> values,
+        osc::ColumnarBinaryCompression compression)
+    {
+        // reserve space for the payload size, which is back-filled once it's known
+        size_t const sizeOffset = buf.size();
+        AppendLittleEndian(buf, uint64_t{0});
+        size_t const payloadOffset = buf.size();
+
+        switch (compression)
+        {
+        case osc::ColumnarBinaryCompression::ShuffledRunLength:
+            AppendShuffledRunLength(buf, values);
+            break;
+        case osc::ColumnarBinaryCompression::None:
+        default:
+            AppendUncompressed(buf, values);
+            break;
+        }
+
+        uint64_t const payloadSize = static_cast<uint64_t>(buf.size() - payloadOffset);
+        for (size_t i = 0; i < sizeof(uint64_t); ++i)
+        {
+            buf[sizeOffset + i] = static_cast<char>((payloadSize >> (8*i)) & 0xff);
+        }
+    }
+
+    size_t GetNumValues(osc::ColumnarBinaryColumnView const& column)
+    {
+        return std::visit([](auto const& values) { return values.size(); }, column.values);
+    }
+
+    osc::ColumnarBinaryDataType GetColumnViewDataType(osc::ColumnarBinaryColumnView const& column)
+    {
+        return std::holds_alternative<nonstd::span<float const>>(column.values) ?
+            osc::ColumnarBinaryDataType::Float32 :
+            osc::ColumnarBinaryDataType::Float64;
+    }
+
+    // reading
+
+    // a cursor over an in-memory buffer that throws if a read runs past the end of it
+    class ByteReader final {
+    public:
+        explicit ByteReader(std::string_view data) :
+            m_Data{data}
+        {
+        }
+
+        size_t remaining() const
+        {
+            return m_Data.size() - m_Pos;
+        }
+
+        std::string_view readBytes(size_t n)
+        {
+            if (n > remaining())
+            {
+                throw std::runtime_error{"columnar binary: unexpected end of data (the file may be truncated)"};
+            }
+            std::string_view const rv = m_Data.substr(m_Pos, n);
+            m_Pos += n;
+            return rv;
+        }
+
+        template<typename UInt>
+        UInt readLittleEndian()
+        {
+            static_assert(std::is_unsigned_v<UInt>);
+            std::string_view const bytes = readBytes(sizeof(UInt));
+            UInt rv = 0;
+            for (size_t i = 0; i < sizeof(UInt); ++i)
+            {
+                rv |= static_cast<UInt>(static_cast<uint8_t>(bytes[i])) << (8*i);
+            }
+            return rv;
+        }
+
+    private:
+        std::string_view m_Data;
+        size_t m_Pos = 0;
+    };
+
+    size_t ToSizeT(uint64_t v)
+    {
+        if (v > std::numeric_limits<size_t>::max())
+        {
+            throw std::runtime_error{"columnar binary: the file contains a size that is too large to be loaded on this machine"};
+        }
+        return static_cast<size_t>(v);
+    }
+
+    // decodes data that was encoded with `AppendRunLengthEncoded`
+    std::vector<uint8_t> DecodeRunLength(std::string_view in, size_t expectedSize)
+    {
+        std::vector<uint8_t> rv;
+        rv.reserve(std::min(expectedSize, 129*in.size()));  // (don't trust `expectedSize` with a huge allocation)
+
+        size_t i = 0;
+        while (i < in.size())
+        {
+            auto const control = static_cast<uint8_t>(in[i++]);
+            if (control < 128)
+            {
+                size_t const n = control + 1;
+                if (n > in.size() - i || n > expectedSize - rv.size())
+                {
+                    throw std::runtime_error{"columnar binary: a compressed column contains an invalid literal run"};
+                }
+                rv.insert(rv.end(), in.begin() + i, in.begin() + i + n);
+                i += n;
+            }
+            else
+            {
+                size_t const n = control - 126;
+                if (i >= in.size() || n > expectedSize - rv.size())
+                {
+                    throw std::runtime_error{"columnar binary: a compressed column contains an invalid repeated run"};
+                }
+                rv.insert(rv.end(), n, static_cast<uint8_t>(in[i++]));
+            }
+        }
+
+        if (rv.size() != expectedSize)
+        {
+            throw std::runtime_error{"columnar binary: a compressed column decompressed to an unexpected size"};
+        }
+        return rv;
+    }
+
+    template<typename T>
+    std::vector<T> DecodeColumnPayload(
+        std::string_view payload,
+        size_t numRows,
+        osc::ColumnarBinaryCompression compression)
+    {
+        if (numRows > std::numeric_limits<size_t>::max()/sizeof(T))
+        {
+            throw std::runtime_error{"columnar binary: the file contains too many rows"};
+        }
+        size_t const numBytes = numRows * sizeof(T);
+
+        if (compression == osc::ColumnarBinaryCompression::ShuffledRunLength)
+        {
+            std::vector<uint8_t> const planes = DecodeRunLength(payload, numBytes);
+            std::vector<T> rv(numRows);
+            for (size_t i = 0; i < numRows; ++i)
+            {
+                BitsOf<T> bits = 0;
+                for (size_t byte = 0; byte < sizeof(T); ++byte)
+                {
+                    bits |= static_cast<BitsOf<T>>(planes[byte*numRows + i]) << (8*byte);
+                }
+                std::memcpy(&rv[i], &bits, sizeof(T));
+            }
+            return rv;
+        }
+        else
+        {
+            if (payload.size() != numBytes)
+            {
+                throw std::runtime_error{"columnar binary: an uncompressed column has an unexpected size"};
+            }
+
+            std::vector<T> rv(numRows);
+
+            if (IsLittleEndianHost())
+            {
+                std::memcpy(rv.data(), payload.data(), numBytes);
+            }
+            else
+            {
+                ByteReader reader{payload};
+                for (T& v : rv)
+                {
+                    BitsOf<T> const bits = reader.readLittleEndian<BitsOf<T>>();
+                    std::memcpy(&v, &bits, sizeof(T));
+                }
+            }
+            return rv;
+        }
+    }
+
+    std::string SlurpStream(std::istream& in)
+    {
+        std::string rv;
+
+        // try to size the buffer up-front, so that big files are read in one go
+        std::istream::pos_type const start = in.tellg();
+        if (start != std::istream::pos_type(-1) && in.seekg(0, std::ios::end))
+        {
+            std::istream::pos_type const end = in.tellg();
+            in.seekg(start);
+            if (end != std::istream::pos_type(-1) && end >= start)
+            {
+                rv.resize(static_cast<size_t>(end - start));
+                in.read(rv.data(), static_cast<std::streamsize>(rv.size()));
+                rv.resize(static_cast<size_t>(in.gcount()));
+                return rv;
+            }
+        }
+        in.clear();
+
+        rv.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+        return rv;
+    }
+}
+
+osc::ColumnarBinaryDataType osc::GetDataType(ColumnarBinaryColumn const& column)
+{
+    return std::holds_alternative<std::vector<float>>(column.values) ?
+        ColumnarBinaryDataType::Float32 :
+        ColumnarBinaryDataType::Float64;
+}
+
+std::vector<float> osc::GetValuesAsFloats(ColumnarBinaryColumn const& column)
+{
+    return std::visit([](auto const& values)
+    {
+        std::vector<float> rv;
+        rv.reserve(values.size());
+        for (auto v : values)
+        {
+            rv.push_back(static_cast<float>(v));
+        }
+        return rv;
+    }, column.values);
+}
+
+osc::ColumnarBinaryColumn const* osc::FindColumn(ColumnarBinaryContents const& contents, std::string_view name)
+{
+    auto const it = std::find_if(contents.columns.begin(), contents.columns.end(), [name](ColumnarBinaryColumn const& c)
+    {
+        return c.name == name;
+    });
+    return it != contents.columns.end() ? &(*it) : nullptr;
+}
+
+void osc::WriteColumnarBinary(
+    std::ostream& out,
+    nonstd::span<ColumnarBinaryColumnView const> columns,
+    ColumnarBinaryCompression compression)
+{
+    OSC_ASSERT(compression < ColumnarBinaryCompression::NUM_OPTIONS && "invalid compression option provided");
+
+    size_t const numRows = columns.empty() ? 0 : GetNumValues(columns.front());
+    for (ColumnarBinaryColumnView const& column : columns)
+    {
+        if (GetNumValues(column) != numRows)
+        {
+            std::stringstream ss;
+            ss << "columnar binary: column '" << column.name << "' has " << GetNumValues(column) << " values, but " << numRows << " were expected: all columns must be the same length";
+            throw std::runtime_error{std::move(ss).str()};
+        }
+        if (column.name.size() > std::numeric_limits<uint32_t>::max())
+        {
+            throw std::runtime_error{"columnar binary: a column name is too long"};
+        }
+    }
+    if (columns.size() > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::runtime_error{"columnar binary: too many columns"};
+    }
+
+    // build the entire file in memory, so that it can be written in one bulk write
+    std::vector<char> buf;
+    {
+        size_t expectedSize = c_Magic.size() + 4 + 4 + 8 + 4;
+        for (ColumnarBinaryColumnView const& column : columns)
+        {
+            expectedSize += 4 + column.name.size() + 1 + 8;
+            expectedSize += std::visit([](auto const& values) { return values.size_bytes(); }, column.values);
+        }
+        buf.reserve(expectedSize);
+    }
+
+    // header
+    buf.insert(buf.end(), c_Magic.begin(), c_Magic.end());
+    AppendLittleEndian(buf, c_Version);
+    AppendLittleEndian(buf, static_cast<uint32_t>(compression));
+    AppendLittleEndian(buf, static_cast<uint64_t>(numRows));
+    AppendLittleEndian(buf, static_cast<uint32_t>(columns.size()));
+    for (ColumnarBinaryColumnView const& column : columns)
+    {
+        AppendLittleEndian(buf, static_cast<uint32_t>(column.name.size()));
+        buf.insert(buf.end(), column.name.begin(), column.name.end());
+        AppendLittleEndian(buf, static_cast<uint8_t>(GetColumnViewDataType(column)));
+    }
+
+    // data
+    for (ColumnarBinaryColumnView const& column : columns)
+    {
+        std::visit([&buf, compression](auto const& values) { AppendColumnPayload(buf, values, compression); }, column.values);
+    }
+
+    out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+}
+
+osc::ColumnarBinaryContents osc::ReadColumnarBinary(std::istream& in)
+{
+    std::string const data = SlurpStream(in);
+    ByteReader reader{data};
+
+    // header
+    if (reader.remaining() < c_Magic.size() || reader.readBytes(c_Magic.size()) != c_Magic)
+    {
+        throw std::runtime_error{"columnar binary: the data does not start with the expected magic bytes (is it a columnar binary file?)"};
+    }
+
+    uint32_t const version = reader.readLittleEndian<uint32_t>();
+    if (version != c_Version)
+    {
+        std::stringstream ss;
+        ss << "columnar binary: unsupported version (" << version << "): only version " << c_Version << " is supported";
+        throw std::runtime_error{std::move(ss).str()};
+    }
+
+    uint32_t const compressionInt = reader.readLittleEndian<uint32_t>();
+    if (compressionInt >= static_cast<uint32_t>(ColumnarBinaryCompression::NUM_OPTIONS))
+    {
+        throw std::runtime_error{"columnar binary: unsupported compression method"};
+    }
+    auto const compression = static_cast<ColumnarBinaryCompression>(compressionInt);
+
+    ColumnarBinaryContents rv;
+    rv.numRows = ToSizeT(reader.readLittleEndian<uint64_t>());
+
+    uint32_t const numColumns = reader.readLittleEndian<uint32_t>();
+    std::vector<ColumnarBinaryDataType> types;
+    for (uint32_t i = 0; i < numColumns; ++i)
+    {
+        uint32_t const nameLength = reader.readLittleEndian<uint32_t>();
+        std::string_view const name = reader.readBytes(nameLength);
+
+        uint8_t const typeInt = reader.readLittleEndian<uint8_t>();
+        if (typeInt >= static_cast<uint8_t>(ColumnarBinaryDataType::NUM_OPTIONS))
+        {
+            throw std::runtime_error{"columnar binary: a column has an unsupported data type"};
+        }
+
+        rv.columns.push_back(ColumnarBinaryColumn{std::string{name}, {}});
+        types.push_back(static_cast<ColumnarBinaryDataType>(typeInt));
+    }
+
+    // data
+    for (size_t i = 0; i < rv.columns.size(); ++i)
+    {
+        std::string_view const payload = reader.readBytes(ToSizeT(reader.readLittleEndian<uint64_t>()));
+
+        if (types[i] == ColumnarBinaryDataType::Float32)
+        {
+            rv.columns[i].values = DecodeColumnPayload<float>(payload, rv.numRows, compression);
+        }
+        else
+        {
+            rv.columns[i].values = DecodeColumnPayload<double>(payload, rv.numRows, compression);
+        }
+    }
+
+    return rv;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "oscar/Utils/CStringView.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+// columnar binary format
+//
+// a small binary format for writing equal-length numeric columns (e.g. simulation outputs)
+// to disk in one bulk write. The layout (all integers little-endian) is:
+//
+//     magic          8 bytes ("OSCBCOL\0")
+//     version        u32
+//     compression    u32 (see `ColumnarBinaryCompression`)
+//     numRows        u64
+//     numColumns     u32
+//     for each column:
+//         nameLength     u32
+//         name           `nameLength` bytes (UTF-8, not NUL-terminated)
+//         dataType       u8 (see `ColumnarBinaryDataType`)
+//     for each column:
+//         payloadSize    u64
+//         payload        `payloadSize` bytes (`numRows` contiguous little-endian values, compressed
+//                        with `compression`)
+namespace osc
+{
+    // the file extension that the UI uses for columnar binary files
+    constexpr CStringView c_ColumnarBinaryFileExtension = "bcol";
+
+    enum class ColumnarBinaryDataType : uint8_t {
+        Float32 = 0,
+        Float64,
+        NUM_OPTIONS,
+    };
+
+    enum class ColumnarBinaryCompression : uint32_t {
+        // each column's values are written as-is
+        None = 0,
+
+        // each column's values are split into byte planes (e.g. all exponent bytes are
+        // written together), which are then run-length encoded
+        //
+        // slower to write than `None`, but typically much smaller for smooth timeseries data
+        ShuffledRunLength,
+
+        NUM_OPTIONS,
+    };
+
+    // a non-owning view of one column that should be written
+    struct ColumnarBinaryColumnView final {
+
+        ColumnarBinaryColumnView(std::string_view name_, nonstd::span<float const> values_) :
+            name{name_},
+            values{values_}
+        {
+        }
+
+        ColumnarBinaryColumnView(std::string_view name_, nonstd::span<double const> values_) :
+            name{name_},
+            values{values_}
+        {
+        }
+
+        std::string_view name;
+        std::variant<nonstd::span<float const>, nonstd::span<double const>> values;
+    };
+
+    // an (owned) column that was read from a columnar binary file
+    struct ColumnarBinaryColumn final {
+        std::string name;
+        std::variant<std::vector<float>, std::vector<double>> values;
+    };
+
+    // returns the data type of the given column
+    ColumnarBinaryDataType GetDataType(ColumnarBinaryColumn const&);
+
+    // returns the values of the given column as floats (narrowing doubles, if necessary)
+    std::vector<float> GetValuesAsFloats(ColumnarBinaryColumn const&);
+
+    struct ColumnarBinaryContents final {
+        size_t numRows = 0;
+        std::vector<ColumnarBinaryColumn> columns;
+    };
+
+    // returns a pointer to the first column in `contents` named `name`, or `nullptr` if no such column exists
+    ColumnarBinaryColumn const* FindColumn(ColumnarBinaryContents const&, std::string_view name);
+
+    // writes the provided columns to the output stream in one bulk write
+    //
+    // throws if the columns are not all the same length
+    void WriteColumnarBinary(
+        std::ostream&,
+        nonstd::span<ColumnarBinaryColumnView const>,
+        ColumnarBinaryCompression = ColumnarBinaryCompression::None
+    );
+
+    // reads all columns from the input stream
+    //
+    // throws if the stream does not contain valid columnar binary data
+    ColumnarBinaryContents ReadColumnarBinary(std::istream&);
+}
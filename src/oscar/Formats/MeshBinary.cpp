@@ -0,0 +1,284 @@
+#include "MeshBinary.hpp"
+
+#include "oscar/Graphics/Mesh.hpp"
+#include "oscar/Graphics/MeshIndicesView.hpp"
+#include "oscar/Graphics/MeshTopology.hpp"
+
+#include <glm/vec3.hpp>
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr std::string_view c_Magic{"OSCMESH\0", 8};
+    constexpr uint32_t c_Version = 1;
+
+    bool IsLittleEndianHost()
+    {
+        uint16_t const v = 1;
+        unsigned char firstByte = 0;
+        std::memcpy(&firstByte, &v, 1);
+        return firstByte == 1;
+    }
+
+    // the unsigned integer type that has the same size as `T`
+    template<typename T>
+    using BitsOf = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+
+    // writing
+
+    template<typename UInt>
+    void AppendLittleEndian(std::vector<char>& buf, UInt v)
+    {
+        static_assert(std::is_unsigned_v<UInt>);
+        for (size_t i = 0; i < sizeof(UInt); ++i)
+        {
+            buf.push_back(static_cast<char>((v >> (8*i)) & 0xff));
+        }
+    }
+
+    // appends the given (trivially-copyable) values, which must be made of 2- or 4-byte scalars, in little-endian order
+    template<typename Scalar, typename T>
+    void AppendLittleEndianScalars(std::vector<char>& buf, nonstd::span<T const> values)
+    {
+        static_assert(sizeof(T) % sizeof(Scalar) == 0);
+
+        size_t const numBytes = values.size()*sizeof(T);
+        if (IsLittleEndianHost())
+        {
+            size_t const offset = buf.size();
+            buf.resize(offset + numBytes);
+            std::memcpy(buf.data() + offset, values.data(), numBytes);
+        }
+        else
+        {
+            auto const* const bytes = reinterpret_cast<unsigned char const*>(values.data());
+            for (size_t offset = 0; offset < numBytes; offset += sizeof(Scalar))
+            {
+                BitsOf<Scalar> bits{};
+                std::memcpy(&bits, bytes + offset, sizeof(Scalar));
+                AppendLittleEndian(buf, bits);
+            }
+        }
+    }
+
+    // reading
+
+    // a cursor over an in-memory buffer that throws if a read runs past the end of it
+    class ByteReader final {
+    public:
+        explicit ByteReader(std::string_view data) :
+            m_Data{data}
+        {
+        }
+
+        size_t remaining() const
+        {
+            return m_Data.size() - m_Pos;
+        }
+
+        std::string_view readBytes(size_t n)
+        {
+            if (n > remaining())
+            {
+                throw std::runtime_error{"mesh binary: unexpected end of data (the file may be truncated)"};
+            }
+            std::string_view const rv = m_Data.substr(m_Pos, n);
+            m_Pos += n;
+            return rv;
+        }
+
+        template<typename UInt>
+        UInt readLittleEndian()
+        {
+            static_assert(std::is_unsigned_v<UInt>);
+            std::string_view const bytes = readBytes(sizeof(UInt));
+            UInt rv = 0;
+            for (size_t i = 0; i < sizeof(UInt); ++i)
+            {
+                rv |= static_cast<UInt>(static_cast<uint8_t>(bytes[i])) << (8*i);
+            }
+            return rv;
+        }
+
+        // reads `n` (trivially-copyable) values, which must be made of 2- or 4-byte scalars, that were
+        // written with `AppendLittleEndianScalars`
+        template<typename Scalar, typename T>
+        std::vector<T> readLittleEndianScalars(size_t n)
+        {
+            static_assert(sizeof(T) % sizeof(Scalar) == 0);
+
+            if (n > remaining()/sizeof(T))
+            {
+                throw std::runtime_error{"mesh binary: unexpected end of data (the file may be truncated)"};
+            }
+            std::string_view const bytes = readBytes(n*sizeof(T));
+
+            std::vector<T> rv(n);
+            if (IsLittleEndianHost())
+            {
+                std::memcpy(rv.data(), bytes.data(), bytes.size());
+            }
+            else
+            {
+                auto* const out = reinterpret_cast<unsigned char*>(rv.data());
+                for (size_t offset = 0; offset < bytes.size(); offset += sizeof(Scalar))
+                {
+                    BitsOf<Scalar> bits = 0;
+                    for (size_t i = 0; i < sizeof(Scalar); ++i)
+                    {
+                        bits |= static_cast<BitsOf<Scalar>>(static_cast<uint8_t>(bytes[offset + i])) << (8*i);
+                    }
+                    std::memcpy(out + offset, &bits, sizeof(Scalar));
+                }
+            }
+            return rv;
+        }
+
+    private:
+        std::string_view m_Data;
+        size_t m_Pos = 0;
+    };
+
+    size_t ToSizeT(uint64_t v)
+    {
+        if (v > std::numeric_limits<size_t>::max())
+        {
+            throw std::runtime_error{"mesh binary: the file contains a size that is too large to be loaded on this machine"};
+        }
+        return static_cast<size_t>(v);
+    }
+
+    std::string SlurpStream(std::istream& in)
+    {
+        return std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    }
+}
+
+void osc::WriteMeshBinary(std::ostream& out, Mesh const& mesh, std::string_view key)
+{
+    if (key.size() > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::runtime_error{"mesh binary: the key is too long"};
+    }
+
+    nonstd::span<glm::vec3 const> const verts = mesh.getVerts();
+    nonstd::span<glm::vec3 const> const normals = mesh.getNormals();
+    bool const hasNormals = !normals.empty();
+    if (hasNormals && normals.size() != verts.size())
+    {
+        throw std::runtime_error{"mesh binary: the mesh has a different number of normals from verts"};
+    }
+    MeshIndicesView const indices = mesh.getIndices();
+
+    // build the entire file in memory, so that it can be written in one bulk write
+    std::vector<char> buf;
+    buf.reserve(
+        c_Magic.size() + 4 + 4 + key.size() + 4 + 8 + 1 + 1 + 8 +
+        (hasNormals ? 2 : 1)*verts.size_bytes() +
+        indices.size()*(indices.isU16() ? sizeof(uint16_t) : sizeof(uint32_t))
+    );
+
+    // header
+    buf.insert(buf.end(), c_Magic.begin(), c_Magic.end());
+    AppendLittleEndian(buf, c_Version);
+    AppendLittleEndian(buf, static_cast<uint32_t>(key.size()));
+    buf.insert(buf.end(), key.begin(), key.end());
+    AppendLittleEndian(buf, static_cast<uint32_t>(mesh.getTopology()));
+    AppendLittleEndian(buf, static_cast<uint64_t>(verts.size()));
+    AppendLittleEndian(buf, static_cast<uint8_t>(hasNormals ? 1 : 0));
+    AppendLittleEndian(buf, static_cast<uint8_t>(indices.isU16() ? sizeof(uint16_t) : sizeof(uint32_t)));
+    AppendLittleEndian(buf, static_cast<uint64_t>(indices.size()));
+
+    // data
+    AppendLittleEndianScalars<float>(buf, verts);
+    if (hasNormals)
+    {
+        AppendLittleEndianScalars<float>(buf, normals);
+    }
+    if (indices.isU16())
+    {
+        AppendLittleEndianScalars<uint16_t>(buf, indices.toU16Span());
+    }
+    else
+    {
+        AppendLittleEndianScalars<uint32_t>(buf, indices.toU32Span());
+    }
+
+    out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+}
+
+osc::MeshBinaryContents osc::ReadMeshBinary(std::istream& in)
+{
+    std::string const data = SlurpStream(in);
+    ByteReader reader{data};
+
+    // header
+    if (reader.remaining() < c_Magic.size() || reader.readBytes(c_Magic.size()) != c_Magic)
+    {
+        throw std::runtime_error{"mesh binary: the data does not start with the expected magic bytes (is it a mesh binary file?)"};
+    }
+
+    uint32_t const version = reader.readLittleEndian<uint32_t>();
+    if (version != c_Version)
+    {
+        std::stringstream ss;
+        ss << "mesh binary: unsupported version (" << version << "): only version " << c_Version << " is supported";
+        throw std::runtime_error{std::move(ss).str()};
+    }
+
+    MeshBinaryContents rv;
+    rv.key = std::string{reader.readBytes(reader.readLittleEndian<uint32_t>())};
+
+    uint32_t const topologyInt = reader.readLittleEndian<uint32_t>();
+    if (topologyInt >= static_cast<uint32_t>(MeshTopology::TOTAL))
+    {
+        throw std::runtime_error{"mesh binary: unsupported mesh topology"};
+    }
+    size_t const numVerts = ToSizeT(reader.readLittleEndian<uint64_t>());
+    bool const hasNormals = reader.readLittleEndian<uint8_t>() != 0;
+    uint8_t const indexSize = reader.readLittleEndian<uint8_t>();
+    if (indexSize != sizeof(uint16_t) && indexSize != sizeof(uint32_t))
+    {
+        throw std::runtime_error{"mesh binary: unsupported index size"};
+    }
+    size_t const numIndices = ToSizeT(reader.readLittleEndian<uint64_t>());
+
+    // data
+    rv.mesh.setTopology(static_cast<MeshTopology>(topologyInt));
+    {
+        std::vector<glm::vec3> const verts = reader.readLittleEndianScalars<float, glm::vec3>(numVerts);
+        rv.mesh.setVerts(verts);
+    }
+    if (hasNormals)
+    {
+        std::vector<glm::vec3> const normals = reader.readLittleEndianScalars<float, glm::vec3>(numVerts);
+        rv.mesh.setNormals(normals);
+    }
+    if (indexSize == sizeof(uint16_t))
+    {
+        std::vector<uint16_t> const indices = reader.readLittleEndianScalars<uint16_t, uint16_t>(numIndices);
+        rv.mesh.setIndices(nonstd::span<uint16_t const>{indices});
+    }
+    else
+    {
+        std::vector<uint32_t> const indices = reader.readLittleEndianScalars<uint32_t, uint32_t>(numIndices);
+        rv.mesh.setIndices(nonstd::span<uint32_t const>{indices});
+    }
+
+    return rv;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "oscar/Graphics/Mesh.hpp"
+#include "oscar/Utils/CStringView.hpp"
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+// mesh binary format
+//
+// a compact binary format for caching (e.g. already-parsed) triangle meshes on disk, so
+// that they can be loaded without re-parsing their source file. The layout (all integers
+// and floats little-endian) is:
+//
+//     magic          8 bytes ("OSCMESH\0")
+//     version        u32
+//     keyLength      u32
+//     key            `keyLength` bytes (caller-defined, e.g. identifies the source file)
+//     topology       u32 (see `MeshTopology`)
+//     numVerts       u64
+//     hasNormals     u8 (0 or 1)
+//     indexSize      u8 (2 or 4 bytes)
+//     numIndices     u64
+//     verts          `numVerts` f32x3s
+//     normals        `numVerts` f32x3s (only present if `hasNormals`)
+//     indices        `numIndices` u16s or u32s (see `indexSize`)
+namespace osc
+{
+    // the file extension that is used for mesh binary files
+    constexpr CStringView c_MeshBinaryFileExtension = "oscmesh";
+
+    struct MeshBinaryContents final {
+        std::string key;
+        Mesh mesh;
+    };
+
+    // writes the mesh's topology, verts, normals, and indices to the output stream in one bulk write
+    //
+    // other mesh data (e.g. texture coordinates, colors) is not written
+    void WriteMeshBinary(std::ostream&, Mesh const&, std::string_view key);
+
+    // reads a mesh from the input stream
+    //
+    // throws if the stream does not contain valid mesh binary data
+    MeshBinaryContents ReadMeshBinary(std::istream&);
+}
@@ -4,10 +4,29 @@
 #include "oscar/Graphics/SceneRenderer.hpp"
 #include "oscar/Graphics/SceneRendererParams.hpp"
 #include "oscar/Platform/Config.hpp"
+#include "oscar/Utils/Algorithms.hpp"
+#include "oscar/Utils/Assertions.hpp"
 
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
+namespace
+{
+    // returns a running (order-dependent) hash of the content of all decorations in the list
+    size_t HashDecorationList(nonstd::span<osc::SceneDecoration const> decorations)
+    {
+        size_t rv = std::hash<size_t>{}(decorations.size());
+        for (osc::SceneDecoration const& decoration : decorations)
+        {
+            rv = osc::HashCombine(rv, decoration);
+        }
+        return rv;
+    }
+}
+
 class osc::CachedSceneRenderer::Impl final {
 public:
     Impl(
@@ -15,8 +34,6 @@ public:
         MeshCache& meshCache,
         ShaderCache& shaderCache) :
 
-        m_LastRenderingParams{},
-        m_LastDecorationList{},
         m_SceneRenderer{config, meshCache, shaderCache}
     {
     }
@@ -25,21 +42,86 @@ public:
         nonstd::span<SceneDecoration const> decorations,
         SceneRendererParams const& params)
     {
-        if (params != m_LastRenderingParams ||
-            !std::equal(decorations.begin(), decorations.end(), m_LastDecorationList.cbegin(), m_LastDecorationList.cend()))
+        size_t const hash = HashDecorationList(decorations);
+        if (!isSameAsLastDraw(hash, params))
+        {
+            // inputs have changed: cache a copy of the new ones and re-render
+            render(std::make_shared<std::vector<SceneDecoration> const>(decorations.begin(), decorations.end()), hash, params);
+        }
+        return m_SceneRenderer.updRenderTexture();
+    }
+
+    osc::RenderTexture& draw(
+        std::vector<SceneDecoration>&& decorations,
+        SceneRendererParams const& params)
+    {
+        size_t const hash = HashDecorationList(decorations);
+        if (!isSameAsLastDraw(hash, params))
+        {
+            // inputs have changed: take ownership of the new ones and re-render
+            render(std::make_shared<std::vector<SceneDecoration> const>(std::move(decorations)), hash, params);
+        }
+        return m_SceneRenderer.updRenderTexture();
+    }
+
+    osc::RenderTexture& draw(
+        std::shared_ptr<std::vector<SceneDecoration> const> decorations,
+        SceneRendererParams const& params)
+    {
+        OSC_ASSERT(decorations != nullptr && "a null decoration list was passed to the cached scene renderer");
+
+        if (decorations == m_LastDecorationList)
         {
-            // inputs have changed: cache the new ones and re-render
-            m_LastRenderingParams = params;
-            m_LastDecorationList.assign(decorations.begin(), decorations.end());
-            m_SceneRenderer.draw(m_LastDecorationList, m_LastRenderingParams);
+            // same (immutable) list: only the params can have changed
+            if (params != m_LastRenderingParams)
+            {
+                m_LastRenderingParams = params;
+                m_SceneRenderer.draw(*m_LastDecorationList, m_LastRenderingParams);
+            }
+            return m_SceneRenderer.updRenderTexture();
         }
 
+        size_t const hash = HashDecorationList(*decorations);
+        if (isSameAsLastDraw(hash, params))
+        {
+            // same content, different list: hold the new one, so that subsequent
+            // draws of it can take the O(1) path above
+            m_LastDecorationList = std::move(decorations);
+        }
+        else
+        {
+            render(std::move(decorations), hash, params);
+        }
         return m_SceneRenderer.updRenderTexture();
     }
 
 private:
-    osc::SceneRendererParams m_LastRenderingParams;
-    std::vector<osc::SceneDecoration> m_LastDecorationList;
+    bool isSameAsLastDraw(
+        size_t hash,
+        SceneRendererParams const& params) const
+    {
+        // the hash covers everything that `operator==` compares (incl. material property block
+        // contents), so the (O(n)) list isn't also compared element-by-element
+        return
+            m_LastDecorationList &&
+            hash == m_LastDecorationHash &&
+            params == m_LastRenderingParams;
+    }
+
+    void render(
+        std::shared_ptr<std::vector<SceneDecoration> const> decorations,
+        size_t hash,
+        SceneRendererParams const& params)
+    {
+        m_LastRenderingParams = params;
+        m_LastDecorationList = std::move(decorations);
+        m_LastDecorationHash = hash;
+        m_SceneRenderer.draw(*m_LastDecorationList, m_LastRenderingParams);
+    }
+
+    osc::SceneRendererParams m_LastRenderingParams{};
+    std::shared_ptr<std::vector<osc::SceneDecoration> const> m_LastDecorationList;
+    size_t m_LastDecorationHash = 0;
     osc::SceneRenderer m_SceneRenderer;
 };
 
@@ -58,4 +140,14 @@ osc::CachedSceneRenderer::~CachedSceneRenderer() noexcept = default;
 osc::RenderTexture& osc::CachedSceneRenderer::draw(nonstd::span<SceneDecoration const> decorations, SceneRendererParams const& params)
 {
     return m_Impl->draw(std::move(decorations), params);
-}
\ No newline at end of file
+}
+
+osc::RenderTexture& osc::CachedSceneRenderer::draw(std::vector<SceneDecoration>&& decorations, SceneRendererParams const& params)
+{
+    return m_Impl->draw(std::move(decorations), params);
+}
+
+osc::RenderTexture& osc::CachedSceneRenderer::draw(std::shared_ptr<std::vector<SceneDecoration> const> decorations, SceneRendererParams const& params)
+{
+    return m_Impl->draw(std::move(decorations), params);
+}
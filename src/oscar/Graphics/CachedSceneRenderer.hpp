@@ -3,6 +3,7 @@
 #include <nonstd/span.hpp>
 
 #include <memory>
+#include <vector>
 
 namespace osc { class Config; }
 namespace osc { class MeshCache; }
@@ -14,6 +15,11 @@ namespace osc { class ShaderCache; }
 namespace osc
 {
     // a scene renderer that only renders if the render parameters + decorations change
+    //
+    // changes to the decoration list are detected by comparing a content hash of the list
+    // (which covers material property block contents) against the hash of the previously-rendered
+    // one, so callers that redraw a static scene each frame only pay for hashing it, rather than a
+    // copy + re-render
     class CachedSceneRenderer final {
     public:
         CachedSceneRenderer(Config const&, MeshCache&, ShaderCache&);
@@ -23,8 +29,18 @@ namespace osc
         CachedSceneRenderer& operator=(CachedSceneRenderer&&) noexcept;
         ~CachedSceneRenderer() noexcept;
 
+        // copies the decorations only if they differ from the previously-rendered ones
         RenderTexture& draw(nonstd::span<SceneDecoration const>, SceneRendererParams const&);
 
+        // takes ownership of the decorations (by move) if they differ from the previously-rendered ones
+        RenderTexture& draw(std::vector<SceneDecoration>&&, SceneRendererParams const&);
+
+        // holds onto the (immutable) decorations if they differ from the previously-rendered ones
+        //
+        // redrawing the same list (pointer) is O(1), so producers that cache their decorations
+        // should prefer this overload
+        RenderTexture& draw(std::shared_ptr<std::vector<SceneDecoration> const>, SceneRendererParams const&);
+
     private:
         class Impl;
         std::unique_ptr<Impl> m_Impl;
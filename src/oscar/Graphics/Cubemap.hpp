@@ -6,6 +6,9 @@
 
 #include <nonstd/span.hpp>
 
+#include <cstddef>
+#include <functional>
+
 namespace osc
 {
     class Cubemap final {
@@ -28,6 +31,7 @@ namespace osc
         friend class GraphicsBackend;
         friend bool operator==(Cubemap const&, Cubemap const&) noexcept;
         friend bool operator!=(Cubemap const&, Cubemap const&) noexcept;
+        friend struct std::hash<Cubemap>;
 
         class Impl;
         CopyOnUpdPtr<Impl> m_Impl;
@@ -43,3 +47,14 @@ namespace osc
         return a.m_Impl != b.m_Impl;
     }
 }
+
+namespace std
+{
+    template<>
+    struct hash<osc::Cubemap> final {
+        size_t operator()(osc::Cubemap const& v) const
+        {
+            return hash<osc::CopyOnUpdPtr<osc::Cubemap::Impl>>{}(v.m_Impl);
+        }
+    };
+}
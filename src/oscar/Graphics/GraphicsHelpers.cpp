@@ -18,7 +18,10 @@
 #include "oscar/Maths/Rect.hpp"
 #include "oscar/Maths/Segment.hpp"
 #include "oscar/Maths/Tetrahedron.hpp"
+#include "oscar/Maths/Triangle.hpp"
 #include "oscar/Platform/Config.hpp"
+#include "oscar/Utils/Algorithms.hpp"
+#include "oscar/Utils/Assertions.hpp"
 #include "oscar/Utils/Cpp20Shims.hpp"
 
 #include <glm/mat4x4.hpp>
@@ -26,9 +29,16 @@
 #include <glm/vec4.hpp>
 #include <glm/gtx/transform.hpp>
 
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 namespace
 {
@@ -70,6 +80,61 @@ namespace
 
         out(osc::SceneDecoration{grid, t, color});
     }
+
+    // a vertex position that has been snapped to a grid, so that nearby positions can be welded via a hash lookup
+    using QuantizedPosition = std::array<int64_t, 3>;
+
+    struct QuantizedPositionHasher final {
+        size_t operator()(QuantizedPosition const& p) const noexcept
+        {
+            return osc::HashOf(p[0], p[1], p[2]);
+        }
+    };
+
+    // returns `p` snapped to a grid with a spacing of `epsilon`, or `std::nullopt` if it cannot be snapped (e.g. NaNs)
+    std::optional<QuantizedPosition> TryQuantize(glm::vec3 const& p, float epsilon)
+    {
+        // (conservative) limit that ensures the cast to an integer cannot overflow
+        constexpr double c_MaxCell = 1e18;
+
+        QuantizedPosition rv{};
+        for (size_t i = 0; i < rv.size(); ++i)
+        {
+            double const cell = std::floor(static_cast<double>(p[static_cast<glm::vec3::length_type>(i)])/static_cast<double>(epsilon) + 0.5);
+            if (!(std::abs(cell) < c_MaxCell))
+            {
+                return std::nullopt;
+            }
+            rv[i] = static_cast<int64_t>(cell);
+        }
+        return rv;
+    }
+
+    // returns the (unit-length) normal of the triangle, or a zero vector if the triangle is degenerate
+    glm::vec3 FaceNormalOrZero(osc::Triangle const& t)
+    {
+        glm::vec3 const n = glm::cross(t.p1 - t.p0, t.p2 - t.p0);
+        float const len = glm::length(n);
+        return len > 0.0f && std::isfinite(len) ? n/len : glm::vec3{};
+    }
+
+    // a (welded position, normal) pair, which uniquely identifies a vertex in a welded mesh
+    struct WeldedVertexKey final {
+        uint32_t positionIndex;
+        glm::vec3 normal;
+    };
+
+    bool operator==(WeldedVertexKey const& a, WeldedVertexKey const& b) noexcept
+    {
+        return a.positionIndex == b.positionIndex && a.normal == b.normal;
+    }
+
+    struct WeldedVertexKeyHasher final {
+        size_t operator()(WeldedVertexKey const& k) const noexcept
+        {
+            return osc::HashOf(k.positionIndex, k.normal.x, k.normal.y, k.normal.z);
+        }
+    };
 }
 
 void osc::DrawBVH(
@@ -122,13 +187,9 @@ void osc::DrawAABBs(
     BVH const& bvh,
     std::function<void(SceneDecoration&&)> const& out)
 {
-    for (BVHNode const& node : bvh.nodes)
+    for (BVHPrim const& prim : bvh.prims)
     {
-        if (!node.isLeaf())
-        {
-            continue;
-        }
-        DrawAABB(cache, node.getBounds(), out);
+        DrawAABB(cache, prim.getBounds(), out);
     }
 }
 
@@ -245,12 +306,10 @@ std::vector<osc::SceneCollision> osc::GetAllSceneCollisions(
     nonstd::span<SceneDecoration const> decorations,
     Line const& ray)
 {
-    // use scene BVH to intersect the ray with the scene
-    std::vector<BVHCollision> const sceneCollisions = bvh.getRayAABBCollisions(ray);
-
-    // perform ray-triangle intersections tests on the scene hits
+    // use scene BVH to intersect the ray with the scene and perform ray-triangle
+    // intersection tests on each scene hit
     std::vector<SceneCollision> rv;
-    for (BVHCollision const& c : sceneCollisions)
+    bvh.forEachRayAABBCollision(ray, [&decorations, &ray, &rv](BVHCollision const& c)
     {
         SceneDecoration const& decoration = decorations[c.id];
         std::optional<RayCollision> const maybeCollision = GetClosestWorldspaceRayCollision(decoration.mesh, decoration.transform, ray);
@@ -259,7 +318,7 @@ std::vector<osc::SceneCollision> osc::GetAllSceneCollisions(
         {
             rv.emplace_back(decoration.id, static_cast<size_t>(c.id), maybeCollision->position, maybeCollision->distance);
         }
-    }
+    });
     return rv;
 }
 
@@ -476,6 +535,139 @@ std::vector<glm::vec4> osc::CalcTangentVectors(
     return rv;
 }
 
+osc::Mesh osc::CreateWeldedTriangleMesh(
+    nonstd::span<Triangle const> triangles,
+    MeshWeldingParams const& params)
+{
+    OSC_ASSERT(params.positionEpsilon > 0.0f && "the position epsilon must be positive");
+
+    size_t const numCorners = 3*triangles.size();
+
+    // weld (near-)identical positions, so that the triangles that share them can be found
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> cornerPositionIndices;
+    cornerPositionIndices.reserve(numCorners);
+    {
+        std::unordered_map<QuantizedPosition, uint32_t, QuantizedPositionHasher> lut;
+        lut.reserve(triangles.size());  // (closed meshes have roughly half as many unique positions as triangles)
+
+        for (Triangle const& triangle : triangles)
+        {
+            for (size_t i = 0; i < 3; ++i)
+            {
+                glm::vec3 const& p = triangle[i];
+                auto const nextIndex = static_cast<uint32_t>(positions.size());
+
+                if (std::optional<QuantizedPosition> const q = TryQuantize(p, params.positionEpsilon))
+                {
+                    auto const [it, inserted] = lut.try_emplace(*q, nextIndex);
+                    if (inserted)
+                    {
+                        positions.push_back(p);
+                    }
+                    cornerPositionIndices.push_back(it->second);
+                }
+                else
+                {
+                    positions.push_back(p);  // unweldable: keep it as-is
+                    cornerPositionIndices.push_back(nextIndex);
+                }
+            }
+        }
+    }
+
+    std::vector<glm::vec3> faceNormals;
+    faceNormals.reserve(triangles.size());
+    for (Triangle const& triangle : triangles)
+    {
+        faceNormals.push_back(FaceNormalOrZero(triangle));
+    }
+
+    // compute a normal for each triangle corner
+    std::vector<glm::vec3> cornerNormals;
+    cornerNormals.reserve(numCorners);
+    if (params.maybeSmoothingAngleDegrees)
+    {
+        float const minCosine = std::cos(glm::radians(*params.maybeSmoothingAngleDegrees));
+
+        // build a (compressed) lookup from each welded position to the triangles that use it
+        std::vector<size_t> offsets(positions.size() + 1, 0);
+        for (uint32_t positionIndex : cornerPositionIndices)
+        {
+            ++offsets[positionIndex + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        std::vector<size_t> incidentTriangles(numCorners);
+        {
+            std::vector<size_t> cursors(offsets.begin(), offsets.end() - 1);
+            for (size_t corner = 0; corner < numCorners; ++corner)
+            {
+                incidentTriangles[cursors[cornerPositionIndices[corner]]++] = corner/3;
+            }
+        }
+
+        // average the face normals of all similarly-facing triangles around each corner
+        //
+        // (corners that see the same set of triangles produce bit-identical normals, because
+        //  the triangles are always summed in the same order, so they can be welded below)
+        for (size_t corner = 0; corner < numCorners; ++corner)
+        {
+            glm::vec3 const& faceNormal = faceNormals[corner/3];
+            uint32_t const positionIndex = cornerPositionIndices[corner];
+
+            glm::vec3 sum{};
+            for (size_t i = offsets[positionIndex]; i < offsets[positionIndex + 1]; ++i)
+            {
+                glm::vec3 const& otherNormal = faceNormals[incidentTriangles[i]];
+                if (glm::dot(faceNormal, otherNormal) >= minCosine)
+                {
+                    sum += otherNormal;
+                }
+            }
+
+            float const len = glm::length(sum);
+            cornerNormals.push_back(len > 0.0f ? sum/len : faceNormal);
+        }
+    }
+    else
+    {
+        for (size_t corner = 0; corner < numCorners; ++corner)
+        {
+            cornerNormals.push_back(faceNormals[corner/3]);
+        }
+    }
+
+    // weld corners that have the same position and normal into one vertex
+    std::vector<glm::vec3> verts;
+    std::vector<glm::vec3> normals;
+    std::vector<uint32_t> indices;
+    indices.reserve(numCorners);
+    {
+        std::unordered_map<WeldedVertexKey, uint32_t, WeldedVertexKeyHasher> lut;
+        lut.reserve(positions.size());
+
+        for (size_t corner = 0; corner < numCorners; ++corner)
+        {
+            WeldedVertexKey const key{cornerPositionIndices[corner], cornerNormals[corner]};
+            auto const [it, inserted] = lut.try_emplace(key, static_cast<uint32_t>(verts.size()));
+            if (inserted)
+            {
+                verts.push_back(positions[key.positionIndex]);
+                normals.push_back(key.normal);
+            }
+            indices.push_back(it->second);
+        }
+    }
+
+    Mesh rv;
+    rv.setTopology(MeshTopology::Triangles);
+    rv.setVerts(verts);
+    rv.setNormals(normals);
+    rv.setIndices(indices);
+    return rv;
+}
+
 osc::Material osc::CreateWireframeOverlayMaterial(Config const& config, ShaderCache& cache)
 {
     std::filesystem::path const vertShader = config.getResourceDir() / "shaders/SceneSolidColor.vert";
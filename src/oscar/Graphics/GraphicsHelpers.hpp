@@ -26,6 +26,7 @@ namespace osc { struct Line; }
 namespace osc { struct Rect; }
 namespace osc { struct Segment; }
 namespace osc { struct Transform; }
+namespace osc { struct Triangle; }
 namespace osc { class Config; }
 namespace osc { class Image; }
 namespace osc { class Mesh; }
@@ -160,6 +161,29 @@ namespace osc
         MeshIndicesView const&
     );
 
+    // parameters for `CreateWeldedTriangleMesh`
+    struct MeshWeldingParams final {
+
+        // vertex positions that are (roughly) within this distance of each other are merged
+        float positionEpsilon = 1e-6f;
+
+        // if provided, vertex normals are smoothed across edges where the face normals of the
+        // adjacent triangles differ by less than this angle, so that (e.g.) curved surfaces
+        // are shaded smoothly while sharp edges stay sharp
+        //
+        // otherwise, each triangle is flat-shaded with its face normal
+        std::optional<float> maybeSmoothingAngleDegrees = std::nullopt;
+    };
+
+    // returns an indexed triangle mesh (with normals) that contains the provided triangles
+    //
+    // vertices that have (near-)identical positions and identical normals are welded
+    // together, so that they can be shared between triangles
+    Mesh CreateWeldedTriangleMesh(
+        nonstd::span<Triangle const>,
+        MeshWeldingParams const& = {}
+    );
+
     // returns a material that can draw a mesh's triangles in wireframe-style
     Material CreateWireframeOverlayMaterial(
         Config const&,
@@ -66,9 +66,12 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <sstream>
 #include <string>
@@ -191,6 +194,72 @@ namespace
             return osc::ShaderType::Unknown;
         }
     }
+
+    // returns a hash of the value that's cheap to compute and is equal for equal values
+    //
+    // (only the cheap-to-hash alternatives contribute their value to the hash, so unequal
+    // values may have equal hashes)
+    size_t HashForBatching(MaterialValue const& v)
+    {
+        size_t const valueHash = std::visit(osc::Overload
+        {
+            [](osc::Color const& c) { return std::hash<osc::Color>{}(c); },
+            [](float f) { return std::hash<float>{}(f); },
+            [](int32_t i) { return std::hash<int32_t>{}(i); },
+            [](bool b) { return std::hash<bool>{}(b); },
+            [](auto const&) { return static_cast<size_t>(0); },
+        }, v);
+        return osc::HashCombine(valueHash, v.index());
+    }
+
+    size_t HashFloats(float const* vs, size_t n)
+    {
+        size_t rv = 0;
+        for (float const* end = vs + n; vs != end; ++vs)
+        {
+            rv = osc::HashCombine(rv, *vs);
+        }
+        return rv;
+    }
+
+    template<typename T>
+    size_t HashElements(std::vector<T> const& vs)
+    {
+        size_t rv = std::hash<size_t>{}(vs.size());
+        for (T const& v : vs)
+        {
+            rv = osc::HashCombine(rv, v);
+        }
+        return rv;
+    }
+
+    // returns a hash of the value, such that equal values have equal hashes
+    //
+    // (unlike `HashForBatching`, every alternative contributes its value to the hash)
+    size_t HashOfContent(MaterialValue const& v)
+    {
+        size_t const valueHash = std::visit(osc::Overload
+        {
+            [](std::vector<osc::Color> const& cs) { return HashElements(cs); },
+            [](std::vector<float> const& fs) { return HashElements(fs); },
+            [](glm::vec2 const& v2) { return HashFloats(&v2.x, 2); },
+            [](glm::vec3 const& v3) { return HashFloats(&v3.x, 3); },
+            [](std::vector<glm::vec3> const& v3s)
+            {
+                size_t rv = std::hash<size_t>{}(v3s.size());
+                for (glm::vec3 const& v3 : v3s)
+                {
+                    rv = osc::HashCombine(rv, HashFloats(&v3.x, 3));
+                }
+                return rv;
+            },
+            [](glm::vec4 const& v4) { return HashFloats(&v4.x, 4); },
+            [](glm::mat3 const& m3) { return HashFloats(&m3[0][0], 9); },
+            [](glm::mat4 const& m4) { return HashFloats(&m4[0][0], 16); },
+            [](auto const& other) { return std::hash<std::decay_t<decltype(other)>>{}(other); },
+        }, v);
+        return osc::HashCombine(valueHash, v.index());
+    }
 }
 
 // shader (backend stuff)
@@ -358,7 +427,7 @@ namespace
             mesh{mesh_},
             propBlock{maybePropBlock_ ? std::move(maybePropBlock_).value() : osc::MaterialPropertyBlock{}},
             transform{transform_},
-            worldMidpoint{material.getTransparent() ? osc::TransformPoint(transform_, mesh.getMidpoint()) : glm::vec3{}}
+            worldMidpoint{osc::TransformPoint(transform_, mesh.getMidpoint())}
         {
         }
 
@@ -372,7 +441,7 @@ namespace
             mesh{mesh_},
             propBlock{maybePropBlock_ ? std::move(maybePropBlock_).value() : osc::MaterialPropertyBlock{}},
             transform{transform_},
-            worldMidpoint{material.getTransparent() ? transform_ * glm::vec4{mesh.getMidpoint(), 1.0f} : glm::vec3{}}
+            worldMidpoint{transform_ * glm::vec4{mesh.getMidpoint(), 1.0f}}
         {
         }
 
@@ -385,6 +454,7 @@ namespace
             swap(a.propBlock, b.propBlock);
             swap(a.transform, b.transform);
             swap(a.worldMidpoint, b.worldMidpoint);
+            swap(a.maybeInstanceColor, b.maybeInstanceColor);
         }
 
         osc::Material material;
@@ -392,6 +462,10 @@ namespace
         osc::MaterialPropertyBlock propBlock;
         Mat4OrTransform transform;
         glm::vec3 worldMidpoint;
+
+        // set if the material's shader takes `uDiffuseColor` as an instanced attribute (`aDiffuseColor`), in
+        // which case it's moved out of `propBlock`, so that differently-colored objects can be batched together
+        std::optional<osc::Color> maybeInstanceColor;
     };
 
     bool operator==(RenderObject const& a, RenderObject const& b) noexcept
@@ -401,7 +475,8 @@ namespace
             a.mesh == b.mesh &&
             a.propBlock == b.propBlock &&
             a.transform == b.transform &&
-            a.worldMidpoint == b.worldMidpoint;
+            a.worldMidpoint == b.worldMidpoint &&
+            a.maybeInstanceColor == b.maybeInstanceColor;
     }
 
     bool operator!=(RenderObject const& a, RenderObject const& b) noexcept
@@ -440,27 +515,6 @@ namespace
         return ro.worldMidpoint;
     }
 
-    // function object that returns true if the first argument is farther from the second
-    //
-    // (handy for scene sorting)
-    class RenderObjectIsFartherFrom final {
-    public:
-        RenderObjectIsFartherFrom(glm::vec3 const& pos) : m_Pos{pos} {}
-
-        bool operator()(RenderObject const& a, RenderObject const& b) const
-        {
-            glm::vec3 const aMidpointWorldSpace = WorldMidpoint(a);
-            glm::vec3 const bMidpointWorldSpace = WorldMidpoint(b);
-            glm::vec3 const camera2a = aMidpointWorldSpace - m_Pos;
-            glm::vec3 const camera2b = bMidpointWorldSpace - m_Pos;
-            float const camera2aDistanceSquared = glm::dot(camera2a, camera2a);
-            float const camera2bDistanceSquared = glm::dot(camera2b, camera2b);
-            return camera2aDistanceSquared > camera2bDistanceSquared;
-        }
-    private:
-        glm::vec3 m_Pos;
-    };
-
     class RenderObjectHasMaterial final {
     public:
         RenderObjectHasMaterial(osc::Material const& material) :
@@ -507,44 +561,107 @@ namespace
         std::reference_wrapper<osc::Mesh const> m_Mesh;
     };
 
-    // sort a sequence of `RenderObject`s for optimal drawing
-    std::vector<RenderObject>::iterator SortRenderQueue(std::vector<RenderObject>::iterator begin, std::vector<RenderObject>::iterator end, glm::vec3 cameraPos)
+    // returns a sortable 32-bit representation of a non-negative float (i.e. greater floats
+    // produce greater integers)
+    uint32_t ToSortableBits(float nonNegativeValue)
+    {
+        uint32_t rv = 0;
+        static_assert(sizeof(rv) == sizeof(nonNegativeValue));
+        std::memcpy(&rv, &nonNegativeValue, sizeof(rv));
+        return rv;
+    }
+
+    float DistanceSquared(RenderObject const& ro, glm::vec3 const& pos)
+    {
+        glm::vec3 const camera2midpoint = WorldMidpoint(ro) - pos;
+        return glm::dot(camera2midpoint, camera2midpoint);
+    }
+
+    // layout of a render object's 64-bit sort key
+    //
+    // opaque:      [0 (1 bit)][material ID (16 bits)][prop block ID (16 bits)][mesh ID (16 bits)][depth (15 bits)]
+    // transparent: [1 (1 bit)][unused (31 bits)][inverted depth (32 bits)]
+    //
+    // so that sorting the keys puts opaque objects first (batched by material, then prop block,
+    // then mesh, then front-to-back) followed by transparent objects (back-to-front)
+    constexpr uint64_t c_RenderQueueTransparentBit = static_cast<uint64_t>(1) << 63;
+    constexpr uint64_t c_RenderQueueMaxID = 0xffff;
+
+    uint64_t CalcOpaqueSortKey(uint64_t materialID, uint64_t propBlockID, uint64_t meshID, float distanceSquared)
+    {
+        // IDs are dense per-flush ordinals, so they'll only saturate in scenes with >65k distinct
+        // materials/blocks/meshes, which only affects batching (not correctness)
+        uint64_t const depth = ToSortableBits(distanceSquared) >> 17;  // (coarse) top bits
+
+        return
+            (std::min(materialID, c_RenderQueueMaxID) << 47) |
+            (std::min(propBlockID, c_RenderQueueMaxID) << 31) |
+            (std::min(meshID, c_RenderQueueMaxID) << 15) |
+            depth;
+    }
+
+    uint64_t CalcTransparentSortKey(float distanceSquared)
+    {
+        return c_RenderQueueTransparentBit | static_cast<uint64_t>(~ToSortableBits(distanceSquared));
+    }
+
+    // an entry in the render queue's sort buffer
+    struct RenderQueueSortEntry final {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    // sorts the entries by key with a stable least-significant-digit radix sort
+    //
+    // passes where every key has the same digit (e.g. the unused bits of the key) are skipped
+    void RadixSortByKey(std::vector<RenderQueueSortEntry>& entries, std::vector<RenderQueueSortEntry>& scratch)
     {
-        // split queue into [opaque | transparent]
-        auto const opaqueEnd = std::partition(begin, end, IsOpaque);
+        constexpr size_t numDigits = sizeof(uint64_t);
+        std::array<std::array<size_t, 256>, numDigits> counts{};
+        for (RenderQueueSortEntry const& e : entries)
+        {
+            for (size_t digit = 0; digit < numDigits; ++digit)
+            {
+                ++counts[digit][(e.key >> (8*digit)) & 0xff];
+            }
+        }
 
-        // optimize the opaque partition (it can be reordered safely)
+        scratch.resize(entries.size());
+        for (size_t digit = 0; digit < numDigits; ++digit)
         {
-            // first, sub-parititon by material (top-level batch)
-            auto materialBatchStart = begin;
-            while (materialBatchStart != opaqueEnd)
+            std::array<size_t, 256>& digitCounts = counts[digit];
+            if (std::find(digitCounts.begin(), digitCounts.end(), entries.size()) != digitCounts.end())
             {
-                auto const materialBatchEnd = std::partition(materialBatchStart, opaqueEnd, RenderObjectHasMaterial{materialBatchStart->material});
+                continue;  // every key has the same value for this digit
+            }
 
-                // then sub-sub-partition by material property block
-                auto propBatchStart = materialBatchStart;
-                while (propBatchStart != materialBatchEnd)
-                {
-                    auto const propBatchEnd = std::partition(propBatchStart, materialBatchEnd, RenderObjectHasMaterialPropertyBlock{propBatchStart->propBlock});
-
-                    // then sub-sub-sub-partition by mesh
-                    auto meshBatchStart = propBatchStart;
-                    while (meshBatchStart != propBatchEnd)
-                    {
-                        auto const meshBatchEnd = std::partition(meshBatchStart, propBatchEnd, RenderObjectHasMesh{meshBatchStart->mesh});
-                        meshBatchStart = meshBatchEnd;
-                    }
-                    propBatchStart = propBatchEnd;
-                }
-                materialBatchStart = materialBatchEnd;
+            // counts --> offsets
+            size_t offset = 0;
+            for (size_t& count : digitCounts)
+            {
+                offset += std::exchange(count, offset);
             }
+
+            for (RenderQueueSortEntry const& e : entries)
+            {
+                scratch[digitCounts[(e.key >> (8*digit)) & 0xff]++] = e;
+            }
+            std::swap(entries, scratch);
         }
+    }
 
-        // sort the transparent partition by distance from camera (back-to-front)
-        std::sort(opaqueEnd, end, RenderObjectIsFartherFrom{cameraPos});
+    // assigns a dense ID to each distinct key (in order of first appearance)
+    template<typename Key>
+    class RenderQueueIDs final {
+    public:
+        uint64_t getOrAssign(Key const& key)
+        {
+            return m_IDs.try_emplace(key, m_IDs.size()).first->second;
+        }
 
-        return opaqueEnd;
-    }
+    private:
+        ankerl::unordered_dense::map<Key, uint64_t> m_IDs;
+    };
 
     // top-level state for a "scene" (i.e. a render)
     struct SceneState final {
@@ -638,6 +755,10 @@ namespace osc
             osc::Shader::Impl const& shaderImpl
         );
 
+        static void TryMoveDiffuseColorIntoInstanceData(
+            RenderObject&
+        );
+
         static void TryBindMaterialValueToShaderElement(
             ShaderElement const& se,
             MaterialValue const& v,
@@ -649,6 +770,16 @@ namespace osc
             nonstd::span<RenderObject const>
         );
 
+        static size_t HashForBatching(
+            MaterialPropertyBlock const&
+        );
+
+        static void SortRenderQueue(
+            std::vector<RenderObject>::iterator begin,
+            std::vector<RenderObject>::iterator end,
+            glm::vec3 const& cameraPos
+        );
+
         static void DrawBatchedByMaterial(
             SceneState const&,
             nonstd::span<RenderObject const>
@@ -2329,6 +2460,10 @@ private:
         {
             m_MaybeInstancedNormalMatAttr = *e;
         }
+        if (ShaderElement const* e = TryGetValue(m_Attributes, "aDiffuseColor"))
+        {
+            m_MaybeInstancedDiffuseColorAttr = *e;
+        }
     }
 
     friend class GraphicsBackend;
@@ -2344,6 +2479,7 @@ private:
     std::optional<ShaderElement> m_MaybeViewProjMatUniform;
     std::optional<ShaderElement> m_MaybeInstancedModelMatAttr;
     std::optional<ShaderElement> m_MaybeInstancedNormalMatAttr;
+    std::optional<ShaderElement> m_MaybeInstancedDiffuseColorAttr;
 };
 
 
@@ -3036,6 +3172,17 @@ public:
         return m_Values == other.m_Values;
     }
 
+    size_t hash() const
+    {
+        // the values aren't ordered, so the hash must not depend on iteration order
+        size_t rv = std::hash<size_t>{}(m_Values.size());
+        for (auto const& [name, value] : m_Values)
+        {
+            rv += osc::HashCombine(std::hash<std::string>{}(name), HashOfContent(value));
+        }
+        return rv;
+    }
+
 private:
     template<typename T>
     std::optional<T> getValue(std::string_view propertyName) const
@@ -3188,6 +3335,11 @@ bool osc::operator!=(MaterialPropertyBlock const& a, MaterialPropertyBlock const
     return a.m_Impl != b.m_Impl;
 }
 
+size_t std::hash<osc::MaterialPropertyBlock>::operator()(osc::MaterialPropertyBlock const& block) const
+{
+    return block.m_Impl->hash();
+}
+
 std::ostream& osc::operator<<(std::ostream& o, MaterialPropertyBlock const&)
 {
     return o << "MaterialPropertyBlock()";
@@ -3241,6 +3393,8 @@ public:
     void setTopology(MeshTopology newTopology)
     {
         m_Topology = newTopology;
+
+        recalculateBounds();
         m_Version->reset();
     }
 
@@ -3392,7 +3546,16 @@ public:
 
     BVH const& getBVH() const
     {
-        return m_TriangleBVH;
+        // the BVH is only built on first request, because many meshes (e.g. generated
+        // grids, warped previews) are rendered but never hit-tested
+        //
+        // the lock is necessary because a const `Impl` may be shared between threads
+        std::lock_guard lock{*m_TriangleBVHMutex};
+        if (!*m_MaybeTriangleBVH)
+        {
+            m_MaybeTriangleBVH->emplace(buildTriangleBVH());
+        }
+        return **m_MaybeTriangleBVH;
     }
 
     void clear()
@@ -3409,6 +3572,7 @@ public:
         m_IndicesData.clear();
         m_AABB = {};
         m_Midpoint = {};
+        m_MaybeTriangleBVH->reset();
     }
 
     // non-PIMPL methods
@@ -3445,9 +3609,10 @@ public:
 
 private:
 
+    // recomputes the (cheap) bounds of the mesh and invalidates the (expensive) BVH
     void recalculateBounds()
     {
-        OSC_PERF("bounds/BVH computation");
+        OSC_PERF("bounds computation");
 
         if (m_NumIndices == 0)
         {
@@ -3455,35 +3620,38 @@ private:
         }
         else if (m_IndicesAre32Bit)
         {
-            nonstd::span<uint32_t const> const indices(&m_IndicesData.front().u32, m_NumIndices);
+            m_AABB = AABBFromIndexedVerts(m_Vertices, nonstd::span<uint32_t const>{&m_IndicesData.front().u32, m_NumIndices});
+        }
+        else
+        {
+            m_AABB = AABBFromIndexedVerts(m_Vertices, nonstd::span<uint16_t const>{&m_IndicesData.front().u16.a, m_NumIndices});
+        }
+        m_Midpoint = Midpoint(m_AABB);
 
-            if (m_Topology == MeshTopology::Triangles)
-            {
-                m_TriangleBVH.buildFromIndexedTriangles(m_Vertices, indices);
-                m_AABB = m_TriangleBVH.nodes.front().getBounds();
-            }
-            else
-            {
-                m_TriangleBVH.clear();
-                m_AABB = AABBFromIndexedVerts(m_Vertices, indices);
-            }
+        // the BVH is (re)built on-demand by `getBVH`
+        m_MaybeTriangleBVH->reset();
+    }
+
+    BVH buildTriangleBVH() const
+    {
+        OSC_PERF("BVH computation");
+
+        BVH rv;
+        if (m_Topology != MeshTopology::Triangles || m_NumIndices == 0)
+        {
+            return rv;  // only triangle meshes have a triangle BVH
+        }
+        else if (m_IndicesAre32Bit)
+        {
+            nonstd::span<uint32_t const> const indices(&m_IndicesData.front().u32, m_NumIndices);
+            rv.buildFromIndexedTriangles(m_Vertices, indices);
         }
         else
         {
             nonstd::span<uint16_t const> const indices(&m_IndicesData.front().u16.a, m_NumIndices);
-
-            if (m_Topology == MeshTopology::Triangles)
-            {
-                m_TriangleBVH.buildFromIndexedTriangles(m_Vertices, indices);
-                m_AABB = m_TriangleBVH.nodes.empty() ? AABB{} : m_TriangleBVH.nodes.front().getBounds();
-            }
-            else
-            {
-                m_TriangleBVH.clear();
-                m_AABB = AABBFromIndexedVerts(m_Vertices, indices);
-            }
+            rv.buildFromIndexedTriangles(m_Vertices, indices);
         }
-        m_Midpoint = Midpoint(m_AABB);
+        return rv;
     }
 
     void uploadToGPU()
@@ -3647,7 +3815,10 @@ private:
 
     AABB m_AABB = {};
     glm::vec3 m_Midpoint = {};
-    BVH m_TriangleBVH;
+
+    // lazily built by `getBVH` (copies rebuild it on-demand, rather than copying it)
+    mutable DefaultConstructOnCopy<std::mutex> m_TriangleBVHMutex;
+    mutable DefaultConstructOnCopy<std::optional<BVH>> m_MaybeTriangleBVH;
 
     DefaultConstructOnCopy<std::optional<MeshOpenGLData>> m_MaybeGPUBuffers;
 };
@@ -4787,6 +4958,9 @@ public:
     // storage for instance data
     std::vector<float> m_InstanceCPUBuffer;
     gl::ArrayBuffer<float, GL_STREAM_DRAW> m_InstanceGPUBuffer;
+
+    // number of draw calls issued by the current render queue flush
+    size_t m_NumDrawCallsInFlush = 0;
 };
 
 static std::unique_ptr<osc::GraphicsContext::Impl> g_GraphicsContextImpl = nullptr;
@@ -4954,7 +5128,7 @@ std::optional<InstancingState> osc::GraphicsBackend::UploadInstanceData(
     // preemptively upload instancing data
     std::optional<InstancingState> maybeInstancingState;
 
-    if (shaderImpl.m_MaybeInstancedModelMatAttr || shaderImpl.m_MaybeInstancedNormalMatAttr)
+    if (shaderImpl.m_MaybeInstancedModelMatAttr || shaderImpl.m_MaybeInstancedNormalMatAttr || shaderImpl.m_MaybeInstancedDiffuseColorAttr)
     {
         // compute the stride between each instance
         size_t byteStride = 0;
@@ -4976,6 +5150,18 @@ std::optional<InstancingState> osc::GraphicsBackend::UploadInstanceData(
                 byteStride += sizeof(float) * 9;
             }
         }
+        if (shaderImpl.m_MaybeInstancedDiffuseColorAttr)
+        {
+            if (shaderImpl.m_MaybeInstancedDiffuseColorAttr->shaderType == osc::ShaderType::Vec4)
+            {
+                byteStride += sizeof(float) * 4;
+            }
+        }
+
+        // instances that weren't drawn with a color use the material's color (if any)
+        Color const defaultDiffuseColor = shaderImpl.m_MaybeInstancedDiffuseColorAttr ?
+            els.front().material.getColor("uDiffuseColor").value_or(Color::white()) :
+            Color::white();
 
         // write the instance data into a CPU-side buffer
 
@@ -5010,6 +5196,16 @@ std::optional<InstancingState> osc::GraphicsBackend::UploadInstanceData(
                     floatOffset += 9;
                 }
             }
+            if (shaderImpl.m_MaybeInstancedDiffuseColorAttr)
+            {
+                if (shaderImpl.m_MaybeInstancedDiffuseColorAttr->shaderType == osc::ShaderType::Vec4)
+                {
+                    // colors are converted from sRGB to linear, like when they're bound as uniforms
+                    static_assert(alignof(glm::vec4) == alignof(float) && sizeof(glm::vec4) == 4 * sizeof(float));
+                    reinterpret_cast<glm::vec4&>(buf[floatOffset]) = ToLinear(el.maybeInstanceColor.value_or(defaultDiffuseColor));
+                    floatOffset += 4;
+                }
+            }
         }
         OSC_ASSERT_ALWAYS(sizeof(float)*floatOffset == els.size() * byteStride);
 
@@ -5019,6 +5215,35 @@ std::optional<InstancingState> osc::GraphicsBackend::UploadInstanceData(
     return maybeInstancingState;
 }
 
+// helper: moves a render object's `uDiffuseColor` out of its property block, if its shader
+// takes the color as an instanced attribute
+//
+// (so that objects that only differ by color have equal property blocks, and can be batched)
+void osc::GraphicsBackend::TryMoveDiffuseColorIntoInstanceData(RenderObject& ro)
+{
+    Shader::Impl const& shaderImpl = *ro.material.m_Impl->m_Shader.m_Impl;
+    if (!shaderImpl.m_MaybeInstancedDiffuseColorAttr)
+    {
+        return;  // the shader takes the color as a uniform (if at all)
+    }
+
+    std::optional<Color> const maybeColor = ro.propBlock.getColor("uDiffuseColor");
+    if (!maybeColor)
+    {
+        return;  // no per-object color: the material's color will be used
+    }
+
+    ro.maybeInstanceColor = *maybeColor;
+    if (ro.propBlock.m_Impl->m_Values.size() == 1)
+    {
+        ro.propBlock = MaterialPropertyBlock{};  // (shared) empty block: no allocation
+    }
+    else
+    {
+        ro.propBlock.m_Impl.upd()->m_Values.erase(std::string{"uDiffuseColor"});
+    }
+}
+
 // helper: binds to instanced attributes (per-drawcall)
 void osc::GraphicsBackend::BindToInstancedAttributes(
         Shader::Impl const& shaderImpl,
@@ -5046,7 +5271,7 @@ void osc::GraphicsBackend::BindToInstancedAttributes(
             gl::VertexAttribPointer(mmtxAttr, false, ins.stride, ins.baseOffset + byteOffset);
             gl::VertexAttribDivisor(mmtxAttr, 1);
             gl::EnableVertexAttribArray(mmtxAttr);
-            // unused: byteOffset += sizeof(float) * 16;
+            byteOffset += sizeof(float) * 16;
         }
         else if (shaderImpl.m_MaybeInstancedNormalMatAttr->shaderType == ShaderType::Mat3)
         {
@@ -5054,7 +5279,18 @@ void osc::GraphicsBackend::BindToInstancedAttributes(
             gl::VertexAttribPointer(mmtxAttr, false, ins.stride, ins.baseOffset + byteOffset);
             gl::VertexAttribDivisor(mmtxAttr, 1);
             gl::EnableVertexAttribArray(mmtxAttr);
-            // unused: byteOffset += sizeof(float) * 9;
+            byteOffset += sizeof(float) * 9;
+        }
+    }
+    if (shaderImpl.m_MaybeInstancedDiffuseColorAttr)
+    {
+        if (shaderImpl.m_MaybeInstancedDiffuseColorAttr->shaderType == ShaderType::Vec4)
+        {
+            gl::AttributeVec4 colorAttr{shaderImpl.m_MaybeInstancedDiffuseColorAttr->location};
+            gl::VertexAttribPointer(colorAttr, false, ins.stride, ins.baseOffset + byteOffset);
+            gl::VertexAttribDivisor(colorAttr, 1);
+            gl::EnableVertexAttribArray(colorAttr);
+            // unused: byteOffset += sizeof(float) * 4;
         }
     }
 }
@@ -5085,6 +5321,14 @@ void osc::GraphicsBackend::UnbindFromInstancedAttributes(
             gl::DisableVertexAttribArray(mmtxAttr);
         }
     }
+    if (shaderImpl.m_MaybeInstancedDiffuseColorAttr)
+    {
+        if (shaderImpl.m_MaybeInstancedDiffuseColorAttr->shaderType == ShaderType::Vec4)
+        {
+            gl::AttributeVec4 colorAttr{shaderImpl.m_MaybeInstancedDiffuseColorAttr->location};
+            gl::DisableVertexAttribArray(colorAttr);
+        }
+    }
 }
 
 // helper: draw a batch of render objects that have the same material, material block, and mesh
@@ -5135,6 +5379,7 @@ void osc::GraphicsBackend::HandleBatchWithSameMesh(
                 BindToInstancedAttributes(shaderImpl, *ins);
             }
             meshImpl.drawInstanced(1);
+            ++g_GraphicsContextImpl->m_NumDrawCallsInFlush;
             if (ins)
             {
                 UnbindFromInstancedAttributes(shaderImpl, *ins);
@@ -5149,6 +5394,7 @@ void osc::GraphicsBackend::HandleBatchWithSameMesh(
             BindToInstancedAttributes(shaderImpl, *ins);
         }
         meshImpl.drawInstanced(els.size());
+        ++g_GraphicsContextImpl->m_NumDrawCallsInFlush;
         if (ins)
         {
             UnbindFromInstancedAttributes(shaderImpl, *ins);
@@ -5481,6 +5727,84 @@ void osc::GraphicsBackend::DrawBatchedByOpaqueness(
     }
 }
 
+size_t osc::GraphicsBackend::HashForBatching(MaterialPropertyBlock const& block)
+{
+    // combined with addition, so that the hash doesn't depend on iteration order
+    size_t rv = 0;
+    for (auto const& [name, value] : block.m_Impl->m_Values)
+    {
+        rv += HashCombine(std::hash<std::string>{}(name), ::HashForBatching(value));
+    }
+    return rv;
+}
+
+// sort a sequence of `RenderObject`s for optimal drawing
+void osc::GraphicsBackend::SortRenderQueue(
+    std::vector<RenderObject>::iterator begin,
+    std::vector<RenderObject>::iterator end,
+    glm::vec3 const& cameraPos)
+{
+    OSC_PERF("GraphicsBackend::SortRenderQueue");
+
+    // assign a dense ID to each distinct material and mesh (by identity) and property
+    // block (by value, because callers tend to create a new block per draw call)
+    RenderQueueIDs<Material::Impl const*> materialIDs;
+    RenderQueueIDs<Mesh::Impl const*> meshIDs;
+    ankerl::unordered_dense::map<MaterialPropertyBlock::Impl const*, uint64_t> propBlockIDsByImpl;
+    ankerl::unordered_dense::map<size_t, std::vector<std::pair<MaterialPropertyBlock const*, uint64_t>>> propBlockIDsByHash;
+    uint64_t numDistinctPropBlocks = 0;
+
+    auto const getPropBlockID = [&](MaterialPropertyBlock const& block)
+    {
+        auto const [implIt, inserted] = propBlockIDsByImpl.try_emplace(block.m_Impl.get(), 0);
+        if (!inserted)
+        {
+            return implIt->second;  // already seen this exact block
+        }
+
+        // not seen this block before: find an equal-valued block, or assign it a new ID
+        std::vector<std::pair<MaterialPropertyBlock const*, uint64_t>>& bucket = propBlockIDsByHash[HashForBatching(block)];
+        auto const it = std::find_if(bucket.begin(), bucket.end(), [&block](auto const& p) { return *p.first == block; });
+        if (it != bucket.end())
+        {
+            implIt->second = it->second;
+        }
+        else
+        {
+            implIt->second = numDistinctPropBlocks++;
+            bucket.emplace_back(&block, implIt->second);
+        }
+        return implIt->second;
+    };
+
+    // compute a sort key for each render object
+    auto const numObjects = static_cast<size_t>(std::distance(begin, end));
+    std::vector<RenderQueueSortEntry> entries;
+    entries.reserve(numObjects);
+    for (size_t i = 0; i < numObjects; ++i)
+    {
+        RenderObject const& ro = begin[i];
+        float const distanceSquared = DistanceSquared(ro, cameraPos);
+        uint64_t const key = IsOpaque(ro) ?
+            CalcOpaqueSortKey(materialIDs.getOrAssign(ro.material.m_Impl.get()), getPropBlockID(ro.propBlock), meshIDs.getOrAssign(ro.mesh.m_Impl.get()), distanceSquared) :
+            CalcTransparentSortKey(distanceSquared);
+        entries.push_back({key, static_cast<uint32_t>(i)});
+    }
+
+    // sort the keys (not the `RenderObject`s, which are comparatively expensive to move)
+    std::vector<RenderQueueSortEntry> scratch;
+    RadixSortByKey(entries, scratch);
+
+    // then apply the sorted order to the `RenderObject`s in one pass
+    std::vector<RenderObject> sorted;
+    sorted.reserve(numObjects);
+    for (RenderQueueSortEntry const& e : entries)
+    {
+        sorted.push_back(std::move(begin[e.index]));
+    }
+    std::move(sorted.begin(), sorted.end(), begin);
+}
+
 void osc::GraphicsBackend::FlushRenderQueue(Camera::Impl& camera, float aspectRatio)
 {
     OSC_PERF("GraphicsBackend::FlushRenderQueue");
@@ -5544,6 +5868,8 @@ void osc::GraphicsBackend::FlushRenderQueue(Camera::Impl& camera, float aspectRa
 
     // queue flushed: clear it
     queue.clear();
+
+    OSC_PERF_COUNT("GraphicsBackend::FlushRenderQueue/drawCalls", std::exchange(g_GraphicsContextImpl->m_NumDrawCallsInFlush, 0));
 }
 
 void osc::GraphicsBackend::ValidateRenderTarget(RenderTarget& renderTarget)
@@ -5849,7 +6175,8 @@ void osc::GraphicsBackend::DrawMesh(
     Camera& camera,
     std::optional<MaterialPropertyBlock> maybeMaterialPropertyBlock)
 {
-    camera.m_Impl.upd()->m_RenderQueue.emplace_back(mesh, transform, material, std::move(maybeMaterialPropertyBlock));
+    RenderObject& ro = camera.m_Impl.upd()->m_RenderQueue.emplace_back(mesh, transform, material, std::move(maybeMaterialPropertyBlock));
+    TryMoveDiffuseColorIntoInstanceData(ro);
 }
 
 void osc::GraphicsBackend::DrawMesh(
@@ -5859,7 +6186,8 @@ void osc::GraphicsBackend::DrawMesh(
     Camera& camera,
     std::optional<MaterialPropertyBlock> maybeMaterialPropertyBlock)
 {
-    camera.m_Impl.upd()->m_RenderQueue.emplace_back(mesh, transform, material, std::move(maybeMaterialPropertyBlock));
+    RenderObject& ro = camera.m_Impl.upd()->m_RenderQueue.emplace_back(mesh, transform, material, std::move(maybeMaterialPropertyBlock));
+    TryMoveDiffuseColorIntoInstanceData(ro);
 }
 
 void osc::GraphicsBackend::BlitToScreen(
@@ -15,7 +15,9 @@
 #include <glm/vec4.hpp>
 #include <nonstd/span.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <optional>
 #include <string_view>
@@ -106,6 +108,7 @@ namespace osc
         friend class GraphicsBackend;
         friend bool operator==(Material const&, Material const&) noexcept;
         friend bool operator!=(Material const&, Material const&) noexcept;
+        friend struct std::hash<Material>;
         friend std::ostream& operator<<(std::ostream&, Material const&);
 
         class Impl;
@@ -123,3 +126,14 @@ namespace osc
     }
     std::ostream& operator<<(std::ostream&, Material const&);
 }
+
+namespace std
+{
+    template<>
+    struct hash<osc::Material> final {
+        size_t operator()(osc::Material const& v) const
+        {
+            return hash<osc::CopyOnUpdPtr<osc::Material::Impl>>{}(v.m_Impl);
+        }
+    };
+}
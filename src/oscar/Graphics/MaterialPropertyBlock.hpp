@@ -9,7 +9,9 @@
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <optional>
 #include <string_view>
@@ -73,6 +75,7 @@ namespace osc
         friend bool operator==(MaterialPropertyBlock const&, MaterialPropertyBlock const&) noexcept;
         friend bool operator!=(MaterialPropertyBlock const&, MaterialPropertyBlock const&) noexcept;
         friend std::ostream& operator<<(std::ostream&, MaterialPropertyBlock const&);
+        friend struct std::hash<MaterialPropertyBlock>;
 
         class Impl;
         CopyOnUpdPtr<Impl> m_Impl;
@@ -81,4 +84,13 @@ namespace osc
     bool operator==(MaterialPropertyBlock const&, MaterialPropertyBlock const&) noexcept;
     bool operator!=(MaterialPropertyBlock const&, MaterialPropertyBlock const&) noexcept;
     std::ostream& operator<<(std::ostream&, MaterialPropertyBlock const&);
-}
\ No newline at end of file
+}
+
+namespace std
+{
+    // hashes the content of a property block, such that equal property blocks have equal hashes
+    template<>
+    struct hash<osc::MaterialPropertyBlock> final {
+        size_t operator()(osc::MaterialPropertyBlock const&) const;
+    };
+}
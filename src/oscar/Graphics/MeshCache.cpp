@@ -1,14 +1,33 @@
 #include "MeshCache.hpp"
 
+#include "oscar/Formats/MeshBinary.hpp"
 #include "oscar/Graphics/Mesh.hpp"
 #include "oscar/Graphics/MeshGen.hpp"
 #include "oscar/Platform/Log.hpp"
+#include "oscar/Platform/os.hpp"
 #include "oscar/Utils/Algorithms.hpp"
 #include "oscar/Utils/SynchronizedValue.hpp"
+#include "oscar/Utils/WorkStealingThreadPool.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <functional>
+#include <future>
+#include <iomanip>
 #include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -34,6 +53,271 @@ namespace
     {
         return a.torusCenterToTubeCenterRadius == b.torusCenterToTubeCenterRadius && a.tubeRadius == b.tubeRadius;
     }
+
+    // the version of the on-disk cache's keys
+    //
+    // bump this whenever the meshes that are written to the cache change for the same source
+    // file (e.g. because a loader, or what's written, changed), so that stale entries are ignored
+    constexpr int c_OnDiskCacheVersion = 2;
+
+    // returns a string that identifies the current content of the file at the given path (i.e. its
+    // absolute path, size, and modification time), or `std::nullopt` if it cannot be computed
+    std::optional<std::string> TryGetSourceFileKey(std::filesystem::path const& path)
+    {
+        std::error_code ec;
+        std::filesystem::path const absPath = std::filesystem::absolute(path, ec);
+        if (ec)
+        {
+            return std::nullopt;
+        }
+        auto const size = std::filesystem::file_size(absPath, ec);
+        if (ec)
+        {
+            return std::nullopt;
+        }
+        auto const modificationTime = std::filesystem::last_write_time(absPath, ec);
+        if (ec)
+        {
+            return std::nullopt;
+        }
+
+        std::stringstream ss;
+        ss << 'v' << c_OnDiskCacheVersion << '|' << absPath.lexically_normal().string() << '|' << size << '|' << modificationTime.time_since_epoch().count();
+        return std::move(ss).str();
+    }
+
+    std::filesystem::path GetOnDiskCachePath(std::filesystem::path const& cacheDir, std::string const& sourceFileKey)
+    {
+        std::stringstream ss;
+        ss << std::hex << std::setw(16) << std::setfill('0') << osc::HashOf(sourceFileKey) << '.' << osc::c_MeshBinaryFileExtension;
+        return cacheDir / std::move(ss).str();
+    }
+
+    std::optional<osc::Mesh> TryReadFromOnDiskCache(
+        std::filesystem::path const& cachePath,
+        std::string const& sourceFileKey)
+    {
+        std::ifstream in{cachePath, std::ios::binary};
+        if (!in)
+        {
+            return std::nullopt;  // not cached yet
+        }
+
+        try
+        {
+            osc::MeshBinaryContents contents = osc::ReadMeshBinary(in);
+            if (contents.key != sourceFileKey)
+            {
+                return std::nullopt;  // hash collision with another source file
+            }
+
+            // mark the file as recently used, so that it's evicted after less-recently-used ones
+            std::error_code ec;
+            std::filesystem::last_write_time(cachePath, std::filesystem::file_time_type::clock::now(), ec);
+
+            return std::move(contents.mesh);
+        }
+        catch (std::exception const& ex)
+        {
+            osc::log::warn("%s: error reading a cached mesh: it will be reloaded from its source file: %s", cachePath.string().c_str(), ex.what());
+            return std::nullopt;
+        }
+    }
+
+    void TryWriteToOnDiskCache(
+        std::filesystem::path const& cachePath,
+        std::string const& sourceFileKey,
+        osc::Mesh const& mesh)
+    {
+        // write to a temporary file first and then rename it, so that other readers (e.g. another
+        // instance of the application) never see a partially-written cache file
+        std::filesystem::path tmpPath = cachePath;
+        tmpPath += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+        try
+        {
+            std::filesystem::create_directories(cachePath.parent_path());
+            {
+                std::ofstream out{tmpPath, std::ios::binary | std::ios::trunc};
+                if (!out)
+                {
+                    throw std::runtime_error{"cannot open the file for writing"};
+                }
+                osc::WriteMeshBinary(out, mesh, sourceFileKey);
+                if (!out)
+                {
+                    throw std::runtime_error{"error writing to the file"};
+                }
+            }
+            std::filesystem::rename(tmpPath, cachePath);
+        }
+        catch (std::exception const& ex)
+        {
+            osc::log::warn("%s: error writing a mesh to the on-disk mesh cache: %s", cachePath.string().c_str(), ex.what());
+
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+
+    // deletes the least-recently-used mesh binary files in the cache directory until the
+    // directory's mesh binary files are no larger than `maxSize`
+    void EvictFromOnDiskCache(std::filesystem::path const& cacheDir, size_t maxSize)
+    {
+        struct CacheFile final {
+            std::filesystem::path path;
+            std::uintmax_t size;
+            std::filesystem::file_time_type lastUsed;
+        };
+
+        std::filesystem::path const extension{std::string{"."} + osc::c_MeshBinaryFileExtension.c_str()};
+        std::vector<CacheFile> files;
+        std::uintmax_t totalSize = 0;
+        std::error_code ec;
+        for (std::filesystem::directory_iterator it{cacheDir, ec}, end; !ec && it != end; it.increment(ec))
+        {
+            std::filesystem::path const& p = it->path();
+            if (p.extension() != extension)
+            {
+                continue;  // e.g. another thread's temporary file
+            }
+
+            std::error_code sizeEc;
+            std::error_code timeEc;
+            std::uintmax_t const size = it->file_size(sizeEc);
+            std::filesystem::file_time_type const lastUsed = it->last_write_time(timeEc);
+            if (!sizeEc && !timeEc)
+            {
+                files.push_back(CacheFile{p, size, lastUsed});
+                totalSize += size;
+            }
+        }
+
+        if (totalSize <= maxSize)
+        {
+            return;
+        }
+
+        std::sort(files.begin(), files.end(), [](CacheFile const& a, CacheFile const& b)
+        {
+            return a.lastUsed < b.lastUsed;
+        });
+        for (CacheFile const& f : files)
+        {
+            if (totalSize <= maxSize)
+            {
+                break;
+            }
+            std::error_code removeEc;
+            if (std::filesystem::remove(f.path, removeEc))
+            {
+                totalSize -= f.size;
+            }
+        }
+    }
+
+    // returns true if the mesh binary format can store all of the mesh's data (e.g. it doesn't
+    // store texture coordinates or colors)
+    bool CanBeWrittenToOnDiskCache(osc::Mesh const& mesh)
+    {
+        return mesh.getTexCoords().empty() && mesh.getColors().empty() && mesh.getTangents().empty();
+    }
+
+    osc::Mesh LoadViaOnDiskCache(
+        std::optional<std::filesystem::path> const& maybeCacheDir,
+        size_t maxCacheDirSize,
+        std::filesystem::path const& path,
+        std::function<osc::Mesh(std::filesystem::path const&)> const& loader)
+    {
+        if (!maybeCacheDir)
+        {
+            return loader(path);
+        }
+
+        std::optional<std::string> const maybeSourceFileKey = TryGetSourceFileKey(path);
+        if (!maybeSourceFileKey)
+        {
+            return loader(path);  // e.g. the file doesn't exist: let the loader report it
+        }
+
+        std::filesystem::path const cachePath = GetOnDiskCachePath(*maybeCacheDir, *maybeSourceFileKey);
+        if (std::optional<osc::Mesh> maybeCached = TryReadFromOnDiskCache(cachePath, *maybeSourceFileKey))
+        {
+            return *std::move(maybeCached);
+        }
+
+        osc::Mesh rv = loader(path);
+        if (CanBeWrittenToOnDiskCache(rv))
+        {
+            TryWriteToOnDiskCache(cachePath, *maybeSourceFileKey, rv);
+            EvictFromOnDiskCache(*maybeCacheDir, maxCacheDirSize);
+        }
+        return rv;
+    }
+
+    // the pool that background (e.g. prefetched) mesh loads run on
+    osc::WorkStealingThreadPool& GetMeshLoadingThreadPool()
+    {
+        static osc::WorkStealingThreadPool s_Pool;
+        return s_Pool;
+    }
+
+    // load counters, which are shared with background loads, so that those loads can
+    // safely finish after the cache that started them is destroyed
+    struct LoadCounters final {
+        std::atomic<size_t> numPending{0};
+    };
+
+    // fulfills the promise with the getter's mesh, or `fallback` if the getter throws
+    void FulfillLoad(
+        std::promise<osc::Mesh>& promise,
+        std::string const& key,
+        std::function<osc::Mesh()> const& getter,
+        osc::Mesh const& fallback,
+        LoadCounters& counters)
+    {
+        try
+        {
+            promise.set_value(getter());
+        }
+        catch (std::exception const& ex)
+        {
+            osc::log::error("%s: error getting a mesh via a getter: it will be replaced with a dummy cube: %s", key.c_str(), ex.what());
+            promise.set_value(fallback);
+        }
+        catch (...)
+        {
+            osc::log::error("%s: unknown error getting a mesh via a getter: it will be replaced with a dummy cube", key.c_str());
+            promise.set_value(fallback);
+        }
+
+        --counters.numPending;
+    }
+
+    bool IsReady(std::shared_future<osc::Mesh> const& future)
+    {
+        return future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+    }
+
+    // returns the key that a mesh file is cached with
+    //
+    // the path is normalized, so that different spellings of the same path (e.g. a relative
+    // path from a decoration vs. the absolute path used to prefetch it) share one load
+    std::string ToFileCacheKey(std::filesystem::path const& path)
+    {
+        std::error_code ec;
+        std::filesystem::path const absPath = std::filesystem::absolute(path, ec);
+        return (ec ? path : absPath).lexically_normal().string();
+    }
+
+    // placeholders that were handed out while their meshes were loading in the background
+    //
+    // each load gets its own placeholder, so that callers can check whether the meshes that
+    // they actually used have loaded, rather than whether any load has finished
+    struct Placeholders final {
+        std::unordered_map<std::string, osc::Mesh> byKey;
+        std::unordered_map<osc::Mesh, std::shared_future<osc::Mesh>> loads;
+    };
 }
 
 namespace std
@@ -49,6 +333,59 @@ namespace std
 
 class osc::MeshCache::Impl final {
 public:
+    Impl(
+        std::function<std::optional<std::filesystem::path>()> getOnDiskCacheDir_,
+        size_t maxOnDiskCacheSize_) :
+
+        getOnDiskCacheDir{std::move(getOnDiskCacheDir_)},
+        maxOnDiskCacheSize{maxOnDiskCacheSize_}
+    {
+    }
+
+    // returns a getter that loads the mesh at the given path via the on-disk cache
+    std::function<Mesh()> makeFileGetter(
+        std::filesystem::path const& path,
+        std::function<Mesh(std::filesystem::path const&)> const& loader) const
+    {
+        return [getOnDiskCacheDir = getOnDiskCacheDir, maxOnDiskCacheSize = maxOnDiskCacheSize, path, loader]()
+        {
+            return LoadViaOnDiskCache(getOnDiskCacheDir(), maxOnDiskCacheSize, path, loader);
+        };
+    }
+
+    // returns the (possibly, not-yet-ready) mesh for the given key, and a promise for it if
+    // the key wasn't already loaded/loading, which the caller must then fulfill
+    std::pair<std::shared_future<Mesh>, std::optional<std::promise<Mesh>>> lookupOrInsert(std::string const& key)
+    {
+        auto guard = fileCacheShards[std::hash<std::string>{}(key) % fileCacheShards.size()].lock();
+
+        auto [it, inserted] = guard->try_emplace(key);
+        if (!inserted)
+        {
+            return {it->second, std::nullopt};
+        }
+
+        std::promise<Mesh> promise;
+        it->second = promise.get_future().share();
+        ++loadCounters->numPending;
+        return {it->second, std::move(promise)};
+    }
+
+    // like `lookupOrInsert`, but the mesh is loaded (if necessary) on a background thread
+    std::shared_future<Mesh> lookupOrLoadInBackground(std::string const& key, std::function<Mesh()> getter)
+    {
+        auto lookup = lookupOrInsert(key);
+        if (lookup.second)
+        {
+            auto promise = std::make_shared<std::promise<Mesh>>(*std::move(lookup.second));
+            GetMeshLoadingThreadPool().submit([promise, key, getter = std::move(getter), fallback = cube, counters = loadCounters]()
+            {
+                FulfillLoad(*promise, key, getter, fallback, *counters);
+            });
+        }
+        return lookup.first;
+    }
+
     Mesh sphere = GenUntexturedUVSphere(16, 16);
     Mesh circle = GenCircle(16);
     Mesh cylinder = GenUntexturedYToYCylinder(16);
@@ -60,12 +397,41 @@ public:
     Mesh yLine = GenYLine();
     Mesh texturedQuad = GenTexturedQuad();
 
+    // returns the placeholder for the given (not-yet-loaded) key's mesh
+    Mesh getPlaceholder(std::string const& key, std::shared_future<Mesh> const& future)
+    {
+        auto guard = placeholders.lock();
+        auto [it, inserted] = guard->byKey.try_emplace(key);
+        if (inserted)
+        {
+            guard->loads.emplace(it->second, future);
+        }
+        return it->second;
+    }
+
     SynchronizedValue<std::unordered_map<TorusParameters, Mesh>> torusCache;
-    SynchronizedValue<std::unordered_map<std::string, Mesh>> fileCache;
+
+    // each key maps onto a future that is fulfilled by whichever caller first asked for it, and
+    // keys are spread over shards, so that loading (or looking up) one mesh doesn't block others
+    std::array<SynchronizedValue<std::unordered_map<std::string, std::shared_future<Mesh>>>, 16> fileCacheShards;
+    std::shared_ptr<LoadCounters> loadCounters = std::make_shared<LoadCounters>();
+    SynchronizedValue<Placeholders> placeholders;
+
+    // (a callback, because resolving the default directory can be expensive)
+    std::function<std::optional<std::filesystem::path>()> getOnDiskCacheDir;
+    size_t maxOnDiskCacheSize;
 };
 
 osc::MeshCache::MeshCache() :
-    m_Impl{std::make_unique<Impl>()}
+    m_Impl{std::make_unique<Impl>([]() { return std::optional<std::filesystem::path>{GetUserDataDir() / "mesh_cache"}; }, c_DefaultMaxOnDiskCacheSize)}
+{
+}
+
+osc::MeshCache::MeshCache(
+    std::optional<std::filesystem::path> maybeOnDiskCacheDir,
+    size_t maxOnDiskCacheSize) :
+
+    m_Impl{std::make_unique<Impl>([dir = std::move(maybeOnDiskCacheDir)]() { return dir; }, maxOnDiskCacheSize)}
 {
 }
 
@@ -75,28 +441,64 @@ osc::MeshCache::~MeshCache() noexcept = default;
 
 void osc::MeshCache::clear()
 {
-    m_Impl->fileCache.lock()->clear();
+    for (auto& shard : m_Impl->fileCacheShards)
+    {
+        shard.lock()->clear();
+    }
+
+    auto placeholders = m_Impl->placeholders.lock();
+    placeholders->byKey.clear();
+    placeholders->loads.clear();
 }
 
 osc::Mesh osc::MeshCache::get(std::string const& key, std::function<Mesh()> const& getter)
 {
-    auto guard = m_Impl->fileCache.lock();
+    auto lookup = m_Impl->lookupOrInsert(key);
+    if (lookup.second)
+    {
+        // this caller is the first to ask for the mesh, so it's responsible for loading it (outside
+        // of the lock, so that other callers can concurrently get other meshes)
+        FulfillLoad(*lookup.second, key, getter, m_Impl->cube, *m_Impl->loadCounters);
+    }
+    return lookup.first.get();
+}
 
-    auto [it, inserted] = guard->try_emplace(key, m_Impl->cube);
+osc::Mesh osc::MeshCache::getFromFile(
+    std::filesystem::path const& path,
+    std::function<Mesh(std::filesystem::path const&)> const& loader,
+    MeshLoadingPolicy policy)
+{
+    std::string const key = ToFileCacheKey(path);
 
-    if (inserted)
+    if (policy == MeshLoadingPolicy::PlaceholderWhileLoading)
     {
-        try
-        {
-            it->second = getter();
-        }
-        catch (std::exception const& ex)
-        {
-            log::error("%s: error getting a mesh via a getter: it will be replaced with a dummy cube: %s", key.c_str(), ex.what());
-        }
+        std::shared_future<Mesh> const future = m_Impl->lookupOrLoadInBackground(key, m_Impl->makeFileGetter(path, loader));
+        return IsReady(future) ? future.get() : m_Impl->getPlaceholder(key, future);
     }
 
-    return it->second;
+    return get(key, [this, &path, &loader]()
+    {
+        return LoadViaOnDiskCache(m_Impl->getOnDiskCacheDir(), m_Impl->maxOnDiskCacheSize, path, loader);
+    });
+}
+
+void osc::MeshCache::prefetchFromFile(
+    std::filesystem::path const& path,
+    std::function<Mesh(std::filesystem::path const&)> const& loader)
+{
+    m_Impl->lookupOrLoadInBackground(ToFileCacheKey(path), m_Impl->makeFileGetter(path, loader));
+}
+
+bool osc::MeshCache::isLoading(Mesh const& placeholder) const
+{
+    auto guard = m_Impl->placeholders.lock();
+    auto const it = guard->loads.find(placeholder);
+    return it != guard->loads.end() && !IsReady(it->second);
+}
+
+size_t osc::MeshCache::getNumPendingLoads() const
+{
+    return m_Impl->loadCounters->numPending;
 }
 
 osc::Mesh osc::MeshCache::getSphereMesh()
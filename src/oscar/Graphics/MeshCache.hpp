@@ -2,15 +2,50 @@
 
 #include "oscar/Graphics/Mesh.hpp"
 
+#include <cstddef>
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace osc
 {
+    // what `MeshCache::getFromFile` should do if the mesh isn't loaded yet
+    enum class MeshLoadingPolicy {
+
+        // wait for the mesh to load (e.g. on the calling thread, or on the thread that
+        // started loading it first)
+        Blocking = 0,
+
+        // start loading the mesh in the background (if it isn't already loading) and
+        // immediately return an (empty) placeholder mesh
+        //
+        // each load has its own placeholder, so that callers can use `isLoading` to detect when
+        // the meshes that they used have loaded, so that they can swap the placeholders for the
+        // loaded meshes (e.g. by re-fetching them)
+        PlaceholderWhileLoading,
+
+        NUM_OPTIONS,
+    };
+
     class MeshCache final {
     public:
+        // the default maximum size of the on-disk cache's directory
+        static constexpr size_t c_DefaultMaxOnDiskCacheSize = 512*1024*1024;
+
+        // creates a cache that also caches meshes that are loaded via `getFromFile` in the user's data directory
         MeshCache();
+
+        // creates a cache that also caches meshes that are loaded via `getFromFile` in the given directory (if provided)
+        //
+        // whenever writing to the directory makes its cached meshes larger than `maxOnDiskCacheSize` bytes, the
+        // least-recently-used ones are deleted
+        explicit MeshCache(
+            std::optional<std::filesystem::path> maybeOnDiskCacheDir,
+            size_t maxOnDiskCacheSize = c_DefaultMaxOnDiskCacheSize
+        );
+
         MeshCache(MeshCache const&) = delete;
         MeshCache(MeshCache&&) noexcept;
         MeshCache& operator=(MeshCache const&) = delete;
@@ -21,8 +56,40 @@ namespace osc
         void clear();
 
         // always returns (it will use a dummy cube and print a log error if something fails)
+        //
+        // concurrent calls for the same key only call `getter` once: the other callers wait
+        // for that call to finish. Calls for different keys do not wait on each other
         Mesh get(std::string const& key, std::function<Mesh()> const& getter);
 
+        // like `get`, but the mesh is (slowly) loaded from the file at the given path via `loader`
+        //
+        // the path is normalized (made absolute, with `.` and `..` elements removed) before it's
+        // used as a key, so that different spellings of the same path share one load
+        //
+        // loaded meshes are also written to the on-disk cache (keyed by the file's path, size, and
+        // modification time), so that later loads of the same unmodified file (e.g. in a later session)
+        // can skip calling `loader`. Meshes that have data that the cache can't store (e.g. texture
+        // coordinates, colors) aren't written to it
+        Mesh getFromFile(
+            std::filesystem::path const&,
+            std::function<Mesh(std::filesystem::path const&)> const& loader,
+            MeshLoadingPolicy = MeshLoadingPolicy::Blocking
+        );
+
+        // starts loading the mesh at the given path in the background (if it isn't already
+        // loaded/loading), so that a later `getFromFile` call for the same path is fast
+        void prefetchFromFile(
+            std::filesystem::path const&,
+            std::function<Mesh(std::filesystem::path const&)> const& loader
+        );
+
+        // returns the number of meshes that are currently being loaded (by any thread)
+        size_t getNumPendingLoads() const;
+
+        // returns true if `placeholder` is a placeholder that `getFromFile` returned and the mesh that
+        // it stands in for is still loading
+        bool isLoading(Mesh const& placeholder) const;
+
         Mesh getSphereMesh();
         Mesh getCircleMesh();
         Mesh getCylinderMesh();
@@ -7,6 +7,8 @@
 
 #include <glm/vec2.hpp>
 
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
 #include <optional>
 
@@ -63,6 +65,7 @@ namespace osc
         friend class GraphicsBackend;
         friend bool operator==(RenderTexture const&, RenderTexture const&) noexcept;
         friend bool operator!=(RenderTexture const&, RenderTexture const&) noexcept;
+        friend struct std::hash<RenderTexture>;
         friend std::ostream& operator<<(std::ostream&, RenderTexture const&);
 
         class Impl;
@@ -80,4 +83,15 @@ namespace osc
     }
 
     std::ostream& operator<<(std::ostream&, RenderTexture const&);
-}
\ No newline at end of file
+}
+
+namespace std
+{
+    template<>
+    struct hash<osc::RenderTexture> final {
+        size_t operator()(osc::RenderTexture const& v) const
+        {
+            return hash<osc::CopyOnUpdPtr<osc::RenderTexture::Impl>>{}(v.m_Impl);
+        }
+    };
+}
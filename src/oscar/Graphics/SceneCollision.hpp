@@ -1,10 +1,11 @@
 #pragma once
 
+#include "oscar/Utils/InternedString.hpp"
+
 #include <glm/vec3.hpp>
 #include <nonstd/span.hpp>
 
 #include <cstddef>
-#include <string>
 #include <utility>
 
 namespace osc
@@ -12,7 +13,7 @@ namespace osc
     // describes a collision between a ray and a decoration in the scene
     struct SceneCollision final {
         SceneCollision(
-            std::string decorationID_,
+            InternedString decorationID_,
             size_t decorationIndex_,
             glm::vec3 const& worldspaceLocation_,
             float distanceFromRayOrigin_) :
@@ -24,7 +25,7 @@ namespace osc
         {
         }
 
-        std::string decorationID;
+        InternedString decorationID;
         size_t decorationIndex;
         glm::vec3 worldspaceLocation;
         float distanceFromRayOrigin;
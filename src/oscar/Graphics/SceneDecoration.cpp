@@ -1,11 +1,18 @@
 #include "SceneDecoration.hpp"
 
 #include "oscar/Graphics/Color.hpp"
+#include "oscar/Graphics/Material.hpp"
+#include "oscar/Graphics/MaterialPropertyBlock.hpp"
 #include "oscar/Graphics/Mesh.hpp"
 #include "oscar/Graphics/SceneDecoration.hpp"
 #include "oscar/Maths/AABB.hpp"
 #include "oscar/Maths/MathHelpers.hpp"
 #include "oscar/Maths/Transform.hpp"
+#include "oscar/Utils/Algorithms.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
 
 bool osc::operator==(SceneDecoration const& a, SceneDecoration const& b) noexcept
 {
@@ -17,4 +24,20 @@ bool osc::operator==(SceneDecoration const& a, SceneDecoration const& b) noexcep
         a.flags == b.flags &&
         a.maybeMaterial == b.maybeMaterial &&
         a.maybeMaterialProps == b.maybeMaterialProps;
-}
\ No newline at end of file
+}
+
+size_t std::hash<osc::SceneDecoration>::operator()(osc::SceneDecoration const& d) const
+{
+    osc::Transform const& t = d.transform;
+    return osc::HashOf(
+        d.mesh,
+        t.scale.x, t.scale.y, t.scale.z,
+        t.rotation.w, t.rotation.x, t.rotation.y, t.rotation.z,
+        t.position.x, t.position.y, t.position.z,
+        d.color,
+        d.id,
+        d.flags,
+        d.maybeMaterial,
+        d.maybeMaterialProps
+    );
+}
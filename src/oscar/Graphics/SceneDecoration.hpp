@@ -7,9 +7,11 @@
 #include "oscar/Graphics/SceneDecorationFlags.hpp"
 #include "oscar/Graphics/SimpleSceneDecoration.hpp"
 #include "oscar/Maths/Transform.hpp"
+#include "oscar/Utils/InternedString.hpp"
 
+#include <cstddef>
+#include <functional>
 #include <optional>
-#include <string>
 #include <utility>
 
 namespace osc
@@ -44,7 +46,7 @@ namespace osc
             Mesh const& mesh_,
             Transform const& transform_,
             Color const& color_,
-            std::string id_,
+            InternedString id_,
             SceneDecorationFlags flags_) :
 
             mesh{mesh_},
@@ -59,7 +61,7 @@ namespace osc
             Mesh const& mesh_,
             Transform const& transform_,
             Color const& color_,
-            std::string id_,
+            InternedString id_,
             SceneDecorationFlags flags_,
             std::optional<Material> maybeMaterial_,
             std::optional<MaterialPropertyBlock> maybeProps_ = std::nullopt) :
@@ -77,7 +79,7 @@ namespace osc
         Mesh mesh;
         Transform transform{};
         Color color = Color::white();
-        std::string id;
+        InternedString id;  // interned, because decorations are frequently copied and compared
         SceneDecorationFlags flags = SceneDecorationFlags_None;
         std::optional<Material> maybeMaterial = std::nullopt;
         std::optional<MaterialPropertyBlock> maybeMaterialProps = std::nullopt;
@@ -85,3 +87,15 @@ namespace osc
 
     bool operator==(SceneDecoration const&, SceneDecoration const&) noexcept;
 }
+
+namespace std
+{
+    // hashes the content of a decoration, such that equal decorations have equal hashes
+    //
+    // materials are hashed by identity (like `operator==`), and material property blocks are
+    // hashed by content
+    template<>
+    struct hash<osc::SceneDecoration> final {
+        size_t operator()(osc::SceneDecoration const&) const;
+    };
+}
@@ -14,7 +14,9 @@
 #include "oscar/Graphics/SceneRendererParams.hpp"
 #include "oscar/Graphics/ShaderCache.hpp"
 #include "oscar/Graphics/TextureGen.hpp"
+#include "oscar/Maths/CollisionTests.hpp"
 #include "oscar/Maths/Constants.hpp"
+#include "oscar/Maths/Frustum.hpp"
 #include "oscar/Maths/MathHelpers.hpp"
 #include "oscar/Maths/PolarPerspectiveCamera.hpp"
 #include "oscar/Maths/Rect.hpp"
@@ -26,11 +28,14 @@
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 #include <glm/gtx/transform.hpp>
 #include <nonstd/span.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -51,6 +56,39 @@ namespace
         return osc::TransformAABB(d.mesh.getBounds(), d.transform);
     }
 
+    bool IsRimHighlighted(osc::SceneDecoration const& d)
+    {
+        return d.flags & (osc::SceneDecorationFlags_IsSelected | osc::SceneDecorationFlags_IsChildOfSelected | osc::SceneDecorationFlags_IsHovered | osc::SceneDecorationFlags_IsChildOfHovered);
+    }
+
+    // returns the (approximate) diameter, in pixels, of the given worldspace AABB when it's drawn on-screen
+    float CalcScreenspaceDiameterInPixels(osc::AABB const& worldspaceAABB, osc::SceneRendererParams const& params)
+    {
+        osc::Sphere const bounds = osc::ToSphere(worldspaceAABB);
+        glm::mat4 const& projMat = params.projectionMatrix;
+        glm::vec4 const clipspaceOrigin = projMat * params.viewMatrix * glm::vec4{bounds.origin, 1.0f};
+
+        // perspective projections put the viewspace depth in `w`, orthographic ones leave it as 1
+        bool const isPerspective = projMat[3][3] == 0.0f;
+        if (isPerspective && clipspaceOrigin.w <= bounds.radius)
+        {
+            // the camera is inside (or behind) the bounds
+            return std::numeric_limits<float>::infinity();
+        }
+
+        float const pixelsPerNDCUnit = 0.5f * std::max(
+            std::abs(projMat[0][0]) * static_cast<float>(params.dimensions.x),
+            std::abs(projMat[1][1]) * static_cast<float>(params.dimensions.y)
+        );
+        return 2.0f * bounds.radius * pixelsPerNDCUnit / clipspaceOrigin.w;
+    }
+
+    // per-decoration information that is computed once per draw and shared by all passes
+    struct DecorationCullingInfo final {
+        osc::AABB worldspaceAABB;
+        bool isVisible;
+    };
+
     struct RimHighlights final {
         RimHighlights(
             osc::Mesh const& mesh_,
@@ -184,9 +222,15 @@ public:
 
     void draw(nonstd::span<SceneDecoration const> decorations, SceneRendererParams const& params)
     {
+        // figure out which decorations can appear in the render
+        Frustum const viewFrustum = FrustumFromViewProjectionMatrix(params.projectionMatrix * params.viewMatrix);
+        size_t const numVisible = cullDecorations(decorations, params, viewFrustum);
+        OSC_PERF_COUNT("SceneRenderer/draw/submittedDecorations", numVisible);
+        OSC_PERF_COUNT("SceneRenderer/draw/culledDecorations", decorations.size() - numVisible);
+
         // render any other perspectives on the scene (shadows, rim highlights, etc.)
         std::optional<RimHighlights> const maybeRimHighlights = tryGenerateRimHighlights(decorations, params);
-        std::optional<Shadows> const maybeShadowMap = tryGenerateShadowMap(decorations, params);
+        std::optional<Shadows> const maybeShadowMap = tryGenerateShadowMap(decorations, params, viewFrustum);
 
         // setup camera for this render
         m_Camera.reset();
@@ -226,8 +270,14 @@ public:
 
             MaterialPropertyBlock propBlock;
             Color lastColor = {-1.0f, -1.0f, -1.0f, 0.0f};
-            for (SceneDecoration const& dec : decorations)
+            for (size_t i = 0; i < decorations.size(); ++i)
             {
+                if (!m_CullingInfo[i].isVisible)
+                {
+                    continue;
+                }
+
+                SceneDecoration const& dec = decorations[i];
                 if (dec.color != lastColor)
                 {
                     propBlock.setColor("uDiffuseColor", dec.color);
@@ -307,6 +357,43 @@ public:
     }
 
 private:
+    // populates `m_CullingInfo` for the given decorations and returns the number of visible decorations
+    //
+    // a decoration is visible if it's (conservatively) inside the view frustum and, if requested,
+    // isn't too small to see
+    size_t cullDecorations(
+        nonstd::span<SceneDecoration const> decorations,
+        SceneRendererParams const& params,
+        Frustum const& viewFrustum)
+    {
+        bool const cullSmallDecorations = params.minDecorationDiameterInPixels > 0.0f;
+
+        m_CullingInfo.clear();
+        m_CullingInfo.reserve(decorations.size());
+
+        size_t numVisible = 0;
+        for (SceneDecoration const& dec : decorations)
+        {
+            AABB const aabb = WorldpaceAABB(dec);
+
+            bool isVisible = IsAABBIntersectingFrustum(aabb, viewFrustum);
+            if (isVisible &&
+                cullSmallDecorations &&
+                !IsRimHighlighted(dec) &&
+                CalcScreenspaceDiameterInPixels(aabb, params) < params.minDecorationDiameterInPixels)
+            {
+                isVisible = false;
+            }
+
+            m_CullingInfo.push_back(DecorationCullingInfo{aabb, isVisible});
+            if (isVisible)
+            {
+                ++numVisible;
+            }
+        }
+        return numVisible;
+    }
+
     std::optional<RimHighlights> tryGenerateRimHighlights(
         nonstd::span<SceneDecoration const> decorations,
         SceneRendererParams const& params)
@@ -316,13 +403,13 @@ private:
             return std::nullopt;
         }
 
-        // compute the worldspace bounds union of all rim-highlighted geometry
+        // compute the worldspace bounds union of all (visible) rim-highlighted geometry
         std::optional<AABB> maybeRimWorldspaceAABB;
-        for (SceneDecoration const& dec : decorations)
+        for (size_t i = 0; i < decorations.size(); ++i)
         {
-            if (dec.flags & (SceneDecorationFlags_IsSelected | SceneDecorationFlags_IsChildOfSelected | SceneDecorationFlags_IsHovered | SceneDecorationFlags_IsChildOfHovered))
+            if (m_CullingInfo[i].isVisible && IsRimHighlighted(decorations[i]))
             {
-                AABB const decAABB = WorldpaceAABB(dec);
+                AABB const& decAABB = m_CullingInfo[i].worldspaceAABB;
                 maybeRimWorldspaceAABB = maybeRimWorldspaceAABB ? Union(*maybeRimWorldspaceAABB, decAABB) : decAABB;
             }
         }
@@ -386,9 +473,15 @@ private:
         m_Camera.setProjectionMatrixOverride(params.projectionMatrix);
         m_Camera.setBackgroundColor(Color::clear());
 
-        // draw all selected geometry in a solid color
-        for (SceneDecoration const& dec : decorations)
+        // draw all (visible) selected geometry in a solid color
+        for (size_t i = 0; i < decorations.size(); ++i)
         {
+            if (!m_CullingInfo[i].isVisible)
+            {
+                continue;
+            }
+
+            SceneDecoration const& dec = decorations[i];
             if (dec.flags & (SceneDecorationFlags_IsSelected | SceneDecorationFlags_IsChildOfSelected))
             {
                 Graphics::DrawMesh(dec.mesh, dec.transform, m_SolidColorMaterial, m_Camera, m_RimsSelectedColor);
@@ -429,7 +522,8 @@ private:
 
     std::optional<Shadows> tryGenerateShadowMap(
         nonstd::span<SceneDecoration const> decorations,
-        SceneRendererParams const& params)
+        SceneRendererParams const& params,
+        Frustum const& viewFrustum)
     {
         if (!params.drawShadows)
         {
@@ -441,28 +535,59 @@ private:
 
         // compute the bounds of everything that casts a shadow
         //
-        // (also, while doing that, draw each mesh - to prevent multipass)
+        // (even if it isn't visible: it might cast a shadow onto something that is)
         std::optional<AABB> casterAABBs;
-        for (SceneDecoration const& dec : decorations)
+        for (size_t i = 0; i < decorations.size(); ++i)
         {
-            if (dec.flags & SceneDecorationFlags_CastsShadows)
+            if (decorations[i].flags & SceneDecorationFlags_CastsShadows)
             {
-                AABB const decorationAABB = WorldpaceAABB(dec);
+                AABB const& decorationAABB = m_CullingInfo[i].worldspaceAABB;
                 casterAABBs = casterAABBs ? Union(*casterAABBs, decorationAABB) : decorationAABB;
-                Graphics::DrawMesh(dec.mesh, dec.transform, m_DepthWritingMaterial, m_Camera);
             }
         }
 
         if (!casterAABBs)
         {
             // there are no shadow casters, so there will be no shadows
-            m_Camera.reset();
             return std::nullopt;
         }
 
         // compute camera matrices for the orthogonal (direction) camera used for lighting
+        //
+        // the light's frustum is fitted to all casters, so that culling (below) doesn't affect
+        // the shadow map's projection
         ShadowCameraMatrices const matrices = CalcShadowCameraMatrices(*casterAABBs, params.lightDirection);
 
+        // only draw casters that can cast a shadow into the view frustum
+        //
+        // a caster can only shadow things that are "behind" it along the light's direction, up to
+        // the depth of the light's frustum, so test the volume that it sweeps along that direction
+        glm::vec3 const shadowSweep = 2.0f * ToSphere(*casterAABBs).radius * glm::normalize(params.lightDirection);
+        size_t numSubmittedCasters = 0;
+        size_t numCulledCasters = 0;
+        for (size_t i = 0; i < decorations.size(); ++i)
+        {
+            SceneDecoration const& dec = decorations[i];
+            if (!(dec.flags & SceneDecorationFlags_CastsShadows))
+            {
+                continue;
+            }
+
+            AABB const& aabb = m_CullingInfo[i].worldspaceAABB;
+            AABB const sweptAABB = Union(aabb, AABB{aabb.min + shadowSweep, aabb.max + shadowSweep});
+            if (IsAABBIntersectingFrustum(sweptAABB, viewFrustum))
+            {
+                Graphics::DrawMesh(dec.mesh, dec.transform, m_DepthWritingMaterial, m_Camera);
+                ++numSubmittedCasters;
+            }
+            else
+            {
+                ++numCulledCasters;
+            }
+        }
+        OSC_PERF_COUNT("SceneRenderer/tryGenerateShadowMap/submittedCasters", numSubmittedCasters);
+        OSC_PERF_COUNT("SceneRenderer/tryGenerateShadowMap/culledCasters", numCulledCasters);
+
         m_Camera.setBackgroundColor({1.0f, 0.0f, 0.0f, 0.0f});
         m_Camera.setViewMatrixOverride(matrices.viewMatrix);
         m_Camera.setProjectionMatrixOverride(matrices.projMatrix);
@@ -487,6 +612,7 @@ private:
     RenderTexture m_RimsTexture;
     RenderTexture m_ShadowMapTexture;
     RenderTexture m_OutputTexture;
+    std::vector<DecorationCullingInfo> m_CullingInfo;
 };
 
 
@@ -22,7 +22,8 @@ osc::SceneRendererParams::SceneRendererParams() :
     rimColor{0.95f, 0.35f, 0.0f, 1.0f},
     rimThicknessInPixels{1.0f, 1.0f},
     floorLocation{0.0f, -0.001f, 0.0f},
-    fixupScaleFactor{1.0f}
+    fixupScaleFactor{1.0f},
+    minDecorationDiameterInPixels{0.0f}
 {
 }
 
@@ -50,7 +51,8 @@ bool osc::operator==(SceneRendererParams const& a, SceneRendererParams const& b)
         a.rimColor == b.rimColor &&
         a.rimThicknessInPixels == b.rimThicknessInPixels &&
         a.floorLocation == b.floorLocation &&
-        a.fixupScaleFactor == b.fixupScaleFactor;
+        a.fixupScaleFactor == b.fixupScaleFactor &&
+        a.minDecorationDiameterInPixels == b.minDecorationDiameterInPixels;
 }
 
 bool osc::operator!=(SceneRendererParams const& a, SceneRendererParams const& b)
@@ -34,6 +34,11 @@ namespace osc
         glm::vec2 rimThicknessInPixels;
         glm::vec3 floorLocation;
         float fixupScaleFactor;
+
+        // decorations that appear smaller than this on-screen are culled (<= 0 disables culling)
+        //
+        // selected/hovered decorations are never culled this way
+        float minDecorationDiameterInPixels;
     };
 
     bool operator==(SceneRendererParams const&, SceneRendererParams const&);
@@ -10,7 +10,9 @@
 #include <glm/vec2.hpp>
 #include <nonstd/span.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <string_view>
 
@@ -72,6 +74,7 @@ namespace osc
         friend class GraphicsBackend;
         friend bool operator==(Texture2D const&, Texture2D const&) noexcept;
         friend bool operator!=(Texture2D const&, Texture2D const&) noexcept;
+        friend struct std::hash<Texture2D>;
         friend std::ostream& operator<<(std::ostream&, Texture2D const&);
 
         class Impl;
@@ -90,3 +93,14 @@ namespace osc
 
     std::ostream& operator<<(std::ostream&, Texture2D const&);
 }
+
+namespace std
+{
+    template<>
+    struct hash<osc::Texture2D> final {
+        size_t operator()(osc::Texture2D const& v) const
+        {
+            return hash<osc::CopyOnUpdPtr<osc::Texture2D::Impl>>{}(v.m_Impl);
+        }
+    };
+}
@@ -6,7 +6,9 @@
 #include <glm/vec3.hpp>
 #include <nonstd/span.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -17,18 +19,21 @@ namespace osc
 {
     class BVHNode final {
     public:
-        static BVHNode leaf(AABB const& bounds, size_t primOffset)
+        // the maximum number of prims that a single leaf node can contain
+        static inline size_t constexpr c_MaxPrimsPerLeaf = 127;
+
+        static BVHNode leaf(AABB const& bounds, size_t firstPrimOffset, size_t numPrims = 1)
         {
-            return BVHNode{bounds, primOffset | c_LeafMask};
+            return BVHNode{bounds, c_LeafMask | (static_cast<uint64_t>(numPrims) << c_NumPrimsShift) | (static_cast<uint64_t>(firstPrimOffset) & c_PrimOffsetMask)};
         }
 
         static BVHNode node(AABB const& bounds, size_t numLhs)
         {
-            return BVHNode{bounds, numLhs & ~c_LeafMask};
+            return BVHNode{bounds, static_cast<uint64_t>(numLhs) & ~c_LeafMask};
         }
 
     private:
-        BVHNode(AABB const& bounds_, size_t data_) :
+        BVHNode(AABB const& bounds_, uint64_t data_) :
             m_Bounds{bounds_},
             m_Data{std::move(data_)}
         {
@@ -51,23 +56,34 @@ namespace osc
 
         size_t getNumLhsNodes() const
         {
-            return m_Data & ~c_LeafMask;
+            return static_cast<size_t>(m_Data & ~c_LeafMask);
         }
 
         void setNumLhsNodes(size_t n)
         {
-            m_Data = n & ~c_LeafMask;
+            m_Data = static_cast<uint64_t>(n) & ~c_LeafMask;
         }
 
         size_t getFirstPrimOffset() const
         {
-            return m_Data & ~c_LeafMask;
+            return static_cast<size_t>(m_Data & c_PrimOffsetMask);
+        }
+
+        // returns the number of (contiguous) prims in this leaf node
+        size_t getNumPrims() const
+        {
+            return static_cast<size_t>((m_Data & ~c_LeafMask) >> c_NumPrimsShift);
         }
 
     private:
-        static inline size_t constexpr c_LeafMask = static_cast<size_t>(1) << (8*sizeof(size_t) - 1);
+        // leaf layout: [leaf flag (1 bit)][num prims (7 bits)][first prim offset (56 bits)]
+        static inline uint64_t constexpr c_LeafMask = static_cast<uint64_t>(1) << 63;
+        static inline uint64_t constexpr c_NumPrimsShift = 56;
+        static inline uint64_t constexpr c_PrimOffsetMask = (static_cast<uint64_t>(1) << c_NumPrimsShift) - 1;
+        static_assert(c_MaxPrimsPerLeaf < (static_cast<uint64_t>(1) << (63 - c_NumPrimsShift)));
+
         AABB m_Bounds;  // union of all AABBs below/including this one
-        size_t m_Data;
+        uint64_t m_Data;
     };
 
     class BVHPrim final {
@@ -104,6 +120,41 @@ namespace osc
         ptrdiff_t id;
     };
 
+    // the algorithm that's used to partition prims into child nodes when building a BVH
+    enum class BVHBuildStrategy {
+
+        // split each node at the midpoint of its longest dimension
+        //
+        // fast to build, but can produce a poor-quality (slow to query) tree
+        Midpoint = 0,
+
+        // split each node along the plane that minimizes a (binned) surface area heuristic
+        //
+        // slower to build, but produces higher-quality (faster to query) trees
+        BinnedSAH,
+
+        NUM_OPTIONS,
+    };
+
+    // options that affect how a BVH is built
+    struct BVHBuildOptions final {
+        BVHBuildStrategy strategy = BVHBuildStrategy::BinnedSAH;
+
+        // clamped to [1, BVHNode::c_MaxPrimsPerLeaf]
+        size_t maxPrimsPerLeaf = 4;
+
+        // (`BinnedSAH` only) number of candidate split planes, per dimension, is `numSAHBins-1`
+        //
+        // clamped to [2, 64]
+        size_t numSAHBins = 16;
+
+        // if true, sufficiently large subtrees are built in parallel on separate threads
+        bool allowParallelBuild = true;
+
+        // (if `allowParallelBuild`) subtrees with fewer prims than this are built on the calling thread
+        size_t minPrimsForParallelSubtreeBuild = 16384;
+    };
+
     // TODO: should be a class
     struct BVH final {
 
@@ -114,11 +165,13 @@ namespace osc
         // prim.getID() will refer to the index of the first vertex in the triangle
         void buildFromIndexedTriangles(
             nonstd::span<glm::vec3 const> verts,
-            nonstd::span<uint16_t const> indices
+            nonstd::span<uint16_t const> indices,
+            BVHBuildOptions const& = {}
         );
         void buildFromIndexedTriangles(
             nonstd::span<glm::vec3 const> verts,
-            nonstd::span<uint32_t const> indices
+            nonstd::span<uint32_t const> indices,
+            BVHBuildOptions const& = {}
         );
 
         // returns the location of the closest ray-triangle collision along the ray, if any
@@ -136,15 +189,32 @@ namespace osc
         // AABB BVHes
         //
         // prim.id will refer to the index of the AABB
-        void buildFromAABBs(nonstd::span<AABB const> aabbs);
+        void buildFromAABBs(
+            nonstd::span<AABB const> aabbs,
+            BVHBuildOptions const& = {}
+        );
 
-        // returns prim.id of the AABB (leaf) that the line intersects, or -1 if no intersection
+        // updates the bounds of each prim and node from the given AABBs without changing
+        // the topology of the tree (i.e. no prims are added, removed, or re-partitioned)
         //
-        // no assumptions about prim.id required here - it's using the BVH's AABBs
+        // `aabbs` must be indexed the same way as the AABBs that the BVH was built from. This
+        // is much cheaper than a rebuild when the AABBs only move a little (e.g. an animated
+        // scene), but the quality of the tree degrades as the AABBs drift from where they were
+        // when it was built
+        void refitFromAABBs(nonstd::span<AABB const> aabbs);
+
+        // returns a collision (containing prim.id) for each prim AABB that the line intersects
         //
-        // returns true if at least one collision was found and appended to the output
+        // no assumptions about prim.id required here - it's using the BVH's AABBs
         std::vector<BVHCollision> getRayAABBCollisions(Line const&) const;
 
+        // calls the callback with a collision (containing prim.id) for each prim AABB that the
+        // line intersects, without allocating
+        //
+        // nodes are visited nearest-first, so collisions are *roughly* (not strictly) ordered by
+        // distance along the line
+        void forEachRayAABBCollision(Line const&, std::function<void(BVHCollision const&)> const&) const;
+
         // returns the maximum depth of the given BVH tree
         size_t getMaxDepth() const;
 
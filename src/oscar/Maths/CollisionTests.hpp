@@ -8,6 +8,7 @@
 
 namespace osc { struct AABB; }
 namespace osc { struct Disc; }
+namespace osc { struct Frustum; }
 namespace osc { struct Line; }
 namespace osc { struct Plane; }
 namespace osc { struct Rect; }
@@ -17,6 +18,12 @@ namespace osc { struct Triangle; }
 namespace osc
 {
     bool IsPointInRect(Rect const&, glm::vec2 const&) noexcept;
+
+    // returns true if the AABB may be inside (or intersecting) the frustum
+    //
+    // conservative: can return true for AABBs that are near the frustum's corners, but
+    // never returns false for an AABB that's inside (or intersecting) it
+    bool IsAABBIntersectingFrustum(AABB const&, Frustum const&) noexcept;
     std::optional<RayCollision> GetRayCollisionSphere(Line const&, Sphere const&) noexcept;
     std::optional<RayCollision> GetRayCollisionAABB(Line const&, AABB const&) noexcept;
     std::optional<RayCollision> GetRayCollisionPlane(Line const&, Plane const&) noexcept;
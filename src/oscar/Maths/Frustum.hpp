@@ -0,0 +1,18 @@
+#pragma once
+
+#include "oscar/Maths/Plane.hpp"
+
+#include <array>
+#include <iosfwd>
+
+namespace osc
+{
+    // a convex volume bounded by six planes (left, right, bottom, top, near, far)
+    //
+    // each plane's normal points into the volume
+    struct Frustum final {
+        std::array<Plane, 6> planes;
+    };
+
+    std::ostream& operator<<(std::ostream&, Frustum const&);
+}
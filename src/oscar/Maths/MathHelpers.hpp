@@ -20,6 +20,7 @@
 #include <optional>
 
 namespace osc { struct Disc; }
+namespace osc { struct Frustum; }
 namespace osc { struct Plane; }
 namespace osc { struct Rect; }
 namespace osc { struct Segment; }
@@ -242,6 +243,9 @@ namespace osc
     // returns the volume of the AABB
     float Volume(AABB const&) noexcept;
 
+    // returns the surface area of the AABB
+    float SurfaceArea(AABB const&) noexcept;
+
     // returns the smallest AABB that spans both of the provided AABBs
     AABB Union(AABB const&, AABB const&) noexcept;
 
@@ -290,6 +294,12 @@ namespace osc
     );
 
 
+    // ----- osc::Frustum helpers -----
+
+    // returns the worldspace frustum of a camera with the given (projection * view) matrix
+    Frustum FrustumFromViewProjectionMatrix(glm::mat4 const& viewProjMat) noexcept;
+
+
     // ----- osc::Segment helpers -----
 
     // returns a transform matrix that maps a path segment to another path segment
@@ -7,6 +7,7 @@
 #include "oscar/Maths/MathHelpers.hpp"
 #include "oscar/Maths/RayCollision.hpp"
 #include "oscar/Maths/EulerPerspectiveCamera.hpp"
+#include "oscar/Maths/Frustum.hpp"
 #include "oscar/Maths/Line.hpp"
 #include "oscar/Maths/MathHelpers.hpp"
 #include "oscar/Maths/Plane.hpp"
@@ -34,13 +35,25 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <functional>
+#include <future>
 #include <iterator>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <stack>
 #include <stdexcept>
+#include <string_view>
+#include <thread>
 #include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+// SSE2 is guaranteed to be available on all x86-64 CPUs, so the (4-wide) BVH kernels are
+// selected at compile-time
+#define OSC_BVH_SSE2_AVAILABLE
+#include <emmintrin.h>
+#endif
 
 
 // osc::AABB implementation
@@ -66,16 +79,6 @@ bool osc::operator!=(AABB const& a, AABB const& b) noexcept
 // BVH helpers
 namespace
 {
-    osc::AABB Union(nonstd::span<osc::BVHPrim const> prims)
-    {
-        osc::AABB rv = prims.front().getBounds();
-        for (auto it = prims.begin() + 1; it != prims.end(); ++it)
-        {
-            rv = Union(rv, it->getBounds());
-        }
-        return rv;
-    }
-
     template<typename T>
     T const& at(nonstd::span<T const> vs, size_t i)
     {
@@ -94,165 +97,738 @@ namespace
         return !(t.p0 == t.p1 || t.p0 == t.p2 || t.p1 == t.p2);
     }
 
-    // recursively build the BVH
-    void BVH_RecursiveBuild(osc::BVH& bvh, ptrdiff_t const begin, ptrdiff_t const n)
+    // returns the options, with any out-of-range values clamped into range
+    osc::BVHBuildOptions Sanitized(osc::BVHBuildOptions opts)
     {
-        if (n == 1)
+        opts.maxPrimsPerLeaf = std::clamp(opts.maxPrimsPerLeaf, static_cast<size_t>(1), osc::BVHNode::c_MaxPrimsPerLeaf);
+        opts.numSAHBins = std::clamp(opts.numSAHBins, static_cast<size_t>(2), static_cast<size_t>(64));
+        return opts;
+    }
+
+    // returns the number of levels of the tree that should fork a thread for one of its subtrees
+    size_t CalcNumParallelLevels(osc::BVHBuildOptions const& opts)
+    {
+        if (!opts.allowParallelBuild)
         {
-            // recursion bottomed out: create a leaf node
-            bvh.nodes.push_back(osc::BVHNode::leaf(
-                bvh.prims.at(begin).getBounds(),
-                begin
-            ));
-            return;
+            return 0;
+        }
+
+        // each level doubles the number of threads, so stop once there's (roughly) one
+        // thread per hardware thread
+        size_t levels = 0;
+        for (size_t n = std::max(std::thread::hardware_concurrency(), 1u); n > 1; n /= 2)
+        {
+            ++levels;
+        }
+        return levels;
+    }
+
+    // returns the index of the first prim in the right-hand partition of `prims[begin, end)`
+    // after partitioning them at the midpoint of the longest dimension of `bounds`, or
+    // `begin` if a leaf should be created instead
+    size_t BVH_PartitionMidpoint(
+        nonstd::span<osc::BVHPrim> prims,
+        size_t begin,
+        size_t end,
+        osc::AABB const& bounds,
+        osc::BVHBuildOptions const& opts)
+    {
+        size_t const n = end - begin;
+        if (n <= opts.maxPrimsPerLeaf)
+        {
+            return begin;
         }
 
-        // else: n >= 2, so partition the data appropriately and allocate an internal node
+        // compute slicing position along the longest dimension
+        auto const longestDimIdx = LongestDimIndex(bounds);
+        float const midpointX2 = bounds.min[longestDimIdx] + bounds.max[longestDimIdx];
 
-        ptrdiff_t midpoint = -1;
-        ptrdiff_t internalNodeLoc = -1;
+        // returns true if a given primitive is below the midpoint along the dim
+        auto const isBelowMidpoint = [longestDimIdx, midpointX2](osc::BVHPrim const& p)
         {
-            // allocate an appropriate internal node
+            float const primMidpointX2 = p.getBounds().min[longestDimIdx] + p.getBounds().max[longestDimIdx];
+            return primMidpointX2 <= midpointX2;
+        };
 
-            // compute bounding box of remaining (children) prims
-            osc::AABB const aabb = Union({bvh.prims.data() + begin, static_cast<size_t>(n)});
+        // partition prims into above/below the midpoint
+        auto const it = std::partition(prims.begin() + begin, prims.begin() + end, isBelowMidpoint);
+        size_t midpoint = static_cast<size_t>(std::distance(prims.begin(), it));
 
-            // compute slicing position along the longest dimension
-            auto const longestDimIdx = LongestDimIndex(aabb);
-            float const midpointX2 = aabb.min[longestDimIdx] + aabb.max[longestDimIdx];
+        if (midpoint == begin || midpoint == end)
+        {
+            // edge-case: failed to spacially partition: just naievely partition
+            midpoint = begin + n/2;
+        }
+        return midpoint;
+    }
 
-            // returns true if a given primitive is below the midpoint along the dim
-            auto const isBelowMidpoint = [longestDimIdx, midpointX2](osc::BVHPrim const& p)
-            {
-                float const primMidpointX2 = p.getBounds().min[longestDimIdx] + p.getBounds().max[longestDimIdx];
-                return primMidpointX2 <= midpointX2;
-            };
+    // returns the index of the first prim in the right-hand partition of `prims[begin, end)`
+    // after partitioning them along the split plane that minimizes the (binned) surface area
+    // heuristic, or `begin` if a leaf should be created instead
+    size_t BVH_PartitionBinnedSAH(
+        nonstd::span<osc::BVHPrim> prims,
+        size_t begin,
+        size_t end,
+        osc::AABB const& bounds,
+        osc::AABB const& centroidBounds,
+        osc::BVHBuildOptions const& opts)
+    {
+        // relative cost of traversing a node vs. intersecting a prim
+        constexpr float c_TraversalCost = 1.0f;
+
+        size_t const n = end - begin;
+        if (n <= 1)
+        {
+            return begin;
+        }
 
-            // partition prims into above/below the midpoint
-            ptrdiff_t const end = begin + n;
-            auto const it = std::partition(bvh.prims.begin() + begin, bvh.prims.begin() + end, isBelowMidpoint);
+        struct Bin final {
+            osc::AABB bounds = osc::InvertedAABB();
+            size_t count = 0;
+        };
+        std::array<std::array<Bin, 64>, 3> bins;
+        std::array<float, 64> rhsCosts{};
+        size_t const numBins = opts.numSAHBins;
+
+        // prims are binned by their centroids
+        glm::vec3 binScale{};
+        for (glm::vec3::length_type dim = 0; dim < 3; ++dim)
+        {
+            float const extent = centroidBounds.max[dim] - centroidBounds.min[dim];
+            binScale[dim] = extent > 0.0f ? static_cast<float>(numBins) / extent : 0.0f;
+        }
+        auto const binIndexOf = [&centroidBounds, &binScale, numBins](osc::BVHPrim const& p, glm::vec3::length_type dim)
+        {
+            float const rel = (Midpoint(p.getBounds())[dim] - centroidBounds.min[dim]) * binScale[dim];
+            return std::min(static_cast<size_t>(rel), numBins-1);
+        };
+
+        // bin all dimensions in one pass over the prims
+        for (size_t i = begin; i < end; ++i)
+        {
+            for (glm::vec3::length_type dim = 0; dim < 3; ++dim)
+            {
+                Bin& bin = bins[dim][binIndexOf(prims[i], dim)];
+                bin.bounds = Union(bin.bounds, prims[i].getBounds());
+                ++bin.count;
+            }
+        }
 
-            midpoint = std::distance(bvh.prims.begin(), it);
-            if (midpoint == begin || midpoint == end)
+        // find the cheapest split (if any) across all dimensions
+        //
+        // the costs are not divided by the parent's surface area, because that's the
+        // same for all splits (+ the leaf cost is scaled accordingly)
+        float bestCost = std::numeric_limits<float>::max();
+        glm::vec3::length_type bestDim = 0;
+        size_t bestSplit = 0;  // prims in bins [0, bestSplit) go on the left-hand side
+        for (glm::vec3::length_type dim = 0; dim < 3; ++dim)
+        {
+            if (binScale[dim] == 0.0f)
             {
-                // edge-case: failed to spacially partition: just naievely partition
-                midpoint = begin + n/2;
+                continue;  // all centroids are coplanar in this dimension: can't split along it
             }
 
-            internalNodeLoc = static_cast<ptrdiff_t>(bvh.nodes.size());
+            // sweep from the right to compute the cost of each right-hand side
+            {
+                osc::AABB rhsBounds = osc::InvertedAABB();
+                size_t rhsCount = 0;
+                for (size_t split = numBins-1; split > 0; --split)
+                {
+                    rhsBounds = Union(rhsBounds, bins[dim][split].bounds);
+                    rhsCount += bins[dim][split].count;
+                    rhsCosts[split] = rhsCount > 0 ? SurfaceArea(rhsBounds) * static_cast<float>(rhsCount) : -1.0f;
+                }
+            }
 
-            // push the internal node
-            bvh.nodes.push_back(osc::BVHNode::node(
-                aabb,
-                0  // the number of left-hand nodes is set later
-            ));
+            // sweep from the left to compute the total cost of each split
+            osc::AABB lhsBounds = osc::InvertedAABB();
+            size_t lhsCount = 0;
+            for (size_t split = 1; split < numBins; ++split)
+            {
+                lhsBounds = Union(lhsBounds, bins[dim][split-1].bounds);
+                lhsCount += bins[dim][split-1].count;
+
+                if (lhsCount == 0 || rhsCosts[split] < 0.0f)
+                {
+                    continue;  // one of the sides would be empty
+                }
+
+                float const cost = SurfaceArea(lhsBounds) * static_cast<float>(lhsCount) + rhsCosts[split];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestDim = dim;
+                    bestSplit = split;
+                }
+            }
         }
 
-        // build left-hand subtree
-        BVH_RecursiveBuild(bvh, begin, midpoint-begin);
+        if (bestSplit == 0)
+        {
+            // edge-case: all centroids are coincident, so they can't be spatially partitioned
+            return n <= opts.maxPrimsPerLeaf ? begin : begin + n/2;
+        }
 
-        // the left-hand build allocated nodes for the left hand side contiguously in memory
-        ptrdiff_t numLhsNodes = (static_cast<ptrdiff_t>(bvh.nodes.size()) - 1) - internalNodeLoc;
-        OSC_ASSERT(numLhsNodes > 0);
-        bvh.nodes[internalNodeLoc].setNumLhsNodes(numLhsNodes);
+        float const parentArea = SurfaceArea(bounds);
+        float const leafCost = parentArea * static_cast<float>(n);
+        float const splitCost = parentArea * c_TraversalCost + bestCost;
+        if (n <= opts.maxPrimsPerLeaf && leafCost <= splitCost)
+        {
+            return begin;  // it's cheaper to just test all of the prims
+        }
 
-        // build right node
-        BVH_RecursiveBuild(bvh, midpoint, (begin + n) - midpoint);
-        OSC_ASSERT(internalNodeLoc+numLhsNodes < static_cast<ptrdiff_t>(bvh.nodes.size()));
+        auto const it = std::partition(prims.begin() + begin, prims.begin() + end, [&binIndexOf, bestDim, bestSplit](osc::BVHPrim const& p)
+        {
+            return binIndexOf(p, bestDim) < bestSplit;
+        });
+        return static_cast<size_t>(std::distance(prims.begin(), it));
     }
 
-    // returns true if something hit (recursively)
+    // builds the subtree for `prims[begin, end)` by appending its nodes to `out` in
+    // depth-first (left-hand side first) order
     //
-    // populates outparam with all AABB hits in depth-first order
-    bool BVH_GetRayAABBCollisionsRecursive(
-        osc::BVH const& bvh,
-        osc::Line const& ray,
-        ptrdiff_t nodeidx,
-        std::vector<osc::BVHCollision>& out)
-    {
-        osc::BVHNode const& node = bvh.nodes[nodeidx];
+    // leaf nodes refer to prims by their absolute index in `prims`, and internal nodes only
+    // refer to other nodes via relative offsets, so subtrees can be built independently
+    // (e.g. on other threads) and then concatenated
+    void BVH_BuildSubtree(
+        nonstd::span<osc::BVHPrim> prims,
+        size_t begin,
+        size_t end,
+        osc::BVHBuildOptions const& opts,
+        size_t numParallelLevels,
+        std::vector<osc::BVHNode>& out)
+    {
+        size_t const n = end - begin;
+
+        // compute the bounds of the prims (+ of their centroids, for binning)
+        osc::AABB bounds = osc::InvertedAABB();
+        osc::AABB centroidBounds = osc::InvertedAABB();
+        for (size_t i = begin; i < end; ++i)
+        {
+            glm::vec3 const centroid = Midpoint(prims[i].getBounds());
+            bounds = Union(bounds, prims[i].getBounds());
+            centroidBounds = Union(centroidBounds, osc::AABB{centroid, centroid});
+        }
 
-        // check ray-AABB intersection with the BVH node
-        std::optional<osc::RayCollision> res = osc::GetRayCollisionAABB(ray, node.getBounds());
+        size_t const midpoint = opts.strategy == osc::BVHBuildStrategy::Midpoint ?
+            BVH_PartitionMidpoint(prims, begin, end, bounds, opts) :
+            BVH_PartitionBinnedSAH(prims, begin, end, bounds, centroidBounds, opts);
 
-        if (!res)
+        if (midpoint == begin)
         {
-            return false;  // no intersection with this node at all
+            // recursion bottomed out: create a leaf node
+            OSC_ASSERT(n <= opts.maxPrimsPerLeaf);
+            out.push_back(osc::BVHNode::leaf(bounds, begin, n));
+            return;
         }
 
-        if (node.isLeaf())
+        // else: the prims were partitioned, so allocate an internal node
+        size_t const internalNodeLoc = out.size();
+        out.push_back(osc::BVHNode::node(
+            bounds,
+            0  // the number of left-hand nodes is set later
+        ));
+
+        if (numParallelLevels > 0 && n >= opts.minPrimsForParallelSubtreeBuild)
         {
-            // it's a leaf node, so we've sucessfully found the AABB that intersected
+            // build the right-hand subtree on another thread while this thread builds
+            // the left-hand subtree
+            std::vector<osc::BVHNode> rhsNodes;
+            std::future<void> rhsBuild = std::async(std::launch::async, [prims, midpoint, end, &opts, numParallelLevels, &rhsNodes]()
+            {
+                BVH_BuildSubtree(prims, midpoint, end, opts, numParallelLevels-1, rhsNodes);
+            });
+            BVH_BuildSubtree(prims, begin, midpoint, opts, numParallelLevels-1, out);
+            rhsBuild.get();
 
-            out.push_back(osc::BVHCollision{res->distance, res->position, bvh.prims[node.getFirstPrimOffset()].getID()});
-            return true;
+            out[internalNodeLoc].setNumLhsNodes((out.size() - 1) - internalNodeLoc);
+            out.insert(out.end(), rhsNodes.begin(), rhsNodes.end());
         }
+        else
+        {
+            // build left-hand subtree
+            BVH_BuildSubtree(prims, begin, midpoint, opts, 0, out);
+
+            // the left-hand build allocated nodes for the left hand side contiguously in memory
+            out[internalNodeLoc].setNumLhsNodes((out.size() - 1) - internalNodeLoc);
 
-        // else: we've "hit" an internal node and need to recurse to find the leaf
-        bool const lhs = BVH_GetRayAABBCollisionsRecursive(bvh, ray, nodeidx+1, out);
-        bool const rhs = BVH_GetRayAABBCollisionsRecursive(bvh, ray, nodeidx+node.getNumLhsNodes()+1, out);
-        return lhs || rhs;
+            // build right-hand subtree
+            BVH_BuildSubtree(prims, midpoint, end, opts, 0, out);
+        }
     }
 
-    template<typename TIndex>
-    std::optional<osc::BVHCollision> BVH_GetClosestRayIndexedTriangleCollisionRecursive(
-        osc::BVH const& bvh,
-        nonstd::span<glm::vec3 const> verts,
-        nonstd::span<TIndex const> indices,
-        osc::Line const& ray,
-        float& closest,
-        ptrdiff_t nodeidx)
+    // builds the BVH's nodes from its (already-populated) prims
+    void BVH_BuildNodes(osc::BVH& bvh, osc::BVHBuildOptions const& unsanitizedOpts)
     {
-        osc::BVHNode const& node = bvh.nodes[nodeidx];
-        std::optional<osc::RayCollision> const res = osc::GetRayCollisionAABB(ray, node.getBounds());
+        if (bvh.prims.empty())
+        {
+            return;
+        }
+
+        osc::BVHBuildOptions const opts = Sanitized(unsanitizedOpts);
+        bvh.nodes.reserve(2*bvh.prims.size());  // upper bound for a binary tree with at least one prim per leaf
+        BVH_BuildSubtree(bvh.prims, 0, bvh.prims.size(), opts, CalcNumParallelLevels(opts), bvh.nodes);
+    }
 
-        if (!res)
+    // a ray, plus values that are precomputed once per query and reused by each ray-vs-box test
+    struct BVHRay final {
+
+        explicit BVHRay(osc::Line const& line) :
+            origin{line.origin},
+            dir{line.dir},
+            invDir{1.0f/line.dir.x, 1.0f/line.dir.y, 1.0f/line.dir.z}
         {
-            return std::nullopt;  // didn't hit this node at all
         }
 
-        if (res->distance > closest)
+        glm::vec3 origin;
+        glm::vec3 dir;
+        glm::vec3 invDir;
+    };
+
+    // returned by the ray-vs-prim tests when the ray misses the prim
+    constexpr float c_BVHMissDistance = std::numeric_limits<float>::infinity();
+
+    // returns the distance along the ray to where it enters the AABB, or `c_BVHMissDistance` if
+    // it doesn't intersect the AABB
+    //
+    // uses the same slab test as `osc::GetRayCollisionAABB`, but with a precomputed inverse
+    // direction, and the comparisons are ordered the same way as the SIMD kernel's, so that
+    // both produce identical results
+    float BVH_GetRayAABBDistance(BVHRay const& ray, osc::AABB const& bb)
+    {
+        float t0 = std::numeric_limits<float>::lowest();
+        float t1 = std::numeric_limits<float>::max();
+        for (glm::vec3::length_type i = 0; i < 3; ++i)
         {
-            return std::nullopt;  // this AABB can't contain something closer
+            float const ta = (bb.min[i] - ray.origin[i]) * ray.invDir[i];
+            float const tb = (bb.max[i] - ray.origin[i]) * ray.invDir[i];
+            float const tNear = ta < tb ? ta : tb;
+            float const tFar = ta > tb ? ta : tb;
+            t0 = tNear > t0 ? tNear : t0;
+            t1 = tFar < t1 ? tFar : t1;
         }
+        return t0 <= t1 ? t0 : c_BVHMissDistance;
+    }
 
-        if (node.isLeaf())
+    // the number of prims that the SIMD kernels test at once
+    constexpr size_t c_BVHSimdWidth = 4;
+
+#ifdef OSC_BVH_SSE2_AVAILABLE
+    // three (SoA) lanes of `c_BVHSimdWidth` vectors
+    struct BVHVec3x4 final {
+        __m128 x;
+        __m128 y;
+        __m128 z;
+    };
+
+    BVHVec3x4 Splat(glm::vec3 const& v)
+    {
+        return {_mm_set1_ps(v.x), _mm_set1_ps(v.y), _mm_set1_ps(v.z)};
+    }
+
+    BVHVec3x4 operator-(BVHVec3x4 const& a, BVHVec3x4 const& b)
+    {
+        return {_mm_sub_ps(a.x, b.x), _mm_sub_ps(a.y, b.y), _mm_sub_ps(a.z, b.z)};
+    }
+
+    __m128 Dot(BVHVec3x4 const& a, BVHVec3x4 const& b)
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+    }
+
+    BVHVec3x4 Cross(BVHVec3x4 const& a, BVHVec3x4 const& b)
+    {
+        return
         {
-            // leaf node: check ray-triangle intersection
+            _mm_sub_ps(_mm_mul_ps(a.y, b.z), _mm_mul_ps(a.z, b.y)),
+            _mm_sub_ps(_mm_mul_ps(a.z, b.x), _mm_mul_ps(a.x, b.z)),
+            _mm_sub_ps(_mm_mul_ps(a.x, b.y), _mm_mul_ps(a.y, b.x)),
+        };
+    }
 
-            osc::BVHPrim const& p = bvh.prims.at(node.getFirstPrimOffset());
+    // returns lanes of `v` where `mask` is set, and `c_BVHMissDistance` elsewhere
+    std::array<float, c_BVHSimdWidth> SelectOrMiss(__m128 mask, __m128 v)
+    {
+        __m128 const rv = _mm_or_ps(_mm_and_ps(mask, v), _mm_andnot_ps(mask, _mm_set1_ps(c_BVHMissDistance)));
+        std::array<float, c_BVHSimdWidth> out;
+        _mm_storeu_ps(out.data(), rv);
+        return out;
+    }
 
-            osc::Triangle const triangle =
+    // 4-wide equivalent of `BVH_GetRayAABBDistance`
+    std::array<float, c_BVHSimdWidth> BVH_GetRayAABBDistancesX4(
+        BVHRay const& ray,
+        std::array<osc::AABB const*, c_BVHSimdWidth> const& bbs)
+    {
+        BVHVec3x4 const mins =
+        {
+            _mm_setr_ps(bbs[0]->min.x, bbs[1]->min.x, bbs[2]->min.x, bbs[3]->min.x),
+            _mm_setr_ps(bbs[0]->min.y, bbs[1]->min.y, bbs[2]->min.y, bbs[3]->min.y),
+            _mm_setr_ps(bbs[0]->min.z, bbs[1]->min.z, bbs[2]->min.z, bbs[3]->min.z),
+        };
+        BVHVec3x4 const maxs =
+        {
+            _mm_setr_ps(bbs[0]->max.x, bbs[1]->max.x, bbs[2]->max.x, bbs[3]->max.x),
+            _mm_setr_ps(bbs[0]->max.y, bbs[1]->max.y, bbs[2]->max.y, bbs[3]->max.y),
+            _mm_setr_ps(bbs[0]->max.z, bbs[1]->max.z, bbs[2]->max.z, bbs[3]->max.z),
+        };
+
+        __m128 t0 = _mm_set1_ps(std::numeric_limits<float>::lowest());
+        __m128 t1 = _mm_set1_ps(std::numeric_limits<float>::max());
+        auto const intersectSlab = [&t0, &t1](__m128 min, __m128 max, float origin, float invDir)
+        {
+            __m128 const ta = _mm_mul_ps(_mm_sub_ps(min, _mm_set1_ps(origin)), _mm_set1_ps(invDir));
+            __m128 const tb = _mm_mul_ps(_mm_sub_ps(max, _mm_set1_ps(origin)), _mm_set1_ps(invDir));
+
+            // note: operand order matters (it matches the scalar implementation's NaN handling)
+            __m128 const tNear = _mm_min_ps(ta, tb);
+            __m128 const tFar = _mm_max_ps(ta, tb);
+            t0 = _mm_max_ps(tNear, t0);
+            t1 = _mm_min_ps(tFar, t1);
+        };
+        intersectSlab(mins.x, maxs.x, ray.origin.x, ray.invDir.x);
+        intersectSlab(mins.y, maxs.y, ray.origin.y, ray.invDir.y);
+        intersectSlab(mins.z, maxs.z, ray.origin.z, ray.invDir.z);
+
+        return SelectOrMiss(_mm_cmple_ps(t0, t1), t0);
+    }
+
+    // returns the distance along the ray to where it intersects each (double-sided) triangle, or
+    // `c_BVHMissDistance` if it doesn't intersect the triangle or the intersection is behind the
+    // ray's origin
+    //
+    // this is a 4-wide Moller-Trumbore test that rejects (near-)parallel rays with the same threshold
+    // as `osc::GetRayCollisionTriangle`
+    std::array<float, c_BVHSimdWidth> BVH_GetRayTriangleDistancesX4(
+        BVHRay const& ray,
+        std::array<osc::Triangle, c_BVHSimdWidth> const& tris)
+    {
+        auto const gather = [&tris](size_t vert)
+        {
+            return BVHVec3x4
             {
-                at(verts, at(indices, p.getID())),
-                at(verts, at(indices, p.getID()+1)),
-                at(verts, at(indices, p.getID()+2)),
+                _mm_setr_ps(tris[0][vert].x, tris[1][vert].x, tris[2][vert].x, tris[3][vert].x),
+                _mm_setr_ps(tris[0][vert].y, tris[1][vert].y, tris[2][vert].y, tris[3][vert].y),
+                _mm_setr_ps(tris[0][vert].z, tris[1][vert].z, tris[2][vert].z, tris[3][vert].z),
             };
+        };
+        constexpr float eps = std::numeric_limits<float>::epsilon();
+
+        BVHVec3x4 const p0 = gather(0);
+        BVHVec3x4 const e1 = gather(1) - p0;
+        BVHVec3x4 const e2 = gather(2) - p0;
+        BVHVec3x4 const dir = Splat(ray.dir);
+        BVHVec3x4 const n = Cross(e1, e2);
+        BVHVec3x4 const p = Cross(dir, e2);
+        __m128 const det = Dot(e1, p);
+
+        __m128 const invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+        BVHVec3x4 const s = Splat(ray.origin) - p0;
+        BVHVec3x4 const q = Cross(s, e1);
+        __m128 const u = _mm_mul_ps(Dot(s, p), invDet);
+        __m128 const v = _mm_mul_ps(Dot(dir, q), invDet);
+        __m128 const t = _mm_mul_ps(Dot(e2, q), invDet);
+
+        __m128 const zero = _mm_setzero_ps();
+        __m128 mask = _mm_cmpge_ps(_mm_mul_ps(det, det), _mm_mul_ps(_mm_set1_ps(eps*eps), Dot(n, n)));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f)));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(t, zero));
+        return SelectOrMiss(mask, t);
+    }
+#else
+    // scalar fallbacks for CPUs without SSE2
+
+    // returns the distance along the ray to where it intersects the (double-sided) triangle, or
+    // `c_BVHMissDistance` if it doesn't intersect the triangle or the intersection is behind the
+    // ray's origin
+    //
+    // this is a Moller-Trumbore test that rejects (near-)parallel rays with the same threshold
+    // as `osc::GetRayCollisionTriangle`
+    float BVH_GetRayTriangleDistance(BVHRay const& ray, osc::Triangle const& tri)
+    {
+        constexpr float eps = std::numeric_limits<float>::epsilon();
+
+        glm::vec3 const e1 = tri.p1 - tri.p0;
+        glm::vec3 const e2 = tri.p2 - tri.p0;
+        glm::vec3 const n = glm::cross(e1, e2);
+        glm::vec3 const p = glm::cross(ray.dir, e2);
+        float const det = glm::dot(e1, p);
+
+        // equivalent to `abs(dot(normalize(n), dir)) < eps`, without the square root
+        if (!(det*det >= eps*eps*glm::dot(n, n)))
+        {
+            return c_BVHMissDistance;
+        }
+
+        float const invDet = 1.0f/det;
+        glm::vec3 const s = ray.origin - tri.p0;
+        glm::vec3 const q = glm::cross(s, e1);
+        float const u = glm::dot(s, p) * invDet;
+        float const v = glm::dot(ray.dir, q) * invDet;
+        float const t = glm::dot(e2, q) * invDet;
+
+        return (u >= 0.0f && v >= 0.0f && u+v <= 1.0f && t >= 0.0f) ? t : c_BVHMissDistance;
+    }
+
+    std::array<float, c_BVHSimdWidth> BVH_GetRayAABBDistancesX4(
+        BVHRay const& ray,
+        std::array<osc::AABB const*, c_BVHSimdWidth> const& bbs)
+    {
+        std::array<float, c_BVHSimdWidth> rv;
+        for (size_t i = 0; i < c_BVHSimdWidth; ++i)
+        {
+            rv[i] = BVH_GetRayAABBDistance(ray, *bbs[i]);
+        }
+        return rv;
+    }
+
+    std::array<float, c_BVHSimdWidth> BVH_GetRayTriangleDistancesX4(
+        BVHRay const& ray,
+        std::array<osc::Triangle, c_BVHSimdWidth> const& tris)
+    {
+        std::array<float, c_BVHSimdWidth> rv;
+        for (size_t i = 0; i < c_BVHSimdWidth; ++i)
+        {
+            rv[i] = BVH_GetRayTriangleDistance(ray, tris[i]);
+        }
+        return rv;
+    }
+#endif
 
-            std::optional<osc::RayCollision> const rayTriangleColl = osc::GetRayCollisionTriangle(ray, triangle);
+    // a stack of not-yet-visited nodes (+ the distance to them) for iterative traversal
+    //
+    // the first `c_InlineCapacity` entries live inside the stack object (i.e. on the caller's stack,
+    // no heap allocation), which is more than enough for a reasonably-balanced tree; however,
+    // degenerate inputs can produce deeper trees, so it spills onto the heap if necessary
+    class BVHTraversalStack final {
+    public:
+        struct Entry final {
+            size_t nodeIndex;
+            float distance;
+        };
+
+        bool empty() const
+        {
+            return m_Size == 0;
+        }
 
-            if (rayTriangleColl && rayTriangleColl->distance < closest)
+        void push(Entry e)
+        {
+            if (m_Size < c_InlineCapacity)
             {
-                closest = rayTriangleColl->distance;
-                return osc::BVHCollision{rayTriangleColl->distance, rayTriangleColl->position, p.getID()};
+                m_Inline[m_Size] = e;
             }
             else
             {
-                return std::nullopt;  // it didn't collide with the triangle
+                m_Overflow.push_back(e);
             }
+            ++m_Size;
         }
 
-        // else: internal node: recurse
-        std::optional<osc::BVHCollision> const lhs = BVH_GetClosestRayIndexedTriangleCollisionRecursive(bvh, verts, indices, ray, closest, nodeidx+1);
-        std::optional<osc::BVHCollision> const rhs = BVH_GetClosestRayIndexedTriangleCollisionRecursive(bvh, verts, indices, ray, closest, nodeidx+node.getNumLhsNodes()+1);
-        return rhs ? rhs : lhs;
+        Entry pop()
+        {
+            --m_Size;
+            if (m_Size < c_InlineCapacity)
+            {
+                return m_Inline[m_Size];
+            }
+            else
+            {
+                Entry const rv = m_Overflow.back();
+                m_Overflow.pop_back();
+                return rv;
+            }
+        }
+
+    private:
+        static inline constexpr size_t c_InlineCapacity = 64;
+
+        std::array<Entry, c_InlineCapacity> m_Inline;
+        std::vector<Entry> m_Overflow;
+        size_t m_Size = 0;
+    };
+
+    // iteratively traverses the BVH, nearest-child-first, calling `onLeaf(leafNode)` for each leaf
+    // node that the ray intersects no further than `cutoff` along the ray
+    //
+    // `cutoff` is re-read throughout the traversal, so `onLeaf` can lower it (e.g. to the closest
+    // hit found so far) to skip nodes that cannot contain anything closer
+    template<typename LeafCallback>
+    void BVH_ForEachRayLeafFrontToBack(
+        osc::BVH const& bvh,
+        BVHRay const& ray,
+        float const& cutoff,
+        LeafCallback&& onLeaf)
+    {
+        if (bvh.nodes.empty() || !(BVH_GetRayAABBDistance(ray, bvh.nodes.front().getBounds()) <= cutoff))
+        {
+            return;
+        }
+
+        BVHTraversalStack stack;
+        size_t cur = 0;
+        for (;;)
+        {
+            osc::BVHNode const& node = bvh.nodes[cur];
+
+            if (node.isNode())
+            {
+                // internal node: descend into the nearest intersected child (if any), deferring
+                // the other one
+
+                size_t const lhs = cur + 1;
+                size_t const rhs = cur + node.getNumLhsNodes() + 1;
+                float const lhsDistance = BVH_GetRayAABBDistance(ray, bvh.nodes[lhs].getBounds());
+                float const rhsDistance = BVH_GetRayAABBDistance(ray, bvh.nodes[rhs].getBounds());
+                bool const lhsHit = lhsDistance <= cutoff;
+                bool const rhsHit = rhsDistance <= cutoff;
+
+                if (lhsHit && rhsHit)
+                {
+                    if (lhsDistance <= rhsDistance)
+                    {
+                        stack.push({rhs, rhsDistance});
+                        cur = lhs;
+                    }
+                    else
+                    {
+                        stack.push({lhs, lhsDistance});
+                        cur = rhs;
+                    }
+                    continue;
+                }
+                else if (lhsHit)
+                {
+                    cur = lhs;
+                    continue;
+                }
+                else if (rhsHit)
+                {
+                    cur = rhs;
+                    continue;
+                }
+            }
+            else
+            {
+                onLeaf(node);
+            }
+
+            // pop the next deferred node that could still contain something within the cutoff
+            bool found = false;
+            while (!stack.empty())
+            {
+                BVHTraversalStack::Entry const e = stack.pop();
+                if (e.distance <= cutoff)
+                {
+                    cur = e.nodeIndex;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+            {
+                return;
+            }
+        }
+    }
+
+    // calls `f(prim, distance)` for each of the given leaf's prims that the ray intersects
+    template<typename PrimHitCallback>
+    void BVH_ForEachRayLeafPrimAABBHit(
+        osc::BVH const& bvh,
+        BVHRay const& ray,
+        osc::BVHNode const& leaf,
+        PrimHitCallback&& f)
+    {
+        size_t const begin = leaf.getFirstPrimOffset();
+        size_t const end = begin + leaf.getNumPrims();
+
+        for (size_t chunk = begin; chunk < end; chunk += c_BVHSimdWidth)
+        {
+            // pad any unused lanes with the last prim (their results are ignored)
+            size_t const n = std::min(c_BVHSimdWidth, end - chunk);
+            std::array<osc::AABB const*, c_BVHSimdWidth> bbs;
+            for (size_t i = 0; i < c_BVHSimdWidth; ++i)
+            {
+                bbs[i] = &bvh.prims[chunk + std::min(i, n-1)].getBounds();
+            }
+
+            std::array<float, c_BVHSimdWidth> const distances = BVH_GetRayAABBDistancesX4(ray, bbs);
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (distances[i] != c_BVHMissDistance)
+                {
+                    f(bvh.prims[chunk + i], distances[i]);
+                }
+            }
+        }
+    }
+
+    template<typename TIndex>
+    std::optional<osc::BVHCollision> GetClosestRayIndexedTriangleCollision(
+        osc::BVH const& bvh,
+        nonstd::span<glm::vec3 const> verts,
+        nonstd::span<TIndex const> indices,
+        osc::Line const& line)
+    {
+        if (bvh.nodes.empty() || bvh.prims.empty() || indices.empty())
+        {
+            return std::nullopt;
+        }
+
+        BVHRay const ray{line};
+        float closest = std::numeric_limits<float>::max();
+        std::optional<ptrdiff_t> closestID;
+
+        BVH_ForEachRayLeafFrontToBack(bvh, ray, closest, [&](osc::BVHNode const& leaf)
+        {
+            size_t const begin = leaf.getFirstPrimOffset();
+            size_t const end = begin + leaf.getNumPrims();
+
+            for (size_t chunk = begin; chunk < end; chunk += c_BVHSimdWidth)
+            {
+                // pad any unused lanes with the last triangle (their results are ignored)
+                size_t const n = std::min(c_BVHSimdWidth, end - chunk);
+                std::array<osc::Triangle, c_BVHSimdWidth> tris;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    ptrdiff_t const id = bvh.prims[chunk + i].getID();
+                    tris[i] =
+                    {
+                        at(verts, at(indices, id)),
+                        at(verts, at(indices, id+1)),
+                        at(verts, at(indices, id+2)),
+                    };
+                }
+                std::fill(tris.begin() + n, tris.end(), tris[n-1]);
+
+                std::array<float, c_BVHSimdWidth> const distances = BVH_GetRayTriangleDistancesX4(ray, tris);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (distances[i] < closest)
+                    {
+                        closest = distances[i];
+                        closestID = bvh.prims[chunk + i].getID();
+                    }
+                }
+            }
+        });
+
+        if (!closestID)
+        {
+            return std::nullopt;
+        }
+        return osc::BVHCollision{closest, line.origin + closest*line.dir, *closestID};
     }
 
     template<typename TIndex>
     void BuildFromIndexedTriangles(
         osc::BVH& bvh,
         nonstd::span<glm::vec3 const> verts,
-        nonstd::span<TIndex const> indices)
+        nonstd::span<TIndex const> indices,
+        osc::BVHBuildOptions const& opts)
     {
         // clear out any old data
         bvh.clear();
@@ -274,26 +850,7 @@ namespace
             }
         }
 
-        if (!bvh.prims.empty())
-        {
-            BVH_RecursiveBuild(bvh, 0, static_cast<ptrdiff_t>(bvh.prims.size()));
-        }
-    }
-
-    template<typename TIndex>
-    std::optional<osc::BVHCollision> GetClosestRayIndexedTriangleCollision(
-        osc::BVH const& bvh,
-        nonstd::span<glm::vec3 const> verts,
-        nonstd::span<TIndex const> indices,
-        osc::Line const& ray)
-    {
-        if (bvh.nodes.empty() || bvh.prims.empty() || indices.empty())
-        {
-            return std::nullopt;
-        }
-
-        float closest = std::numeric_limits<float>::max();
-        return BVH_GetClosestRayIndexedTriangleCollisionRecursive(bvh, verts, indices, ray, closest, 0);
+        BVH_BuildNodes(bvh, opts);
     }
 }
 
@@ -303,14 +860,14 @@ void osc::BVH::clear()
     prims.clear();
 }
 
-void osc::BVH::buildFromIndexedTriangles(nonstd::span<glm::vec3 const> verts, nonstd::span<uint16_t const> indices)
+void osc::BVH::buildFromIndexedTriangles(nonstd::span<glm::vec3 const> verts, nonstd::span<uint16_t const> indices, BVHBuildOptions const& opts)
 {
-    BuildFromIndexedTriangles<uint16_t>(*this, verts, indices);
+    BuildFromIndexedTriangles<uint16_t>(*this, verts, indices, opts);
 }
 
-void osc::BVH::buildFromIndexedTriangles(nonstd::span<glm::vec3 const> verts, nonstd::span<uint32_t const> indices)
+void osc::BVH::buildFromIndexedTriangles(nonstd::span<glm::vec3 const> verts, nonstd::span<uint32_t const> indices, BVHBuildOptions const& opts)
 {
-    BuildFromIndexedTriangles<uint32_t>(*this, verts, indices);
+    BuildFromIndexedTriangles<uint32_t>(*this, verts, indices, opts);
 }
 
 std::optional<osc::BVHCollision> osc::BVH::getClosestRayIndexedTriangleCollision(nonstd::span<glm::vec3 const> verts, nonstd::span<uint16_t const> indices, Line const& line) const
@@ -323,7 +880,7 @@ std::optional<osc::BVHCollision> osc::BVH::getClosestRayIndexedTriangleCollision
     return GetClosestRayIndexedTriangleCollision<uint32_t>(*this, verts, indices, line);
 }
 
-void osc::BVH::buildFromAABBs(nonstd::span<AABB const> aabbs)
+void osc::BVH::buildFromAABBs(nonstd::span<AABB const> aabbs, BVHBuildOptions const& opts)
 {
     // clear out any old data
     clear();
@@ -338,29 +895,67 @@ void osc::BVH::buildFromAABBs(nonstd::span<AABB const> aabbs)
         }
     }
 
-    if (!prims.empty())
+    BVH_BuildNodes(*this, opts);
+}
+
+void osc::BVH::refitFromAABBs(nonstd::span<AABB const> aabbs)
+{
+    for (BVHPrim& prim : prims)
     {
-        BVH_RecursiveBuild(*this, 0, static_cast<ptrdiff_t>(prims.size()));
+        OSC_ASSERT(static_cast<size_t>(prim.getID()) < aabbs.size() && "the provided AABBs do not match the ones the BVH was built from");
+        prim = BVHPrim{prim.getID(), aabbs[prim.getID()]};
+    }
+
+    // nodes are stored depth-first (children after their parent), so iterating
+    // backwards guarantees that both children are refit before their parent
+    for (size_t nodeIndex = nodes.size(); nodeIndex-- > 0;)
+    {
+        BVHNode& node = nodes[nodeIndex];
+
+        if (node.isLeaf())
+        {
+            size_t const begin = node.getFirstPrimOffset();
+            size_t const end = begin + node.getNumPrims();
+            AABB bounds = prims[begin].getBounds();
+            for (size_t i = begin+1; i < end; ++i)
+            {
+                bounds = Union(bounds, prims[i].getBounds());
+            }
+            node = BVHNode::leaf(bounds, begin, node.getNumPrims());
+        }
+        else
+        {
+            size_t const numLhs = node.getNumLhsNodes();
+            AABB const& lhs = nodes[nodeIndex + 1].getBounds();
+            AABB const& rhs = nodes[nodeIndex + numLhs + 1].getBounds();
+            node = BVHNode::node(Union(lhs, rhs), numLhs);
+        }
     }
 }
 
 std::vector<osc::BVHCollision> osc::BVH::getRayAABBCollisions(Line const& ray) const
 {
     std::vector<osc::BVHCollision> rv;
+    forEachRayAABBCollision(ray, [&rv](BVHCollision const& c) { rv.push_back(c); });
+    return rv;
+}
 
-    if (nodes.empty())
-    {
-        return rv;
-    }
-
+void osc::BVH::forEachRayAABBCollision(Line const& line, std::function<void(BVHCollision const&)> const& callback) const
+{
     if (prims.empty())
     {
-        return rv;
+        return;
     }
 
-    BVH_GetRayAABBCollisionsRecursive(*this, ray, 0, rv);
-
-    return rv;
+    BVHRay const ray{line};
+    float const cutoff = std::numeric_limits<float>::max();
+    BVH_ForEachRayLeafFrontToBack(*this, ray, cutoff, [&](BVHNode const& leaf)
+    {
+        BVH_ForEachRayLeafPrimAABBHit(*this, ray, leaf, [&](BVHPrim const& prim, float distance)
+        {
+            callback(BVHCollision{distance, line.origin + distance*line.dir, prim.getID()});
+        });
+    });
 }
 
 size_t osc::BVH::getMaxDepth() const
@@ -459,6 +1054,21 @@ glm::mat4 osc::EulerPerspectiveCamera::getProjMtx(float aspect_ratio) const noex
 }
 
 
+// osc::Frustum implementation
+
+std::ostream& osc::operator<<(std::ostream& o, Frustum const& f)
+{
+    o << "Frustum(planes = [";
+    std::string_view delim;
+    for (Plane const& p : f.planes)
+    {
+        o << delim << p;
+        delim = ", ";
+    }
+    return o << "])";
+}
+
+
 // osc::Line implementation
 
 std::ostream& osc::operator<<(std::ostream& o, Line const& l)
@@ -1571,6 +2181,12 @@ float osc::Volume(AABB const& a) noexcept
     return d.x * d.y * d.z;
 }
 
+float osc::SurfaceArea(AABB const& a) noexcept
+{
+    glm::vec3 d = Dimensions(a);
+    return 2.0f * (d.x*d.y + d.y*d.z + d.z*d.x);
+}
+
 osc::AABB osc::Union(AABB const& a, AABB const& b) noexcept
 {
     return AABB
@@ -1821,6 +2437,38 @@ std::optional<osc::Rect> osc::AABBToScreenNDCRect(
     return rv;
 }
 
+osc::Frustum osc::FrustumFromViewProjectionMatrix(glm::mat4 const& m) noexcept
+{
+    // Gribb & Hartmann: each clipping plane is a sum/difference of the matrix's rows
+    //
+    // care: glm matrices are column-major, so `m[col][row]`
+    auto const row = [&m](glm::mat4::length_type i)
+    {
+        return glm::vec4{m[0][i], m[1][i], m[2][i], m[3][i]};
+    };
+
+    std::array<glm::vec4, 6> const coefficients =
+    {
+        row(3) + row(0),  // left
+        row(3) - row(0),  // right
+        row(3) + row(1),  // bottom
+        row(3) - row(1),  // top
+        row(3) + row(2),  // near
+        row(3) - row(2),  // far
+    };
+
+    Frustum rv{};
+    for (size_t i = 0; i < coefficients.size(); ++i)
+    {
+        // convert `ax + by + cz + d = 0` into a (unit) normal + a point on the plane
+        glm::vec3 const abc{coefficients[i]};
+        float const len = glm::length(abc);
+        glm::vec3 const normal = abc / len;
+        rv.planes[i] = Plane{-(coefficients[i].w / len) * normal, normal};
+    }
+    return rv;
+}
+
 glm::mat4 osc::SegmentToSegmentMat4(Segment const& a, Segment const& b) noexcept
 {
     glm::vec3 a1ToA2 = a.p2 - a.p1;
@@ -2013,6 +2661,27 @@ bool osc::IsPointInRect(Rect const& r, glm::vec2 const& p) noexcept
     return (0.0f <= relPos.x && relPos.x <= dims.x) && (0.0f <= relPos.y && relPos.y <= dims.y);
 }
 
+bool osc::IsAABBIntersectingFrustum(AABB const& aabb, Frustum const& frustum) noexcept
+{
+    for (Plane const& plane : frustum.planes)
+    {
+        // test the AABB corner that's furthest along the plane's (inward-facing) normal: if
+        // even that corner is behind the plane, then the whole AABB is outside the frustum
+        glm::vec3 const furthestCorner
+        {
+            plane.normal.x >= 0.0f ? aabb.max.x : aabb.min.x,
+            plane.normal.y >= 0.0f ? aabb.max.y : aabb.min.y,
+            plane.normal.z >= 0.0f ? aabb.max.z : aabb.min.z,
+        };
+
+        if (glm::dot(furthestCorner - plane.origin, plane.normal) < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 std::optional<osc::RayCollision> osc::GetRayCollisionSphere(Line const& l, Sphere const& s) noexcept
 {
     return GetRayCollisionSphereAnalytic(s, l);
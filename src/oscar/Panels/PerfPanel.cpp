@@ -25,6 +25,11 @@ namespace
     {
         return a.getLabel() > b.getLabel();
     }
+
+    bool LexographicallyHighestCountLabel(osc::PerfCount const& a, osc::PerfCount const& b)
+    {
+        return a.getLabel() > b.getLabel();
+    }
 }
 
 class osc::PerfPanel::Impl final : public osc::StandardPanel {
@@ -70,6 +75,10 @@ private:
             m_MeasurementBuffer.clear();
             GetAllMeasurements(m_MeasurementBuffer);
             Sort(m_MeasurementBuffer, LexographicallyHighestLabel);
+
+            m_CountBuffer.clear();
+            GetAllCounts(m_CountBuffer);
+            Sort(m_CountBuffer, LexographicallyHighestCountLabel);
         }
 
         ImGuiTableFlags flags =
@@ -111,10 +120,44 @@ private:
 
             ImGui::EndTable();
         }
+
+        if (ImGui::BeginTable("counts", 5, flags))
+        {
+            ImGui::TableSetupColumn("Label");
+            ImGui::TableSetupColumn("Source File");
+            ImGui::TableSetupColumn("Num Samples");
+            ImGui::TableSetupColumn("Last Value");
+            ImGui::TableSetupColumn("Average Value");
+            ImGui::TableHeadersRow();
+
+            for (osc::PerfCount const& pc : m_CountBuffer)
+            {
+                if (pc.getNumSamples() <= 0)
+                {
+                    continue;
+                }
+
+                int column = 0;
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(column++);
+                ImGui::TextUnformatted(pc.getLabel().c_str());
+                ImGui::TableSetColumnIndex(column++);
+                ImGui::Text("%s:%u", pc.getFilename().c_str(), pc.getLine());
+                ImGui::TableSetColumnIndex(column++);
+                ImGui::Text("%" PRId64, pc.getNumSamples());
+                ImGui::TableSetColumnIndex(column++);
+                ImGui::Text("%" PRId64, pc.getLastValue());
+                ImGui::TableSetColumnIndex(column++);
+                ImGui::Text("%.1f", pc.getAvgValue());
+            }
+
+            ImGui::EndTable();
+        }
     }
 
     bool m_IsPaused = false;
     std::vector<osc::PerfMeasurement> m_MeasurementBuffer;
+    std::vector<osc::PerfCount> m_CountBuffer;
 };
 
 
@@ -0,0 +1,194 @@
+#include "MemoryMappedFile.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef WIN32
+#include <Windows.h>  // CreateFileW, CreateFileMappingW, MapViewOfFile, UnmapViewOfFile, CloseHandle
+#else
+#include <fcntl.h>  // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>  // close
+#endif
+
+namespace
+{
+    [[noreturn]] void ThrowMappingError(std::filesystem::path const& p, std::string_view reason)
+    {
+        std::stringstream ss;
+        ss << p.string() << ": cannot memory-map file: " << reason;
+        throw std::runtime_error{std::move(ss).str()};
+    }
+}
+
+#ifdef WIN32
+class osc::MemoryMappedFile::Impl final {
+public:
+    explicit Impl(std::filesystem::path const& p)
+    {
+        m_File = CreateFileW(p.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_File == INVALID_HANDLE_VALUE)
+        {
+            ThrowMappingError(p, "cannot open file");
+        }
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(m_File, &size))
+        {
+            CloseHandle(m_File);
+            ThrowMappingError(p, "cannot get file size");
+        }
+        m_Size = static_cast<size_t>(size.QuadPart);
+
+        if (m_Size == 0)
+        {
+            return;  // empty files cannot be mapped (and don't need to be)
+        }
+
+        m_Mapping = CreateFileMappingW(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_Mapping == nullptr)
+        {
+            CloseHandle(m_File);
+            ThrowMappingError(p, "CreateFileMapping failed");
+        }
+
+        m_Data = MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+        if (m_Data == nullptr)
+        {
+            CloseHandle(m_Mapping);
+            CloseHandle(m_File);
+            ThrowMappingError(p, "MapViewOfFile failed");
+        }
+    }
+    Impl(Impl const&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(Impl const&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept
+    {
+        if (m_Data)
+        {
+            UnmapViewOfFile(m_Data);
+        }
+        if (m_Mapping)
+        {
+            CloseHandle(m_Mapping);
+        }
+        CloseHandle(m_File);
+    }
+
+    size_t size() const
+    {
+        return m_Size;
+    }
+
+    void const* data() const
+    {
+        return m_Data;
+    }
+
+private:
+    HANDLE m_File = INVALID_HANDLE_VALUE;
+    HANDLE m_Mapping = nullptr;
+    void* m_Data = nullptr;
+    size_t m_Size = 0;
+};
+#else
+class osc::MemoryMappedFile::Impl final {
+public:
+    explicit Impl(std::filesystem::path const& p)
+    {
+        m_FileDescriptor = open(p.c_str(), O_RDONLY);
+        if (m_FileDescriptor == -1)
+        {
+            ThrowMappingError(p, "cannot open file");
+        }
+
+        struct stat st{};
+        if (fstat(m_FileDescriptor, &st) == -1)
+        {
+            close(m_FileDescriptor);
+            ThrowMappingError(p, "cannot get file size");
+        }
+        m_Size = static_cast<size_t>(st.st_size);
+
+        if (m_Size == 0)
+        {
+            return;  // empty files cannot be mapped (and don't need to be)
+        }
+
+        m_Data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_FileDescriptor, 0);
+        if (m_Data == MAP_FAILED)
+        {
+            m_Data = nullptr;
+            close(m_FileDescriptor);
+            ThrowMappingError(p, "mmap failed");
+        }
+
+        // callers (typically) parse the file front-to-back
+        madvise(m_Data, m_Size, MADV_SEQUENTIAL);
+    }
+    Impl(Impl const&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(Impl const&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept
+    {
+        if (m_Data)
+        {
+            munmap(m_Data, m_Size);
+        }
+        close(m_FileDescriptor);
+    }
+
+    size_t size() const
+    {
+        return m_Size;
+    }
+
+    void const* data() const
+    {
+        return m_Data;
+    }
+
+private:
+    int m_FileDescriptor = -1;
+    void* m_Data = nullptr;
+    size_t m_Size = 0;
+};
+#endif
+
+
+// public API (PIMPL)
+
+osc::MemoryMappedFile::MemoryMappedFile(std::filesystem::path const& p) :
+    m_Impl{std::make_unique<Impl>(p)}
+{
+}
+osc::MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&&) noexcept = default;
+osc::MemoryMappedFile& osc::MemoryMappedFile::operator=(MemoryMappedFile&&) noexcept = default;
+osc::MemoryMappedFile::~MemoryMappedFile() noexcept = default;
+
+size_t osc::MemoryMappedFile::size() const
+{
+    return m_Impl->size();
+}
+
+nonstd::span<std::byte const> osc::MemoryMappedFile::getBytes() const
+{
+    return {static_cast<std::byte const*>(m_Impl->data()), m_Impl->size()};
+}
+
+std::string_view osc::MemoryMappedFile::getChars() const
+{
+    return {static_cast<char const*>(m_Impl->data()), m_Impl->size()};
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace osc
+{
+    // a readonly view of a file's contents that is memory-mapped by the OS, rather than
+    // being read into (e.g.) a `std::string`
+    //
+    // this is useful for parsing large files, because the OS pages in the contents on-demand
+    // and the parser can work directly on the mapped bytes
+    //
+    // throws a `std::runtime_error` if the file cannot be opened/mapped
+    class MemoryMappedFile final {
+    public:
+        explicit MemoryMappedFile(std::filesystem::path const&);
+        MemoryMappedFile(MemoryMappedFile const&) = delete;
+        MemoryMappedFile(MemoryMappedFile&&) noexcept;
+        MemoryMappedFile& operator=(MemoryMappedFile const&) = delete;
+        MemoryMappedFile& operator=(MemoryMappedFile&&) noexcept;
+        ~MemoryMappedFile() noexcept;
+
+        size_t size() const;
+        nonstd::span<std::byte const> getBytes() const;
+        std::string_view getChars() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
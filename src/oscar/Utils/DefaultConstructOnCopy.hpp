@@ -12,7 +12,12 @@ namespace osc
 
         DefaultConstructOnCopy() = default;
 
-        template<typename... Args>
+        // (excludes copying from a non-const `DefaultConstructOnCopy`, e.g. a `mutable` one, which
+        // should still go via the copy constructor)
+        template<
+            typename... Args,
+            typename = std::enable_if_t<!(sizeof...(Args) == 1 && (std::is_same_v<std::decay_t<Args>, DefaultConstructOnCopy> && ...))>
+        >
         DefaultConstructOnCopy(Args&& ...args) : m_Value{std::forward<Args>(args)...}
         {
         }
@@ -0,0 +1,47 @@
+#include "InternedString.hpp"
+
+#include "oscar/Utils/SynchronizedValue.hpp"
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+    // the keys are views into the (heap-allocated, so address-stable) values, which
+    // enables looking strings up without allocating a temporary `std::string`
+    using InternedStringTable = std::unordered_map<std::string_view, std::unique_ptr<std::string const>>;
+
+    osc::SynchronizedValue<InternedStringTable>& GetGlobalInternedStringTable()
+    {
+        static osc::SynchronizedValue<InternedStringTable> s_Table;
+        return s_Table;
+    }
+}
+
+osc::InternedString::InternedString(std::string_view s)
+{
+    if (s.empty())
+    {
+        return;  // the empty string is always represented by `nullptr`
+    }
+
+    auto table = GetGlobalInternedStringTable().lock();
+    if (auto const it = table->find(s); it != table->end())
+    {
+        m_Ptr = it->second.get();
+    }
+    else
+    {
+        auto value = std::make_unique<std::string const>(s);
+        m_Ptr = value.get();
+        table->emplace(std::string_view{*value}, std::move(value));
+    }
+}
+
+std::ostream& osc::operator<<(std::ostream& o, InternedString const& s)
+{
+    return o << s.str();
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace osc
+{
+    // an immutable, interned, string
+    //
+    // each unique string value is stored once in a global table, so copying, comparing,
+    // and hashing an `InternedString` is as cheap as copying, comparing, and hashing a
+    // pointer. Constructing one requires a (locked) table lookup, so it's only worth using
+    // for strings that are copied/compared much more often than they are created (e.g.
+    // the IDs of scene decorations)
+    //
+    // the table never shrinks, so this shouldn't be used for arbitrary (e.g. user-provided
+    // or randomly-generated) strings
+    class InternedString final {
+    public:
+        InternedString() = default;  // the empty string
+        explicit InternedString(std::string_view);
+
+        std::string const& str() const noexcept
+        {
+            return m_Ptr ? *m_Ptr : c_EmptyString;
+        }
+
+        char const* c_str() const noexcept
+        {
+            return str().c_str();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_Ptr == nullptr;
+        }
+
+        operator std::string_view () const noexcept
+        {
+            return str();
+        }
+
+        friend bool operator==(InternedString const& a, InternedString const& b) noexcept
+        {
+            return a.m_Ptr == b.m_Ptr;
+        }
+
+        friend bool operator!=(InternedString const& a, InternedString const& b) noexcept
+        {
+            return a.m_Ptr != b.m_Ptr;
+        }
+
+    private:
+        friend struct std::hash<InternedString>;
+
+        static inline std::string const c_EmptyString{};
+
+        // points into the (stable) global table, or `nullptr` for the empty string
+        std::string const* m_Ptr = nullptr;
+    };
+
+    std::ostream& operator<<(std::ostream&, InternedString const&);
+}
+
+namespace std
+{
+    template<>
+    struct hash<osc::InternedString> final {
+        size_t operator()(osc::InternedString const& s) const noexcept
+        {
+            return std::hash<std::string const*>{}(s.m_Ptr);
+        }
+    };
+}
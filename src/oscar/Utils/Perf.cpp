@@ -26,6 +26,12 @@ namespace
         static osc::SynchronizedValue<std::unordered_map<int64_t, osc::PerfMeasurement>> s_Measurements;
         return s_Measurements;
     }
+
+    osc::SynchronizedValue<std::unordered_map<int64_t, osc::PerfCount>>& GetCountStorage()
+    {
+        static osc::SynchronizedValue<std::unordered_map<int64_t, osc::PerfCount>> s_Counts;
+        return s_Counts;
+    }
 }
 
 
@@ -53,11 +59,19 @@ void osc::SubmitMeasurement(int64_t id, PerfClock::time_point start, PerfClock::
 
 void osc::ClearPerfMeasurements()
 {
-    auto guard = GetMeasurementStorage().lock();
-
-    for (auto& [id, data] : *guard)
     {
-        data.clear();
+        auto guard = GetMeasurementStorage().lock();
+        for (auto& [id, data] : *guard)
+        {
+            data.clear();
+        }
+    }
+    {
+        auto guard = GetCountStorage().lock();
+        for (auto& [id, data] : *guard)
+        {
+            data.clear();
+        }
     }
 }
 
@@ -73,6 +87,34 @@ size_t osc::GetAllMeasurements(std::vector<PerfMeasurement>& appendOut)
     return i;
 }
 
+int64_t osc::AllocateCountID(char const* label, char const* filename, unsigned int line)
+{
+    int64_t id = GenerateID(label, filename, line);
+
+    auto guard = GetCountStorage().lock();
+    guard->emplace(std::piecewise_construct, std::tie(id), std::tie(id, label, filename, line));
+    return id;
+}
 
+void osc::SubmitCount(int64_t id, int64_t value) noexcept
+{
+    auto guard = GetCountStorage().lock();
+    auto it = guard->find(id);
 
+    if (it != guard->end())
+    {
+        it->second.submit(value);
+    }
+}
 
+size_t osc::GetAllCounts(std::vector<PerfCount>& appendOut)
+{
+    auto guard = GetCountStorage().lock();
+    size_t i = 0;
+    for (auto const& [id, count] : *guard)
+    {
+        appendOut.push_back(count);
+        ++i;
+    }
+    return i;
+}
@@ -90,11 +90,89 @@ namespace osc
         osc::PerfClock::duration m_LastDuration{0};
     };
 
+    // a named integer count (e.g. number of culled objects) that is sampled once per call
+    class PerfCount final {
+    public:
+        PerfCount(int64_t id,
+                  char const* label,
+                  char const* filename,
+                  unsigned int line) :
+            m_ID{id},
+            m_Label{label},
+            m_Filename{filename},
+            m_Line{line}
+        {
+        }
+
+        int64_t getID() const
+        {
+            return m_ID;
+        }
+
+        std::string const& getLabel() const
+        {
+            return m_Label;
+        }
+
+        std::string const& getFilename() const
+        {
+            return m_Filename;
+        }
+
+        unsigned int getLine() const
+        {
+            return m_Line;
+        }
+
+        int64_t getNumSamples() const
+        {
+            return m_NumSamples;
+        }
+
+        int64_t getLastValue() const
+        {
+            return m_LastValue;
+        }
+
+        double getAvgValue() const
+        {
+            return m_NumSamples > 0 ? static_cast<double>(m_TotalValue)/static_cast<double>(m_NumSamples) : 0.0;
+        }
+
+        void submit(int64_t value)
+        {
+            m_LastValue = value;
+            m_TotalValue += value;
+            m_NumSamples++;
+        }
+
+        void clear()
+        {
+            m_NumSamples = 0;
+            m_TotalValue = 0;
+            m_LastValue = 0;
+        }
+
+    private:
+        int64_t m_ID;
+        std::string m_Label;
+        std::string m_Filename;
+        unsigned int m_Line = 0;
+
+        int64_t m_NumSamples = 0;
+        int64_t m_TotalValue = 0;
+        int64_t m_LastValue = 0;
+    };
+
     int64_t AllocateMeasurementID(char const* label, char const* filename, unsigned int line);
     void SubmitMeasurement(int64_t id, PerfClock::time_point start, PerfClock::time_point end) noexcept;
     void ClearPerfMeasurements();
     size_t GetAllMeasurements(std::vector<PerfMeasurement>& appendOut);
 
+    int64_t AllocateCountID(char const* label, char const* filename, unsigned int line);
+    void SubmitCount(int64_t id, int64_t value) noexcept;
+    size_t GetAllCounts(std::vector<PerfCount>& appendOut);
+
     class PerfTimer final {
     public:
         explicit PerfTimer(int64_t id) noexcept :
@@ -117,4 +195,8 @@ namespace osc
 #define OSC_PERF(label) \
     static int64_t const OSC_TOKENPASTE2(s_TimerID, __LINE__) = osc::AllocateMeasurementID(label, OSC_FILENAME, __LINE__); \
     osc::PerfTimer OSC_TOKENPASTE2(timer, __LINE__) (OSC_TOKENPASTE2(s_TimerID, __LINE__));
+
+#define OSC_PERF_COUNT(label, value) \
+    static int64_t const OSC_TOKENPASTE2(s_CountID, __LINE__) = osc::AllocateCountID(label, OSC_FILENAME, __LINE__); \
+    osc::SubmitCount(OSC_TOKENPASTE2(s_CountID, __LINE__), static_cast<int64_t>(value))
 }
@@ -1,14 +1,18 @@
 #pragma once
 
 #include "oscar/Utils/Cpp20Shims.hpp"
+#include "oscar/Utils/SpscRingBuffer.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <cstdint>
-#include <list>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <utility>
 
 // extremely basic support for a single-producer single-consumer (sp-sc) queue
@@ -20,18 +24,65 @@ namespace osc::spsc
     template<typename T>
     class Receiver;
 
+    // what a `Sender` should do when the channel is full
+    enum class OverflowPolicy {
+
+        // wait until the receiver makes space (or hangs up) - i.e. apply backpressure
+        // to the sender
+        Block,
+
+        // drop the message that is being sent
+        DropNewest,
+
+        // hold the message in a single sender-side slot, replacing any message that's
+        // already held there, and try to send it again on the next `send`/`flush`
+        //
+        // handy for "latest value" channels (e.g. progress updates), where the receiver
+        // only cares about the most recent message
+        Coalesce,
+    };
+
+    // default capacity of a channel (can be overridden in `channel()`)
+    inline constexpr size_t c_DefaultChannelCapacity = 64;
+
     // internal implementation class
     template<typename T>
     class Impl final {
+    public:
+        Impl(size_t capacity, OverflowPolicy policy) :
+            m_Buffer{capacity},
+            m_Policy{policy}
+        {
+        }
 
-        // queue mutex
-        std::mutex m_Mutex;
+    private:
+        // wakes the receiver, if it's sleeping in `recv`
+        void notifyReceiver()
+        {
+            // care: this must be seq_cst w.r.t. the receiver setting `m_ReceiverIsWaiting`
+            // and then re-checking the buffer, or a wakeup can be lost
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_ReceiverIsWaiting.load())
+            {
+                std::lock_guard l{m_Mutex};
+                m_Condvar.notify_one();
+            }
+        }
 
-        // queue != empty condvar for worker
-        std::condition_variable m_Condvar;
+        // the (lock-free) queue
+        SpscRingBuffer<T> m_Buffer;
 
-        // the queue
-        std::list<T> m_MessageQueue;
+        // what senders should do when the queue is full
+        OverflowPolicy m_Policy;
+
+        // number of messages that were dropped (`OverflowPolicy::DropNewest`) or
+        // overwritten (`OverflowPolicy::Coalesce`) because the queue was full
+        std::atomic<size_t> m_NumDropped = 0;
+
+        // only used to sleep/wake the receiver in `recv`: pushing/popping is lock-free
+        std::mutex m_Mutex;
+        std::condition_variable m_Condvar;
+        std::atomic<bool> m_ReceiverIsWaiting = false;
 
         // how many `Sender` classes use this Impl (should be 1/0)
         std::atomic<int32_t> m_NumSenders = 0;
@@ -40,7 +91,7 @@ namespace osc::spsc
         std::atomic<int32_t> m_NumReceivers = 0;
 
         template<typename U>
-        friend std::pair<Sender<U>, Receiver<U>> channel();
+        friend std::pair<Sender<U>, Receiver<U>> channel(size_t, OverflowPolicy);
         friend class Sender<T>;
         friend class Receiver<T>;
     };
@@ -50,8 +101,11 @@ namespace osc::spsc
     class Sender final {
         std::shared_ptr<Impl<T>> m_Impl;
 
+        // only used by `OverflowPolicy::Coalesce`
+        std::optional<T> m_Pending;
+
         template<typename U>
-        friend std::pair<Sender<U>, Receiver<U>> channel();
+        friend std::pair<Sender<U>, Receiver<U>> channel(size_t, OverflowPolicy);
 
         Sender(std::shared_ptr<Impl<T>> impl) : m_Impl{std::move(impl)}
         {
@@ -67,24 +121,125 @@ namespace osc::spsc
         {
             if (m_Impl)
             {
+                flush();
                 --m_Impl->m_NumSenders;
-                m_Impl->m_Condvar.notify_all();  // so receivers can know the hangup happened
+
+                // so receivers can know the hangup happened
+                std::lock_guard l{m_Impl->m_Mutex};
+                m_Impl->m_Condvar.notify_all();
+            }
+        }
+
+        // send data, handling a full channel according to the channel's `OverflowPolicy`
+        //
+        // only blocks if the policy is `OverflowPolicy::Block`, in which case it waits
+        // until there's space in the channel or the receiver hangs up
+        void send(T v)
+        {
+            send(std::move(v), []() { return false; });
+        }
+
+        // as above, but also stops waiting (dropping the message) if `shouldStopWaiting`
+        // returns `true` (e.g. because the sender's thread was asked to stop)
+        //
+        // returns `true` if the message was enqueued (or, for `OverflowPolicy::Coalesce`,
+        // is being held for the next `send`/`flush`)
+        template<typename Predicate>
+        bool send(T v, Predicate shouldStopWaiting)
+        {
+            switch (m_Impl->m_Policy) {
+            case OverflowPolicy::Block:
+            {
+                for (int attempt = 0; !m_Impl->m_Buffer.tryPush(std::move(v)); ++attempt)
+                {
+                    if (isReceiverHungUp() || shouldStopWaiting())
+                    {
+                        ++m_Impl->m_NumDropped;
+                        return false;
+                    }
+                    Backoff(attempt);
+                }
+                m_Impl->notifyReceiver();
+                return true;
+            }
+            case OverflowPolicy::DropNewest:
+            {
+                if (!m_Impl->m_Buffer.tryPush(std::move(v)))
+                {
+                    ++m_Impl->m_NumDropped;
+                    return false;
+                }
+                m_Impl->notifyReceiver();
+                return true;
+            }
+            case OverflowPolicy::Coalesce:
+            default:
+            {
+                flush();
+                if (!m_Pending && m_Impl->m_Buffer.tryPush(std::move(v)))
+                {
+                    m_Impl->notifyReceiver();
+                    return true;
+                }
+                if (m_Pending)
+                {
+                    ++m_Impl->m_NumDropped;  // the older pending message is overwritten
+                }
+                m_Pending = std::move(v);
+                return true;
+            }
             }
         }
 
-        // asynchronously (non-blocking) send data
-        void send(T v) {
+        // non-blocking: returns `false` (leaving `v` untouched) if the channel is full
+        bool trySend(T& v)
+        {
+            if (m_Impl->m_Buffer.tryPush(std::move(v)))
             {
-                std::lock_guard l{m_Impl->m_Mutex};
-                m_Impl->m_MessageQueue.push_front(std::move(v));
+                m_Impl->notifyReceiver();
+                return true;
+            }
+            return false;
+        }
+
+        // try to send any message that's being held by `OverflowPolicy::Coalesce`
+        void flush()
+        {
+            if (m_Pending && m_Impl->m_Buffer.tryPush(std::move(*m_Pending)))
+            {
+                m_Pending.reset();
+                m_Impl->notifyReceiver();
             }
-            m_Impl->m_Condvar.notify_one();
         }
 
         [[nodiscard]] bool isReceiverHungUp() noexcept
         {
             return m_Impl->m_NumReceivers <= 0;
         }
+
+        [[nodiscard]] size_t getNumDropped() const noexcept
+        {
+            return m_Impl->m_NumDropped;
+        }
+
+    private:
+        // spin for a short while, then start yielding/sleeping, so that a blocked sender
+        // doesn't burn a whole core while waiting on a slow receiver
+        static void Backoff(int attempt)
+        {
+            if (attempt < 64)
+            {
+                // spin
+            }
+            else if (attempt < 128)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds{200});
+            }
+        }
     };
 
     // a class the client can receive data from
@@ -93,7 +248,7 @@ namespace osc::spsc
         std::shared_ptr<Impl<T>> m_Impl;
 
         template<typename U>
-        friend std::pair<Sender<U>, Receiver<U>> channel();
+        friend std::pair<Sender<U>, Receiver<U>> channel(size_t, OverflowPolicy);
 
         Receiver(std::shared_ptr<Impl<T>> impl) : m_Impl{std::move(impl)}
         {
@@ -115,53 +270,45 @@ namespace osc::spsc
         // non-blocking: empty if nothing is sent, or the sender has hung up
         std::optional<T> tryReceive()
         {
-            std::lock_guard l{m_Impl->m_Mutex};
-
-            if (m_Impl->m_MessageQueue.empty())
-            {
-                return std::nullopt;
-            }
+            return m_Impl->m_Buffer.tryPop();
+        }
 
-            std::optional<T> rv{std::move(m_Impl->m_MessageQueue.back())};
-            m_Impl->m_MessageQueue.pop_back();
-            return rv;
+        // non-blocking: receives everything that's currently in the channel into the
+        // output iterator and returns how many messages were received
+        template<typename OutputIt>
+        size_t tryReceiveAll(OutputIt out)
+        {
+            return m_Impl->m_Buffer.popAll(out);
         }
 
         // blocking: only empty if the sender hung up
         std::optional<T> recv()
         {
-            std::unique_lock l{m_Impl->m_Mutex};
-
             // easy case: queue is not empty
-            if (!m_Impl->m_MessageQueue.empty())
+            if (std::optional<T> rv = m_Impl->m_Buffer.tryPop())
             {
-                std::optional<T> rv{std::move(m_Impl->m_MessageQueue.back())};
-                m_Impl->m_MessageQueue.pop_back();
                 return rv;
             }
 
             // harder case: sleep until the queue is not empty, *or* until
             // the sender hangs up
+            std::unique_lock l{m_Impl->m_Mutex};
+            m_Impl->m_ReceiverIsWaiting = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            std::optional<T> rv;
             m_Impl->m_Condvar.wait(l, [&]()
             {
-                return !m_Impl->m_MessageQueue.empty() || m_Impl->m_NumSenders <= 0;
+                rv = m_Impl->m_Buffer.tryPop();
+                return rv || m_Impl->m_NumSenders <= 0;
             });
+            m_Impl->m_ReceiverIsWaiting = false;
 
             // the condvar woke up (non-spuriously), either:
             //
             // - there's something in the queue (return it)
-            // - the sender hung up (return nullopt)
-
-            if (!m_Impl->m_MessageQueue.empty())
-            {
-                std::optional<T> rv{std::move(m_Impl->m_MessageQueue.back())};
-                m_Impl->m_MessageQueue.pop_back();
-                return rv;
-            }
-            else
-            {
-                return std::nullopt;
-            }
+            // - the sender hung up (return whatever's left, or nullopt)
+            return rv ? std::move(rv) : m_Impl->m_Buffer.tryPop();
         }
 
         [[nodiscard]] bool isSenderHungUp() noexcept
@@ -172,9 +319,11 @@ namespace osc::spsc
 
     // create a new threadsafe spsc channel (sender + receiver)
     template<typename T>
-    std::pair<Sender<T>, Receiver<T>> channel()
+    std::pair<Sender<T>, Receiver<T>> channel(
+        size_t capacity = c_DefaultChannelCapacity,
+        OverflowPolicy policy = OverflowPolicy::Block)
     {
-        auto impl = std::make_shared<Impl<T>>();
+        auto impl = std::make_shared<Impl<T>>(capacity, policy);
         return {Sender<T>{impl}, Receiver<T>{impl}};
     }
 
@@ -191,11 +340,22 @@ namespace osc::spsc
         // sending end of the channel: sends inputs to background thread
         spsc::Sender<Input> m_Tx;
 
+        // inputs that couldn't be sent yet, because the input channel was full
+        //
+        // (the UI thread never blocks on a worker: it holds onto the inputs and tries
+        //  to send them again on the next `send`/`poll`)
+        //
+        // the backlog is bounded, so that a stalled worker still applies backpressure: once
+        // it's full, new inputs are dropped (and counted)
+        std::deque<Input> m_Backlog;
+        size_t m_MaxBacklog;
+        size_t m_NumDroppedInputs = 0;
+
         // receiving end of the channel: receives outputs from background thread
         spsc::Receiver<Output> m_Rx;
 
         // MAIN function for an SPSC worker thread
-        static int main(osc::stop_token,
+        static int main(osc::stop_token stopToken,
                         spsc::Receiver<Input> rx,
                         spsc::Sender<Output> tx,
                         Func input2output)
@@ -211,38 +371,67 @@ namespace osc::spsc
                     return 0;  // sender hung up
                 }
 
-                tx.send(input2output(*msg));
+                // block (backpressure) if the receiver isn't keeping up
+                tx.send(input2output(*msg), [&stopToken]() { return stopToken.stop_requested(); });
             }
 
             return 0;  // receiver hung up
         }
 
-        Worker(osc::jthread&& worker, spsc::Sender<Input>&& tx, spsc::Receiver<Output>&& rx) :
+        Worker(osc::jthread&& worker, spsc::Sender<Input>&& tx, size_t maxBacklog, spsc::Receiver<Output>&& rx) :
             m_WorkerThread{std::move(worker)},
             m_Tx{std::move(tx)},
+            m_MaxBacklog{maxBacklog},
             m_Rx{std::move(rx)}
         {
         }
 
     public:
 
-        // create a new worker
-        static Worker create(Func f)
+        // create a new worker that holds up to `maxBacklog` inputs (on top of the ones in the
+        // input channel) while the worker is busy
+        static Worker create(Func f, size_t maxBacklog = c_DefaultChannelCapacity)
         {
             auto [reqTransmit, reqReceive] = spsc::channel<Input>();
             auto [respTransmit, respReceive] = spsc::channel<Output>();
             osc::jthread worker{Worker::main, std::move(reqReceive), std::move(respTransmit), std::move(f)};
-            return Worker{std::move(worker), std::move(reqTransmit), std::move(respReceive)};
+            return Worker{std::move(worker), std::move(reqTransmit), maxBacklog, std::move(respReceive)};
         }
 
-        void send(Input req)
+        // returns `false` (and drops the input) if both the input channel and the backlog are full
+        bool send(Input req)
         {
-            m_Tx.send(std::move(req));
+            flushBacklog();
+            if (m_Backlog.size() >= m_MaxBacklog)
+            {
+                ++m_NumDroppedInputs;
+                return false;
+            }
+            m_Backlog.push_back(std::move(req));
+            flushBacklog();
+            return true;
         }
 
         std::optional<Output> poll()
         {
-            return m_Rx.tryReceive();
+            std::optional<Output> rv = m_Rx.tryReceive();
+            flushBacklog();
+            return rv;
+        }
+
+        // returns how many inputs were dropped by `send`, because the worker wasn't keeping up
+        [[nodiscard]] size_t getNumDroppedInputs() const noexcept
+        {
+            return m_NumDroppedInputs;
+        }
+
+    private:
+        void flushBacklog()
+        {
+            while (!m_Backlog.empty() && m_Tx.trySend(m_Backlog.front()))
+            {
+                m_Backlog.pop_front();
+            }
         }
     };
 }
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "oscar/Utils/Assertions.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace osc
+{
+    // a bounded, lock-free, single-producer single-consumer (sp-sc) ring buffer
+    //
+    // - exactly one thread may call the producer methods (`tryPush`, `tryEmplace`)
+    // - exactly one (other) thread may call the consumer methods (`tryPop`, `popAll`)
+    // - the capacity is rounded up to the next power of two
+    //
+    // the producer's and consumer's indices are kept on separate cache lines (and each
+    // side caches the other side's index) so that, in the common case, pushing/popping
+    // doesn't bounce cache lines between the two threads
+    template<typename T>
+    class SpscRingBuffer final {
+    public:
+        explicit SpscRingBuffer(size_t minCapacity) :
+            m_Capacity{RoundUpToPowerOfTwo(minCapacity)},
+            m_Mask{m_Capacity - 1},
+            m_Slots{std::make_unique<Slot[]>(m_Capacity)}
+        {
+        }
+        SpscRingBuffer(SpscRingBuffer const&) = delete;
+        SpscRingBuffer(SpscRingBuffer&&) noexcept = delete;
+        SpscRingBuffer& operator=(SpscRingBuffer const&) = delete;
+        SpscRingBuffer& operator=(SpscRingBuffer&&) noexcept = delete;
+        ~SpscRingBuffer() noexcept
+        {
+            for (size_t i = m_Tail.load(std::memory_order_relaxed), end = m_Head.load(std::memory_order_relaxed); i != end; ++i)
+            {
+                std::launder(reinterpret_cast<T*>(&m_Slots[i & m_Mask]))->~T();
+            }
+        }
+
+        size_t capacity() const noexcept
+        {
+            return m_Capacity;
+        }
+
+        // approximate, because the other thread may be concurrently pushing/popping
+        size_t sizeApprox() const noexcept
+        {
+            size_t const tail = m_Tail.load(std::memory_order_acquire);
+            size_t const head = m_Head.load(std::memory_order_acquire);
+            return head - tail;
+        }
+
+        bool emptyApprox() const noexcept
+        {
+            return sizeApprox() == 0;
+        }
+
+        // producer: returns `false` (and leaves `v` untouched) if the buffer is full
+        bool tryPush(T&& v)
+        {
+            return tryEmplace(std::move(v));
+        }
+
+        // producer: returns `false` (and constructs nothing) if the buffer is full
+        template<typename... Args>
+        bool tryEmplace(Args&&... args)
+        {
+            size_t const head = m_Head.load(std::memory_order_relaxed);
+            if (head - m_CachedTail == m_Capacity)
+            {
+                m_CachedTail = m_Tail.load(std::memory_order_acquire);
+                if (head - m_CachedTail == m_Capacity)
+                {
+                    return false;  // full
+                }
+            }
+
+            new (&m_Slots[head & m_Mask]) T(std::forward<Args>(args)...);
+            m_Head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // consumer: returns `std::nullopt` if the buffer is empty
+        std::optional<T> tryPop()
+        {
+            size_t const tail = m_Tail.load(std::memory_order_relaxed);
+            if (tail == m_CachedHead)
+            {
+                m_CachedHead = m_Head.load(std::memory_order_acquire);
+                if (tail == m_CachedHead)
+                {
+                    return std::nullopt;  // empty
+                }
+            }
+
+            T* const el = std::launder(reinterpret_cast<T*>(&m_Slots[tail & m_Mask]));
+            std::optional<T> rv{std::move(*el)};
+            el->~T();
+            m_Tail.store(tail + 1, std::memory_order_release);
+            return rv;
+        }
+
+        // consumer: pops everything that's currently in the buffer into the output
+        // iterator and returns the number of elements popped
+        template<typename OutputIt>
+        size_t popAll(OutputIt out)
+        {
+            size_t const tail = m_Tail.load(std::memory_order_relaxed);
+            m_CachedHead = m_Head.load(std::memory_order_acquire);
+
+            for (size_t i = tail; i != m_CachedHead; ++i)
+            {
+                T* const el = std::launder(reinterpret_cast<T*>(&m_Slots[i & m_Mask]));
+                *out++ = std::move(*el);
+                el->~T();
+            }
+
+            // only publish the new tail once, so the producer sees all of the space at once
+            m_Tail.store(m_CachedHead, std::memory_order_release);
+            return m_CachedHead - tail;
+        }
+
+    private:
+        // the size of a cache line on the (typical) target hardware
+        //
+        // (`std::hardware_destructive_interference_size` isn't available in all of the
+        //  compilers that osc is built with)
+        static constexpr size_t c_CacheLineSize = 64;
+
+        using Slot = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+        static size_t RoundUpToPowerOfTwo(size_t v)
+        {
+            OSC_ASSERT(v > 0 && "an SPSC ring buffer must have a nonzero capacity");
+            size_t rv = 1;
+            while (rv < v)
+            {
+                rv <<= 1;
+            }
+            return rv;
+        }
+
+        // read-only after construction (shared by both threads)
+        size_t m_Capacity;
+        size_t m_Mask;
+        std::unique_ptr<Slot[]> m_Slots;
+
+        // producer-owned (the consumer only reads `m_Head`)
+        char m_Padding0[c_CacheLineSize];
+        std::atomic<size_t> m_Head{0};
+        size_t m_CachedTail = 0;
+
+        // consumer-owned (the producer only reads `m_Tail`)
+        char m_Padding1[c_CacheLineSize];
+        std::atomic<size_t> m_Tail{0};
+        size_t m_CachedHead = 0;
+        char m_Padding2[c_CacheLineSize];
+    };
+}
@@ -16,6 +16,13 @@ namespace osc
         {
         }
 
+        // adopts a mutex that the caller has already locked
+        SynchronizedValueGuard(std::mutex& mutex, std::adopt_lock_t, T& _ref) :
+            m_Guard{mutex, std::adopt_lock},
+            m_Ptr{&_ref}
+        {
+        }
+
         T& operator*() & noexcept { return *m_Ptr; }
         T const& operator*() const & noexcept { return *m_Ptr; }
         T* operator->() noexcept { return m_Ptr; }
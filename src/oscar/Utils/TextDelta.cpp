@@ -0,0 +1,176 @@
+#include "TextDelta.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // runs of matching lines that are shorter than this are inserted, rather than copied,
+    // because a copy edit would use more memory than the text it copies
+    constexpr size_t c_MinCopyLength = 2*sizeof(size_t) + 16;
+
+    // maximum number of (same-content) base lines that are tried when looking for the longest
+    // run of lines that matches the target (e.g. XML documents repeat many lines)
+    constexpr size_t c_MaxCandidateLines = 16;
+
+    struct Line final {
+        size_t offset;
+        std::string_view text;  // including the trailing newline (if any)
+    };
+
+    std::vector<Line> SplitLines(std::string_view text, size_t offsetOfText)
+    {
+        std::vector<Line> rv;
+        size_t pos = 0;
+        while (pos < text.size())
+        {
+            size_t const newline = text.find('\n', pos);
+            size_t const end = newline == std::string_view::npos ? text.size() : newline + 1;
+            rv.push_back(Line{offsetOfText + pos, text.substr(pos, end - pos)});
+            pos = end;
+        }
+        return rv;
+    }
+
+    size_t CommonPrefixLength(std::string_view a, std::string_view b)
+    {
+        return static_cast<size_t>(std::mismatch(a.begin(), a.begin() + std::min(a.size(), b.size()), b.begin()).first - a.begin());
+    }
+
+    size_t CommonSuffixLength(std::string_view a, std::string_view b)
+    {
+        return static_cast<size_t>(std::mismatch(a.rbegin(), a.rbegin() + std::min(a.size(), b.size()), b.rbegin()).first - a.rbegin());
+    }
+}
+
+osc::TextDelta::TextDelta(std::string_view base, std::string_view target) :
+    m_BaseLength{base.size()},
+    m_TargetLength{target.size()}
+{
+    // most deltas are between similar texts (e.g. where one part of a document was edited), so
+    // handle the common prefix/suffix up-front
+    size_t const prefixLength = CommonPrefixLength(base, target);
+    size_t const suffixLength = CommonSuffixLength(base.substr(prefixLength), target.substr(prefixLength));
+    std::string_view const baseMiddle = base.substr(prefixLength, base.size() - prefixLength - suffixLength);
+    std::string_view const targetMiddle = target.substr(prefixLength, target.size() - prefixLength - suffixLength);
+
+    if (prefixLength > 0)
+    {
+        pushCopy(0, prefixLength);
+    }
+
+    // then encode the (differing) middle line-by-line, by copying the longest runs of base
+    // lines that match the target and inserting everything else
+    std::vector<Line> const baseLines = SplitLines(baseMiddle, prefixLength);
+    std::vector<Line> const targetLines = SplitLines(targetMiddle, prefixLength);
+
+    std::unordered_map<std::string_view, std::vector<size_t>> baseLineLookup;
+    for (size_t i = 0; i < baseLines.size(); ++i)
+    {
+        std::vector<size_t>& indices = baseLineLookup[baseLines[i].text];
+        if (indices.size() < c_MaxCandidateLines)
+        {
+            indices.push_back(i);
+        }
+    }
+
+    for (size_t i = 0; i < targetLines.size();)
+    {
+        size_t bestNumLines = 0;
+        size_t bestLength = 0;
+        size_t bestBaseLine = 0;
+        if (auto const it = baseLineLookup.find(targetLines[i].text); it != baseLineLookup.end())
+        {
+            for (size_t const baseLine : it->second)
+            {
+                size_t numLines = 0;
+                size_t length = 0;
+                while (i + numLines < targetLines.size() &&
+                    baseLine + numLines < baseLines.size() &&
+                    targetLines[i + numLines].text == baseLines[baseLine + numLines].text)
+                {
+                    length += targetLines[i + numLines].text.size();
+                    ++numLines;
+                }
+
+                if (length > bestLength)
+                {
+                    bestNumLines = numLines;
+                    bestLength = length;
+                    bestBaseLine = baseLine;
+                }
+            }
+        }
+
+        if (bestLength >= c_MinCopyLength)
+        {
+            pushCopy(baseLines[bestBaseLine].offset, bestLength);
+            i += bestNumLines;
+        }
+        else
+        {
+            pushInsertion(targetLines[i].text);
+            ++i;
+        }
+    }
+
+    if (suffixLength > 0)
+    {
+        pushCopy(base.size() - suffixLength, suffixLength);
+    }
+
+    m_Edits.shrink_to_fit();
+    m_InsertedText.shrink_to_fit();
+}
+
+std::string osc::TextDelta::apply(std::string_view base) const
+{
+    if (base.size() != m_BaseLength)
+    {
+        throw std::runtime_error{"text delta: the given base text has a different length from the one that the delta was computed against"};
+    }
+
+    std::string rv;
+    rv.reserve(m_TargetLength);
+    for (Edit const& edit : m_Edits)
+    {
+        std::string_view const source = edit.isCopy ? base : std::string_view{m_InsertedText};
+        rv.append(source.substr(edit.offset, edit.length));
+    }
+    return rv;
+}
+
+size_t osc::TextDelta::getNumBytesUsed() const
+{
+    return sizeof(*this) + m_Edits.capacity()*sizeof(Edit) + m_InsertedText.capacity();
+}
+
+void osc::TextDelta::pushCopy(size_t baseOffset, size_t length)
+{
+    if (!m_Edits.empty() && m_Edits.back().isCopy && m_Edits.back().offset + m_Edits.back().length == baseOffset)
+    {
+        m_Edits.back().length += length;  // extend the previous copy
+    }
+    else
+    {
+        m_Edits.push_back(Edit{true, baseOffset, length});
+    }
+}
+
+void osc::TextDelta::pushInsertion(std::string_view text)
+{
+    if (!m_Edits.empty() && !m_Edits.back().isCopy)
+    {
+        m_Edits.back().length += text.size();  // extend the previous insertion
+    }
+    else
+    {
+        m_Edits.push_back(Edit{false, m_InsertedText.size(), text.size()});
+    }
+    m_InsertedText += text;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace osc
+{
+    // a compact encoding of a (target) text as a sequence of edits to another (base) text
+    //
+    // the edits are line-based: each one either copies a run of the base's lines or inserts
+    // new text. This makes it cheap to store many similar versions of a large text (e.g. a
+    // document's history) by only storing one version in full and the rest as deltas
+    class TextDelta final {
+    public:
+        // an empty delta that turns an empty base into an empty text
+        TextDelta() = default;
+
+        // computes a delta that turns `base` into `target`
+        TextDelta(std::string_view base, std::string_view target);
+
+        // returns the target text, given the base text that the delta was computed against
+        //
+        // throws if `base` can't be the base text that the delta was computed against
+        std::string apply(std::string_view base) const;
+
+        // returns the (approximate) number of bytes of memory that the delta uses
+        size_t getNumBytesUsed() const;
+
+    private:
+        struct Edit final {
+            bool isCopy;    // else, it's an insertion
+            size_t offset;  // into the base (copies) or `m_InsertedText` (insertions)
+            size_t length;
+        };
+
+        void pushCopy(size_t baseOffset, size_t length);
+        void pushInsertion(std::string_view);
+
+        size_t m_BaseLength = 0;
+        size_t m_TargetLength = 0;
+        std::vector<Edit> m_Edits;
+        std::string m_InsertedText;
+    };
+}
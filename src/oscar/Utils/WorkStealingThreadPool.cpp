@@ -0,0 +1,262 @@
+#include "WorkStealingThreadPool.hpp"
+
+#include "oscar/Platform/Log.hpp"
+#include "oscar/Utils/Assertions.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // a worker's task queue
+    //
+    // the owning worker pushes/pops at the back (LIFO: better cache locality for
+    // subtasks), thieves steal from the front (FIFO: steals the oldest, and usually
+    // largest, task)
+    class TaskQueue final {
+    public:
+        void pushBack(std::function<void()> task)
+        {
+            std::lock_guard lock{m_Mutex};
+            m_Tasks.push_back(std::move(task));
+        }
+
+        std::optional<std::function<void()>> tryPopBack()
+        {
+            std::lock_guard lock{m_Mutex};
+            if (m_Tasks.empty())
+            {
+                return std::nullopt;
+            }
+            std::function<void()> rv = std::move(m_Tasks.back());
+            m_Tasks.pop_back();
+            return rv;
+        }
+
+        std::optional<std::function<void()>> trySteal()
+        {
+            std::lock_guard lock{m_Mutex};
+            if (m_Tasks.empty())
+            {
+                return std::nullopt;
+            }
+            std::function<void()> rv = std::move(m_Tasks.front());
+            m_Tasks.pop_front();
+            return rv;
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::deque<std::function<void()>> m_Tasks;
+    };
+}
+
+class osc::WorkStealingThreadPool::Impl final {
+public:
+    explicit Impl(size_t numThreads)
+    {
+        OSC_ASSERT(numThreads > 0 && "a thread pool must have at least one thread");
+
+        m_Queues.reserve(numThreads);
+        for (size_t i = 0; i < numThreads; ++i)
+        {
+            m_Queues.push_back(std::make_unique<TaskQueue>());
+        }
+
+        m_Workers.reserve(numThreads);
+        for (size_t i = 0; i < numThreads; ++i)
+        {
+            m_Workers.emplace_back([this, i]() { workerMain(i); });
+        }
+    }
+    Impl(Impl const&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(Impl const&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept
+    {
+        waitUntilIdle();
+        {
+            std::lock_guard lock{m_WakeMutex};
+            m_IsShuttingDown = true;
+        }
+        m_WakeCondition.notify_all();
+        for (std::thread& worker : m_Workers)
+        {
+            worker.join();
+        }
+    }
+
+    size_t getNumThreads() const
+    {
+        return m_Workers.size();
+    }
+
+    void submit(std::function<void()> task)
+    {
+        // tasks submitted from a worker in this pool go onto that worker's queue
+        size_t const queueIndex = t_CurrentPool == this ?
+            t_CurrentWorkerIndex :
+            m_NextQueue.fetch_add(1, std::memory_order_relaxed) % m_Queues.size();
+
+        // count the task before publishing it, so that a worker that dequeues it straight
+        // away can't decrement the counts below zero
+        m_NumUnfinishedTasks.fetch_add(1, std::memory_order_relaxed);
+        m_NumQueuedTasks.fetch_add(1, std::memory_order_seq_cst);
+        m_Queues[queueIndex]->pushBack(std::move(task));
+
+        // only take the wake mutex if a worker is (about to be) asleep
+        //
+        // (a worker increments the sleeper count before checking the queued count, and this
+        //  increments the queued count before checking the sleeper count, so at least one side
+        //  sees the other's increment)
+        if (m_NumSleepingWorkers.load(std::memory_order_seq_cst) > 0)
+        {
+            {
+                std::lock_guard lock{m_WakeMutex};
+            }
+            m_WakeCondition.notify_one();
+        }
+    }
+
+    void waitUntilIdle()
+    {
+        OSC_ASSERT(t_CurrentPool != this && "waiting for a pool to be idle from one of its own workers would deadlock");
+
+        std::unique_lock lock{m_IdleMutex};
+        m_IdleCondition.wait(lock, [this]() { return m_NumUnfinishedTasks.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    void workerMain(size_t workerIndex)
+    {
+        t_CurrentPool = this;
+        t_CurrentWorkerIndex = workerIndex;
+
+        while (true)
+        {
+            if (std::optional<std::function<void()>> task = tryDequeue(workerIndex))
+            {
+                run(*task);
+                continue;
+            }
+
+            std::unique_lock lock{m_WakeMutex};
+            m_NumSleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+            m_WakeCondition.wait(lock, [this]() { return m_NumQueuedTasks.load(std::memory_order_seq_cst) > 0 || m_IsShuttingDown; });
+            m_NumSleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+            if (m_NumQueuedTasks.load(std::memory_order_relaxed) == 0 && m_IsShuttingDown)
+            {
+                return;
+            }
+        }
+    }
+
+    std::optional<std::function<void()>> tryDequeue(size_t workerIndex)
+    {
+        // try own queue first
+        std::optional<std::function<void()>> rv = m_Queues[workerIndex]->tryPopBack();
+
+        // then try to steal from the other workers, starting with the next one along
+        // (so that thieves don't all contend on the same victim)
+        for (size_t i = 1; !rv && i < m_Queues.size(); ++i)
+        {
+            rv = m_Queues[(workerIndex + i) % m_Queues.size()]->trySteal();
+        }
+
+        if (rv)
+        {
+            m_NumQueuedTasks.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return rv;
+    }
+
+    void run(std::function<void()>& task)
+    {
+        try
+        {
+            task();
+        }
+        catch (std::exception const& ex)
+        {
+            log::error("a task in a thread pool threw an exception: %s", ex.what());
+        }
+        catch (...)
+        {
+            log::error("a task in a thread pool threw an exception with an unknown type");
+        }
+        task = nullptr;  // destroy captured state before marking the task as finished
+
+        if (m_NumUnfinishedTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            // lock (+ unlock) the idle mutex, so that a waiter that saw a non-zero count
+            // must already be waiting when it's notified
+            {
+                std::lock_guard lock{m_IdleMutex};
+            }
+            m_IdleCondition.notify_all();
+        }
+    }
+
+    static inline thread_local Impl const* t_CurrentPool = nullptr;
+    static inline thread_local size_t t_CurrentWorkerIndex = 0;
+
+    std::vector<std::unique_ptr<TaskQueue>> m_Queues;
+    std::atomic<size_t> m_NextQueue = 0;
+
+    // only used on the sleep/wake path: submitting + dequeueing tasks only touches the atomics
+    std::mutex m_WakeMutex;
+    std::condition_variable m_WakeCondition;
+    std::atomic<size_t> m_NumQueuedTasks = 0;
+    std::atomic<size_t> m_NumSleepingWorkers = 0;
+    bool m_IsShuttingDown = false;  // guarded by `m_WakeMutex`
+
+    std::mutex m_IdleMutex;
+    std::condition_variable m_IdleCondition;
+    std::atomic<size_t> m_NumUnfinishedTasks = 0;
+
+    // last, so that workers are spawned after everything else is initialized
+    std::vector<std::thread> m_Workers;
+};
+
+
+// public API (PIMPL)
+
+size_t osc::GetDefaultNumWorkerThreads()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+osc::WorkStealingThreadPool::WorkStealingThreadPool(size_t numThreads) :
+    m_Impl{std::make_unique<Impl>(numThreads)}
+{
+}
+osc::WorkStealingThreadPool::WorkStealingThreadPool(WorkStealingThreadPool&&) noexcept = default;
+osc::WorkStealingThreadPool& osc::WorkStealingThreadPool::operator=(WorkStealingThreadPool&&) noexcept = default;
+osc::WorkStealingThreadPool::~WorkStealingThreadPool() noexcept = default;
+
+size_t osc::WorkStealingThreadPool::getNumThreads() const
+{
+    return m_Impl->getNumThreads();
+}
+
+void osc::WorkStealingThreadPool::submit(std::function<void()> task)
+{
+    m_Impl->submit(std::move(task));
+}
+
+void osc::WorkStealingThreadPool::waitUntilIdle()
+{
+    m_Impl->waitUntilIdle();
+}
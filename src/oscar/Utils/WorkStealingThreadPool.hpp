@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace osc
+{
+    // returns the number of worker threads that a pool should use by default (i.e. one
+    // per hardware thread, with a minimum of one)
+    size_t GetDefaultNumWorkerThreads();
+
+    // a fixed-size pool of worker threads that execute submitted tasks
+    //
+    // each worker owns a task queue. Workers pop tasks from the back of their own queue
+    // and, when it's empty, steal tasks from the front of other workers' queues, so that
+    // long-running tasks (e.g. simulations) don't leave other workers idle. Tasks that
+    // are submitted from inside a worker (e.g. subtasks) are pushed onto that worker's
+    // queue, tasks submitted from other threads are distributed round-robin
+    //
+    // destroying the pool waits for all submitted tasks to finish
+    class WorkStealingThreadPool final {
+    public:
+        explicit WorkStealingThreadPool(size_t numThreads = GetDefaultNumWorkerThreads());
+        WorkStealingThreadPool(WorkStealingThreadPool const&) = delete;
+        WorkStealingThreadPool(WorkStealingThreadPool&&) noexcept;
+        WorkStealingThreadPool& operator=(WorkStealingThreadPool const&) = delete;
+        WorkStealingThreadPool& operator=(WorkStealingThreadPool&&) noexcept;
+        ~WorkStealingThreadPool() noexcept;
+
+        size_t getNumThreads() const;
+
+        // enqueues the task for execution on a worker thread
+        //
+        // exceptions thrown by the task are caught and logged by the worker
+        void submit(std::function<void()>);
+
+        // blocks until all submitted tasks have finished executing
+        void waitUntilIdle();
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
@@ -0,0 +1,97 @@
+#include "OpenSimCreator/Graphics/CachedModelRenderer.hpp"
+
+#include "OpenSimCreator/ActionFunctions.hpp"
+#include "OpenSimCreator/Graphics/ModelRendererParams.hpp"
+#include "OpenSimCreator/UndoableModelStatePair.hpp"
+
+#include <oscar/Graphics/MeshCache.hpp>
+#include <oscar/Graphics/SceneDecoration.hpp>
+#include <oscar/Graphics/ShaderCache.hpp>
+#include <oscar/Platform/App.hpp>
+#include <oscar/Utils/UID.hpp>
+
+#include <gtest/gtest.h>
+#include <nonstd/span.hpp>
+#include <OpenSim/Simulation/Model/Geometry.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/Body.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
+#include <SimTKcommon.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+static std::unique_ptr<osc::App> g_App;
+
+class CachedModelRendererTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite()
+    {
+        g_App = std::make_unique<osc::App>();
+    }
+
+    static void TearDownTestSuite()
+    {
+        g_App.reset();
+    }
+
+    // returns a two-body pendulum that only uses analytic geometry, so that decoration
+    // generation doesn't depend on (asynchronously-loaded) mesh files
+    static std::unique_ptr<OpenSim::Model> CreatePendulumModel()
+    {
+        auto model = std::make_unique<OpenSim::Model>();
+
+        auto* upper = new OpenSim::Body{"upper", 1.0, SimTK::Vec3{0.0}, SimTK::Inertia{1.0}};
+        upper->attachGeometry(new OpenSim::Brick{SimTK::Vec3{0.1, 0.5, 0.1}});
+        model->addBody(upper);
+        model->addJoint(new OpenSim::PinJoint{"shoulder", model->getGround(), SimTK::Vec3{0.0}, SimTK::Vec3{0.0}, *upper, SimTK::Vec3{0.0, 0.5, 0.0}, SimTK::Vec3{0.0}});
+
+        auto* lower = new OpenSim::Body{"lower", 1.0, SimTK::Vec3{0.0}, SimTK::Inertia{1.0}};
+        lower->attachGeometry(new OpenSim::Sphere{0.1});
+        model->addBody(lower);
+        model->addJoint(new OpenSim::PinJoint{"elbow", *upper, SimTK::Vec3{0.0, -0.5, 0.0}, SimTK::Vec3{0.0}, *lower, SimTK::Vec3{0.0, 0.5, 0.0}, SimTK::Vec3{0.0}});
+
+        return model;
+    }
+
+    std::shared_ptr<osc::MeshCache> m_MeshCache = std::make_shared<osc::MeshCache>(std::nullopt);
+    osc::ShaderCache m_ShaderCache;
+    osc::ModelRendererParams m_Params;
+};
+
+TEST_F(CachedModelRendererTest, RegeneratingAfterACoordinateEditProducesTheSameDecorationsAsAFullRegeneration)
+{
+    osc::UndoableModelStatePair model{CreatePendulumModel()};
+
+    // generate the decorations for the initial state
+    osc::CachedModelRenderer incremental{osc::App::config(), m_MeshCache, m_ShaderCache};
+    incremental.autoFocusCamera(model, m_Params, 1.0f);
+    ASSERT_FALSE(incremental.getDrawlist().empty());
+
+    // edit a coordinate, which should only change the state (so that the renderer can
+    // regenerate only the decorations that moved)
+    OpenSim::Coordinate const& shoulder = model.getModel().getComponent<OpenSim::Coordinate>("/jointset/shoulder/shoulder_coord_0");
+    osc::UID const modelVersionBeforeEdit = model.getModelVersion();
+    osc::UID const stateVersionBeforeEdit = model.getStateVersion();
+    ASSERT_TRUE(osc::ActionSetCoordinateValue(model, shoulder, 0.5));
+    ASSERT_EQ(model.getModelVersion(), modelVersionBeforeEdit);
+    ASSERT_NE(model.getStateVersion(), stateVersionBeforeEdit);
+
+    incremental.autoFocusCamera(model, m_Params, 1.0f);
+
+    // generate the decorations for the edited state from scratch
+    osc::CachedModelRenderer full{osc::App::config(), m_MeshCache, m_ShaderCache};
+    full.autoFocusCamera(model, m_Params, 1.0f);
+
+    nonstd::span<osc::SceneDecoration const> const lhs = incremental.getDrawlist();
+    nonstd::span<osc::SceneDecoration const> const rhs = full.getDrawlist();
+    ASSERT_EQ(lhs.size(), rhs.size());
+    for (size_t i = 0; i < lhs.size(); ++i)
+    {
+        ASSERT_TRUE(lhs[i] == rhs[i]) << "decoration " << i << " (" << lhs[i].id << ") differs";
+    }
+    ASSERT_TRUE(incremental.getRootAABB() == full.getRootAABB());
+}
@@ -11,9 +11,13 @@
 #include <oscar/Platform/Log.hpp>
 
 #include <gtest/gtest.h>
+#include <OpenSim/Actuators/RegisterTypes_osimActuators.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <filesystem>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -32,7 +36,7 @@ TEST(OpenSimDecorationGenerator, GenerateDecorationsWithOpenSimMuscleColoringGen
     osc::CustomDecorationOptions opts;
     opts.setMuscleColoringStyle(osc::MuscleColoringStyle::OpenSimAppearanceProperty);
 
-    osc::MeshCache meshCache;
+    osc::MeshCache meshCache{std::nullopt};
     bool passedTest = false;
     osc::GenerateModelDecorations(
         meshCache,
@@ -54,3 +58,96 @@ TEST(OpenSimDecorationGenerator, GenerateDecorationsWithOpenSimMuscleColoringGen
     );
     ASSERT_TRUE(passedTest);
 }
+
+TEST(OpenSimDecorationGenerator, GenerateDecorationsOnlyEmitsDecorationsForComponentsThatShouldBeGenerated)
+{
+    std::filesystem::path const tugOfWarPath = std::filesystem::path{OSC_TESTING_SOURCE_DIR} / "resources" / "models" / "Tug_of_War" / "Tug_of_War.osim";
+    OpenSim::Model model{tugOfWarPath.string()};
+    model.buildSystem();
+    SimTK::State& state = model.initializeState();
+
+    osc::CustomDecorationOptions const opts;
+    osc::MeshCache meshCache{std::nullopt};
+
+    // generate everything, keeping track of which component was being generated for each decoration
+    std::vector<OpenSim::Component const*> visited;
+    std::vector<OpenSim::Component const*> allGenerators;
+    osc::GenerateModelDecorations(
+        meshCache,
+        model,
+        state,
+        opts,
+        1.0f,
+        [&visited, &allGenerators](OpenSim::Component const&, osc::SceneDecoration&&)
+        {
+            allGenerators.push_back(visited.back());
+        },
+        [&visited](OpenSim::Component const& c)
+        {
+            visited.push_back(&c);
+            return true;
+        }
+    );
+    ASSERT_FALSE(allGenerators.empty());
+
+    // then only generate decorations for the first component that emitted any
+    OpenSim::Component const* const first = allGenerators.front();
+    size_t numEmitted = 0;
+    osc::GenerateModelDecorations(
+        meshCache,
+        model,
+        state,
+        opts,
+        1.0f,
+        [&numEmitted](OpenSim::Component const&, osc::SceneDecoration&&)
+        {
+            ++numEmitted;
+        },
+        [first](OpenSim::Component const& c)
+        {
+            return &c == first;
+        }
+    );
+    ASSERT_EQ(numEmitted, static_cast<size_t>(std::count(allGenerators.begin(), allGenerators.end(), first)));
+}
+
+TEST(OpenSimDecorationGenerator, ParallelGenerationEmitsTheSameDecorationsAsSerialGeneration)
+{
+    RegisterTypes_osimActuators();
+    std::filesystem::path const rajagopalPath = std::filesystem::path{OSC_TESTING_SOURCE_DIR} / "resources" / "models" / "RajagopalModel" / "Rajagopal2015.osim";
+    OpenSim::Model model{rajagopalPath.string()};
+    osc::InitializeModel(model);
+    SimTK::State const& state = osc::InitializeState(model);
+
+    osc::CustomDecorationOptions const opts;
+    osc::MeshCache meshCache{std::nullopt};
+
+    auto const generate = [&](osc::DecorationGenerationStrategy strategy)
+    {
+        std::vector<std::pair<OpenSim::Component const*, osc::SceneDecoration>> rv;
+        osc::GenerateModelDecorations(
+            meshCache,
+            model,
+            state,
+            opts,
+            1.0f,
+            [&rv](OpenSim::Component const& c, osc::SceneDecoration&& dec)
+            {
+                rv.emplace_back(&c, std::move(dec));
+            },
+            strategy
+        );
+        return rv;
+    };
+
+    auto const serial = generate(osc::DecorationGenerationStrategy::Serial);
+    auto const parallel = generate(osc::DecorationGenerationStrategy::Parallel);
+
+    ASSERT_FALSE(serial.empty());
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i)
+    {
+        ASSERT_EQ(serial[i].first, parallel[i].first);
+        ASSERT_EQ(serial[i].second, parallel[i].second);
+    }
+}
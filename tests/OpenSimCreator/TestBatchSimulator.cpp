@@ -0,0 +1,105 @@
+#include "OpenSimCreator/BatchSimulator.hpp"
+
+#include "OpenSimCreator/BasicModelStatePair.hpp"
+#include "OpenSimCreator/ForwardDynamicSimulatorParams.hpp"
+#include "OpenSimCreator/IntegratorMethod.hpp"
+#include "OpenSimCreator/SimulationClock.hpp"
+#include "OpenSimCreator/SimulationStatus.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+
+namespace
+{
+    osc::ForwardDynamicSimulatorParams ShortSimulationParams()
+    {
+        osc::ForwardDynamicSimulatorParams params;
+        params.finalTime = osc::SimulationClock::start() + osc::SimulationClock::duration{0.05};
+        return params;
+    }
+}
+
+TEST(BatchSimulator, GenerateIntegratorSweepJobsReturnsOneJobPerIntegrator)
+{
+    auto const jobs = osc::GenerateIntegratorSweepJobs(osc::BasicModelStatePair{}, ShortSimulationParams());
+    ASSERT_EQ(jobs.size(), osc::GetAllIntegratorMethods().size());
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        ASSERT_EQ(jobs[i].params.integratorMethodUsed, osc::GetAllIntegratorMethods()[i]);
+    }
+}
+
+TEST(BatchSimulator, GenerateAccuracySweepJobsReturnsOneJobPerAccuracy)
+{
+    std::array<double, 3> const accuracies = {1e-3, 1e-4, 1e-5};
+    auto const jobs = osc::GenerateAccuracySweepJobs(osc::BasicModelStatePair{}, ShortSimulationParams(), accuracies);
+    ASSERT_EQ(jobs.size(), accuracies.size());
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        ASSERT_EQ(jobs[i].params.integratorAccuracy, accuracies[i]);
+    }
+}
+
+TEST(BatchSimulator, RunsAllJobsToCompletion)
+{
+    osc::BatchSimulatorParams params;
+    params.numThreads = 2;
+
+    osc::BatchSimulator batch{osc::GenerateIntegratorSweepJobs(osc::BasicModelStatePair{}, ShortSimulationParams()), params};
+    batch.wait();
+
+    ASSERT_TRUE(batch.isFinished());
+    for (size_t i = 0; i < batch.getNumJobs(); ++i)
+    {
+        osc::BatchSimulationJobProgress const progress = batch.getJobProgress(i);
+        ASSERT_EQ(progress.status, osc::SimulationStatus::Completed) << batch.getJobName(i);
+        ASSERT_EQ(progress.progress, 1.0f);
+        ASSERT_GT(progress.numReports, 0);
+        ASSERT_TRUE(progress.latestReport);
+    }
+}
+
+TEST(BatchSimulator, WritesOneOutputFilePerJobAndASummary)
+{
+    std::filesystem::path const outputDir = std::filesystem::temp_directory_path() / "osc_TestBatchSimulator";
+    std::filesystem::remove_all(outputDir);
+
+    osc::BatchSimulatorParams params;
+    params.outputDirectory = outputDir;
+    {
+        osc::BatchSimulator batch{osc::GenerateIntegratorSweepJobs(osc::BasicModelStatePair{}, ShortSimulationParams()), params};
+        batch.wait();
+    }
+
+    ASSERT_TRUE(std::filesystem::exists(outputDir / "summary.csv"));
+    size_t numFiles = 0;
+    for ([[maybe_unused]] auto const& entry : std::filesystem::directory_iterator{outputDir})
+    {
+        ++numFiles;
+    }
+    ASSERT_EQ(numFiles, osc::GetAllIntegratorMethods().size() + 1);
+
+    std::filesystem::remove_all(outputDir);
+}
+
+TEST(BatchSimulator, RequestStopCancelsUnfinishedJobs)
+{
+    osc::ForwardDynamicSimulatorParams simParams;
+    simParams.finalTime = osc::SimulationClock::start() + osc::SimulationClock::duration{1.0e6};  // effectively forever
+
+    osc::BatchSimulatorParams params;
+    params.numThreads = 1;
+
+    osc::BatchSimulator batch{osc::GenerateIntegratorSweepJobs(osc::BasicModelStatePair{}, simParams), params};
+    batch.requestStop();
+    batch.wait();
+
+    ASSERT_TRUE(batch.isFinished());
+    for (size_t i = 0; i < batch.getNumJobs(); ++i)
+    {
+        ASSERT_EQ(batch.getJobProgress(i).status, osc::SimulationStatus::Cancelled);
+    }
+}
@@ -37,3 +37,16 @@ TEST(ForwardDynamicSimulation, CanInitFromBasicModel)
     sim.setFixupScaleFactor(newSf);
     ASSERT_EQ(sim.getFixupScaleFactor(), newSf);
 }
+
+TEST(ForwardDynamicSimulation, GetPrecomputedOutputValuesReturnsNulloptForOutputsThatArentComputedOnTheSimulatorThread)
+{
+    osc::BasicModelStatePair modelState;
+
+    osc::ForwardDynamicSimulatorParams params;
+    params.finalTime = osc::SimulationClock::start();  // don't run a full sim
+
+    osc::ForwardDynamicSimulation sim{modelState, params};
+
+    ASSERT_FALSE(sim.getOutputExtractors().empty());
+    ASSERT_FALSE(sim.getPrecomputedOutputValues(sim.getOutputExtractors().front()));
+}
@@ -0,0 +1,122 @@
+#include "OpenSimCreator/ForwardDynamicSimulator.hpp"
+
+#include "OpenSimCreator/BasicModelStatePair.hpp"
+#include "OpenSimCreator/ComponentOutputExtractor.hpp"
+#include "OpenSimCreator/ForwardDynamicSimulatorParams.hpp"
+#include "OpenSimCreator/OutputExtractor.hpp"
+#include "OpenSimCreator/SimulationClock.hpp"
+#include "OpenSimCreator/SimulationReport.hpp"
+#include "OpenSimCreator/SimulationStatus.hpp"
+
+#include <oscar/Utils/Cpp20Shims.hpp>
+#include <oscar/Utils/UID.hpp>
+
+#include <gtest/gtest.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::vector<osc::SimulationReport> RunSimulation(
+        osc::BasicModelStatePair const& modelState,
+        osc::ForwardDynamicSimulatorParams const& params)
+    {
+        std::vector<osc::SimulationReport> rv;
+        osc::stop_source stopSource;
+        osc::SimulationStatus const status = osc::RunForwardDynamicSimulation(
+            modelState,
+            params,
+            [&rv](osc::SimulationReport r) { rv.push_back(std::move(r)); },
+            stopSource.get_token()
+        );
+        EXPECT_EQ(status, osc::SimulationStatus::Completed);
+        return rv;
+    }
+
+    osc::ForwardDynamicSimulatorParams ShortSimulationParams()
+    {
+        osc::ForwardDynamicSimulatorParams params;
+        params.finalTime = osc::SimulationClock::start() + osc::SimulationClock::duration{0.1};
+        params.reportingInterval = osc::SimulationClock::duration{0.01};
+        return params;
+    }
+}
+
+TEST(ForwardDynamicSimulator, RunForwardDynamicSimulationEmitsAReportPerReportingInterval)
+{
+    auto const reports = RunSimulation(osc::BasicModelStatePair{}, ShortSimulationParams());
+    ASSERT_EQ(reports.size(), 11);  // t = 0, 0.01, ..., 0.1
+    ASSERT_EQ(reports.front().getTime(), osc::SimulationClock::start());
+}
+
+TEST(ForwardDynamicSimulator, ReportingStrideSkipsReportingIntervals)
+{
+    osc::ForwardDynamicSimulatorParams params = ShortSimulationParams();
+    params.reportingStride = 5;
+
+    auto const reports = RunSimulation(osc::BasicModelStatePair{}, params);
+    ASSERT_EQ(reports.size(), 3);  // t = 0, 0.05, 0.1
+}
+
+TEST(ForwardDynamicSimulator, AdaptiveDecimationSkipsReportsForStaticModelsButKeepsFirstAndLast)
+{
+    osc::ForwardDynamicSimulatorParams params = ShortSimulationParams();
+    params.adaptiveDecimationThreshold = 1.0;  // the (empty) model never changes
+
+    auto const reports = RunSimulation(osc::BasicModelStatePair{}, params);
+    ASSERT_EQ(reports.size(), 2);
+    ASSERT_EQ(reports.back().getTime(), params.finalTime);
+}
+
+TEST(ForwardDynamicSimulator, AuxiliaryOutputWhitelistOnlyCapturesWhitelistedOutputs)
+{
+    osc::ForwardDynamicSimulatorParams params = ShortSimulationParams();
+    params.auxiliaryOutputWhitelist = std::vector<std::string>{"NumStepsTaken"};
+
+    auto const reports = RunSimulation(osc::BasicModelStatePair{}, params);
+    ASSERT_FALSE(reports.empty());
+    for (osc::SimulationReport const& report : reports)
+    {
+        ASSERT_EQ(report.getAuxiliaryValues().size(), 1);
+    }
+}
+
+TEST(ForwardDynamicSimulator, SimulatorThreadOutputsAreWrittenIntoReports)
+{
+    osc::BasicModelStatePair const modelState;
+    osc::UID const id;
+
+    osc::ForwardDynamicSimulatorParams params = ShortSimulationParams();
+    params.simulatorThreadOutputs.push_back(osc::SimulatorThreadOutput{
+        osc::OutputExtractor{osc::ComponentOutputExtractor{modelState.getModel().getOutput("kinetic_energy")}},
+        id,
+    });
+
+    auto const reports = RunSimulation(modelState, params);
+    ASSERT_FALSE(reports.empty());
+    for (osc::SimulationReport const& report : reports)
+    {
+        ASSERT_TRUE(report.getAuxiliaryValue(id));
+    }
+}
+
+TEST(ForwardDynamicSimulator, SimulatorThreadOutputsMatchExtractingTheOutputFromTheReport)
+{
+    osc::BasicModelStatePair const modelState;
+    osc::OutputExtractor const output{osc::ComponentOutputExtractor{modelState.getModel().getOutput("kinetic_energy")}};
+    osc::UID const id;
+
+    osc::ForwardDynamicSimulatorParams params = ShortSimulationParams();
+    params.simulatorThreadOutputs.push_back(osc::SimulatorThreadOutput{output, id});
+
+    auto const reports = RunSimulation(modelState, params);
+    ASSERT_FALSE(reports.empty());
+    for (osc::SimulationReport const& report : reports)
+    {
+        ASSERT_EQ(report.getAuxiliaryValue(id), output.getValueFloat(modelState.getModel(), report));
+    }
+}
@@ -0,0 +1,100 @@
+#include "OpenSimCreator/ModelStateCommit.hpp"
+
+#include "OpenSimCreator/BasicModelStatePair.hpp"
+#include "OpenSimCreator/OpenSimApp.hpp"
+#include "OpenSimCreator/OpenSimHelpers.hpp"
+#include "OpenSimCreator/VirtualConstModelStatePair.hpp"
+
+#include <oscar/Platform/Config.hpp>
+#include <oscar/Utils/UID.hpp>
+
+#include <gtest/gtest.h>
+#include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <SimTKcommon.h>
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    // a model+state pair with a model that cannot be initialized (one of its sockets can't be connected)
+    class UninitializableModelStatePair final : public osc::VirtualConstModelStatePair {
+    public:
+        UninitializableModelStatePair()
+        {
+            auto* frame = new OpenSim::PhysicalOffsetFrame{};
+            frame->setName("frame");
+            frame->updSocket("parent").setConnecteePath("/does_not_exist");
+            m_Model.addComponent(frame);
+        }
+
+    private:
+        OpenSim::Model const& implGetModel() const final
+        {
+            return m_Model;
+        }
+
+        SimTK::State const& implGetState() const final
+        {
+            return m_State;
+        }
+
+        OpenSim::Model m_Model;
+        SimTK::State m_State;
+    };
+}
+
+TEST(ModelStateCommit, CompactingAgainstASimilarCommitStoresAMuchSmallerDelta)
+{
+    auto config = osc::Config::load();
+    osc::GlobalInitOpenSim(*config);  // ensure muscles are available etc.
+
+    std::filesystem::path const modelPath = config->getResourceDir() / "models" / "RajagopalModel" / "Rajagopal2015.osim";
+    OpenSim::Model model{modelPath.string()};
+    osc::InitializeModel(model);
+    osc::InitializeState(model);
+    osc::ModelStateCommit const older{osc::BasicModelStatePair{model, model.getWorkingState()}, "loaded model"};
+
+    // edit two (distant) parts of the model's document (e.g. like an action that changes
+    // several coordinates at once)
+    std::vector<OpenSim::Coordinate*> coords;
+    for (OpenSim::Coordinate& c : model.updComponentList<OpenSim::Coordinate>())
+    {
+        coords.push_back(&c);
+    }
+    ASSERT_GE(coords.size(), 2);
+    OpenSim::ComponentPath const firstCoordPath = osc::GetAbsolutePath(*coords.front());
+    double const firstCoordOriginalValue = coords.front()->getDefaultValue();
+    ASSERT_NE(firstCoordOriginalValue, 0.123);
+    coords.front()->setDefaultValue(0.123);
+    coords.back()->setDefaultValue(0.456);
+    osc::InitializeModel(model);
+    osc::InitializeState(model);
+    osc::ModelStateCommit const newer{osc::BasicModelStatePair{model, model.getWorkingState()}, "edited coordinates", older.getID()};
+
+    newer.compact(nullptr, true);
+    older.compact(&newer, false);
+
+    // the delta only has to contain the edited lines, rather than the (large) document
+    ASSERT_GT(newer.getNumSerializedBytes(), 0);
+    ASSERT_LT(older.getNumSerializedBytes(), newer.getNumSerializedBytes()/50);
+
+    // and the older commit's model can be reconstructed from the delta
+    auto const reconstructed = older.getModel();
+    OpenSim::Coordinate const* const firstCoord = osc::FindComponent<OpenSim::Coordinate>(*reconstructed, firstCoordPath);
+    ASSERT_NE(firstCoord, nullptr);
+    ASSERT_EQ(firstCoord->getDefaultValue(), firstCoordOriginalValue);
+}
+
+TEST(ModelStateCommit, AsynchronousCommitThatCannotBeInitializedIsFlaggedAsFailed)
+{
+    osc::ModelStateCommit const working{osc::BasicModelStatePair{}, "working", osc::UID::empty(), osc::ModelStateCommitStrategy::Asynchronous};
+    ASSERT_FALSE(working.failedToInitialize());
+
+    osc::ModelStateCommit const broken{UninitializableModelStatePair{}, "broken", osc::UID::empty(), osc::ModelStateCommitStrategy::Asynchronous};
+    ASSERT_TRUE(broken.failedToInitialize());
+}
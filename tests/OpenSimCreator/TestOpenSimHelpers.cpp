@@ -1,3 +1,4 @@
+#include "OpenSimCreator/ComponentPathIndex.hpp"
 #include "OpenSimCreator/OpenSimApp.hpp"
 #include "OpenSimCreator/OpenSimHelpers.hpp"
 #include "OpenSimCreator/TypeRegistry.hpp"
@@ -5,10 +6,12 @@
 
 #include <oscar/Platform/Config.hpp>
 #include <oscar/Platform/Log.hpp>
+#include <oscar/Utils/UID.hpp>
 
 #include <gtest/gtest.h>
 #include <OpenSim/Common/Component.h>
 #include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/SimbodyEngine/Body.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/Model/JointSet.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -179,3 +182,41 @@ TEST(OpenSimHelpers, CanTryToDeleteEveryComponentFromComplicatedModelWithNoFault
         }
     }
 }
+
+TEST(OpenSimHelpers, FindComponentWithIndexReturnsSameResultAsWithoutIndexForComplexModel)
+{
+    auto config = osc::Config::load();
+    std::filesystem::path modelPath = config->getResourceDir() / "models" / "RajagopalModel" / "Rajagopal2015.osim";
+
+    OpenSim::Model m{modelPath.string()};
+    osc::InitializeModel(m);
+
+    osc::ComponentPathIndex index;
+    osc::UID const version;
+    for (OpenSim::Component const& c : m.getComponentList())
+    {
+        OpenSim::ComponentPath const p = c.getAbsolutePath();
+        ASSERT_EQ(osc::FindComponent(index, m, version, p), osc::FindComponent(m, p));
+        ASSERT_EQ(osc::FindComponent(index, m, version, p), &c);
+    }
+
+    ASSERT_EQ(osc::FindComponent(index, m, version, OpenSim::ComponentPath{"/"}), &m);
+    ASSERT_EQ(osc::FindComponent(index, m, version, OpenSim::ComponentPath{}), nullptr);
+    ASSERT_EQ(osc::FindComponent(index, m, version, OpenSim::ComponentPath{"/does/not/exist"}), nullptr);
+}
+
+TEST(OpenSimHelpers, FindComponentWithIndexRebuildsIndexWhenVersionChanges)
+{
+    OpenSim::Model m;
+    osc::InitializeModel(m);
+
+    osc::ComponentPathIndex index;
+    ASSERT_EQ(osc::FindComponent(index, m, osc::UID{}, OpenSim::ComponentPath{"/bodyset/newbody"}), nullptr);
+
+    auto body = std::make_unique<OpenSim::Body>("newbody", 1.0, SimTK::Vec3{}, SimTK::Inertia{1.0});
+    OpenSim::Body const* const bodyPtr = body.get();
+    m.addBody(body.release());
+    osc::InitializeModel(m);
+
+    ASSERT_EQ(osc::FindComponent(index, m, osc::UID{}, OpenSim::ComponentPath{"/bodyset/newbody"}), bodyPtr);
+}
@@ -0,0 +1,69 @@
+#include "OpenSimCreator/SimulationHelpers.hpp"
+
+#include "OpenSimCreator/BasicModelStatePair.hpp"
+#include "OpenSimCreator/SimulationClock.hpp"
+#include "OpenSimCreator/SingleStateSimulation.hpp"
+
+#include <gtest/gtest.h>
+#include <nonstd/span.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+namespace
+{
+    osc::SimulationClock::time_point AtTime(double t)
+    {
+        return osc::SimulationClock::start() + osc::SimulationClock::duration{t};
+    }
+}
+
+TEST(TryFindReportIndexAtOrAfter, ReturnsNulloptForEmptyTimes)
+{
+    ASSERT_FALSE(osc::TryFindReportIndexAtOrAfter({}, AtTime(0.0)));
+}
+
+TEST(TryFindReportIndexAtOrAfter, ReturnsIndexOfExactlyMatchingTime)
+{
+    std::array<double, 4> const times = {0.0, 0.1, 0.2, 0.3};
+    ASSERT_EQ(osc::TryFindReportIndexAtOrAfter(times, AtTime(0.2)), std::optional<size_t>{2});
+}
+
+TEST(TryFindReportIndexAtOrAfter, ReturnsIndexOfNextTimeIfBetweenTimes)
+{
+    std::array<double, 4> const times = {0.0, 0.1, 0.2, 0.3};
+    ASSERT_EQ(osc::TryFindReportIndexAtOrAfter(times, AtTime(0.15)), std::optional<size_t>{2});
+}
+
+TEST(TryFindReportIndexAtOrAfter, ReturnsFirstIndexIfBeforeAllTimes)
+{
+    std::array<double, 4> const times = {0.0, 0.1, 0.2, 0.3};
+    ASSERT_EQ(osc::TryFindReportIndexAtOrAfter(times, AtTime(-1.0)), std::optional<size_t>{0});
+}
+
+TEST(TryFindReportIndexAtOrAfter, ReturnsLastIndexIfAfterAllTimes)
+{
+    std::array<double, 4> const times = {0.0, 0.1, 0.2, 0.3};
+    ASSERT_EQ(osc::TryFindReportIndexAtOrAfter(times, AtTime(1.0)), std::optional<size_t>{3});
+}
+
+TEST(TryFindNthReportAfter, ReturnsNulloptForSimulationWithNoReports)
+{
+    osc::SingleStateSimulation sim{osc::BasicModelStatePair{}};
+    ASSERT_FALSE(osc::TryFindNthReportAfter(sim, AtTime(0.0)));
+}
+
+TEST(TryGetInterpolatedReport, ReturnsNulloptForSimulationWithNoReports)
+{
+    osc::SingleStateSimulation sim{osc::BasicModelStatePair{}};
+    ASSERT_FALSE(osc::TryGetInterpolatedReport(sim, AtTime(0.0)));
+}
+
+TEST(TryGetInterpolatedReport, CachingOverloadReturnsNulloptForSimulationWithNoReports)
+{
+    osc::SingleStateSimulation sim{osc::BasicModelStatePair{}};
+    osc::InterpolatedReportCache cache;
+    ASSERT_FALSE(osc::TryGetInterpolatedReport(sim, AtTime(0.0), cache));
+    ASSERT_FALSE(cache.report);
+}
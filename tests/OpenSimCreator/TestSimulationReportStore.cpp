@@ -0,0 +1,177 @@
+#include "OpenSimCreator/SimulationReportStore.hpp"
+
+#include "OpenSimCreator/BasicModelStatePair.hpp"
+#include "OpenSimCreator/SimulationReport.hpp"
+
+#include <oscar/Utils/UID.hpp>
+
+#include <gtest/gtest.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <SimTKcommon.h>
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+TEST(SimulationReportStore, CanDefaultConstruct)
+{
+    osc::SimulationReportStore store;
+    ASSERT_TRUE(store.empty());
+    ASSERT_EQ(store.size(), 0);
+    ASSERT_TRUE(store.getTimes().empty());
+}
+
+TEST(SimulationReportStore, AppendingAReportStoresItsTimeAndAuxiliaryValues)
+{
+    osc::BasicModelStatePair modelState;
+    osc::UID const auxID;
+
+    SimTK::State st = modelState.getState();
+    st.setTime(1.5);
+
+    osc::SimulationReportStore store;
+    store.append(osc::SimulationReport{SimTK::State{st}, std::unordered_map<osc::UID, float>{{auxID, 7.0f}}});
+
+    ASSERT_EQ(store.size(), 1);
+    ASSERT_EQ(store.getTimes().front(), 1.5);
+    ASSERT_EQ(store.getNumStateVariables(), static_cast<size_t>(st.getNY()));
+    ASSERT_EQ(store.getAuxiliaryValue(auxID, 0), 7.0f);
+    ASSERT_FALSE(store.getAuxiliaryValue(osc::UID{}, 0));
+}
+
+TEST(SimulationReportStore, AuxiliaryValuesThatAreMissingFromSomeReportsAreReportedAsMissing)
+{
+    osc::BasicModelStatePair modelState;
+    osc::UID const auxID;
+
+    osc::SimulationReportStore store;
+    store.append(osc::SimulationReport{SimTK::State{modelState.getState()}});
+    store.append(osc::SimulationReport{SimTK::State{modelState.getState()}, std::unordered_map<osc::UID, float>{{auxID, 3.0f}}});
+
+    ASSERT_EQ(store.getAuxiliaryValues(auxID).size(), 2);
+    ASSERT_FALSE(store.getAuxiliaryValue(auxID, 0));
+    ASSERT_EQ(store.getAuxiliaryValue(auxID, 1), 3.0f);
+}
+
+TEST(SimulationReportStore, RestoreStateReturnsStateWithSameTimeAndStateVariables)
+{
+    osc::BasicModelStatePair modelState;
+
+    osc::SimulationReportStore store;
+    for (int i = 0; i < 1000; ++i)  // spans multiple chunks
+    {
+        SimTK::State st = modelState.getState();
+        st.setTime(static_cast<double>(i));
+        store.append(osc::SimulationReport{std::move(st)});
+    }
+
+    SimTK::State const restored = store.restoreState(600);
+    ASSERT_EQ(restored.getTime(), 600.0);
+    ASSERT_EQ(restored.getNY(), modelState.getState().getNY());
+}
+
+TEST(SimulationReportStore, RestoreStateCachedOnlyKeepsRecentlyRestoredStates)
+{
+    osc::BasicModelStatePair modelState;
+
+    osc::SimulationReportStore store;
+    for (int i = 0; i < 32; ++i)
+    {
+        SimTK::State st = modelState.getState();
+        st.setTime(static_cast<double>(i));
+        store.append(osc::SimulationReport{std::move(st)});
+    }
+
+    std::shared_ptr<SimTK::State const> first = store.restoreStateCached(0);
+    ASSERT_EQ(first->getTime(), 0.0);
+    ASSERT_EQ(store.restoreStateCached(0), first);  // reused while it's recently used
+
+    std::weak_ptr<SimTK::State const> const weakFirst = first;
+    first.reset();
+    for (size_t i = 1; i < store.size(); ++i)
+    {
+        ASSERT_EQ(store.restoreStateCached(i)->getTime(), static_cast<double>(i));
+    }
+    ASSERT_TRUE(weakFirst.expired());  // evicted, rather than kept forever
+}
+
+TEST(SimulationReportStore, StoreBackedReportReadsTimeAndAuxiliaryValuesFromStore)
+{
+    osc::BasicModelStatePair modelState;
+    osc::UID const auxID;
+
+    SimTK::State st = modelState.getState();
+    st.setTime(2.0);
+
+    auto store = std::make_shared<osc::SimulationReportStore>();
+    store->append(osc::SimulationReport{std::move(st), std::unordered_map<osc::UID, float>{{auxID, -1.0f}}});
+
+    osc::SimulationReport const report{store, 0};
+    ASSERT_EQ(report.getTime(), osc::SimulationClock::start() + osc::SimulationClock::duration{2.0});
+    ASSERT_EQ(report.getAuxiliaryValue(auxID), -1.0f);
+    ASSERT_EQ(report.getState().getTime(), 2.0);
+}
+
+TEST(SimulationReportStore, StoreBackedReportStateOutlivesRestoringManyOtherStates)
+{
+    osc::BasicModelStatePair modelState;
+
+    auto store = std::make_shared<osc::SimulationReportStore>();
+    for (int i = 0; i < 32; ++i)
+    {
+        SimTK::State st = modelState.getState();
+        st.setTime(static_cast<double>(i));
+        store->append(osc::SimulationReport{std::move(st)});
+    }
+
+    osc::SimulationReport const first{store, 0};
+    SimTK::State const& firstState = first.getState();
+
+    // restore (and evict) many other states
+    for (size_t i = 1; i < store->size(); ++i)
+    {
+        ASSERT_EQ(osc::SimulationReport(store, i).getState().getTime(), static_cast<double>(i));
+    }
+
+    ASSERT_EQ(&first.getState(), &firstState);
+    ASSERT_EQ(firstState.getTime(), 0.0);
+}
+
+TEST(SimulationReportStore, EditingAStoreBackedReportStateDoesNotEditOtherReportsOfTheSameRow)
+{
+    osc::BasicModelStatePair modelState;
+
+    auto store = std::make_shared<osc::SimulationReportStore>();
+    SimTK::State st = modelState.getState();
+    st.setTime(1.0);
+    store->append(osc::SimulationReport{std::move(st)});
+
+    osc::SimulationReport edited{store, 0};
+    osc::SimulationReport const other{store, 0};
+    ASSERT_EQ(other.getState().getTime(), 1.0);
+
+    edited.updStateHACK().setTime(5.0);
+
+    ASSERT_EQ(edited.getState().getTime(), 5.0);
+    ASSERT_EQ(other.getState().getTime(), 1.0);
+    ASSERT_EQ(store->restoreStateCached(0)->getTime(), 1.0);
+}
+
+TEST(SimulationReportStore, ReserveMeansAppendingDoesNotReallocateAuxiliaryColumns)
+{
+    osc::BasicModelStatePair modelState;
+    osc::UID const auxID;
+
+    osc::SimulationReportStore store;
+    store.reserve(16);
+    store.append(osc::SimulationReport{SimTK::State{modelState.getState()}, std::unordered_map<osc::UID, float>{{auxID, 0.0f}}});
+
+    float const* const firstValue = store.getAuxiliaryValues(auxID).data();
+    for (int i = 1; i < 16; ++i)
+    {
+        store.append(osc::SimulationReport{SimTK::State{modelState.getState()}, std::unordered_map<osc::UID, float>{{auxID, static_cast<float>(i)}}});
+    }
+
+    ASSERT_EQ(store.getAuxiliaryValues(auxID).data(), firstValue);
+    ASSERT_EQ(store.getAuxiliaryValue(auxID, 15), 15.0f);
+}
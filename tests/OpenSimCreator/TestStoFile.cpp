@@ -0,0 +1,94 @@
+#include "OpenSimCreator/StoFile.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    constexpr std::string_view c_ExampleStoFile =
+        "Coordinates\n"
+        "version=1\n"
+        "nRows=3\n"
+        "nColumns=3\n"
+        "inDegrees=yes\n"
+        "endheader\n"
+        "time\tjoint/q1/value\tjoint/q2/value\n"
+        "      0.00000000\t      1.50000000\t     -2.00000000\n"
+        "      0.01000000\t   1.2345678e+01\t      0.10000000\n"
+        "      0.02000000\t     -0.00000000\t             nan\n";
+}
+
+TEST(ParseStoFile, ParsesHeaderLabelsAndColumns)
+{
+    osc::StoFileContents const sto = osc::ParseStoFile(c_ExampleStoFile);
+
+    ASSERT_TRUE(sto.inDegrees);
+    ASSERT_EQ(sto.columnLabels, (std::vector<std::string>{"joint/q1/value", "joint/q2/value"}));
+    ASSERT_EQ(sto.getNumRows(), 3);
+    ASSERT_EQ(sto.times, (std::vector<double>{0.0, 0.01, 0.02}));
+    ASSERT_EQ(sto.columns.size(), 2);
+    ASSERT_EQ(sto.columns[0], (std::vector<double>{1.5, 12.345678, -0.0}));
+    ASSERT_EQ(sto.columns[1][0], -2.0);
+    ASSERT_EQ(sto.columns[1][1], 0.1);
+    ASSERT_TRUE(std::isnan(sto.columns[1][2]));
+}
+
+TEST(ParseStoFile, ParsedValuesMatchStrtod)
+{
+    // values that can't use the parser's exact fast path should still parse identically
+    std::string_view const content =
+        "endheader\n"
+        "time a b c\n"
+        "1.00000000000000000000001 1e-300 123456789012345678901234 0.1e30\n";
+
+    osc::StoFileContents const sto = osc::ParseStoFile(content);
+
+    ASSERT_EQ(sto.times.front(), std::strtod("1.00000000000000000000001", nullptr));
+    ASSERT_EQ(sto.columns[0].front(), std::strtod("1e-300", nullptr));
+    ASSERT_EQ(sto.columns[1].front(), std::strtod("123456789012345678901234", nullptr));
+    ASSERT_EQ(sto.columns[2].front(), std::strtod("0.1e30", nullptr));
+}
+
+TEST(ParseStoFile, HandlesCRLFLineEndingsAndBlankLines)
+{
+    std::string_view const content = "inDegrees=no\r\nendheader\r\n\r\ntime\tx\r\n0\t1\r\n\r\n1\t2\r\n";
+
+    osc::StoFileContents const sto = osc::ParseStoFile(content);
+
+    ASSERT_FALSE(sto.inDegrees);
+    ASSERT_EQ(sto.times, (std::vector<double>{0.0, 1.0}));
+    ASSERT_EQ(sto.columns.at(0), (std::vector<double>{1.0, 2.0}));
+}
+
+TEST(ParseStoFile, ThrowsIfNoEndheader)
+{
+    ASSERT_THROW({ osc::ParseStoFile("time\tx\n0\t1\n"); }, std::runtime_error);
+}
+
+TEST(ParseStoFile, ThrowsIfFirstColumnIsNotTime)
+{
+    ASSERT_THROW({ osc::ParseStoFile("endheader\nx\ttime\n0\t1\n"); }, std::runtime_error);
+}
+
+TEST(ParseStoFile, ThrowsIfARowHasTheWrongNumberOfValues)
+{
+    ASSERT_THROW({ osc::ParseStoFile("endheader\ntime\tx\n0\n"); }, std::runtime_error);
+    ASSERT_THROW({ osc::ParseStoFile("endheader\ntime\tx\n0\t1\t2\n"); }, std::runtime_error);
+}
+
+TEST(ReadStoFile, ReadsFileFromDisk)
+{
+    std::filesystem::path const p = std::filesystem::temp_directory_path() / "osc_readstofile_test.sto";
+    std::ofstream{p, std::ios::binary} << c_ExampleStoFile;
+
+    osc::StoFileContents const sto = osc::ReadStoFile(p);
+    ASSERT_EQ(sto.getNumRows(), 3);
+
+    std::filesystem::remove(p);
+}
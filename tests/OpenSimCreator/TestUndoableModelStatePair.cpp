@@ -1,5 +1,6 @@
 #include "OpenSimCreator/UndoableModelStatePair.hpp"
 
+#include "OpenSimCreator/ActionFunctions.hpp"
 #include "OpenSimCreator/Graphics/CustomDecorationOptions.hpp"
 #include "OpenSimCreator/Graphics/OpenSimDecorationGenerator.hpp"
 #include "OpenSimCreator/OpenSimApp.hpp"
@@ -13,16 +14,23 @@
 
 #include <gtest/gtest.h>
 #include <OpenSim/Common/Component.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/Body.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 
 #include <sstream>
 #include <filesystem>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <string>
 
 TEST(UndoableModelStatePair, CanLoadAndRenderAllUserFacingExampleFiles)
 {
     osc::GlobalInitOpenSim(*osc::Config::load());
 
-    osc::MeshCache meshCache;
+    osc::MeshCache meshCache{std::nullopt};
 
     // turn as many decoration options on as possible, so that the code gets tested
     // against them (#661)
@@ -76,3 +84,115 @@ TEST(UndoableModelStatePair, CanLoadAndRenderAllUserFacingExampleFiles)
     }
     ASSERT_GT(nExamplesTested, 0);  // sanity check: remove this if you want <10 examples
 }
+
+TEST(UndoableModelStatePair, CommitsCanImmediatelyBeUndoneAndRedone)
+{
+    // commits of an initialized model are initialized in the background, but they should
+    // still be immediately usable (e.g. by undo/redo)
+    osc::UndoableModelStatePair model;
+    model.updModel().setName("edited");
+    osc::InitializeModel(model.updModel());
+    osc::InitializeState(model.updModel());
+    model.commit("edited the model's name");
+
+    ASSERT_EQ(model.getLatestCommit().getModel()->getName(), "edited");
+    ASSERT_TRUE(model.canUndo());
+
+    model.doUndo();
+    ASSERT_NE(model.getModel().getName(), "edited");
+    ASSERT_TRUE(model.canRedo());
+
+    model.doRedo();
+    ASSERT_EQ(model.getModel().getName(), "edited");
+    ASSERT_TRUE(model.getLatestCommit().isReady());
+}
+
+TEST(UndoableModelStatePair, UndoingManyCommitsReconstructsEachCommitsModel)
+{
+    // older commits are compacted (in the background) into deltas, so undoing back through
+    // them has to reconstruct their models
+    osc::UndoableModelStatePair model;
+    for (int i = 0; i < 10; ++i)
+    {
+        model.updModel().setName("edit_" + std::to_string(i));
+        model.commit("edited the model's name");
+    }
+
+    // ensure that the commits were compacted, so that the undos have to reconstruct them
+    model.waitForHistoryCompaction();
+
+    for (int i = 8; i >= 0; --i)
+    {
+        ASSERT_TRUE(model.canUndo());
+        model.doUndo();
+        ASSERT_EQ(model.getModel().getName(), "edit_" + std::to_string(i));
+        model.waitForHistoryCompaction();
+    }
+}
+
+TEST(UndoableModelStatePair, ZeroHistoryMemoryBudgetStillKeepsOneUndo)
+{
+    osc::UndoableModelStatePair model;
+    model.setHistoryMemoryBudget(0);
+    ASSERT_EQ(model.getHistoryMemoryBudget(), 0);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        model.updModel().setName("edit_" + std::to_string(i));
+        model.commit("edited the model's name");
+    }
+    model.waitForHistoryCompaction();  // the budget is enforced once the history is compacted
+
+    ASSERT_TRUE(model.canUndo());
+    model.doUndo();
+    ASSERT_EQ(model.getModel().getName(), "edit_3");
+    ASSERT_FALSE(model.canUndo()) << "older commits should've been erased, because they're over the budget";
+}
+
+TEST(UndoableModelStatePair, PreviewEditsOnlyBumpStateVersionUntilCommitted)
+{
+    auto model = std::make_unique<OpenSim::Model>();
+    auto body = std::make_unique<OpenSim::Body>("body", 1.0, SimTK::Vec3{0.0}, SimTK::Inertia{1.0});
+    auto joint = std::make_unique<OpenSim::PinJoint>("joint", model->getGround(), *body);
+    model->addJoint(joint.release());
+    model->addBody(body.release());
+
+    osc::UndoableModelStatePair p{std::move(model)};
+    OpenSim::Coordinate const& coord = *p.getModel().getComponentList<OpenSim::Coordinate>().begin();
+    osc::UID const modelVersion = p.getModelVersion();
+    osc::UID const stateVersion = p.getStateVersion();
+
+    // e.g. one tick of dragging the coordinate's slider
+    ASSERT_TRUE(osc::ActionSetCoordinateValue(p, coord, 0.5));
+    ASSERT_TRUE(p.isPreviewing());
+    ASSERT_EQ(p.getModelVersion(), modelVersion);
+    ASSERT_NE(p.getStateVersion(), stateVersion);
+    ASSERT_GE(p.getState().getSystemStage(), SimTK::Stage::Position);
+    ASSERT_DOUBLE_EQ(coord.getValue(p.getState()), 0.5);
+
+    p.commit("dragged the coordinate");
+    ASSERT_FALSE(p.isPreviewing());
+    ASSERT_GE(p.getState().getSystemStage(), SimTK::Stage::Dynamics);
+}
+
+TEST(UndoableModelStatePair, GetStateRealizesAPreviewToDynamicsButRenderingStateDoesNot)
+{
+    auto model = std::make_unique<OpenSim::Model>();
+    auto body = std::make_unique<OpenSim::Body>("body", 1.0, SimTK::Vec3{0.0}, SimTK::Inertia{1.0});
+    auto joint = std::make_unique<OpenSim::PinJoint>("joint", model->getGround(), *body);
+    model->addJoint(joint.release());
+    model->addBody(body.release());
+
+    osc::UndoableModelStatePair p{std::move(model)};
+    OpenSim::Coordinate const& coord = *p.getModel().getComponentList<OpenSim::Coordinate>().begin();
+
+    ASSERT_TRUE(osc::ActionSetCoordinateValue(p, coord, 0.5));
+    ASSERT_TRUE(p.isPreviewing());
+
+    // renderers only need the preview's positions...
+    ASSERT_EQ(p.getStateForRendering().getSystemStage(), SimTK::Stage::Position);
+
+    // ...but other readers (e.g. output plots) may read force-dependent outputs
+    ASSERT_GE(p.getState().getSystemStage(), SimTK::Stage::Dynamics);
+    ASSERT_TRUE(p.isPreviewing());
+}
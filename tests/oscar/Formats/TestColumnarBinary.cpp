@@ -0,0 +1,142 @@
+#include "oscar/Formats/ColumnarBinary.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace
+{
+    osc::ColumnarBinaryContents RoundTrip(
+        std::vector<osc::ColumnarBinaryColumnView> const& columns,
+        osc::ColumnarBinaryCompression compression)
+    {
+        std::stringstream ss;
+        osc::WriteColumnarBinary(ss, columns, compression);
+        return osc::ReadColumnarBinary(ss);
+    }
+
+    std::vector<float> GenerateSmoothFloats(size_t n)
+    {
+        std::vector<float> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            rv.push_back(static_cast<float>(std::sin(0.001 * static_cast<double>(i))));
+        }
+        return rv;
+    }
+}
+
+TEST(ColumnarBinary, RoundTripsEmptyColumnList)
+{
+    osc::ColumnarBinaryContents const rv = RoundTrip({}, osc::ColumnarBinaryCompression::None);
+    ASSERT_EQ(rv.numRows, 0);
+    ASSERT_TRUE(rv.columns.empty());
+}
+
+TEST(ColumnarBinary, RoundTripsFloatAndDoubleColumnsWithEachCompressionMethod)
+{
+    std::vector<double> const times = {0.0, 0.5, 1.0, 1.5};
+    std::vector<float> const values = {-1.0f, std::numeric_limits<float>::infinity(), 3.25f, 3.25f};
+
+    for (auto compression : {osc::ColumnarBinaryCompression::None, osc::ColumnarBinaryCompression::ShuffledRunLength})
+    {
+        osc::ColumnarBinaryContents const rv = RoundTrip({{"time", times}, {"some/output", values}}, compression);
+
+        ASSERT_EQ(rv.numRows, 4);
+        ASSERT_EQ(rv.columns.size(), 2);
+
+        ASSERT_EQ(rv.columns[0].name, "time");
+        ASSERT_EQ(osc::GetDataType(rv.columns[0]), osc::ColumnarBinaryDataType::Float64);
+        ASSERT_EQ(std::get<std::vector<double>>(rv.columns[0].values), times);
+
+        ASSERT_EQ(rv.columns[1].name, "some/output");
+        ASSERT_EQ(osc::GetDataType(rv.columns[1]), osc::ColumnarBinaryDataType::Float32);
+        ASSERT_EQ(std::get<std::vector<float>>(rv.columns[1].values), values);
+    }
+}
+
+TEST(ColumnarBinary, RoundTripsNaNBitPatterns)
+{
+    std::vector<float> const values = {std::numeric_limits<float>::quiet_NaN(), 1.0f};
+    osc::ColumnarBinaryContents const rv = RoundTrip({{"col", values}}, osc::ColumnarBinaryCompression::ShuffledRunLength);
+
+    auto const& got = std::get<std::vector<float>>(rv.columns.at(0).values);
+    ASSERT_TRUE(std::isnan(got.at(0)));
+    ASSERT_EQ(got.at(1), 1.0f);
+}
+
+TEST(ColumnarBinary, ShuffledRunLengthCompressionRoundTripsAndShrinksSmoothData)
+{
+    std::vector<float> const values = GenerateSmoothFloats(10000);
+    std::vector<float> const constant(10000, 2.0f);
+    std::vector<osc::ColumnarBinaryColumnView> const columns = {{"smooth", values}, {"constant", constant}};
+
+    std::stringstream uncompressed;
+    osc::WriteColumnarBinary(uncompressed, columns, osc::ColumnarBinaryCompression::None);
+    std::stringstream compressed;
+    osc::WriteColumnarBinary(compressed, columns, osc::ColumnarBinaryCompression::ShuffledRunLength);
+
+    ASSERT_LT(compressed.str().size(), uncompressed.str().size());
+
+    osc::ColumnarBinaryContents const rv = osc::ReadColumnarBinary(compressed);
+    ASSERT_EQ(std::get<std::vector<float>>(rv.columns.at(0).values), values);
+    ASSERT_EQ(std::get<std::vector<float>>(rv.columns.at(1).values), constant);
+}
+
+TEST(ColumnarBinary, WriteThrowsIfColumnsHaveDifferentLengths)
+{
+    std::vector<float> const a = {1.0f, 2.0f};
+    std::vector<float> const b = {1.0f};
+    std::vector<osc::ColumnarBinaryColumnView> const columns = {{"a", a}, {"b", b}};
+
+    std::stringstream ss;
+    ASSERT_THROW({ osc::WriteColumnarBinary(ss, columns); }, std::runtime_error);
+}
+
+TEST(ColumnarBinary, ReadThrowsOnBadMagic)
+{
+    std::stringstream ss{"time,value\n0,1\n"};
+    ASSERT_THROW({ osc::ReadColumnarBinary(ss); }, std::runtime_error);
+}
+
+TEST(ColumnarBinary, ReadThrowsOnTruncatedData)
+{
+    std::vector<double> const values = {1.0, 2.0, 3.0};
+    std::vector<osc::ColumnarBinaryColumnView> const columns = {{"col", values}};
+
+    for (auto compression : {osc::ColumnarBinaryCompression::None, osc::ColumnarBinaryCompression::ShuffledRunLength})
+    {
+        std::stringstream ss;
+        osc::WriteColumnarBinary(ss, columns, compression);
+        std::string const full = ss.str();
+
+        for (size_t len = 0; len < full.size(); ++len)
+        {
+            std::stringstream truncated{full.substr(0, len)};
+            ASSERT_THROW({ osc::ReadColumnarBinary(truncated); }, std::runtime_error);
+        }
+    }
+}
+
+TEST(ColumnarBinary, GetValuesAsFloatsNarrowsDoubles)
+{
+    osc::ColumnarBinaryColumn const column{"col", std::vector<double>{0.5, 2.0}};
+    ASSERT_EQ(osc::GetValuesAsFloats(column), (std::vector<float>{0.5f, 2.0f}));
+}
+
+TEST(ColumnarBinary, FindColumnReturnsNullptrIfNoColumnHasTheName)
+{
+    osc::ColumnarBinaryContents contents;
+    contents.columns.push_back({"a", std::vector<float>{}});
+
+    ASSERT_EQ(osc::FindColumn(contents, "b"), nullptr);
+    ASSERT_EQ(osc::FindColumn(contents, "a"), &contents.columns.front());
+}
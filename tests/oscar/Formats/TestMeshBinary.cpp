@@ -0,0 +1,109 @@
+#include "oscar/Formats/MeshBinary.hpp"
+
+#include "oscar/Graphics/Mesh.hpp"
+#include "oscar/Graphics/MeshIndicesView.hpp"
+#include "oscar/Graphics/MeshTopology.hpp"
+
+#include <glm/vec3.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    osc::MeshBinaryContents RoundTrip(osc::Mesh const& mesh, std::string const& key)
+    {
+        std::stringstream ss;
+        osc::WriteMeshBinary(ss, mesh, key);
+        return osc::ReadMeshBinary(ss);
+    }
+
+    std::vector<uint32_t> ToVector(osc::MeshIndicesView const& indices)
+    {
+        std::vector<uint32_t> rv;
+        for (uint32_t index : indices)
+        {
+            rv.push_back(index);
+        }
+        return rv;
+    }
+}
+
+TEST(MeshBinary, RoundTripsEmptyMesh)
+{
+    osc::MeshBinaryContents const rv = RoundTrip(osc::Mesh{}, "");
+
+    ASSERT_TRUE(rv.key.empty());
+    ASSERT_TRUE(rv.mesh.getVerts().empty());
+    ASSERT_TRUE(rv.mesh.getNormals().empty());
+    ASSERT_EQ(rv.mesh.getIndices().size(), 0);
+}
+
+TEST(MeshBinary, RoundTripsKeyVertsNormalsAndIndices)
+{
+    std::vector<glm::vec3> const verts = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.5f}};
+    std::vector<glm::vec3> const normals = {{0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}};
+    std::vector<uint16_t> const indices = {0, 1, 2, 2, 1, 0};
+
+    osc::Mesh mesh;
+    mesh.setVerts(verts);
+    mesh.setNormals(normals);
+    mesh.setIndices(indices);
+
+    osc::MeshBinaryContents const rv = RoundTrip(mesh, "some/path.vtp|123|456");
+
+    ASSERT_EQ(rv.key, "some/path.vtp|123|456");
+    ASSERT_EQ(rv.mesh.getTopology(), osc::MeshTopology::Triangles);
+    ASSERT_EQ(std::vector<glm::vec3>(rv.mesh.getVerts().begin(), rv.mesh.getVerts().end()), verts);
+    ASSERT_EQ(std::vector<glm::vec3>(rv.mesh.getNormals().begin(), rv.mesh.getNormals().end()), normals);
+    ASSERT_TRUE(rv.mesh.getIndices().isU16());
+    ASSERT_EQ(ToVector(rv.mesh.getIndices()), ToVector(mesh.getIndices()));
+    ASSERT_EQ(rv.mesh.getBounds(), mesh.getBounds());
+}
+
+TEST(MeshBinary, RoundTrips32BitIndicesAndTopology)
+{
+    std::vector<glm::vec3> const verts(70000, glm::vec3{1.0f, 2.0f, 3.0f});
+    std::vector<uint32_t> const indices = {0, 69999};
+
+    osc::Mesh mesh;
+    mesh.setTopology(osc::MeshTopology::Lines);
+    mesh.setVerts(verts);
+    mesh.setIndices(indices);
+
+    osc::MeshBinaryContents const rv = RoundTrip(mesh, "key");
+
+    ASSERT_EQ(rv.mesh.getTopology(), osc::MeshTopology::Lines);
+    ASSERT_EQ(rv.mesh.getVerts().size(), verts.size());
+    ASSERT_TRUE(rv.mesh.getNormals().empty());
+    ASSERT_TRUE(rv.mesh.getIndices().isU32());
+    ASSERT_EQ(ToVector(rv.mesh.getIndices()), indices);
+}
+
+TEST(MeshBinary, ReadThrowsIfGivenNonMeshBinaryData)
+{
+    std::stringstream ss{"not a mesh binary file"};
+    ASSERT_THROW({ osc::ReadMeshBinary(ss); }, std::runtime_error);
+}
+
+TEST(MeshBinary, ReadThrowsIfDataIsTruncated)
+{
+    std::vector<glm::vec3> const verts = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+    std::vector<uint16_t> const indices = {0, 1, 2};
+
+    osc::Mesh mesh;
+    mesh.setVerts(verts);
+    mesh.setIndices(indices);
+
+    std::stringstream ss;
+    osc::WriteMeshBinary(ss, mesh, "key");
+    std::string data = std::move(ss).str();
+    data.resize(data.size() - 1);
+
+    std::stringstream truncated{data};
+    ASSERT_THROW({ osc::ReadMeshBinary(truncated); }, std::runtime_error);
+}
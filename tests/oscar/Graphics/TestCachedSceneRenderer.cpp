@@ -0,0 +1,73 @@
+#include "oscar/Graphics/CachedSceneRenderer.hpp"
+
+#include "oscar/Graphics/Color.hpp"
+#include "oscar/Graphics/MaterialPropertyBlock.hpp"
+#include "oscar/Graphics/MeshCache.hpp"
+#include "oscar/Graphics/MeshGen.hpp"
+#include "oscar/Graphics/SceneDecoration.hpp"
+#include "oscar/Graphics/SceneRendererParams.hpp"
+#include "oscar/Graphics/ShaderCache.hpp"
+#include "oscar/Platform/App.hpp"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+static std::unique_ptr<osc::App> g_App;
+
+// note: the `std::vector&&` overload only takes ownership of (i.e. moves from) the decorations
+// if it re-renders, which is how these tests detect whether a draw call re-rendered
+class CachedSceneRendererTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite()
+    {
+        g_App = std::make_unique<osc::App>();
+    }
+
+    static void TearDownTestSuite()
+    {
+        g_App.reset();
+    }
+
+    static std::vector<osc::SceneDecoration> GenerateDecorations(osc::Color const& propsColor)
+    {
+        osc::MaterialPropertyBlock props;
+        props.setColor("uDiffuseColor", propsColor);
+
+        std::vector<osc::SceneDecoration> rv;
+        rv.emplace_back(osc::GenCube(), osc::Transform{}, osc::Color::white(), "cube", osc::SceneDecorationFlags_None, std::nullopt, props);
+        return rv;
+    }
+
+    osc::MeshCache m_MeshCache{std::nullopt};
+    osc::ShaderCache m_ShaderCache;
+    osc::CachedSceneRenderer m_Renderer{osc::App::config(), m_MeshCache, m_ShaderCache};
+    osc::SceneRendererParams m_Params;
+};
+
+TEST_F(CachedSceneRendererTest, DrawingAnIdenticalListSkipsRendering)
+{
+    std::vector<osc::SceneDecoration> first = GenerateDecorations(osc::Color::red());
+    m_Renderer.draw(std::move(first), m_Params);
+
+    std::vector<osc::SceneDecoration> second = GenerateDecorations(osc::Color::red());
+    m_Renderer.draw(std::move(second), m_Params);
+
+    ASSERT_FALSE(second.empty()) << "an identical list shouldn't be re-rendered (taken)";
+}
+
+TEST_F(CachedSceneRendererTest, DrawingAListThatOnlyDiffersByMaterialPropertiesRenders)
+{
+    std::vector<osc::SceneDecoration> first = GenerateDecorations(osc::Color::red());
+    m_Renderer.draw(std::move(first), m_Params);
+
+    // the hash covers material property contents, so the renderer can rely on it alone
+    std::vector<osc::SceneDecoration> second = GenerateDecorations(osc::Color::blue());
+    ASSERT_NE(std::hash<osc::SceneDecoration>{}(second.front()), std::hash<osc::SceneDecoration>{}(GenerateDecorations(osc::Color::red()).front()));
+    m_Renderer.draw(std::move(second), m_Params);
+
+    ASSERT_TRUE(second.empty()) << "a list with different material properties should be re-rendered (taken)";
+}
@@ -3,8 +3,11 @@
 #include "oscar/Graphics/ColorSpace.hpp"
 #include "oscar/Graphics/Texture2D.hpp"
 #include "oscar/Graphics/Image.hpp"
+#include "oscar/Graphics/Mesh.hpp"
+#include "oscar/Maths/Triangle.hpp"
 #include "oscar/Platform/Config.hpp"
 
+#include <glm/vec3.hpp>
 #include <gtest/gtest.h>
 
 TEST(GraphicsHelpers, ToTexture2DPropagatesSRGBColorSpace)
@@ -35,4 +38,65 @@ TEST(GraphicsHelpers, LoadTexture2DFromImageRespectsLinearColorSpace)
 	osc::Texture2D const rv = osc::LoadTexture2DFromImage(path, osc::ColorSpace::Linear);
 
 	ASSERT_EQ(rv.getColorSpace(), osc::ColorSpace::Linear);
-}
\ No newline at end of file
+}
+TEST(GraphicsHelpers, CreateWeldedTriangleMeshSharesVertsBetweenCoplanarTriangles)
+{
+	osc::Triangle const triangles[] =
+	{
+		{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}},
+		{{1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 0.0f}},
+	};
+
+	osc::Mesh const mesh = osc::CreateWeldedTriangleMesh(triangles);
+
+	ASSERT_EQ(mesh.getVerts().size(), 4);
+	ASSERT_EQ(mesh.getNormals().size(), 4);
+	ASSERT_EQ(mesh.getIndices().size(), 6);
+	for (glm::vec3 const& normal : mesh.getNormals())
+	{
+		ASSERT_EQ(normal, glm::vec3(0.0f, 0.0f, 1.0f));
+	}
+}
+
+TEST(GraphicsHelpers, CreateWeldedTriangleMeshWeldsPositionsThatAreWithinEpsilon)
+{
+	osc::Triangle const triangles[] =
+	{
+		{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}},
+		{{1.0f, 1.0f + 1e-8f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 0.0f}},
+	};
+
+	ASSERT_EQ(osc::CreateWeldedTriangleMesh(triangles).getVerts().size(), 4);
+}
+
+TEST(GraphicsHelpers, CreateWeldedTriangleMeshDoesNotShareVertsAcrossFlatShadedEdges)
+{
+	// two triangles that meet at a right angle along the X axis
+	osc::Triangle const triangles[] =
+	{
+		{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+		{{1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+	};
+
+	ASSERT_EQ(osc::CreateWeldedTriangleMesh(triangles).getVerts().size(), 6);
+}
+
+TEST(GraphicsHelpers, CreateWeldedTriangleMeshSmoothsNormalsAcrossShallowEdges)
+{
+	// two triangles that meet at a shallow angle along the X axis
+	osc::Triangle const triangles[] =
+	{
+		{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.1f}},
+		{{1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, -1.0f, 0.1f}},
+	};
+
+	osc::MeshWeldingParams params;
+	params.maybeSmoothingAngleDegrees = 30.0f;
+	osc::Mesh const smoothed = osc::CreateWeldedTriangleMesh(triangles, params);
+
+	ASSERT_EQ(smoothed.getVerts().size(), 4);  // the shared edge's verts are shared
+	ASSERT_EQ(smoothed.getNormals().size(), 4);
+
+	params.maybeSmoothingAngleDegrees = 1.0f;
+	ASSERT_EQ(osc::CreateWeldedTriangleMesh(triangles, params).getVerts().size(), 6);  // too sharp to smooth
+}
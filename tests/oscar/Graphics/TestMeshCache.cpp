@@ -0,0 +1,287 @@
+#include "oscar/Graphics/MeshCache.hpp"
+
+#include "oscar/Graphics/Mesh.hpp"
+#include "oscar/Graphics/MeshGen.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::filesystem::path WriteTemporaryFile(char const* name, char const* content)
+    {
+        std::filesystem::path const p = std::filesystem::temp_directory_path() / name;
+        std::ofstream{p, std::ios::binary} << content;
+        return p;
+    }
+}
+
+TEST(MeshCache, GetFromFileOnlyCallsLoaderOnce)
+{
+    std::filesystem::path const sourceFile = WriteTemporaryFile("oscar_meshcache_once.txt", "some content");
+
+    osc::MeshCache cache{std::nullopt};
+    size_t numCalls = 0;
+    auto const loader = [&numCalls](std::filesystem::path const&)
+    {
+        ++numCalls;
+        return osc::GenCube();
+    };
+
+    osc::Mesh const first = cache.getFromFile(sourceFile, loader);
+    osc::Mesh const second = cache.getFromFile(sourceFile, loader);
+
+    ASSERT_EQ(numCalls, 1);
+    ASSERT_EQ(first, second);
+
+    std::filesystem::remove(sourceFile);
+}
+
+TEST(MeshCache, GetFromFileUsesOnDiskCacheBetweenCacheInstances)
+{
+    std::filesystem::path const sourceFile = WriteTemporaryFile("oscar_meshcache_ondisk.txt", "some content");
+    std::filesystem::path const cacheDir = std::filesystem::temp_directory_path() / "oscar_meshcache_ondisk_cache";
+    std::filesystem::remove_all(cacheDir);
+
+    size_t numCalls = 0;
+    auto const loader = [&numCalls](std::filesystem::path const&)
+    {
+        ++numCalls;
+        return osc::GenCube();
+    };
+
+    osc::Mesh const loaded = osc::MeshCache{cacheDir}.getFromFile(sourceFile, loader);
+    osc::Mesh const cached = osc::MeshCache{cacheDir}.getFromFile(sourceFile, loader);
+
+    ASSERT_EQ(numCalls, 1);
+    ASSERT_EQ(cached.getVerts().size(), loaded.getVerts().size());
+    ASSERT_EQ(cached.getIndices().size(), loaded.getIndices().size());
+    ASSERT_EQ(cached.getBounds(), loaded.getBounds());
+
+    std::filesystem::remove_all(cacheDir);
+    std::filesystem::remove(sourceFile);
+}
+
+TEST(MeshCache, GetFromFileReloadsFileIfItWasModified)
+{
+    std::filesystem::path const sourceFile = WriteTemporaryFile("oscar_meshcache_modified.txt", "some content");
+    std::filesystem::path const cacheDir = std::filesystem::temp_directory_path() / "oscar_meshcache_modified_cache";
+    std::filesystem::remove_all(cacheDir);
+
+    size_t numCalls = 0;
+    auto const loader = [&numCalls](std::filesystem::path const&)
+    {
+        ++numCalls;
+        return osc::GenCube();
+    };
+
+    osc::MeshCache{cacheDir}.getFromFile(sourceFile, loader);
+    WriteTemporaryFile("oscar_meshcache_modified.txt", "some different (longer) content");
+    osc::MeshCache{cacheDir}.getFromFile(sourceFile, loader);
+
+    ASSERT_EQ(numCalls, 2);
+
+    std::filesystem::remove_all(cacheDir);
+    std::filesystem::remove(sourceFile);
+}
+
+TEST(MeshCache, ConcurrentGetsForTheSameKeyOnlyCallGetterOnce)
+{
+    osc::MeshCache cache{std::nullopt};
+    std::atomic<size_t> numCalls = 0;
+    auto const getter = [&numCalls]()
+    {
+        ++numCalls;
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        return osc::GenCube();
+    };
+
+    std::vector<std::future<osc::Mesh>> futures;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        futures.push_back(std::async(std::launch::async, [&cache, &getter]() { return cache.get("key", getter); }));
+    }
+    std::vector<osc::Mesh> meshes;
+    for (std::future<osc::Mesh>& f : futures)
+    {
+        meshes.push_back(f.get());
+    }
+
+    ASSERT_EQ(numCalls, 1);
+    for (osc::Mesh const& mesh : meshes)
+    {
+        ASSERT_EQ(mesh, meshes.front());
+    }
+}
+
+TEST(MeshCache, GetterCanGetOtherKeysWhileItIsRunning)
+{
+    // i.e. the cache doesn't hold a (global) lock while a getter runs
+    osc::MeshCache cache{std::nullopt};
+    osc::Mesh const mesh = cache.get("outer", [&cache]()
+    {
+        return cache.get("inner", []() { return osc::GenCube(); });
+    });
+
+    ASSERT_EQ(mesh, cache.get("inner", []() { return osc::Mesh{}; }));
+}
+
+TEST(MeshCache, GetFromFileAfterPrefetchFromFileDoesNotCallLoaderAgain)
+{
+    std::filesystem::path const sourceFile = WriteTemporaryFile("oscar_meshcache_prefetch.txt", "some content");
+
+    osc::MeshCache cache{std::nullopt};
+    std::atomic<size_t> numCalls = 0;
+    auto const loader = [&numCalls](std::filesystem::path const&)
+    {
+        ++numCalls;
+        return osc::GenCube();
+    };
+
+    cache.prefetchFromFile(sourceFile, loader);
+    osc::Mesh const mesh = cache.getFromFile(sourceFile, loader);
+
+    ASSERT_EQ(numCalls, 1);
+    ASSERT_EQ(mesh.getVerts().size(), osc::GenCube().getVerts().size());
+
+    std::filesystem::remove(sourceFile);
+}
+
+TEST(MeshCache, GetFromFileTreatsDifferentSpellingsOfAPathAsTheSameFile)
+{
+    std::filesystem::path const sourceFile = WriteTemporaryFile("oscar_meshcache_spellings.txt", "some content");
+    std::filesystem::path const otherSpelling = sourceFile.parent_path() / "." / sourceFile.filename();
+
+    osc::MeshCache cache{std::nullopt};
+    std::atomic<size_t> numCalls = 0;
+    auto const loader = [&numCalls](std::filesystem::path const&)
+    {
+        ++numCalls;
+        return osc::GenCube();
+    };
+
+    cache.prefetchFromFile(sourceFile, loader);
+    osc::Mesh const mesh = cache.getFromFile(otherSpelling, loader);
+
+    ASSERT_EQ(numCalls, 1);
+    ASSERT_EQ(mesh.getVerts().size(), osc::GenCube().getVerts().size());
+
+    std::filesystem::remove(sourceFile);
+}
+
+TEST(MeshCache, IsLoadingIsFalseForMeshesThatAreNotPlaceholders)
+{
+    osc::MeshCache cache{std::nullopt};
+    ASSERT_FALSE(cache.isLoading(cache.getBrickMesh()));
+    ASSERT_FALSE(cache.isLoading(osc::Mesh{}));
+}
+
+TEST(MeshCache, GetFromFileWithPlaceholderPolicyReturnsPlaceholderUntilLoaded)
+{
+    std::filesystem::path const sourceFile = WriteTemporaryFile("oscar_meshcache_placeholder.txt", "some content");
+
+    osc::MeshCache cache{std::nullopt};
+    std::promise<void> allowLoad;
+    std::shared_future<void> const loadAllowed = allowLoad.get_future().share();
+    auto const loader = [loadAllowed](std::filesystem::path const&)
+    {
+        loadAllowed.wait();
+        return osc::GenCube();
+    };
+
+    osc::Mesh const placeholder = cache.getFromFile(sourceFile, loader, osc::MeshLoadingPolicy::PlaceholderWhileLoading);
+    ASSERT_TRUE(placeholder.getVerts().empty());
+    ASSERT_TRUE(cache.isLoading(placeholder));
+    ASSERT_EQ(cache.getNumPendingLoads(), 1);
+
+    allowLoad.set_value();
+    while (cache.isLoading(placeholder))
+    {
+        std::this_thread::yield();
+    }
+
+    osc::Mesh const loaded = cache.getFromFile(sourceFile, loader, osc::MeshLoadingPolicy::PlaceholderWhileLoading);
+    ASSERT_EQ(loaded.getVerts().size(), osc::GenCube().getVerts().size());
+    ASSERT_EQ(cache.getNumPendingLoads(), 0);
+
+    std::filesystem::remove(sourceFile);
+}
+
+TEST(MeshCache, GetReturnsCubeIfGetterThrows)
+{
+    osc::MeshCache cache{std::nullopt};
+    osc::Mesh const mesh = cache.get("throws", []() -> osc::Mesh { throw std::runtime_error{"some error"}; });
+
+    ASSERT_EQ(mesh, cache.getBrickMesh());
+}
+
+TEST(MeshCache, GetFromFileDoesNotWriteMeshesWithTextureCoordinatesToOnDiskCache)
+{
+    std::filesystem::path const sourceFile = WriteTemporaryFile("oscar_meshcache_texcoords.txt", "some content");
+    std::filesystem::path const cacheDir = std::filesystem::temp_directory_path() / "oscar_meshcache_texcoords_cache";
+    std::filesystem::remove_all(cacheDir);
+
+    size_t numCalls = 0;
+    auto const loader = [&numCalls](std::filesystem::path const&)
+    {
+        ++numCalls;
+        return osc::GenTexturedQuad();
+    };
+
+    osc::MeshCache{cacheDir}.getFromFile(sourceFile, loader);
+    osc::Mesh const reloaded = osc::MeshCache{cacheDir}.getFromFile(sourceFile, loader);
+
+    // (the mesh binary format can't store texture coordinates, so they would've been dropped)
+    ASSERT_EQ(numCalls, 2);
+    ASSERT_FALSE(reloaded.getTexCoords().empty());
+
+    std::filesystem::remove_all(cacheDir);
+    std::filesystem::remove(sourceFile);
+}
+
+TEST(MeshCache, GetFromFileEvictsFromOnDiskCacheWhenItIsLargerThanItsMaxSize)
+{
+    std::filesystem::path const firstFile = WriteTemporaryFile("oscar_meshcache_evict_first.txt", "some content");
+    std::filesystem::path const secondFile = WriteTemporaryFile("oscar_meshcache_evict_second.txt", "some other content");
+    std::filesystem::path const cacheDir = std::filesystem::temp_directory_path() / "oscar_meshcache_evict_cache";
+    std::filesystem::remove_all(cacheDir);
+
+    size_t numCalls = 0;
+    auto const loader = [&numCalls](std::filesystem::path const&)
+    {
+        ++numCalls;
+        return osc::GenCube();
+    };
+
+    // measure how large one cached mesh is
+    osc::MeshCache{cacheDir}.getFromFile(firstFile, loader);
+    std::uintmax_t oneFileSize = 0;
+    for (std::filesystem::directory_entry const& e : std::filesystem::directory_iterator{cacheDir})
+    {
+        oneFileSize += e.file_size();
+
+        // (ensure it's older than the next one, even if the filesystem's timestamps are coarse)
+        std::filesystem::last_write_time(e.path(), std::filesystem::file_time_type::clock::now() - std::chrono::hours{1});
+    }
+    ASSERT_GT(oneFileSize, 0);
+
+    // caching a second mesh in a directory that can only hold one evicts the first
+    osc::MeshCache{cacheDir, static_cast<size_t>(oneFileSize)}.getFromFile(secondFile, loader);
+    osc::MeshCache{cacheDir, static_cast<size_t>(oneFileSize)}.getFromFile(firstFile, loader);
+    ASSERT_EQ(numCalls, 3);
+
+    std::filesystem::remove_all(cacheDir);
+    std::filesystem::remove(firstFile);
+    std::filesystem::remove(secondFile);
+}
@@ -8,6 +8,7 @@
 #include "oscar/Graphics/Graphics.hpp"
 #include "oscar/Graphics/GraphicsContext.hpp"
 #include "oscar/Graphics/GraphicsHelpers.hpp"
+#include "oscar/Graphics/Image.hpp"
 #include "oscar/Graphics/Material.hpp"
 #include "oscar/Graphics/MaterialPropertyBlock.hpp"
 #include "oscar/Graphics/Mesh.hpp"
@@ -27,18 +28,25 @@
 #include "oscar/Maths/AABB.hpp"
 #include "oscar/Maths/BVH.hpp"
 #include "oscar/Maths/MathHelpers.hpp"
+#include "oscar/Maths/Transform.hpp"
 #include "oscar/Platform/App.hpp"
 #include "oscar/Utils/Algorithms.hpp"
 #include "oscar/Utils/CStringView.hpp"
+#include "oscar/Utils/Perf.hpp"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <random>
 #include <sstream>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 static std::unique_ptr<osc::App> g_App;
 
@@ -1484,6 +1492,32 @@ TEST_F(Renderer, MaterialPropertyBlockDifferentMaterialBlocksCompareNotEqual)
     ASSERT_NE(m1, m2);
 }
 
+TEST_F(Renderer, MaterialPropertyBlockEqualBlocksHaveEqualHashes)
+{
+    // (set in a different order, because the hash mustn't depend on the block's internal ordering)
+    osc::MaterialPropertyBlock m1;
+    m1.setFloat("someKey", 1.0f);
+    m1.setVec3("someOtherKey", {1.0f, 2.0f, 3.0f});
+
+    osc::MaterialPropertyBlock m2;
+    m2.setVec3("someOtherKey", {1.0f, 2.0f, 3.0f});
+    m2.setFloat("someKey", 1.0f);
+
+    ASSERT_EQ(m1, m2);
+    ASSERT_EQ(std::hash<osc::MaterialPropertyBlock>{}(m1), std::hash<osc::MaterialPropertyBlock>{}(m2));
+}
+
+TEST_F(Renderer, MaterialPropertyBlockBlocksWithDifferentValuesHaveDifferentHashes)
+{
+    osc::MaterialPropertyBlock m1;
+    m1.setColor("someKey", osc::Color::red());
+
+    osc::MaterialPropertyBlock m2;
+    m2.setColor("someKey", osc::Color::blue());
+
+    ASSERT_NE(std::hash<osc::MaterialPropertyBlock>{}(m1), std::hash<osc::MaterialPropertyBlock>{}(m2));
+}
+
 TEST_F(Renderer, MaterialPropertyBlockCanPrintToOutputStream)
 {
     osc::MaterialPropertyBlock m1;
@@ -2209,6 +2243,49 @@ TEST_F(Renderer, MeshGetBVHReturnsExpectedRootNode)
     ASSERT_EQ(expectedRoot, bvh.nodes.front().getBounds());
 }
 
+TEST_F(Renderer, MeshGetBVHReflectsVertsThatWereTransformedAfterPreviousCall)
+{
+    glm::vec3 pyramid[] =
+    {
+        {-1.0f, -1.0f, 0.0f},  // base: bottom-left
+        { 1.0f, -1.0f, 0.0f},  // base: bottom-right
+        { 0.0f,  1.0f, 0.0f},  // base: top-middle
+    };
+    std::uint16_t pyramidIndices[] = {0, 1, 2};
+
+    osc::Mesh m;
+    m.setVerts(pyramid);
+    m.setIndices(pyramidIndices);
+    ASSERT_FALSE(m.getBVH().nodes.empty());  // build the BVH
+
+    m.transformVerts([](nonstd::span<glm::vec3> verts)
+    {
+        for (glm::vec3& v : verts)
+        {
+            v *= 2.0f;
+        }
+    });
+
+    osc::AABB const expectedRoot = osc::AABBFromVerts(m.getVerts());
+    ASSERT_EQ(m.getBounds(), expectedRoot);
+    ASSERT_FALSE(m.getBVH().nodes.empty());
+    ASSERT_EQ(m.getBVH().nodes.front().getBounds(), expectedRoot);
+}
+
+TEST_F(Renderer, MeshGetBVHReturnsEmptyBVHForNonTriangleTopology)
+{
+    glm::vec3 const verts[] = {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}};
+    std::uint16_t const indices[] = {0, 1};
+
+    osc::Mesh m;
+    m.setTopology(osc::MeshTopology::Lines);
+    m.setVerts(verts);
+    m.setIndices(indices);
+
+    ASSERT_EQ(m.getBounds(), osc::AABBFromVerts(verts));
+    ASSERT_TRUE(m.getBVH().nodes.empty());
+}
+
 TEST_F(Renderer, MeshCanBeComparedForEquality)
 {
     osc::Mesh m1;
@@ -2948,6 +3025,84 @@ TEST_F(Renderer, CameraSetClearFlagsCausesCopyToReturnNonEqual)
     ASSERT_NE(camera, copy);
 }
 
+TEST_F(Renderer, DrawMeshWithInstancedDiffuseColorDrawsDifferentlyColoredObjectsInOneDrawCall)
+{
+    static constexpr char const c_InstancedColorVertexShaderSrc[] =
+    R"(
+        #version 330 core
+
+        uniform mat4 uViewProjMat;
+
+        layout (location = 0) in vec3 aPos;
+        layout (location = 6) in mat4 aModelMat;
+        layout (location = 13) in vec4 aDiffuseColor;
+
+        out vec4 DiffuseColor;
+
+        void main()
+        {
+            DiffuseColor = aDiffuseColor;
+            gl_Position = uViewProjMat * aModelMat * vec4(aPos, 1.0);
+        }
+    )";
+
+    static constexpr char const c_InstancedColorFragmentShaderSrc[] =
+    R"(
+        #version 330 core
+
+        in vec4 DiffuseColor;
+
+        out vec4 Color0Out;
+
+        void main()
+        {
+            Color0Out = DiffuseColor;
+        }
+    )";
+
+    osc::Material const material{osc::Shader{c_InstancedColorVertexShaderSrc, c_InstancedColorFragmentShaderSrc}};
+    osc::Mesh const quad = osc::GenTexturedQuad();
+
+    // draw a red quad over the left half of NDC and a green quad over the right half
+    osc::Camera camera;
+    camera.setViewMatrixOverride(glm::mat4{1.0f});
+    camera.setProjectionMatrixOverride(glm::mat4{1.0f});
+    camera.setBackgroundColor(osc::Color::black());
+    for (auto const& [x, color] : {std::make_pair(-0.5f, osc::Color::red()), std::make_pair(0.5f, osc::Color::green())})
+    {
+        osc::Transform t;
+        t.position = {x, 0.0f, 0.0f};
+        t.scale = {0.5f, 1.0f, 1.0f};
+
+        osc::MaterialPropertyBlock props;
+        props.setColor("uDiffuseColor", color);
+        osc::Graphics::DrawMesh(quad, t, material, camera, props);
+    }
+
+    osc::RenderTexture renderTexture{glm::ivec2{4, 2}};
+    camera.renderTo(renderTexture);
+
+    // the differently-colored quads should've been drawn with one (instanced) draw call
+    std::vector<osc::PerfCount> counts;
+    osc::GetAllCounts(counts);
+    auto const it = std::find_if(counts.begin(), counts.end(), [](osc::PerfCount const& c)
+    {
+        return c.getLabel() == "GraphicsBackend::FlushRenderQueue/drawCalls";
+    });
+    ASSERT_NE(it, counts.end());
+    ASSERT_EQ(it->getLastValue(), 1);
+
+    // and each quad should still have its own color
+    osc::Image image;
+    osc::Graphics::ReadPixels(renderTexture, image);
+    ASSERT_EQ(image.getNumChannels(), 4);
+    nonstd::span<uint8_t const> const pixels = image.getPixelData();
+    auto const pixelAt = [&pixels](size_t x) { return std::array<uint8_t, 3>{pixels[4*x], pixels[4*x + 1], pixels[4*x + 2]}; };
+
+    ASSERT_EQ(pixelAt(0), (std::array<uint8_t, 3>{255, 0, 0}));
+    ASSERT_EQ(pixelAt(3), (std::array<uint8_t, 3>{0, 255, 0}));
+}
+
 // TODO MeshSetIndicesU16CausesGetNumIndicesToEqualSuppliedNumberOfIndices
 // TODO Mesh::getIndices
 // TODO Mesh::setIndices U16
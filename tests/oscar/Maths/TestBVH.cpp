@@ -1,6 +1,148 @@
 #include "oscar/Maths/BVH.hpp"
 
+#include "oscar/Maths/AABB.hpp"
+#include "oscar/Maths/Line.hpp"
+
 #include <gtest/gtest.h>
+#include <glm/vec3.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // returns a (deterministic) soup of randomly-placed triangles
+    std::vector<glm::vec3> GenerateTriangleSoup(size_t numTriangles)
+    {
+        std::mt19937 rng{1234};
+        std::uniform_real_distribution<float> centerDist{-10.0f, 10.0f};
+        std::uniform_real_distribution<float> offsetDist{-0.5f, 0.5f};
+
+        std::vector<glm::vec3> rv;
+        rv.reserve(3*numTriangles);
+        for (size_t i = 0; i < numTriangles; ++i)
+        {
+            glm::vec3 const center{centerDist(rng), centerDist(rng), centerDist(rng)};
+            for (size_t v = 0; v < 3; ++v)
+            {
+                rv.push_back(center + glm::vec3{offsetDist(rng), offsetDist(rng), offsetDist(rng)});
+            }
+        }
+        return rv;
+    }
+
+    std::vector<uint32_t> GenerateSequentialIndices(size_t n)
+    {
+        std::vector<uint32_t> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            rv.push_back(static_cast<uint32_t>(i));
+        }
+        return rv;
+    }
+
+    bool Contains(osc::AABB const& outer, osc::AABB const& inner)
+    {
+        for (glm::vec3::length_type i = 0; i < 3; ++i)
+        {
+            if (inner.min[i] < outer.min[i] || inner.max[i] > outer.max[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // recursively checks the structure of the subtree at `nodeIndex`, counting how many
+    // times each prim is referenced by a leaf, and returns the number of nodes in it
+    size_t CheckSubtree(
+        osc::BVH const& bvh,
+        size_t nodeIndex,
+        size_t maxPrimsPerLeaf,
+        std::vector<size_t>& primRefCounts)
+    {
+        osc::BVHNode const& node = bvh.nodes.at(nodeIndex);
+
+        if (node.isLeaf())
+        {
+            EXPECT_GE(node.getNumPrims(), 1);
+            EXPECT_LE(node.getNumPrims(), maxPrimsPerLeaf);
+            for (size_t i = node.getFirstPrimOffset(); i < node.getFirstPrimOffset() + node.getNumPrims(); ++i)
+            {
+                EXPECT_TRUE(Contains(node.getBounds(), bvh.prims.at(i).getBounds()));
+                ++primRefCounts.at(i);
+            }
+            return 1;
+        }
+
+        size_t const lhsIndex = nodeIndex + 1;
+        size_t const rhsIndex = nodeIndex + node.getNumLhsNodes() + 1;
+        EXPECT_TRUE(Contains(node.getBounds(), bvh.nodes.at(lhsIndex).getBounds()));
+        EXPECT_TRUE(Contains(node.getBounds(), bvh.nodes.at(rhsIndex).getBounds()));
+
+        size_t const numLhsNodes = CheckSubtree(bvh, lhsIndex, maxPrimsPerLeaf, primRefCounts);
+        EXPECT_EQ(numLhsNodes, node.getNumLhsNodes());
+        size_t const numRhsNodes = CheckSubtree(bvh, rhsIndex, maxPrimsPerLeaf, primRefCounts);
+        return 1 + numLhsNodes + numRhsNodes;
+    }
+
+    void CheckStructure(osc::BVH const& bvh, size_t maxPrimsPerLeaf)
+    {
+        ASSERT_FALSE(bvh.nodes.empty());
+
+        std::vector<size_t> primRefCounts(bvh.prims.size());
+        size_t const numNodes = CheckSubtree(bvh, 0, maxPrimsPerLeaf, primRefCounts);
+        ASSERT_EQ(numNodes, bvh.nodes.size());
+        for (size_t count : primRefCounts)
+        {
+            ASSERT_EQ(count, 1) << "each prim should be referenced by exactly one leaf";
+        }
+    }
+
+    std::vector<osc::BVHBuildOptions> GenerateBuildOptionsPermutations()
+    {
+        std::vector<osc::BVHBuildOptions> rv;
+        for (auto strategy : {osc::BVHBuildStrategy::Midpoint, osc::BVHBuildStrategy::BinnedSAH})
+        {
+            for (size_t maxPrimsPerLeaf : {1, 2, 4, 8})
+            {
+                osc::BVHBuildOptions opts;
+                opts.strategy = strategy;
+                opts.maxPrimsPerLeaf = maxPrimsPerLeaf;
+                opts.allowParallelBuild = false;
+                rv.push_back(opts);
+            }
+        }
+        return rv;
+    }
+
+    std::optional<float> BruteForceClosestHitDistance(
+        std::vector<glm::vec3> const& verts,
+        osc::Line const& ray)
+    {
+        // uses a single-prim BVH per triangle, so that the test is independent of the tree's structure
+        std::optional<float> rv;
+        for (size_t i = 0; i+2 < verts.size(); i += 3)
+        {
+            osc::BVH single;
+            std::vector<uint32_t> const indices = {0, 1, 2};
+            single.buildFromIndexedTriangles({verts.data() + i, 3}, indices);
+            if (auto const hit = single.getClosestRayIndexedTriangleCollision({verts.data() + i, 3}, indices, ray))
+            {
+                if (!rv || hit->distance < *rv)
+                {
+                    rv = hit->distance;
+                }
+            }
+        }
+        return rv;
+    }
+}
 
 TEST(BVH, BVH_GetMaxDepthReturns0ForEmptyBVH)
 {
@@ -8,3 +150,261 @@ TEST(BVH, BVH_GetMaxDepthReturns0ForEmptyBVH)
 
     ASSERT_EQ(bvh.getMaxDepth(), 0);
 }
+
+TEST(BVH, BuildFromIndexedTrianglesProducesAValidTreeWithEachBuildOption)
+{
+    std::vector<glm::vec3> const verts = GenerateTriangleSoup(1000);
+    std::vector<uint32_t> const indices = GenerateSequentialIndices(verts.size());
+
+    for (osc::BVHBuildOptions const& opts : GenerateBuildOptionsPermutations())
+    {
+        osc::BVH bvh;
+        bvh.buildFromIndexedTriangles(verts, indices, opts);
+
+        ASSERT_EQ(bvh.prims.size(), 1000);
+        CheckStructure(bvh, opts.maxPrimsPerLeaf);
+    }
+}
+
+TEST(BVH, BuildFromAABBsProducesAValidTreeWithEachBuildOption)
+{
+    std::vector<glm::vec3> const verts = GenerateTriangleSoup(500);
+    std::vector<osc::AABB> aabbs;
+    for (size_t i = 0; i < verts.size(); i += 3)
+    {
+        aabbs.push_back(osc::AABB{verts[i], verts[i] + glm::vec3{0.1f, 0.2f, 0.3f}});
+    }
+
+    for (osc::BVHBuildOptions const& opts : GenerateBuildOptionsPermutations())
+    {
+        osc::BVH bvh;
+        bvh.buildFromAABBs(aabbs, opts);
+
+        ASSERT_EQ(bvh.prims.size(), aabbs.size());
+        CheckStructure(bvh, opts.maxPrimsPerLeaf);
+    }
+}
+
+TEST(BVH, BuildHandlesPrimsWithCoincidentCentroids)
+{
+    std::vector<osc::AABB> const aabbs(100, osc::AABB{glm::vec3{-1.0f}, glm::vec3{1.0f}});
+
+    for (osc::BVHBuildOptions const& opts : GenerateBuildOptionsPermutations())
+    {
+        osc::BVH bvh;
+        bvh.buildFromAABBs(aabbs, opts);
+        CheckStructure(bvh, opts.maxPrimsPerLeaf);
+    }
+}
+
+TEST(BVH, MaxPrimsPerLeafIsClampedToTheSupportedRange)
+{
+    std::vector<osc::AABB> const aabbs(1000, osc::AABB{glm::vec3{-1.0f}, glm::vec3{1.0f}});
+
+    osc::BVHBuildOptions opts;
+    opts.maxPrimsPerLeaf = 100000;
+    osc::BVH bvh;
+    bvh.buildFromAABBs(aabbs, opts);
+
+    CheckStructure(bvh, osc::BVHNode::c_MaxPrimsPerLeaf);
+}
+
+TEST(BVH, ParallelBuildProducesTheSameTreeAsSerialBuild)
+{
+    std::vector<glm::vec3> const verts = GenerateTriangleSoup(20000);
+    std::vector<uint32_t> const indices = GenerateSequentialIndices(verts.size());
+
+    osc::BVHBuildOptions serialOpts;
+    serialOpts.allowParallelBuild = false;
+    osc::BVH serial;
+    serial.buildFromIndexedTriangles(verts, indices, serialOpts);
+
+    osc::BVHBuildOptions parallelOpts;
+    parallelOpts.allowParallelBuild = true;
+    parallelOpts.minPrimsForParallelSubtreeBuild = 128;
+    osc::BVH parallel;
+    parallel.buildFromIndexedTriangles(verts, indices, parallelOpts);
+
+    ASSERT_EQ(serial.nodes.size(), parallel.nodes.size());
+    for (size_t i = 0; i < serial.nodes.size(); ++i)
+    {
+        osc::BVHNode const& a = serial.nodes[i];
+        osc::BVHNode const& b = parallel.nodes[i];
+        ASSERT_EQ(a.getBounds(), b.getBounds());
+        ASSERT_EQ(a.isLeaf(), b.isLeaf());
+        if (a.isLeaf())
+        {
+            ASSERT_EQ(a.getFirstPrimOffset(), b.getFirstPrimOffset());
+            ASSERT_EQ(a.getNumPrims(), b.getNumPrims());
+        }
+        else
+        {
+            ASSERT_EQ(a.getNumLhsNodes(), b.getNumLhsNodes());
+        }
+    }
+
+    ASSERT_EQ(serial.prims.size(), parallel.prims.size());
+    for (size_t i = 0; i < serial.prims.size(); ++i)
+    {
+        ASSERT_EQ(serial.prims[i].getID(), parallel.prims[i].getID());
+    }
+}
+
+TEST(BVH, GetClosestRayIndexedTriangleCollisionMatchesBruteForceWithEachBuildOption)
+{
+    std::vector<glm::vec3> const verts = GenerateTriangleSoup(300);
+    std::vector<uint32_t> const indices = GenerateSequentialIndices(verts.size());
+
+    std::vector<osc::Line> rays;
+    for (float x = -10.0f; x <= 10.0f; x += 1.0f)
+    {
+        for (float y = -10.0f; y <= 10.0f; y += 1.0f)
+        {
+            rays.push_back(osc::Line{{x, y, -20.0f}, {0.0f, 0.0f, 1.0f}});
+        }
+    }
+
+    std::vector<std::optional<float>> expected;
+    for (osc::Line const& ray : rays)
+    {
+        expected.push_back(BruteForceClosestHitDistance(verts, ray));
+    }
+
+    for (osc::BVHBuildOptions const& opts : GenerateBuildOptionsPermutations())
+    {
+        osc::BVH bvh;
+        bvh.buildFromIndexedTriangles(verts, indices, opts);
+
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            std::optional<osc::BVHCollision> const hit = bvh.getClosestRayIndexedTriangleCollision(verts, indices, rays[i]);
+            ASSERT_EQ(hit.has_value(), expected[i].has_value());
+            if (hit)
+            {
+                ASSERT_NEAR(hit->distance, *expected[i], 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(BVH, GetRayAABBCollisionsReturnsEachHitPrimWhenLeavesContainMultiplePrims)
+{
+    // a row of boxes along X, which a ray along X should hit all of
+    std::vector<osc::AABB> aabbs;
+    for (int i = 0; i < 50; ++i)
+    {
+        glm::vec3 const center{static_cast<float>(2*i), 0.0f, 0.0f};
+        aabbs.push_back(osc::AABB{center - glm::vec3{0.5f}, center + glm::vec3{0.5f}});
+    }
+
+    osc::BVHBuildOptions opts;
+    opts.maxPrimsPerLeaf = 8;
+    osc::BVH bvh;
+    bvh.buildFromAABBs(aabbs, opts);
+
+    std::vector<osc::BVHCollision> const hits = bvh.getRayAABBCollisions(osc::Line{{-5.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}});
+    ASSERT_EQ(hits.size(), aabbs.size());
+
+    std::vector<bool> seen(aabbs.size());
+    for (osc::BVHCollision const& hit : hits)
+    {
+        seen.at(hit.id) = true;
+    }
+    for (bool s : seen)
+    {
+        ASSERT_TRUE(s);
+    }
+
+    // a ray that passes above all of the boxes shouldn't hit anything
+    ASSERT_TRUE(bvh.getRayAABBCollisions(osc::Line{{-5.0f, 2.0f, 0.0f}, {1.0f, 0.0f, 0.0f}}).empty());
+}
+
+TEST(BVH, GetClosestRayIndexedTriangleCollisionWorksOnTreesThatAreDeeperThanTheTraversalStack)
+{
+    // exponentially-spaced triangles (in the YZ plane) make the midpoint builder produce
+    // a degenerate (chain-like) tree, which a ray along X hits every level of
+    std::vector<glm::vec3> verts;
+    for (int i = 0; i < 100; ++i)
+    {
+        float const x = std::pow(2.0f, static_cast<float>(i));
+        verts.push_back({x, -1.0f, -1.0f});
+        verts.push_back({x, 1.0f, -1.0f});
+        verts.push_back({x, 0.0f, 1.0f});
+    }
+    std::vector<uint32_t> const indices = GenerateSequentialIndices(verts.size());
+
+    osc::BVHBuildOptions opts;
+    opts.strategy = osc::BVHBuildStrategy::Midpoint;
+    opts.maxPrimsPerLeaf = 1;
+    osc::BVH bvh;
+    bvh.buildFromIndexedTriangles(verts, indices, opts);
+    ASSERT_GT(bvh.getMaxDepth(), 64);
+
+    // fire the ray backwards, so that the closest triangle is the last one in the chain
+    osc::Line const ray{{1e31f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}};
+    std::optional<osc::BVHCollision> const hit = bvh.getClosestRayIndexedTriangleCollision(verts, indices, ray);
+    ASSERT_TRUE(hit);
+    ASSERT_EQ(hit->id, 3*99);
+}
+
+TEST(BVH, ForEachRayAABBCollisionVisitsTheSameCollisionsAsGetRayAABBCollisions)
+{
+    std::vector<glm::vec3> const verts = GenerateTriangleSoup(1000);
+    std::vector<osc::AABB> aabbs;
+    for (size_t i = 0; i < verts.size(); i += 3)
+    {
+        aabbs.push_back(osc::AABB{verts[i] - glm::vec3{1.0f}, verts[i] + glm::vec3{1.0f}});
+    }
+    osc::BVH bvh;
+    bvh.buildFromAABBs(aabbs);
+
+    osc::Line const ray{{-20.0f, 0.0f, 0.0f}, {1.0f, 0.05f, 0.0f}};
+    std::vector<osc::BVHCollision> const expected = bvh.getRayAABBCollisions(ray);
+    ASSERT_FALSE(expected.empty());
+
+    std::vector<ptrdiff_t> visited;
+    bvh.forEachRayAABBCollision(ray, [&visited](osc::BVHCollision const& c) { visited.push_back(c.id); });
+
+    ASSERT_EQ(visited.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_EQ(visited[i], expected[i].id);
+    }
+}
+
+TEST(BVH, RefitFromAABBsProducesAValidTreeThatFindsTheMovedAABBs)
+{
+    std::vector<glm::vec3> const verts = GenerateTriangleSoup(1000);
+    std::vector<osc::AABB> aabbs;
+    for (size_t i = 0; i < verts.size(); i += 3)
+    {
+        aabbs.push_back(osc::AABB{verts[i] - glm::vec3{1.0f}, verts[i] + glm::vec3{1.0f}});
+    }
+
+    osc::BVHBuildOptions opts;
+    opts.maxPrimsPerLeaf = 4;
+    osc::BVH bvh;
+    bvh.buildFromAABBs(aabbs, opts);
+    size_t const numNodesBeforeRefit = bvh.nodes.size();
+
+    // move every AABB, so that the old bounds are no longer valid
+    for (osc::AABB& aabb : aabbs)
+    {
+        aabb.min += glm::vec3{100.0f, 0.0f, 0.0f};
+        aabb.max += glm::vec3{100.0f, 0.0f, 0.0f};
+    }
+    bvh.refitFromAABBs(aabbs);
+
+    ASSERT_EQ(bvh.nodes.size(), numNodesBeforeRefit) << "refitting shouldn't change the topology of the tree";
+    CheckStructure(bvh, opts.maxPrimsPerLeaf);
+
+    osc::BVH rebuilt;
+    rebuilt.buildFromAABBs(aabbs, opts);
+    ASSERT_EQ(bvh.getRootAABB(), rebuilt.getRootAABB());
+
+    osc::Line const ray{{80.0f, 0.0f, 0.0f}, {1.0f, 0.05f, 0.0f}};
+    std::vector<osc::BVHCollision> const refitHits = bvh.getRayAABBCollisions(ray);
+    std::vector<osc::BVHCollision> const rebuiltHits = rebuilt.getRayAABBCollisions(ray);
+    ASSERT_FALSE(refitHits.empty());
+    ASSERT_EQ(refitHits.size(), rebuiltHits.size());
+}
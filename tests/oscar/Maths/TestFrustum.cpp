@@ -0,0 +1,60 @@
+#include "oscar/Maths/Frustum.hpp"
+
+#include "oscar/Maths/AABB.hpp"
+#include "oscar/Maths/CollisionTests.hpp"
+#include "oscar/Maths/MathHelpers.hpp"
+#include "oscar/Maths/Plane.hpp"
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace
+{
+    // returns a frustum for a camera at the origin that's looking down -Z with a 90 degree FOV
+    osc::Frustum GetTestFrustum()
+    {
+        glm::mat4 const viewMat = glm::lookAt(glm::vec3{0.0f, 0.0f, 0.0f}, glm::vec3{0.0f, 0.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+        glm::mat4 const projMat = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+        return osc::FrustumFromViewProjectionMatrix(projMat * viewMat);
+    }
+
+    osc::AABB CubeAt(glm::vec3 const& center, float halfWidth)
+    {
+        return osc::AABB{center - halfWidth, center + halfWidth};
+    }
+}
+
+TEST(Frustum, FrustumFromViewProjectionMatrixProducesInwardFacingPlanes)
+{
+    osc::Frustum const frustum = GetTestFrustum();
+    glm::vec3 const pointInFrustum = {0.0f, 0.0f, -10.0f};
+
+    for (osc::Plane const& plane : frustum.planes)
+    {
+        ASSERT_NEAR(glm::length(plane.normal), 1.0f, 1e-5f);
+        ASSERT_GT(glm::dot(pointInFrustum - plane.origin, plane.normal), 0.0f);
+    }
+}
+
+TEST(Frustum, IsAABBIntersectingFrustumReturnsTrueForAABBsInOrStraddlingTheFrustum)
+{
+    osc::Frustum const frustum = GetTestFrustum();
+
+    ASSERT_TRUE(osc::IsAABBIntersectingFrustum(CubeAt({0.0f, 0.0f, -10.0f}, 1.0f), frustum));
+    ASSERT_TRUE(osc::IsAABBIntersectingFrustum(CubeAt({10.0f, 0.0f, -10.0f}, 1.0f), frustum));  // straddles the right plane
+    ASSERT_TRUE(osc::IsAABBIntersectingFrustum(CubeAt({0.0f, 0.0f, 0.0f}, 1.0f), frustum));  // contains the camera
+    ASSERT_TRUE(osc::IsAABBIntersectingFrustum(CubeAt({0.0f, 0.0f, -100.0f}, 1.0f), frustum));  // straddles the far plane
+}
+
+TEST(Frustum, IsAABBIntersectingFrustumReturnsFalseForAABBsOutsideTheFrustum)
+{
+    osc::Frustum const frustum = GetTestFrustum();
+
+    ASSERT_FALSE(osc::IsAABBIntersectingFrustum(CubeAt({0.0f, 0.0f, 10.0f}, 1.0f), frustum));  // behind the camera
+    ASSERT_FALSE(osc::IsAABBIntersectingFrustum(CubeAt({50.0f, 0.0f, -10.0f}, 1.0f), frustum));  // off to the right
+    ASSERT_FALSE(osc::IsAABBIntersectingFrustum(CubeAt({0.0f, -50.0f, -10.0f}, 1.0f), frustum));  // below
+    ASSERT_FALSE(osc::IsAABBIntersectingFrustum(CubeAt({0.0f, 0.0f, -200.0f}, 1.0f), frustum));  // beyond the far plane
+}
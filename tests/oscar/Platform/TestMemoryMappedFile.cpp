@@ -0,0 +1,65 @@
+#include <oscar/Platform/MemoryMappedFile.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    std::filesystem::path WriteTemporaryFile(std::string_view name, std::string_view content)
+    {
+        std::filesystem::path const p = std::filesystem::temp_directory_path() / name;
+        std::ofstream{p, std::ios::binary} << content;
+        return p;
+    }
+}
+
+TEST(MemoryMappedFile, ThrowsIfFileDoesNotExist)
+{
+    ASSERT_THROW({ osc::MemoryMappedFile{std::filesystem::temp_directory_path() / "oscar_doesnotexist.txt"}; }, std::runtime_error);
+}
+
+TEST(MemoryMappedFile, ContentMatchesFileContent)
+{
+    std::string_view const content{"some\ncontent\twith\0a null", 24};  // care: contains a NUL
+    std::filesystem::path const p = WriteTemporaryFile("oscar_mmap_content.txt", content);
+
+    {
+        osc::MemoryMappedFile const f{p};
+        ASSERT_EQ(f.size(), content.size());
+        ASSERT_EQ(f.getChars(), content);
+        ASSERT_EQ(f.getBytes().size(), content.size());
+    }
+
+    std::filesystem::remove(p);
+}
+
+TEST(MemoryMappedFile, CanMapEmptyFile)
+{
+    std::filesystem::path const p = WriteTemporaryFile("oscar_mmap_empty.txt", "");
+
+    {
+        osc::MemoryMappedFile const f{p};
+        ASSERT_EQ(f.size(), 0);
+        ASSERT_TRUE(f.getChars().empty());
+    }
+
+    std::filesystem::remove(p);
+}
+
+TEST(MemoryMappedFile, CanBeMoved)
+{
+    std::filesystem::path const p = WriteTemporaryFile("oscar_mmap_move.txt", "hello");
+
+    {
+        osc::MemoryMappedFile f{p};
+        osc::MemoryMappedFile g{std::move(f)};
+        ASSERT_EQ(g.getChars(), "hello");
+    }
+
+    std::filesystem::remove(p);
+}
@@ -0,0 +1,62 @@
+#include "oscar/Utils/InternedString.hpp"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <future>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST(InternedString, DefaultConstructedIsEmpty)
+{
+    osc::InternedString const s;
+    ASSERT_TRUE(s.empty());
+    ASSERT_EQ(s.str(), "");
+    ASSERT_EQ(s, osc::InternedString{""});
+}
+
+TEST(InternedString, EqualStringsAreInternedToTheSameValue)
+{
+    std::string const a = "/bodyset/femur_r";
+    std::string const b = "/bodyset/" + std::string{"femur_r"};
+
+    osc::InternedString const ia{a};
+    osc::InternedString const ib{b};
+    ASSERT_EQ(ia, ib);
+    ASSERT_EQ(ia.c_str(), ib.c_str()) << "both should point to the same (interned) storage";
+    ASSERT_EQ(std::hash<osc::InternedString>{}(ia), std::hash<osc::InternedString>{}(ib));
+}
+
+TEST(InternedString, DifferentStringsAreNotEqual)
+{
+    osc::InternedString const a{"/bodyset/femur_r"};
+    osc::InternedString const b{"/bodyset/femur_l"};
+    ASSERT_NE(a, b);
+    ASSERT_EQ(a.str(), "/bodyset/femur_r");
+    ASSERT_EQ(b.str(), "/bodyset/femur_l");
+}
+
+TEST(InternedString, CanBeStreamed)
+{
+    std::stringstream ss;
+    ss << osc::InternedString{"some/path"};
+    ASSERT_EQ(ss.str(), "some/path");
+}
+
+TEST(InternedString, InterningConcurrentlyReturnsTheSameValue)
+{
+    auto const internAll = []()
+    {
+        std::vector<osc::InternedString> rv;
+        for (int i = 0; i < 1000; ++i)
+        {
+            rv.emplace_back(std::string{"concurrent/"} + std::to_string(i));
+        }
+        return rv;
+    };
+
+    std::future<std::vector<osc::InternedString>> a = std::async(std::launch::async, internAll);
+    std::future<std::vector<osc::InternedString>> b = std::async(std::launch::async, internAll);
+    ASSERT_EQ(a.get(), b.get());
+}
@@ -0,0 +1,141 @@
+#include "oscar/Utils/Spsc.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST(Spsc, RecvReturnsSentValues)
+{
+    auto [tx, rx] = osc::spsc::channel<int>();
+    tx.send(1);
+    tx.send(2);
+    ASSERT_EQ(rx.recv(), 1);
+    ASSERT_EQ(rx.recv(), 2);
+}
+
+TEST(Spsc, RecvReturnsNulloptWhenSenderHangsUp)
+{
+    auto [tx, rx] = osc::spsc::channel<int>();
+    {
+        auto moved = std::move(tx);
+        moved.send(1);
+    }
+    ASSERT_TRUE(rx.isSenderHungUp());
+    ASSERT_EQ(rx.recv(), 1);  // still receives what was sent before the hangup
+    ASSERT_EQ(rx.recv(), std::nullopt);
+}
+
+TEST(Spsc, BlockingRecvIsWokenBySenderOnAnotherThread)
+{
+    auto [tx, rx] = osc::spsc::channel<int>(4);
+    std::thread sender{[tx = std::move(tx)]() mutable
+    {
+        for (int i = 0; i < 10000; ++i)
+        {
+            tx.send(int{i});  // blocks (backpressure) when the channel is full
+        }
+    }};
+
+    int expected = 0;
+    while (std::optional<int> v = rx.recv())
+    {
+        ASSERT_EQ(*v, expected++);
+    }
+    ASSERT_EQ(expected, 10000);
+    sender.join();
+}
+
+TEST(Spsc, BlockingSendGivesUpWhenPredicateReturnsTrue)
+{
+    auto [tx, rx] = osc::spsc::channel<int>(1);
+    tx.send(1);
+    ASSERT_FALSE(tx.send(2, []() { return true; }));
+    ASSERT_EQ(tx.getNumDropped(), 1);
+    ASSERT_EQ(rx.tryReceive(), 1);
+}
+
+TEST(Spsc, DropNewestPolicyDropsValuesWhenFull)
+{
+    auto [tx, rx] = osc::spsc::channel<int>(2, osc::spsc::OverflowPolicy::DropNewest);
+    for (int i = 0; i < 5; ++i)
+    {
+        tx.send(int{i});
+    }
+
+    std::vector<int> received;
+    rx.tryReceiveAll(std::back_inserter(received));
+    ASSERT_EQ(received, (std::vector<int>{0, 1}));
+    ASSERT_EQ(tx.getNumDropped(), 3);
+}
+
+TEST(Spsc, CoalescePolicyKeepsTheLatestValueWhenFull)
+{
+    auto [tx, rx] = osc::spsc::channel<int>(2, osc::spsc::OverflowPolicy::Coalesce);
+    for (int i = 0; i < 5; ++i)
+    {
+        tx.send(int{i});
+    }
+
+    std::vector<int> received;
+    rx.tryReceiveAll(std::back_inserter(received));
+    tx.flush();
+    rx.tryReceiveAll(std::back_inserter(received));
+    ASSERT_EQ(received, (std::vector<int>{0, 1, 4}));
+}
+
+TEST(Spsc, WorkerRespondsToAllInputsEvenIfTheyOverflowTheChannel)
+{
+    auto f = [](int v) { return 2*v; };
+    auto worker = osc::spsc::Worker<int, int, decltype(f)>::create(f);
+
+    // more than the default channel capacity, but fewer than the capacity + backlog
+    constexpr int c_NumInputs = static_cast<int>(osc::spsc::c_DefaultChannelCapacity) + 32;
+    for (int i = 0; i < c_NumInputs; ++i)
+    {
+        worker.send(i);
+    }
+
+    int expected = 0;
+    while (expected < c_NumInputs)
+    {
+        if (std::optional<int> v = worker.poll())
+        {
+            ASSERT_EQ(*v, 2*expected);
+            ++expected;
+        }
+    }
+    ASSERT_EQ(worker.getNumDroppedInputs(), 0);
+}
+
+TEST(Spsc, WorkerDropsAndCountsInputsThatOverflowItsBacklog)
+{
+    auto f = [](int v) { return 2*v; };
+    auto worker = osc::spsc::Worker<int, int, decltype(f)>::create(f, 8);
+
+    // the worker can't keep up (its outputs aren't being polled), so the backlog fills up
+    constexpr int c_NumInputs = 1000;
+    int numAccepted = 0;
+    for (int i = 0; i < c_NumInputs; ++i)
+    {
+        if (worker.send(i))
+        {
+            ++numAccepted;
+        }
+    }
+    ASSERT_GT(worker.getNumDroppedInputs(), 0);
+    ASSERT_EQ(numAccepted + static_cast<int>(worker.getNumDroppedInputs()), c_NumInputs);
+
+    // but every accepted input is still responded to
+    int numReceived = 0;
+    while (numReceived < numAccepted)
+    {
+        if (worker.poll())
+        {
+            ++numReceived;
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#include "oscar/Utils/SpscRingBuffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+TEST(SpscRingBuffer, CapacityIsRoundedUpToPowerOfTwo)
+{
+    osc::SpscRingBuffer<int> buf{5};
+    ASSERT_EQ(buf.capacity(), 8);
+}
+
+TEST(SpscRingBuffer, TryPopOnEmptyBufferReturnsNullopt)
+{
+    osc::SpscRingBuffer<int> buf{4};
+    ASSERT_TRUE(buf.emptyApprox());
+    ASSERT_EQ(buf.tryPop(), std::nullopt);
+}
+
+TEST(SpscRingBuffer, TryPushFailsWhenFullAndLeavesValueUntouched)
+{
+    osc::SpscRingBuffer<std::unique_ptr<int>> buf{2};
+    ASSERT_TRUE(buf.tryPush(std::make_unique<int>(1)));
+    ASSERT_TRUE(buf.tryPush(std::make_unique<int>(2)));
+
+    auto v = std::make_unique<int>(3);
+    ASSERT_FALSE(buf.tryPush(std::move(v)));
+    ASSERT_NE(v, nullptr);
+    ASSERT_EQ(buf.sizeApprox(), 2);
+}
+
+TEST(SpscRingBuffer, PopsInFifoOrder)
+{
+    osc::SpscRingBuffer<int> buf{4};
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(buf.tryPush(int{i}));
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(buf.tryPop(), i);
+    }
+}
+
+TEST(SpscRingBuffer, PopAllPopsEverythingInOrder)
+{
+    osc::SpscRingBuffer<int> buf{8};
+    for (int i = 0; i < 5; ++i)
+    {
+        ASSERT_TRUE(buf.tryPush(int{i}));
+    }
+
+    std::vector<int> out;
+    ASSERT_EQ(buf.popAll(std::back_inserter(out)), 5);
+    ASSERT_EQ(out, (std::vector<int>{0, 1, 2, 3, 4}));
+    ASSERT_TRUE(buf.emptyApprox());
+}
+
+TEST(SpscRingBuffer, DestructorDestroysRemainingElements)
+{
+    auto p = std::make_shared<int>(1);
+    {
+        osc::SpscRingBuffer<std::shared_ptr<int>> buf{4};
+        ASSERT_TRUE(buf.tryPush(std::shared_ptr<int>{p}));
+        ASSERT_TRUE(buf.tryPush(std::shared_ptr<int>{p}));
+        ASSERT_EQ(p.use_count(), 3);
+    }
+    ASSERT_EQ(p.use_count(), 1);
+}
+
+TEST(SpscRingBuffer, TransfersAllElementsBetweenTwoThreadsInOrder)
+{
+    constexpr int c_NumElements = 100000;
+    osc::SpscRingBuffer<int> buf{16};
+
+    std::thread producer{[&buf]()
+    {
+        for (int i = 0; i < c_NumElements; ++i)
+        {
+            while (!buf.tryPush(int{i}))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    int expected = 0;
+    while (expected < c_NumElements)
+    {
+        if (std::optional<int> v = buf.tryPop())
+        {
+            ASSERT_EQ(*v, expected);
+            ++expected;
+        }
+    }
+    producer.join();
+}
@@ -0,0 +1,98 @@
+#include "oscar/Utils/TextDelta.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // returns a large, XML-like, document with many repeated lines
+    std::string GenerateDocument(size_t numElements)
+    {
+        std::stringstream ss;
+        ss << "<Model name=\"model\">\n";
+        for (size_t i = 0; i < numElements; ++i)
+        {
+            ss << "\t<Body name=\"body_" << i << "\">\n";
+            ss << "\t\t<mass>1</mass>\n";
+            ss << "\t\t<mass_center>0 0 0</mass_center>\n";
+            ss << "\t</Body>\n";
+        }
+        ss << "</Model>\n";
+        return std::move(ss).str();
+    }
+
+    void ReplaceFirst(std::string& s, std::string const& from, std::string const& to)
+    {
+        s.replace(s.find(from), from.size(), to);
+    }
+}
+
+TEST(TextDelta, DefaultConstructedAppliesToEmptyString)
+{
+    ASSERT_EQ(osc::TextDelta{}.apply(""), "");
+}
+
+TEST(TextDelta, ApplyReturnsTargetForEdgeCases)
+{
+    std::string const cases[][2] =
+    {
+        {"", ""},
+        {"", "some text"},
+        {"some text", ""},
+        {"same", "same"},
+        {"no newline", "different, no newline"},
+        {"a\nb\nc\n", "a\nc\n"},
+        {"a\nb\nc\n", "c\nb\na\n"},
+    };
+
+    for (auto const& [base, target] : cases)
+    {
+        ASSERT_EQ(osc::TextDelta(base, target).apply(base), target);
+    }
+}
+
+TEST(TextDelta, ApplyReturnsTargetForScatteredEditsToLargeDocument)
+{
+    std::string const base = GenerateDocument(1000);
+    std::string target = base;
+    ReplaceFirst(target, "body_10\"", "renamed_body\"");
+    ReplaceFirst(target, "\t<Body name=\"body_500\">\n", "");
+    ReplaceFirst(target, "body_900\">\n\t\t<mass>1", "body_900\">\n\t\t<mass>2");
+    target += "<!-- appended -->\n";
+
+    osc::TextDelta const delta{base, target};
+
+    ASSERT_EQ(delta.apply(base), target);
+    ASSERT_LT(delta.getNumBytesUsed(), target.size()/10) << "a few edits should be much smaller than the full text";
+}
+
+TEST(TextDelta, ApplyReturnsTargetForRandomEdits)
+{
+    std::mt19937 rng{1234};
+    std::string const base = GenerateDocument(200);
+
+    for (size_t i = 0; i < 50; ++i)
+    {
+        std::string target = base;
+        for (size_t edit = 0; edit < 5; ++edit)
+        {
+            size_t const pos = std::uniform_int_distribution<size_t>{0, target.size()}(rng);
+            size_t const len = std::uniform_int_distribution<size_t>{0, std::min<size_t>(64, target.size() - pos)}(rng);
+            target.replace(pos, len, edit % 2 == 0 ? "\n\t<inserted/>\n" : "");
+        }
+
+        ASSERT_EQ(osc::TextDelta(base, target).apply(base), target);
+    }
+}
+
+TEST(TextDelta, ApplyThrowsIfGivenADifferentBase)
+{
+    osc::TextDelta const delta{"some base\n", "some target\n"};
+    ASSERT_THROW({ delta.apply("a different base\n"); }, std::runtime_error);
+}
@@ -0,0 +1,89 @@
+#include "oscar/Utils/WorkStealingThreadPool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+TEST(WorkStealingThreadPool, RunsAllSubmittedTasks)
+{
+    std::atomic<int> numRan = 0;
+    {
+        osc::WorkStealingThreadPool pool{4};
+        for (int i = 0; i < 1000; ++i)
+        {
+            pool.submit([&numRan]() { ++numRan; });
+        }
+        pool.waitUntilIdle();
+        ASSERT_EQ(numRan, 1000);
+    }
+}
+
+TEST(WorkStealingThreadPool, DestructorWaitsForSubmittedTasks)
+{
+    std::atomic<int> numRan = 0;
+    {
+        osc::WorkStealingThreadPool pool{2};
+        for (int i = 0; i < 100; ++i)
+        {
+            pool.submit([&numRan]() { ++numRan; });
+        }
+    }
+    ASSERT_EQ(numRan, 100);
+}
+
+TEST(WorkStealingThreadPool, TasksCanSubmitSubtasks)
+{
+    std::atomic<int> numRan = 0;
+    osc::WorkStealingThreadPool pool{3};
+    for (int i = 0; i < 10; ++i)
+    {
+        pool.submit([&pool, &numRan]()
+        {
+            for (int j = 0; j < 10; ++j)
+            {
+                pool.submit([&numRan]() { ++numRan; });
+            }
+        });
+    }
+    pool.waitUntilIdle();
+    ASSERT_EQ(numRan, 100);
+}
+
+TEST(WorkStealingThreadPool, IdleWorkersStealFromBusyWorkers)
+{
+    // all tasks are submitted from one worker (i.e. onto one queue), so the other
+    // workers can only run them by stealing
+    constexpr size_t c_NumThreads = 4;
+    osc::WorkStealingThreadPool pool{c_NumThreads};
+
+    std::atomic<size_t> numRunning = 0;
+    std::atomic<size_t> maxRunning = 0;
+    pool.submit([&]()
+    {
+        for (size_t i = 0; i < 4*c_NumThreads; ++i)
+        {
+            pool.submit([&]()
+            {
+                size_t const n = ++numRunning;
+                size_t prev = maxRunning;
+                while (prev < n && !maxRunning.compare_exchange_weak(prev, n)) {}
+                while (maxRunning < 2) {}  // spin until another worker steals something
+                --numRunning;
+            });
+        }
+    });
+    pool.waitUntilIdle();
+    ASSERT_GE(maxRunning, 2);
+}
+
+TEST(WorkStealingThreadPool, ThrowingTaskDoesNotKillTheWorker)
+{
+    std::atomic<int> numRan = 0;
+    osc::WorkStealingThreadPool pool{1};
+    pool.submit([]() { throw std::runtime_error{"should be caught"}; });
+    pool.submit([&numRan]() { ++numRan; });
+    pool.waitUntilIdle();
+    ASSERT_EQ(numRan, 1);
+}